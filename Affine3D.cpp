@@ -1,4 +1,5 @@
 #include "Affine3D.h"
+#include "Affine3x4.h"
 #include <cmath>
 
 Matrix4x4 MakeRotateXMatrix(float rotateX) {
@@ -9,13 +10,13 @@ Matrix4x4 MakeRotateXMatrix(float rotateX) {
 	matrix.m[0][3] = 0.0f;
 
 	matrix.m[1][0] = 0.0f;
-	matrix.m[1][1] = std::cosf(rotateX);
-	matrix.m[1][2] = std::sinf(rotateX);
+	matrix.m[1][1] = std::cos(rotateX);
+	matrix.m[1][2] = std::sin(rotateX);
 	matrix.m[1][3] = 0.0f;
 
 	matrix.m[2][0] = 0.0f;
-	matrix.m[2][1] = -std::sinf(rotateX);
-	matrix.m[2][2] = std::cosf(rotateX);
+	matrix.m[2][1] = -std::sin(rotateX);
+	matrix.m[2][2] = std::cos(rotateX);
 	matrix.m[2][3] = 0.0f;
 
 	matrix.m[3][0] = 0.0f;
@@ -27,9 +28,9 @@ Matrix4x4 MakeRotateXMatrix(float rotateX) {
 
 Matrix4x4 MakeRotateYMatrix(float rotateY) {
 	Matrix4x4 matrix = {};
-	matrix.m[0][0] = std::cosf(rotateY);
+	matrix.m[0][0] = std::cos(rotateY);
 	matrix.m[0][1] = 0.0f;
-	matrix.m[0][2] = -std::sinf(rotateY);
+	matrix.m[0][2] = -std::sin(rotateY);
 	matrix.m[0][3] = 0.0f;
 
 	matrix.m[1][0] = 0.0f;
@@ -37,9 +38,9 @@ Matrix4x4 MakeRotateYMatrix(float rotateY) {
 	matrix.m[1][2] = 0.0f;
 	matrix.m[1][3] = 0.0f;
 
-	matrix.m[2][0] = std::sinf(rotateY);
+	matrix.m[2][0] = std::sin(rotateY);
 	matrix.m[2][1] = 0.0f;
-	matrix.m[2][2] = std::cosf(rotateY);
+	matrix.m[2][2] = std::cos(rotateY);
 	matrix.m[2][3] = 0.0f;
 
 	matrix.m[3][0] = 0.0f;
@@ -51,13 +52,13 @@ Matrix4x4 MakeRotateYMatrix(float rotateY) {
 
 Matrix4x4 MakeRotateZMatrix(float rotateZ) {
 	Matrix4x4 matrix = {};
-	matrix.m[0][0] = std::cosf(rotateZ);
-	matrix.m[0][1] = std::sinf(rotateZ);
+	matrix.m[0][0] = std::cos(rotateZ);
+	matrix.m[0][1] = std::sin(rotateZ);
 	matrix.m[0][2] = 0.0f;
 	matrix.m[0][3] = 0.0f;
 
-	matrix.m[1][0] = -std::sinf(rotateZ);
-	matrix.m[1][1] = std::cosf(rotateZ);
+	matrix.m[1][0] = -std::sin(rotateZ);
+	matrix.m[1][1] = std::cos(rotateZ);
 	matrix.m[1][2] = 0.0f;
 	matrix.m[1][3] = 0.0f;
 
@@ -98,14 +99,7 @@ Matrix4x4 MakeScaleMatrix(const Vector3& scale) {
 }
 
 Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate) {
-	Matrix4x4 scaleMatrix = MakeScaleMatrix(scale);
-	Matrix4x4 rotateX = MakeRotateXMatrix(rotate.x);
-	Matrix4x4 rotateY = MakeRotateYMatrix(rotate.y);
-	Matrix4x4 rotateZ = MakeRotateZMatrix(rotate.z);
-	Matrix4x4 rotationMatrix = MakeRotateXYZMatrix(rotateX, rotateY, rotateZ);
-	Matrix4x4 translateMatrix = MakeTranslateMatrix(translate);
-	Matrix4x4 affineMatrix = Matrix4x4::Multiply(scaleMatrix, rotationMatrix);
-	affineMatrix = Matrix4x4::Multiply(affineMatrix, translateMatrix);
-	return affineMatrix;
+	// 4x4 の乗算を重ねず、3x4 で直接組み立ててから展開する
+	return Affine3x4::ToMatrix4x4(Affine3x4::MakeAffine(scale, rotate, translate));
 }
 
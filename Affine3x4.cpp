@@ -0,0 +1,159 @@
+#include "Affine3x4.h"
+#include "MathSimd.h"
+#include <cmath>
+
+Affine3x4 Affine3x4::MakeIdentity() {
+	Affine3x4 result = {};
+	result.m[0][0] = 1.0f;
+	result.m[1][1] = 1.0f;
+	result.m[2][2] = 1.0f;
+	return result;
+}
+
+Affine3x4 Affine3x4::MakeAffine(const Vector3& scale, const Vector3& rotate, const Vector3& translate) {
+	const float sx = std::sin(rotate.x), cx = std::cos(rotate.x);
+	const float sy = std::sin(rotate.y), cy = std::cos(rotate.y);
+	const float sz = std::sin(rotate.z), cz = std::cos(rotate.z);
+
+	// Rx * Ry * Rz を展開した回転行列（行ベクトル規約）の各行
+	const float r0[3] = { cy * cz, cy * sz, -sy };
+	const float r1[3] = { sx * sy * cz - cx * sz, sx * sy * sz + cx * cz, sx * cy };
+	const float r2[3] = { cx * sy * cz + sx * sz, cx * sy * sz - sx * cz, cx * cy };
+
+	// S * R は R の各行をスケールする。転置して格納するので列方向に並べる
+	Affine3x4 result;
+	for (int i = 0; i < 3; ++i) {
+		result.m[i][0] = scale.x * r0[i];
+		result.m[i][1] = scale.y * r1[i];
+		result.m[i][2] = scale.z * r2[i];
+	}
+	result.m[0][3] = translate.x;
+	result.m[1][3] = translate.y;
+	result.m[2][3] = translate.z;
+	return result;
+}
+
+Affine3x4 Affine3x4::MakeAffine(const Vector3& scale, const Quaternion& rotate, const Vector3& translate) {
+	const float xx = rotate.x * rotate.x, yy = rotate.y * rotate.y, zz = rotate.z * rotate.z;
+	const float xy = rotate.x * rotate.y, xz = rotate.x * rotate.z, yz = rotate.y * rotate.z;
+	const float wx = rotate.w * rotate.x, wy = rotate.w * rotate.y, wz = rotate.w * rotate.z;
+
+	// 列ベクトル形式の回転行列に、列ごとにスケールを掛けたもの
+	Affine3x4 result;
+	result.m[0][0] = (1.0f - 2.0f * (yy + zz)) * scale.x;
+	result.m[0][1] = 2.0f * (xy - wz) * scale.y;
+	result.m[0][2] = 2.0f * (xz + wy) * scale.z;
+	result.m[0][3] = translate.x;
+
+	result.m[1][0] = 2.0f * (xy + wz) * scale.x;
+	result.m[1][1] = (1.0f - 2.0f * (xx + zz)) * scale.y;
+	result.m[1][2] = 2.0f * (yz - wx) * scale.z;
+	result.m[1][3] = translate.y;
+
+	result.m[2][0] = 2.0f * (xz - wy) * scale.x;
+	result.m[2][1] = 2.0f * (yz + wx) * scale.y;
+	result.m[2][2] = (1.0f - 2.0f * (xx + yy)) * scale.z;
+	result.m[2][3] = translate.z;
+	return result;
+}
+
+Affine3x4 Affine3x4::FromMatrix4x4(const Matrix4x4& matrix) {
+	Affine3x4 result;
+	for (int i = 0; i < 3; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			result.m[i][j] = matrix.m[j][i];
+		}
+	}
+	return result;
+}
+
+Matrix4x4 Affine3x4::ToMatrix4x4(const Affine3x4& affine) {
+	Matrix4x4 result;
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 3; ++j) {
+			result.m[i][j] = affine.m[j][i];
+		}
+		result.m[i][3] = 0.0f;
+	}
+	result.m[3][3] = 1.0f;
+	return result;
+}
+
+Affine3x4 Affine3x4::Multiply(const Affine3x4& a, const Affine3x4& b) {
+	// 列ベクトル形式では b * a（暗黙の最終行 0,0,0,1 を考慮）
+	Affine3x4 result;
+	for (int i = 0; i < 3; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			result.m[i][j] = b.m[i][0] * a.m[0][j] + b.m[i][1] * a.m[1][j] + b.m[i][2] * a.m[2][j];
+		}
+		result.m[i][3] += b.m[i][3];
+	}
+	return result;
+}
+
+Matrix4x4 Affine3x4::Multiply(const Affine3x4& a, const Matrix4x4& b) {
+	// 結果の第 i 行 = a.m[0][i] * b[0] + a.m[1][i] * b[1] + a.m[2][i] * b[2] (+ b[3] : i == 3)
+	Matrix4x4 result;
+#if defined(TOMO_MATH_SSE)
+	const __m128 b0 = _mm_loadu_ps(b.m[0]);
+	const __m128 b1 = _mm_loadu_ps(b.m[1]);
+	const __m128 b2 = _mm_loadu_ps(b.m[2]);
+	const __m128 b3 = _mm_loadu_ps(b.m[3]);
+	for (int i = 0; i < 4; ++i) {
+		__m128 row = _mm_mul_ps(_mm_set1_ps(a.m[0][i]), b0);
+		row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a.m[1][i]), b1));
+		row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a.m[2][i]), b2));
+		if (i == 3) {
+			row = _mm_add_ps(row, b3);
+		}
+		_mm_storeu_ps(result.m[i], row);
+	}
+#else
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			result.m[i][j] = a.m[0][i] * b.m[0][j] + a.m[1][i] * b.m[1][j] + a.m[2][i] * b.m[2][j];
+		}
+	}
+	for (int j = 0; j < 4; ++j) {
+		result.m[3][j] += b.m[3][j];
+	}
+#endif
+	return result;
+}
+
+Affine3x4 Affine3x4::Inverse(const Affine3x4& a) {
+	// 3x3 部分を転置し、各軸のスケールの2乗で割る
+	// （直交する軸を持つ S * R なら (S * R)^-1 = R^T * S^-1）
+	Affine3x4 result;
+	for (int i = 0; i < 3; ++i) {
+		const float lengthSq = a.m[0][i] * a.m[0][i] + a.m[1][i] * a.m[1][i] + a.m[2][i] * a.m[2][i];
+		const float invLengthSq = 1.0f / lengthSq;
+		result.m[i][0] = a.m[0][i] * invLengthSq;
+		result.m[i][1] = a.m[1][i] * invLengthSq;
+		result.m[i][2] = a.m[2][i] * invLengthSq;
+	}
+	// 平行移動は -(逆回転スケール * t)
+	for (int i = 0; i < 3; ++i) {
+		result.m[i][3] = -(result.m[i][0] * a.m[0][3] + result.m[i][1] * a.m[1][3] + result.m[i][2] * a.m[2][3]);
+	}
+	return result;
+}
+
+Vector3 Affine3x4::TransformPoint(const Vector3& point, const Affine3x4& a) {
+	return {
+		a.m[0][0] * point.x + a.m[0][1] * point.y + a.m[0][2] * point.z + a.m[0][3],
+		a.m[1][0] * point.x + a.m[1][1] * point.y + a.m[1][2] * point.z + a.m[1][3],
+		a.m[2][0] * point.x + a.m[2][1] * point.y + a.m[2][2] * point.z + a.m[2][3],
+	};
+}
+
+Vector3 Affine3x4::TransformDirection(const Vector3& direction, const Affine3x4& a) {
+	return {
+		a.m[0][0] * direction.x + a.m[0][1] * direction.y + a.m[0][2] * direction.z,
+		a.m[1][0] * direction.x + a.m[1][1] * direction.y + a.m[1][2] * direction.z,
+		a.m[2][0] * direction.x + a.m[2][1] * direction.y + a.m[2][2] * direction.z,
+	};
+}
+
+Affine3x4 operator*(const Affine3x4& a, const Affine3x4& b) { return Affine3x4::Multiply(a, b); }
+Matrix4x4 operator*(const Affine3x4& a, const Matrix4x4& b) { return Affine3x4::Multiply(a, b); }
@@ -0,0 +1,52 @@
+#pragma once
+#include "Matrix4x4.h"
+#include "Vector3.h"
+#include "Quaternion.h"
+
+// ==================================
+// 3x4 アフィン変換行列
+// ==================================
+// 行ベクトル規約の 4x4 アフィン行列（最終列が 0,0,0,1 固定）を転置し、上3行だけを保持する。
+//
+//   m[i][0..2] : 4x4 行列の第 i 列（スケール・回転成分）
+//   m[i][3]    : 平行移動成分（4x4 行列の m[3][i]）
+//
+// 各行がそのまま float4 になるため、HLSL では row_major float3x4 として
+// mul(World, float4(pos, 1.0f)) で変換できる。サイズは 48 バイト。
+class Affine3x4 {
+public:
+	float m[3][4];
+
+	static Affine3x4 MakeIdentity();
+
+	// S * R * T を直接構築する（MakeAffineMatrix と同じ X→Y→Z の回転順）
+	static Affine3x4 MakeAffine(const Vector3& scale, const Vector3& rotate, const Vector3& translate);
+
+	// 回転をクォータニオンで指定する版（三角関数を使わない。rotate は正規化済みであること）
+	static Affine3x4 MakeAffine(const Vector3& scale, const Quaternion& rotate, const Vector3& translate);
+
+	// 4x4 行列との相互変換（4x4 側の射影成分は捨てる）
+	static Affine3x4 FromMatrix4x4(const Matrix4x4& matrix);
+	static Matrix4x4 ToMatrix4x4(const Affine3x4& affine);
+
+	// a → b の順に適用する合成（4x4 の a * b と同じ）
+	static Affine3x4 Multiply(const Affine3x4& a, const Affine3x4& b);
+
+	// アフィン × 4x4（WVP の計算用）。結果は行ベクトル規約の 4x4
+	static Matrix4x4 Multiply(const Affine3x4& a, const Matrix4x4& b);
+
+	// 逆行列（回転の転置 + スケールの逆数）
+	// シアーを含まない S * R * T 形式を前提とする
+	static Affine3x4 Inverse(const Affine3x4& a);
+
+	// 点の変換（平行移動あり）
+	static Vector3 TransformPoint(const Vector3& point, const Affine3x4& a);
+
+	// 方向ベクトルの変換（平行移動なし）
+	static Vector3 TransformDirection(const Vector3& direction, const Affine3x4& a);
+
+	Vector3 GetTranslation() const { return { m[0][3], m[1][3], m[2][3] }; }
+};
+
+Affine3x4 operator*(const Affine3x4& a, const Affine3x4& b);
+Matrix4x4 operator*(const Affine3x4& a, const Matrix4x4& b);
@@ -0,0 +1,139 @@
+#include "AtlasPacker.h"
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+void AtlasPacker::Reset(uint32_t width, uint32_t height) {
+	width_ = width;
+	height_ = height;
+	usedArea_ = 0;
+	skyline_.clear();
+	skyline_.push_back({ 0, 0, width });
+}
+
+bool AtlasPacker::Fit(size_t index, uint32_t width, uint32_t height, uint32_t& y) const {
+	const uint32_t x = skyline_[index].x;
+	if (x + width > width_) {
+		return false;
+	}
+	// 矩形の幅にかかる区間のうち一番高いところに乗る
+	y = 0;
+	uint32_t remaining = width;
+	for (size_t i = index; remaining > 0; ++i) {
+		assert(i < skyline_.size());
+		y = std::max(y, skyline_[i].y);
+		if (y + height > height_) {
+			return false;
+		}
+		remaining -= std::min(remaining, skyline_[i].width);
+	}
+	return true;
+}
+
+bool AtlasPacker::Insert(uint32_t width, uint32_t height, Rect& rect) {
+	if (width == 0 || height == 0 || width > width_ || height > height_) {
+		return false;
+	}
+
+	// ================================
+	// 1.上端が最も低くなる区間を探す
+	// ================================
+	size_t bestIndex = skyline_.size();
+	uint32_t bestTop = 0;
+	uint32_t bestSegmentWidth = 0;
+	uint32_t bestY = 0;
+	for (size_t i = 0; i < skyline_.size(); ++i) {
+		uint32_t y = 0;
+		if (!Fit(i, width, height, y)) {
+			continue;
+		}
+		const uint32_t top = y + height;
+		if (bestIndex == skyline_.size() || top < bestTop ||
+			(top == bestTop && skyline_[i].width < bestSegmentWidth)) {
+			bestIndex = i;
+			bestTop = top;
+			bestSegmentWidth = skyline_[i].width;
+			bestY = y;
+		}
+	}
+	if (bestIndex == skyline_.size()) {
+		return false;
+	}
+	rect = { skyline_[bestIndex].x, bestY, width, height };
+
+	// ================================
+	// 2.スカイラインを更新する
+	// ================================
+	// 新しい区間を入れ、その下に隠れた区間を削る
+	skyline_.insert(skyline_.begin() + bestIndex, { rect.x, bestTop, width });
+	const uint32_t right = rect.x + width;
+	size_t next = bestIndex + 1;
+	while (next < skyline_.size() && skyline_[next].x < right) {
+		Segment& segment = skyline_[next];
+		const uint32_t segmentRight = segment.x + segment.width;
+		if (segmentRight <= right) {
+			skyline_.erase(skyline_.begin() + next);
+			continue;
+		}
+		segment.width = segmentRight - right;
+		segment.x = right;
+		break;
+	}
+	// 同じ高さで隣り合う区間をまとめる
+	for (size_t i = 0; i + 1 < skyline_.size();) {
+		if (skyline_[i].y == skyline_[i + 1].y) {
+			skyline_[i].width += skyline_[i + 1].width;
+			skyline_.erase(skyline_.begin() + i + 1);
+		} else {
+			++i;
+		}
+	}
+
+	usedArea_ += static_cast<uint64_t>(width) * height;
+	return true;
+}
+
+float AtlasPacker::GetOccupancy() const {
+	const uint64_t pageArea = static_cast<uint64_t>(width_) * height_;
+	return pageArea > 0 ? static_cast<float>(static_cast<double>(usedArea_) / static_cast<double>(pageArea)) : 0.0f;
+}
+
+// ===================================
+// 複数ページへの配置
+// ===================================
+uint32_t AtlasPacker::PackPages(std::span<const Rect> sizes, uint32_t pageWidth, uint32_t pageHeight, std::vector<Placement>& placements) {
+	placements.assign(sizes.size(), Placement{});
+
+	// 高さ（同じなら幅）の大きい順に置くと隙間が少ない
+	std::vector<uint32_t> order(sizes.size());
+	std::iota(order.begin(), order.end(), 0u);
+	std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+		if (sizes[a].height != sizes[b].height) {
+			return sizes[a].height > sizes[b].height;
+		}
+		return sizes[a].width > sizes[b].width;
+	});
+
+	std::vector<AtlasPacker> pages;
+	for (uint32_t index : order) {
+		const Rect& size = sizes[index];
+		if (size.width == 0 || size.height == 0 || size.width > pageWidth || size.height > pageHeight) {
+			continue;
+		}
+		Placement& placement = placements[index];
+		for (uint32_t page = 0; page < pages.size(); ++page) {
+			if (pages[page].Insert(size.width, size.height, placement.rect)) {
+				placement.page = page;
+				break;
+			}
+		}
+		if (placement.page == Placement::kNotPlaced) {
+			pages.emplace_back().Reset(pageWidth, pageHeight);
+			const bool inserted = pages.back().Insert(size.width, size.height, placement.rect);
+			assert(inserted);
+			(void)inserted;
+			placement.page = static_cast<uint32_t>(pages.size() - 1);
+		}
+	}
+	return static_cast<uint32_t>(pages.size());
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// ==================================
+// 矩形の詰め込み（スカイライン法）
+// ==================================
+// ページの上端から積み上がった「スカイライン」（x 方向の区間ごとの高さ）を持ち、
+// 矩形を置いたときに上端が最も低くなる位置（同じなら区間の幅が最も狭い位置）に置く。
+// テクスチャアトラスのタイル配置用（D3D12 にも画像にも依存しない）。
+//
+// 幅・高さを alignment の倍数に切り上げてから渡せば、置かれる位置も alignment の倍数になる
+// （ページの幅も alignment の倍数であること）。
+class AtlasPacker {
+public:
+	struct Rect {
+		uint32_t x = 0;
+		uint32_t y = 0;
+		uint32_t width = 0;
+		uint32_t height = 0;
+	};
+
+	// 複数ページへの配置結果（page が kNotPlaced なら 1 ページに収まらない大きさ）
+	struct Placement {
+		static constexpr uint32_t kNotPlaced = 0xFFFFFFFFu;
+
+		uint32_t page = kNotPlaced;
+		Rect rect;
+	};
+
+	// 空のページにする
+	void Reset(uint32_t width, uint32_t height);
+
+	// width x height を置いて位置を返す。置けなければ false（何も変わらない）
+	bool Insert(uint32_t width, uint32_t height, Rect& rect);
+
+	// 置いた面積 / ページの面積
+	float GetOccupancy() const;
+
+	// sizes（Rect の width / height だけを見る）を大きい順に、既存のページの先頭から順に置き、置けなければページを足す。
+	// placements は sizes と同じ順。使ったページ数を返す
+	static uint32_t PackPages(std::span<const Rect> sizes, uint32_t pageWidth, uint32_t pageHeight, std::vector<Placement>& placements);
+
+private:
+	// スカイラインの 1 区間（x から width の範囲の高さが y）
+	struct Segment {
+		uint32_t x;
+		uint32_t y;
+		uint32_t width;
+	};
+
+	// skyline_[index] の左端に置いたときの上端の高さ。置けなければ false
+	bool Fit(size_t index, uint32_t width, uint32_t height, uint32_t& y) const;
+
+	std::vector<Segment> skyline_; // x の小さい順で隙間なく並ぶ
+	uint32_t width_ = 0;
+	uint32_t height_ = 0;
+	uint64_t usedArea_ = 0;
+};
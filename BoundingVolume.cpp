@@ -0,0 +1,195 @@
+#include "BoundingVolume.h"
+#include "MathSimd.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+const Vector4* PointAt(const Vector4* points, size_t index, size_t stride) {
+	return reinterpret_cast<const Vector4*>(reinterpret_cast<const unsigned char*>(points) + index * stride);
+}
+
+}
+
+// ==================================
+// AABB
+// ==================================
+AABB AABB::MakeEmpty() {
+	constexpr float kInfinity = std::numeric_limits<float>::infinity();
+	return { { kInfinity, kInfinity, kInfinity }, { -kInfinity, -kInfinity, -kInfinity } };
+}
+
+AABB AABB::FromPoints(const Vector4* points, size_t count, size_t stride) {
+	AABB box = MakeEmpty();
+	size_t i = 0;
+
+#if defined(TOMO_MATH_SSE)
+	// 1 点 = __m128 1 本。依存を切るため 2 系統で min / max を取ってから合わせる
+	__m128 min0 = _mm_set1_ps(std::numeric_limits<float>::infinity());
+	__m128 max0 = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+	__m128 min1 = min0;
+	__m128 max1 = max0;
+	for (; i + 2 <= count; i += 2) {
+		const __m128 a = _mm_loadu_ps(&PointAt(points, i, stride)->x);
+		const __m128 b = _mm_loadu_ps(&PointAt(points, i + 1, stride)->x);
+		min0 = _mm_min_ps(min0, a);
+		max0 = _mm_max_ps(max0, a);
+		min1 = _mm_min_ps(min1, b);
+		max1 = _mm_max_ps(max1, b);
+	}
+	alignas(16) float minValues[4];
+	alignas(16) float maxValues[4];
+	_mm_store_ps(minValues, _mm_min_ps(min0, min1));
+	_mm_store_ps(maxValues, _mm_max_ps(max0, max1));
+	box = { { minValues[0], minValues[1], minValues[2] }, { maxValues[0], maxValues[1], maxValues[2] } };
+#elif defined(TOMO_MATH_NEON)
+	float32x4_t min0 = vdupq_n_f32(std::numeric_limits<float>::infinity());
+	float32x4_t max0 = vdupq_n_f32(-std::numeric_limits<float>::infinity());
+	float32x4_t min1 = min0;
+	float32x4_t max1 = max0;
+	for (; i + 2 <= count; i += 2) {
+		const float32x4_t a = vld1q_f32(&PointAt(points, i, stride)->x);
+		const float32x4_t b = vld1q_f32(&PointAt(points, i + 1, stride)->x);
+		min0 = vminq_f32(min0, a);
+		max0 = vmaxq_f32(max0, a);
+		min1 = vminq_f32(min1, b);
+		max1 = vmaxq_f32(max1, b);
+	}
+	float minValues[4];
+	float maxValues[4];
+	vst1q_f32(minValues, vminq_f32(min0, min1));
+	vst1q_f32(maxValues, vmaxq_f32(max0, max1));
+	box = { { minValues[0], minValues[1], minValues[2] }, { maxValues[0], maxValues[1], maxValues[2] } };
+#endif
+
+	// 端数
+	for (; i < count; ++i) {
+		const Vector4& p = *PointAt(points, i, stride);
+		box.min = { std::min(box.min.x, p.x), std::min(box.min.y, p.y), std::min(box.min.z, p.z) };
+		box.max = { std::max(box.max.x, p.x), std::max(box.max.y, p.y), std::max(box.max.z, p.z) };
+	}
+	return box;
+}
+
+AABB AABB::Merge(const AABB& a, const AABB& b) {
+	return {
+		{ std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z) },
+		{ std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z) },
+	};
+}
+
+AABB AABB::Transform(const AABB& box, const Affine3x4& affine) {
+	if (box.IsEmpty()) {
+		return box;
+	}
+	const Vector3 center = Affine3x4::TransformPoint(box.GetCenter(), affine);
+	const Vector3 extents = box.GetExtents();
+	// 各軸の半径 = |行列の行| ・ 元の半径
+	const Vector3 worldExtents = {
+		std::fabs(affine.m[0][0]) * extents.x + std::fabs(affine.m[0][1]) * extents.y + std::fabs(affine.m[0][2]) * extents.z,
+		std::fabs(affine.m[1][0]) * extents.x + std::fabs(affine.m[1][1]) * extents.y + std::fabs(affine.m[1][2]) * extents.z,
+		std::fabs(affine.m[2][0]) * extents.x + std::fabs(affine.m[2][1]) * extents.y + std::fabs(affine.m[2][2]) * extents.z,
+	};
+	return { center - worldExtents, center + worldExtents };
+}
+
+bool AABB::Contains(const Vector3& point) const {
+	return point.x >= min.x && point.x <= max.x &&
+		point.y >= min.y && point.y <= max.y &&
+		point.z >= min.z && point.z <= max.z;
+}
+
+bool AABB::Intersects(const AABB& other) const {
+	return min.x <= other.max.x && max.x >= other.min.x &&
+		min.y <= other.max.y && max.y >= other.min.y &&
+		min.z <= other.max.z && max.z >= other.min.z;
+}
+
+// ==================================
+// BoundingSphere
+// ==================================
+BoundingSphere BoundingSphere::FromPoints(const Vector4* points, size_t count, const AABB& box, size_t stride) {
+	BoundingSphere sphere;
+	if (count == 0 || box.IsEmpty()) {
+		return sphere;
+	}
+	sphere.center = box.GetCenter();
+	float maxDistanceSquared = 0.0f;
+	for (size_t i = 0; i < count; ++i) {
+		const Vector4& p = *PointAt(points, i, stride);
+		const Vector3 d = { p.x - sphere.center.x, p.y - sphere.center.y, p.z - sphere.center.z };
+		maxDistanceSquared = std::max(maxDistanceSquared, Vector3::Dot(d, d));
+	}
+	sphere.radius = std::sqrt(maxDistanceSquared);
+	return sphere;
+}
+
+BoundingSphere BoundingSphere::Transform(const BoundingSphere& sphere, const Affine3x4& affine) {
+	// ローカルの各軸が何倍になるか（Affine3x4 の列の長さ）
+	const float scale = std::sqrt(std::max({
+		affine.m[0][0] * affine.m[0][0] + affine.m[1][0] * affine.m[1][0] + affine.m[2][0] * affine.m[2][0],
+		affine.m[0][1] * affine.m[0][1] + affine.m[1][1] * affine.m[1][1] + affine.m[2][1] * affine.m[2][1],
+		affine.m[0][2] * affine.m[0][2] + affine.m[1][2] * affine.m[1][2] + affine.m[2][2] * affine.m[2][2] }));
+	return { Affine3x4::TransformPoint(sphere.center, affine), sphere.radius * scale };
+}
+
+bool BoundingSphere::Intersects(const BoundingSphere& other) const {
+	const Vector3 d = center - other.center;
+	const float r = radius + other.radius;
+	return Vector3::Dot(d, d) <= r * r;
+}
+
+// ==================================
+// Frustum
+// ==================================
+Frustum Frustum::FromMatrix(const Matrix4x4& viewProjection) {
+	// クリップ座標の第 c 成分 = p ・ (行列の第 c 列)
+	auto column = [&](int c) {
+		return Vector4{ viewProjection.m[0][c], viewProjection.m[1][c], viewProjection.m[2][c], viewProjection.m[3][c] };
+	};
+	const Vector4 x = column(0);
+	const Vector4 y = column(1);
+	const Vector4 z = column(2);
+	const Vector4 w = column(3);
+
+	Frustum frustum;
+	frustum.planes[0] = { w.x + x.x, w.y + x.y, w.z + x.z, w.w + x.w }; // 左   -w <= x
+	frustum.planes[1] = { w.x - x.x, w.y - x.y, w.z - x.z, w.w - x.w }; // 右    x <= w
+	frustum.planes[2] = { w.x + y.x, w.y + y.y, w.z + y.z, w.w + y.w }; // 下   -w <= y
+	frustum.planes[3] = { w.x - y.x, w.y - y.y, w.z - y.z, w.w - y.w }; // 上    y <= w
+	frustum.planes[4] = z;                                              // 近    0 <= z
+	frustum.planes[5] = { w.x - z.x, w.y - z.y, w.z - z.z, w.w - z.w }; // 遠    z <= w
+	for (Vector4& plane : frustum.planes) {
+		const float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+		if (length > 0.0f) {
+			plane = { plane.x / length, plane.y / length, plane.z / length, plane.w / length };
+		}
+	}
+	return frustum;
+}
+
+bool Frustum::Intersects(const BoundingSphere& sphere) const {
+	for (const Vector4& plane : planes) {
+		if (plane.x * sphere.center.x + plane.y * sphere.center.y + plane.z * sphere.center.z + plane.w < -sphere.radius) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool Frustum::Intersects(const AABB& box) const {
+	if (box.IsEmpty()) {
+		return false;
+	}
+	const Vector3 center = box.GetCenter();
+	const Vector3 extents = box.GetExtents();
+	for (const Vector4& plane : planes) {
+		// 平面の法線方向への箱の半径
+		const float radius = std::fabs(plane.x) * extents.x + std::fabs(plane.y) * extents.y + std::fabs(plane.z) * extents.z;
+		if (plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w < -radius) {
+			return false;
+		}
+	}
+	return true;
+}
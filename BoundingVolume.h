@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include "Vector3.h"
+#include "Vector4.h"
+#include "Affine3x4.h"
+#include "Matrix4x4.h"
+
+// ==================================
+// 境界ボリューム
+// ==================================
+// メッシュの読み込み時に 1 度だけ求めて ModelData に持たせ、
+// カリング・LOD 選択・ピッキングでは頂点を走査せずにこれを使う。
+
+// 軸平行境界ボックス
+struct AABB {
+	Vector3 min;
+	Vector3 max;
+
+	// 何も含まない箱（min > max）。Merge の初期値に使う
+	static AABB MakeEmpty();
+
+	// 点列から求める（SIMD で 4 成分ずつ min / max を取る）
+	// points から stride バイトおきに count 個の Vector4 を読み、w は無視する（VertexData::position をそのまま渡せる）
+	static AABB FromPoints(const Vector4* points, size_t count, size_t stride = sizeof(Vector4));
+
+	// 2 つを包む箱
+	static AABB Merge(const AABB& a, const AABB& b);
+
+	// 変換後の 8 頂点を包む箱（Arvo の方法。中心を変換し、半径は行列の絶対値で広げる）
+	static AABB Transform(const AABB& box, const Affine3x4& affine);
+
+	bool IsEmpty() const { return min.x > max.x || min.y > max.y || min.z > max.z; }
+	Vector3 GetCenter() const { return (min + max) * 0.5f; }
+	Vector3 GetExtents() const { return (max - min) * 0.5f; } // 各軸の半分の長さ
+
+	bool Contains(const Vector3& point) const;
+	bool Intersects(const AABB& other) const;
+};
+
+// 境界球
+struct BoundingSphere {
+	Vector3 center;
+	float radius = 0.0f;
+
+	// box の中心を球の中心とし、最も遠い点までを半径とする（points / stride は AABB::FromPoints と同じ）
+	static BoundingSphere FromPoints(const Vector4* points, size_t count, const AABB& box, size_t stride = sizeof(Vector4));
+
+	// 中心を変換し、半径は一番大きい軸のスケールで広げる
+	static BoundingSphere Transform(const BoundingSphere& sphere, const Affine3x4& affine);
+
+	bool Intersects(const BoundingSphere& other) const;
+};
+
+// 視錐台（6 平面。法線は内側向きで正規化済み）
+struct Frustum {
+	// x, y, z : 法線 / w : 距離。dot(法線, p) + w >= 0 が内側
+	Vector4 planes[6];
+
+	// ビュープロジェクション行列（行ベクトル規約、クリップ空間の z は 0～1）から取り出す
+	// ワールド行列まで掛けた WVP を渡せば、平面はモデル空間になる
+	static Frustum FromMatrix(const Matrix4x4& viewProjection);
+
+	// 完全に外側なら false（境界付近は保守的に true）
+	bool Intersects(const BoundingSphere& sphere) const;
+	bool Intersects(const AABB& box) const;
+};
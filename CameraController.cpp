@@ -14,7 +14,7 @@ void CameraController::Initialize() { camera_.Initialize(); }
 void CameraController::Reset() {
 	const WorldTransform& targetTransform = target_->GetWorldTransform();
 	// 追従対象とオフセットからカメラの座標を計算
-	camera_.translation_ = targetTransform.translation_ + targetOffset_;
+	camera_.translation_ = targetTransform.GetTranslation() + targetOffset_;
 }
 
 void CameraController::Update() {
@@ -23,22 +23,22 @@ void CameraController::Update() {
 
 	// ジャンプ中は縦成分を動かさない
 	//if (target_->GetOnGround()) {
-	//	targetPosition_ = targetTransform.translation_ + targetOffset_ + target_->GetVelocity() * kVelocityBias;
+	//	targetPosition_ = targetTransform.GetTranslation() + targetOffset_ + target_->GetVelocity() * kVelocityBias;
 	//} else {
-	//	targetPosition_.x = targetTransform.translation_.x + targetOffset_.x + target_->GetVelocity().x * kVelocityBias;
-	//	targetPosition_.z = targetTransform.translation_.z + targetOffset_.z + target_->GetVelocity().z * kVelocityBias;
+	//	targetPosition_.x = targetTransform.GetTranslation().x + targetOffset_.x + target_->GetVelocity().x * kVelocityBias;
+	//	targetPosition_.z = targetTransform.GetTranslation().z + targetOffset_.z + target_->GetVelocity().z * kVelocityBias;
 	//}
 
-	targetPosition_.x = targetTransform.translation_.x + targetOffset_.x + target_->GetVelocity().x * kVelocityBias;
-	targetPosition_.z = targetTransform.translation_.z + targetOffset_.z + target_->GetVelocity().z * kVelocityBias;
+	targetPosition_.x = targetTransform.GetTranslation().x + targetOffset_.x + target_->GetVelocity().x * kVelocityBias;
+	targetPosition_.z = targetTransform.GetTranslation().z + targetOffset_.z + target_->GetVelocity().z * kVelocityBias;
 
 	// 追従対象とオフセットからカメラの座標を計算
 	camera_.translation_.x = std::lerp(camera_.translation_.x, targetPosition_.x, kInterpolationRate);
 	camera_.translation_.z = std::lerp(camera_.translation_.z, targetPosition_.z, kInterpolationRate);
 
 	// 追従対象が画面内に収まるようにマージンを適応
-	camera_.translation_.x = std::clamp(camera_.translation_.x, targetTransform.translation_.x - kMargin.left, targetTransform.translation_.x + kMargin.right);
-	camera_.translation_.y = std::clamp(camera_.translation_.y, targetTransform.translation_.y - kMargin.top, targetTransform.translation_.y + kMargin.bottom);
+	camera_.translation_.x = std::clamp(camera_.translation_.x, targetTransform.GetTranslation().x - kMargin.left, targetTransform.GetTranslation().x + kMargin.right);
+	camera_.translation_.y = std::clamp(camera_.translation_.y, targetTransform.GetTranslation().y - kMargin.top, targetTransform.GetTranslation().y + kMargin.bottom);
 
 	// 移動可能エリアで制限
 	camera_.translation_.x = std::clamp(camera_.translation_.x, movableArea_.left, movableArea_.right);
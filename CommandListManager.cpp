@@ -76,6 +76,8 @@ void CommandQueue::Create(ID3D12Device* device) {
     assert(SUCCEEDED(hr));
     m_fence->SetName(L"CommandQueueFence");
     m_fence->Signal(0);
+    // 最初の実行は 1 でシグナルする（0 は作成直後から完了扱いなので、フェンスで待つ資源が即座に解放されてしまう）
+    m_nextFenceValue = 1;
 
     m_fenceEventHandle = CreateEvent(nullptr, false, false, nullptr);
     assert(m_fenceEventHandle != nullptr);
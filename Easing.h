@@ -1,9 +1,25 @@
 #pragma once
-#pragma once
-#define _USE_MATH_DEFINES
 #include <algorithm>
 #include <cmath>
-#include <math.h>
+#include <cstdint>
+#include <numbers>
+
+// イージングの種類（TweenSystem などでデータとして持つ用）
+enum class EaseType : uint8_t {
+	Linear,
+	InQuad,
+	OutQuad,
+	InOutQuad,
+	InOutSine,
+	InCubic,
+	OutCubic,
+	InOutCubic,
+	InOut,
+	OutBounce,
+	OutBack,
+	OutElastic,
+	kCount,
+};
 
 class Easing {
 public:
@@ -20,7 +36,7 @@ public:
 	static float EaseInOutQuad(float t) { return t < 0.5f ? 2.0f * t * t : -1.0f + (4.0f - 2.0f * t) * t; }
 
 	// なめらかなリズム感のイージング（加速→減速）
-	static float EaseInOutSine(float t) { return -(cosf((float)M_PI * t) - 1.0f) / 2.0f; }
+	static float EaseInOutSine(float t) { return -(std::cos(std::numbers::pi_v<float> * t) - 1.0f) / 2.0f; }
 
 	// イーズイン（強めの加速）
 	static float EaseInCubic(float t) { return t * t * t; }
@@ -34,7 +50,7 @@ public:
 	// イーズインアウト（強めの加速→減速）
 	static float EaseInOutCubic(float t) { return t < 0.5f ? 4.0f * t * t * t : (t - 1.0f) * (2.0f * t - 2.0f) * (2.0f * t - 2.0f) + 1.0f; }
 
-	static float EaseInOut(float t) { return t < 0.5f ? 2.0f * t * t * t : 1.0f - powf(-2.0f * t + 2.0f, 3) / 2.0f; }
+	static float EaseInOut(float t) { return t < 0.5f ? 2.0f * t * t * t : 1.0f - std::pow(-2.0f * t + 2.0f, 3.0f) / 2.0f; }
 
 	// バウンス（跳ねる）
 	static float EaseOutBounce(float t) {
@@ -78,6 +94,25 @@ public:
 			return 1.0f;
 		float p = 0.3f;
 		float s = p / 4.0f;
-		return powf(2.0f, -10.0f * t) * sinf((t - s) * (2.0f * (float)M_PI) / p) + 1.0f;
+		return std::pow(2.0f, -10.0f * t) * std::sin((t - s) * (2.0f * std::numbers::pi_v<float>) / p) + 1.0f;
+	}
+
+	// 種類を指定して評価する
+	static float Evaluate(EaseType type, float t) {
+		switch (type) {
+		case EaseType::Linear:     return Linear(t);
+		case EaseType::InQuad:     return EaseInQuad(t);
+		case EaseType::OutQuad:    return EaseOutQuad(t);
+		case EaseType::InOutQuad:  return EaseInOutQuad(t);
+		case EaseType::InOutSine:  return EaseInOutSine(t);
+		case EaseType::InCubic:    return EaseInCubic(t);
+		case EaseType::OutCubic:   return EaseOutCubic(t);
+		case EaseType::InOutCubic: return EaseInOutCubic(t);
+		case EaseType::InOut:      return EaseInOut(t);
+		case EaseType::OutBounce:  return EaseOutBounce(t);
+		case EaseType::OutBack:    return EaseOutBack(t);
+		case EaseType::OutElastic: return EaseOutElastic(t);
+		default:                   return t;
+		}
 	}
-};
\ No newline at end of file
+};
@@ -1,22 +1,22 @@
 #include "Enemy.h"
-#include "GraphicsCore.h"
 
 Enemy::Enemy() {}
 Enemy::~Enemy() {}
 
 void Enemy::Initialize(Model* model, const Vector3& position) {
-	worldTransform_.Initialize(GraphicsCore::GetInstance()->GetDevice());
+	worldTransform_.Initialize();
 
 	// 位置を設定
-	worldTransform_.translation_ = position;
-	worldTransform_.scale_ = { 1.0f, 1.0f, 1.0f };
-	worldTransform_.rotation_ = { 0.0f, 0.0f, 0.0f };
+	worldTransform_.SetTranslation(position);
+	worldTransform_.SetScale({ 1.0f, 1.0f, 1.0f });
+	worldTransform_.SetRotation({ 0.0f, 0.0f, 0.0f });
 
 	model_ = model;
+	worldTransform_.SetLocalBounds(model_->GetBounds(), model_->GetBoundingSphere());
 }
 
-void Enemy::Update(const Camera& camera) {
-	worldTransform_.UpdateMatrix(camera);
+void Enemy::Update() {
+	// ワールド行列は TransformSystem::Update でまとめて更新する
 }
 
 void Enemy::Draw(ID3D12GraphicsCommandList* list) {
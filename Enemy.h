@@ -8,7 +8,7 @@ public:
 	Enemy();
 	~Enemy();
 	void Initialize(Model* model, const Vector3& position);
-	void Update(const Camera& camera);
+	void Update();
 	void Draw(ID3D12GraphicsCommandList* list);
 
 	WorldTransform& GetWorldTransform() { return worldTransform_; }
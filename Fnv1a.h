@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+// ==================================
+// FNV-1a ハッシュ
+// ==================================
+// 8 バイト単位で回したもの（キャッシュキー用。暗号強度は不要）
+// MeshCache / TextureCooker のキーに使うので、計算を変えると既存のキャッシュが全部無効になる。
+namespace Fnv1a {
+
+inline constexpr uint64_t kOffsetBasis = 0xcbf29ce484222325ull;
+inline constexpr uint64_t kPrime = 0x100000001b3ull;
+
+inline uint64_t HashBytes(uint64_t hash, const void* data, size_t size) {
+	const unsigned char* p = static_cast<const unsigned char*>(data);
+	while (size >= sizeof(uint64_t)) {
+		uint64_t word;
+		std::memcpy(&word, p, sizeof(word));
+		hash = (hash ^ word) * kPrime;
+		p += sizeof(uint64_t);
+		size -= sizeof(uint64_t);
+	}
+	while (size > 0) {
+		hash = (hash ^ *p) * kPrime;
+		++p;
+		--size;
+	}
+	return hash;
+}
+
+inline uint64_t HashValue(uint64_t hash, uint64_t value) {
+	return HashBytes(hash, &value, sizeof(value));
+}
+
+inline uint64_t HashString(uint64_t hash, std::string_view text) {
+	// 長さも混ぜて "ab"+"c" と "a"+"bc" を区別する
+	hash = HashValue(hash, text.size());
+	return HashBytes(hash, text.data(), text.size());
+}
+
+}
@@ -5,6 +5,8 @@
 #include <numbers>
 #include <format>
 #include "TextureManager.h"
+#include "UploadHeap.h"
+#include "Window.h"
 #include "Sphere.h"
 #include "ModelData.h"
 
@@ -20,6 +22,9 @@ void Game::Initialize() {
 	m_pipeline = std::make_unique<GraphicsPipeline>();
 	m_pipeline->Initialize();
 
+	// トランスフォームの一括管理（WorldTransformより先に初期化）
+	TransformSystem::GetInstance()->Initialize(device);
+
 	// ==================================
 	// 2. 汎用リソース生成 (定数バッファ等)
 	// ==================================
@@ -28,7 +33,7 @@ void Game::Initialize() {
     TransformationMatrix* wvpData = nullptr;
     m_wvpResource.Get()->Map(0, nullptr, reinterpret_cast<void**>(&wvpData));
     wvpData->WVP = Matrix4x4::MakeIdentity4x4();
-    wvpData->World = Matrix4x4::MakeIdentity4x4();
+    wvpData->World = Affine3x4::MakeIdentity();
 
     // マテリアルリソース
     m_materialResource = CreateBufferResource(device, Align256(sizeof(Material)));
@@ -106,7 +111,7 @@ void Game::Initialize() {
 
 	for (uint32_t index = 0; index < kNumInstance; ++index) {
 		instancingData_[index].WVP = Matrix4x4::MakeIdentity4x4();
-		instancingData_[index].World = Matrix4x4::MakeIdentity4x4();
+		instancingData_[index].World = Affine3x4::MakeIdentity();
 	}
 
 	// DescriptorHeapから自動割り当て
@@ -142,17 +147,19 @@ void Game::Initialize() {
     // ==================================
     // TextureManagerの初期化 (ヒープを渡す)
     TextureManager::GetInstance()->Initialize(&m_srvHeap);
+    // テクスチャ転送用のアップロードヒープ（グラフィックスキューのフェンスで使い回す）
+    UploadHeap::GetInstance()->Initialize(device, &GraphicsCore::GetInstance()->GetCommandListManager().GetGraphicsQueue());
+    // ミップストリーミング（粗いミップから読み、画面上の大きさに応じて予算内で細かいミップを足す）
+    constexpr uint64_t kTextureStreamingBudget = 64ull * 1024 * 1024;
+    TextureManager::GetInstance()->EnableStreaming(&GraphicsCore::GetInstance()->GetCommandListManager().GetGraphicsQueue(), kTextureStreamingBudget);
 
     // コマンドリスト開始
     GraphicsContext& context = GraphicsContext::Begin(L"Load Models");
     ID3D12GraphicsCommandList* commandList = context.GetCommandList();
 
     // 1. uvCheckerテクスチャの読み込み
-//    戻り値からGPUハンドルを取得して保持
-    /*const Texture* uvCheckerTexture = TextureManager::GetInstance()->Load("resources/uvChecker.png", commandList);
-    if (uvCheckerTexture) {
-        m_uvCheckerGpuHandle = uvCheckerTexture->gpuHandle;
-    }*/
+    //    ハンドルを保持しておき、描画ではパスを使わない
+    m_uvCheckerTexture = TextureManager::GetInstance()->LoadHandle("resources/uvChecker.png", commandList);
 
 	// モデルデータの初期化
 
@@ -190,18 +197,27 @@ void Game::Initialize() {
 	//camera_->SetTranslation({ 10.0f, 1.0f, -10.0f });
 	//camera_->UpdateMatrix();
 	
-    // 2. Modelの生成
-    modelPlayer_ = Model::CreateFromOBJ("resources/player", "player.obj", commandList);
-    modelSkydome_ = Model::CreateFromOBJ("resources/skydome", "skydome.obj", commandList);
-    modelCube_ = Model::CreateFromOBJ("resources/cube", "cube.obj", commandList);
-	modelFence_ = Model::CreateFromOBJ("resources/fence", "fence.obj", commandList);
+    // 2. 小さいテクスチャはアトラスにまとめる（モデルより先に読むと、マテリアルがページと uvTransform を使う）
+    const std::string atlasTextures[] = {
+        "resources/cube/cube.jpg",
+        "resources/enemy/enemy.png",
+        "resources/fence/fence.png",
+    };
+    TextureManager::GetInstance()->LoadAtlas(atlasTextures, commandList);
+
+    // 3. Modelの生成
+    ModelRegistry* modelRegistry = ModelRegistry::GetInstance();
+    modelPlayer_ = modelRegistry->Load("resources/player", "player.obj", commandList);
+    modelSkydome_ = modelRegistry->Load("resources/skydome", "skydome.obj", commandList);
+    modelCube_ = modelRegistry->Load("resources/cube", "cube.obj", commandList, VertexFormat::Packed);
+	modelFence_ = modelRegistry->Load("resources/fence", "fence.obj", commandList);
 
 	// 初期位置を設定
 	/*modelPlayer_->GetWorldTransform().translation_ = { 10.0f, 10.0f, 0.0f };
 	modelCube_->GetWorldTransform().translation_ = { -3.0f, 0.0f, 0.0f };
 	modelFence_->GetWorldTransform().translation_ = { 0.0f, 0.0f, 0.0f };*/
 
-	blockTransform_.Initialize(device);
+	blockTransform_.Initialize();
 
 	// ==================================
 	// マップチップ用ブロック生成
@@ -215,11 +231,11 @@ void Game::Initialize() {
 	// ==================================
 	Vector3 playerPositon = mapChipField_->GetMapChipPositionByIndex(3, 17);
 	player_ = std::make_unique<Player>();
-	player_->Initialize(modelPlayer_, camera_, playerPositon);
+	player_->Initialize(modelPlayer_.get(), camera_, playerPositon);
 	player_->SetMapChipField(mapChipField_.get());
 
 	skydome_ = std::make_unique<Skydome>();
-	skydome_->Initialize(modelSkydome_, camera_);
+	skydome_->Initialize(modelSkydome_.get(), camera_);
 
 	// カメラコントローラーにプレイヤーをセット
 	cameraController_->SetTarget(player_.get());
@@ -228,17 +244,21 @@ void Game::Initialize() {
 	// Enemy初期化
 	// ==================================
 	enemy_ = std::make_unique<Enemy>();
-	modelEnemy_ = Model::CreateFromOBJ("resources/enemy", "enemy.obj", commandList);
+	modelEnemy_ = modelRegistry->Load("resources/enemy", "enemy.obj", commandList);
 	Vector3 enemyPosition = mapChipField_->GetMapChipPositionByIndex(4, 17);
-	enemy_->Initialize(modelEnemy_, enemyPosition);
+	enemy_->Initialize(modelEnemy_.get(), enemyPosition);
 
     // 転送コマンドの実行と待機
-    context.Finish(true);
+    const uint64_t uploadFenceValue = context.Finish(true);
+    UploadHeap::GetInstance()->Submit(uploadFenceValue);
 }
 
 void Game::Update() {
 	Input().Update();
 
+	// GPU が使い終わったモデルを解放
+	ModelRegistry::GetInstance()->Update();
+
 	// ImGui更新
 	ImGui_ImplDX12_NewFrame();
 	ImGui_ImplWin32_NewFrame();
@@ -259,14 +279,17 @@ void Game::Update() {
 	// スカイドーム更新
 	skydome_->Update();
 
+	// トゥイーンをまとめて進める（各オブジェクトは値を読むだけ）
+	TweenSystem::GetInstance()->Update(1.0f / 60.0f);
+
 	// プレイヤー更新
-	player_->Update(*camera_);
-	enemy_->Update(*camera_);
+	player_->Update();
+	enemy_->Update();
 
 	// パーティクルのインスタンシングデータ更新
 	{
 		for (uint32_t index = 0; index < kNumInstance; ++index) {
-			Matrix4x4 worldMatrix = MakeAffineMatrix(
+			Affine3x4 worldMatrix = Affine3x4::MakeAffine(
 				transform_particles[index].scale,
 				transform_particles[index].rotate,
 				transform_particles[index].translate);
@@ -275,17 +298,11 @@ void Game::Update() {
 			instancingData_[index].World = worldMatrix;
 			instancingData_[index].WVP = wvpMatrix;
 		}
-
-		for (std::vector<WorldTransform*>& worldTransFomBlockLine : worldTransformBlocks_) {
-			for (WorldTransform* worldTransformBlock : worldTransFomBlockLine) {
-				if (!worldTransformBlock) {
-					continue;
-				}
-				worldTransformBlock->UpdateMatrix(*camera_);
-			}
-		}
 	}
 
+	// 全オブジェクト（プレイヤー・敵・スカイドーム・ブロック）の行列をまとめて更新
+	TransformSystem::GetInstance()->Update(*camera_);
+
 
 	// ==================================
 	// ImGui
@@ -311,6 +328,8 @@ void Game::Update() {
 
 	ImGui::Text("Player Texture Handle: %llu", modelPlayer_->GetTextureSrvHandleGPU().ptr);
 	ImGui::Text("Fence Texture Handle: %llu", modelFence_->GetTextureSrvHandleGPU().ptr);
+	const TextureResidency& residency = TextureManager::GetInstance()->GetResidency();
+	ImGui::Text("Texture Residency: %.1f / %.1f MB", residency.GetResidentBytes() / (1024.0 * 1024.0), residency.GetBudget() / (1024.0 * 1024.0));
 
 	ImGui::End();
 	ImGui::Render();
@@ -326,6 +345,9 @@ void Game::Update() {
 }
 
 void Game::Render() {
+	// コピーの終わったアップロード領域を戻す
+	UploadHeap::GetInstance()->Retire();
+
 	// 1. コンテキスト取得 (コマンドリストのリセット等を含む)
 	GraphicsContext& context = GraphicsContext::Begin(L"Scene Render");
 
@@ -340,6 +362,9 @@ void Game::Render() {
 	// 3. 生のコマンドリストを取得して描画コマンドを積む
 	ID3D12GraphicsCommandList* commandList = context.GetCommandList();
 
+	// 前のフレームの要求で常駐ミップを入れ替える（転送は描画より前に積む）
+	TextureManager::GetInstance()->UpdateStreaming(commandList);
+
 	// 画面クリア
 	commandList->ClearRenderTargetView(backBuffer.GetRTV(), backBuffer.GetClearColor(), 0, nullptr);
 	commandList->ClearDepthStencilView(depthBuffer.GetDSV(), D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0, 0, nullptr);
@@ -380,16 +405,18 @@ void Game::Render() {
 	// スカイドームの描画(背景)
 	skydome_->Draw(commandList);
 
-	// ブロックの描画
-	for (std::vector<WorldTransform*> worldTransformBlockLine : worldTransformBlocks_) {
-		for (WorldTransform* worldTransformBlock : worldTransformBlockLine) {
+	// ブロックの描画（圧縮頂点なので専用のパイプラインで描く）
+	m_pipeline->SetState(commandList, PipelineType::Object3DPacked);
+	for (const std::vector<std::unique_ptr<WorldTransform>>& worldTransformBlockLine : worldTransformBlocks_) {
+		for (const std::unique_ptr<WorldTransform>& worldTransformBlock : worldTransformBlockLine) {
 			if (!worldTransformBlock) {
 				continue;
 			}
 
-			modelCube_->Draw(commandList, *worldTransformBlock);
+			modelCube_->Draw(commandList, *worldTransformBlock, *camera_);
 		}
 	}
+	m_pipeline->SetState(commandList, PipelineType::Object3D);
 
 	// 2. モデルの描画
 	//modelPlayer_->PreDraw(commandList);
@@ -414,9 +441,10 @@ void Game::Render() {
 	commandList->SetGraphicsRootDescriptorTable(1, m_instancingSrvHandleGPU);
 
 	// テクスチャ設定（Root Parameter 2）
-	// uvCheckerのハンドルを取得して設定する必要がある
-	const Texture* uvCheckerTexture = TextureManager::GetInstance()->Load("resources/uvChecker.png", commandList);
-	if (uvCheckerTexture) {
+	// 初期化時に取ったハンドルから引く（文字列の生成・ハッシュをしない）
+	// パーティクルは画面上の大きさを見積もらないので、常に最も細かいミップを要求する
+	TextureManager::GetInstance()->RequestMip(m_uvCheckerTexture, static_cast<float>(kClientHeight));
+	if (const Texture* uvCheckerTexture = TextureManager::GetInstance()->Get(m_uvCheckerTexture)) {
 		commandList->SetGraphicsRootDescriptorTable(2, uvCheckerTexture->gpuHandle);
 	}
 
@@ -427,16 +455,28 @@ void Game::Render() {
 	ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), commandList);
 
 	context.TransitionResource(backBuffer, D3D12_RESOURCE_STATE_PRESENT, true);
-	context.Finish();
+	const uint64_t fenceValue = context.Finish();
+	UploadHeap::GetInstance()->Submit(fenceValue);
+	TextureManager::GetInstance()->SubmitStreaming(fenceValue);
 }
 
 void Game::Shutdown() {
 	// GPU処理の完了を待機
 	GraphicsCore::GetInstance()->GetCommandListManager().GetGraphicsQueue().WaitForIdle();
 
-	// 生成したモデルの解放
-	delete modelCube_;
-	modelCube_ = nullptr;
+	// 生成したモデルの解放（ハンドルを全て手放してからレジストリを閉じる）
+	modelCube_.reset();
+	modelPlayer_.reset();
+	modelSkydome_.reset();
+	modelFence_.reset();
+	modelEnemy_.reset();
+	ModelRegistry::GetInstance()->Shutdown();
+
+	// ブロックのトランスフォームを返却してからアップロードバッファを解放
+	worldTransformBlocks_.clear();
+	TransformSystem::GetInstance()->Shutdown();
+	TweenSystem::GetInstance()->Clear();
+	UploadHeap::GetInstance()->Shutdown();
 
 	ImGui_ImplDX12_Shutdown();
 	ImGui_ImplWin32_Shutdown();
@@ -465,10 +505,11 @@ void Game::GenerateBlocks() {
 				continue;
 			}
 			// ブロック有り
-			worldTransformBlocks_[vp][hp] = new WorldTransform();
-			worldTransformBlocks_[vp][hp]->Initialize(GraphicsCore::GetInstance()->GetDevice());
+			worldTransformBlocks_[vp][hp] = std::make_unique<WorldTransform>();
+			worldTransformBlocks_[vp][hp]->Initialize();
 			Vector3 blockPosition = mapChipField_->GetMapChipPositionByIndex(hp, vp);
-			worldTransformBlocks_[vp][hp]->translation_ = blockPosition;
+			worldTransformBlocks_[vp][hp]->SetTranslation(blockPosition);
+			worldTransformBlocks_[vp][hp]->SetLocalBounds(modelCube_->GetBounds(), modelCube_->GetBoundingSphere());
 		}
 	}
 }
\ No newline at end of file
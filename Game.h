@@ -5,6 +5,8 @@
 #include "GraphicsPipeline.h"
 
 #include "Model.h"
+#include "ModelRegistry.h"
+#include "TextureManager.h"
 #include "MapChipField.h"
 
 #include "Player.h"
@@ -49,7 +51,7 @@ private:
     std::unique_ptr<GraphicsPipeline> m_pipeline;
 
     // テクスチャリソース
-    D3D12_GPU_DESCRIPTOR_HANDLE m_uvCheckerGpuHandle = {};
+    TextureHandle m_uvCheckerTexture;
     D3D12_GPU_DESCRIPTOR_HANDLE m_instancingSrvHandleGPU{};
     Microsoft::WRL::ComPtr<ID3D12Resource> m_instancingResource; 
 
@@ -79,10 +81,10 @@ private:
     // ===================================
 	// オブジェクト
 	// ===================================
-    Model* modelCube_ = nullptr;
-    Model* modelPlayer_ = nullptr;
-    Model* modelSkydome_ = nullptr;
-	Model* modelFence_ = nullptr;
+    ModelHandle modelCube_;
+    ModelHandle modelPlayer_;
+    ModelHandle modelSkydome_;
+	ModelHandle modelFence_;
 
 	bool isDebugCameraActive_ = false;
     Camera* camera_ = nullptr;
@@ -98,7 +100,7 @@ private:
 	// ===================================
 	std::unique_ptr<Player> player_;
 
-	Model* modelEnemy_ = nullptr;
+	ModelHandle modelEnemy_;
 	std::unique_ptr<Enemy> enemy_;
 
     // ==================================
@@ -131,5 +133,5 @@ private:
 	// ===================================
 	WorldTransform blockTransform_;
 	std::unique_ptr<MapChipField> mapChipField_;
-    std::vector<std::vector<WorldTransform*>> worldTransformBlocks_;
+    std::vector<std::vector<std::unique_ptr<WorldTransform>>> worldTransformBlocks_;
 };
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <cassert>
 #include <format>
 #include "Logger.h"
+#include "PackedVertexData.h"
 
 void GraphicsPipeline::Initialize() {
     InitializeDXC();
@@ -11,6 +12,7 @@ void GraphicsPipeline::Initialize() {
     // Object3D用の初期化
     CreateObject3DRootSignature();
     CreateObject3DPSO();
+    CreateObject3DPackedPSO();
 
     // Particle用の初期化
     CreateParticleRootSignature();
@@ -22,6 +24,10 @@ void GraphicsPipeline::SetState(ID3D12GraphicsCommandList* commandList, Pipeline
         commandList->SetGraphicsRootSignature(object3DRootSignature_.Get());
         commandList->SetPipelineState(object3DPipelineState_.Get());
     }
+    else if (type == PipelineType::Object3DPacked) {
+        // ルートシグネチャは Object3D と共通。設定し直さず、Object3D で設定済みのルート引数（ライト等）をそのまま使う
+        commandList->SetPipelineState(object3DPackedPipelineState_.Get());
+    }
     else if (type == PipelineType::Particle) {
         commandList->SetGraphicsRootSignature(particleRootSignature_.Get());
         commandList->SetPipelineState(particlePipelineState_.Get());
@@ -50,7 +56,7 @@ void GraphicsPipeline::InitializeDXC() {
 void GraphicsPipeline::CreateObject3DRootSignature() {
     ID3D12Device* device = GetDevice();
 
-    D3D12_ROOT_PARAMETER rootParameters[4] = {};
+    D3D12_ROOT_PARAMETER rootParameters[5] = {};
 
     // [0] Material (CBV)
     rootParameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
@@ -79,6 +85,13 @@ void GraphicsPipeline::CreateObject3DRootSignature() {
     rootParameters[3].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
     rootParameters[3].Descriptor.ShaderRegister = 1;
 
+    // [4] VertexQuantization (32bit 定数、PackedVertexData の位置の復元用)
+    rootParameters[4].ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+    rootParameters[4].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+    rootParameters[4].Constants.ShaderRegister = 1;
+    rootParameters[4].Constants.RegisterSpace = 0;
+    rootParameters[4].Constants.Num32BitValues = sizeof(VertexQuantization) / sizeof(uint32_t);
+
     D3D12_STATIC_SAMPLER_DESC staticSamplers[1] = {};
     staticSamplers[0].Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
     staticSamplers[0].AddressU = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
@@ -108,8 +121,6 @@ void GraphicsPipeline::CreateObject3DRootSignature() {
 }
 
 void GraphicsPipeline::CreateObject3DPSO() {
-    ID3D12Device* device = GetDevice();
-
     D3D12_INPUT_ELEMENT_DESC inputElementDescs[3] = {};
     inputElementDescs[0].SemanticName = "POSITION"; inputElementDescs[0].SemanticIndex = 0; inputElementDescs[0].Format = DXGI_FORMAT_R32G32B32A32_FLOAT; inputElementDescs[0].AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT;
     inputElementDescs[1].SemanticName = "TEXCOORD"; inputElementDescs[1].SemanticIndex = 0; inputElementDescs[1].Format = DXGI_FORMAT_R32G32_FLOAT; inputElementDescs[1].AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT;
@@ -119,6 +130,27 @@ void GraphicsPipeline::CreateObject3DPSO() {
     inputLayoutDesc.pInputElementDescs = inputElementDescs;
     inputLayoutDesc.NumElements = _countof(inputElementDescs);
 
+    object3DPipelineState_ = CreateObject3DPipelineState(inputLayoutDesc, L"Object3d.VS.hlsl");
+}
+
+void GraphicsPipeline::CreateObject3DPackedPSO() {
+    // PackedVertexData に合わせたレイアウト（16 バイト）
+    D3D12_INPUT_ELEMENT_DESC inputElementDescs[3] = {};
+    inputElementDescs[0].SemanticName = "POSITION"; inputElementDescs[0].SemanticIndex = 0; inputElementDescs[0].Format = DXGI_FORMAT_R16G16B16A16_UNORM; inputElementDescs[0].AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT;
+    inputElementDescs[1].SemanticName = "TEXCOORD"; inputElementDescs[1].SemanticIndex = 0; inputElementDescs[1].Format = DXGI_FORMAT_R16G16_FLOAT; inputElementDescs[1].AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT;
+    inputElementDescs[2].SemanticName = "NORMAL";   inputElementDescs[2].SemanticIndex = 0; inputElementDescs[2].Format = DXGI_FORMAT_R16G16_SNORM; inputElementDescs[2].AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT;
+
+    D3D12_INPUT_LAYOUT_DESC inputLayoutDesc = {};
+    inputLayoutDesc.pInputElementDescs = inputElementDescs;
+    inputLayoutDesc.NumElements = _countof(inputElementDescs);
+
+    object3DPackedPipelineState_ = CreateObject3DPipelineState(inputLayoutDesc, L"Object3dPacked.VS.hlsl");
+}
+
+Microsoft::WRL::ComPtr<ID3D12PipelineState> GraphicsPipeline::CreateObject3DPipelineState(
+    const D3D12_INPUT_LAYOUT_DESC& inputLayoutDesc, const std::wstring& vertexShaderPath) {
+    ID3D12Device* device = GetDevice();
+
     D3D12_BLEND_DESC blendDesc = {};
     blendDesc.RenderTarget[0].RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
     blendDesc.RenderTarget[0].BlendEnable = TRUE;
@@ -133,7 +165,7 @@ void GraphicsPipeline::CreateObject3DPSO() {
     rasterizerDesc.CullMode = D3D12_CULL_MODE_BACK;
     rasterizerDesc.FillMode = D3D12_FILL_MODE_SOLID;
 
-    Microsoft::WRL::ComPtr<IDxcBlob> vertexShaderBlob = CompileShader(L"Object3d.VS.hlsl", L"vs_6_0");
+    Microsoft::WRL::ComPtr<IDxcBlob> vertexShaderBlob = CompileShader(vertexShaderPath, L"vs_6_0");
     Microsoft::WRL::ComPtr<IDxcBlob> pixelShaderBlob = CompileShader(L"Object3d.PS.hlsl", L"ps_6_0");
 
     D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc = {};
@@ -153,8 +185,10 @@ void GraphicsPipeline::CreateObject3DPSO() {
     psoDesc.SampleDesc.Count = 1;
     psoDesc.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
 
-    HRESULT hr = device->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(&object3DPipelineState_));
+    Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState;
+    HRESULT hr = device->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(&pipelineState));
     assert(SUCCEEDED(hr));
+    return pipelineState;
 }
 
 // ===================================
@@ -6,6 +6,7 @@
 
 enum class PipelineType {
     Object3D,
+    Object3DPacked, // PackedVertexData 用（ルートシグネチャは Object3D と共通。Object3D を設定した後に切り替える）
     Particle
 };
 
@@ -20,6 +21,9 @@ private:
     // Object3D用
     void CreateObject3DRootSignature();
     void CreateObject3DPSO();
+    void CreateObject3DPackedPSO();
+    Microsoft::WRL::ComPtr<ID3D12PipelineState> CreateObject3DPipelineState(
+        const D3D12_INPUT_LAYOUT_DESC& inputLayoutDesc, const std::wstring& vertexShaderPath);
 
     // Particle用
     void CreateParticleRootSignature();
@@ -37,6 +41,7 @@ private:
     // Object3D用
     Microsoft::WRL::ComPtr<ID3D12RootSignature> object3DRootSignature_;
     Microsoft::WRL::ComPtr<ID3D12PipelineState> object3DPipelineState_;
+    Microsoft::WRL::ComPtr<ID3D12PipelineState> object3DPackedPipelineState_;
 
     // Particle用
     Microsoft::WRL::ComPtr<ID3D12RootSignature> particleRootSignature_;
@@ -26,4 +26,36 @@ MaterialData LoadMaterialTemplateFile(const std::string& directoryPath, const st
 	}
 
 	return materialData;
+}
+
+std::vector<MaterialData> LoadMaterialTemplateLibrary(const std::string& directoryPath, const std::string& filename) {
+	std::vector<MaterialData> materials; // 構築するMaterialDataの一覧
+	std::string line; // ファイルから一行を格納するもの
+	std::ifstream file(directoryPath + "/" + filename); // ファイルを開く
+	assert(file.is_open()); // 開けなかったら止める
+
+	while (std::getline(file, line)) {
+		std::string identifier;
+		std::istringstream s(line);
+		s >> identifier;
+
+		//identifierに応じた処理
+		if (identifier == "newmtl") {
+			// 新しいマテリアルの開始
+			materials.emplace_back();
+			s >> materials.back().name;
+		}
+		else if (identifier == "map_Kd") {
+			std::string textureFilename;
+			s >> textureFilename;
+			// newmtl より前に書かれていた場合は名前なしのマテリアルとして扱う
+			if (materials.empty()) {
+				materials.emplace_back();
+			}
+			//連結してファイルパスにする
+			materials.back().textureFilePath = directoryPath + "/" + textureFilename;
+		}
+	}
+
+	return materials;
 }
\ No newline at end of file
@@ -1,5 +1,9 @@
 #pragma once
 #include "MaterialData.h"
 #include "string.h"
+#include <vector>
 
-MaterialData LoadMaterialTemplateFile(const std::string& directoryPath, const std::string& filename);
\ No newline at end of file
+MaterialData LoadMaterialTemplateFile(const std::string& directoryPath, const std::string& filename);
+
+// ファイル内の全マテリアル（newmtl ごと）を読み込む
+std::vector<MaterialData> LoadMaterialTemplateLibrary(const std::string& directoryPath, const std::string& filename);
\ No newline at end of file
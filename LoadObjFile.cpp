@@ -1,98 +1,542 @@
 #include "LoadObjFile.h"
 #include "LoadMaterialTemplateFile.h"
+#include "MappedFile.h"
 
-#include <fstream>
-#include <sstream>
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <thread>
 
-ModelData LoadObjFile(const std::string& directoryPath, const std::string& fileName) {
-	// ================================
-	// 1.必要な変数の宣言
-	// ================================
-	ModelData modelData; // 構築するModelData
-	std::vector<Vector4> positions; // 頂点座標格
-	std::vector<Vector3> normals;   // 法線ベクトル格納
-	std::vector<Vector2> texcoords; // UV座標格納
-	std::string line; // ファイルから読み込んだ1行分の文字列
+namespace {
 
+// 行内の区切り（CRLF の '\r' も空白として扱う）
+bool IsSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
 
-	// ================================
-	// 2.ファイルを開く
-	// ================================
-	std::ifstream file(directoryPath + "/" + fileName); // ファイルを開く
-	assert(file.is_open()); // ファイルが開けなかった場合は停止
+// この行の終端（'\n' の位置、最終行ならファイル終端）を求める
+const char* FindLineEnd(const char* p, const char* end) {
+	const void* newline = std::memchr(p, '\n', static_cast<size_t>(end - p));
+	return newline ? static_cast<const char*>(newline) : end;
+}
 
-	// ================================
-	// 3.ファイルを読みモデルデータを構築
-	// ================================
-	while (std::getline(file, line)) {
-		std::string identifier; // 行の先頭識別子
-		std::istringstream s(line);
-		s >> identifier; // 行の先頭識別子を取得
+const char* SkipSpaces(const char* p, const char* lineEnd) {
+	while (p < lineEnd && IsSpace(*p)) {
+		++p;
+	}
+	return p;
+}
+
+// 空白区切りのトークンを 1 つ取り出す（コピーしない）
+std::string_view NextToken(const char*& p, const char* lineEnd) {
+	p = SkipSpaces(p, lineEnd);
+	const char* begin = p;
+	while (p < lineEnd && !IsSpace(*p)) {
+		++p;
+	}
+	return { begin, static_cast<size_t>(p - begin) };
+}
+
+float ParseFloat(const char*& p, const char* lineEnd) {
+	p = SkipSpaces(p, lineEnd);
+	// from_chars は先頭の '+' を受け付けないので読み飛ばす
+	if (p < lineEnd && *p == '+') {
+		++p;
+	}
+	float value = 0.0f;
+	const std::from_chars_result result = std::from_chars(p, lineEnd, value);
+	assert(result.ec == std::errc() && "OBJの数値が読めない");
+	p = result.ptr;
+	return value;
+}
+
+// 面のインデックスを読む（負の値は「直前に定義された要素から数えた位置」）
+int32_t ParseIndex(const char*& p, const char* end) {
+	int32_t value = 0;
+	const std::from_chars_result result = std::from_chars(p, end, value);
+	assert(result.ec == std::errc() && value != 0 && "OBJの面のインデックスが読めない");
+	p = result.ptr;
+	return value;
+}
+
+// 負のインデックスを 1 始まりの絶対番号に直す
+// definedCount : この面より前に定義された要素の数（ファイル全体での通し番号）
+uint32_t ResolveIndex(int32_t index, size_t definedCount) {
+	const int64_t resolved = index < 0 ? static_cast<int64_t>(definedCount) + index + 1 : index;
+	assert(resolved >= 1 && "OBJの面のインデックスが範囲外");
+	return static_cast<uint32_t>(resolved);
+}
+
+// 事前に数えた要素数（配列の確保用）
+struct ObjCounts {
+	size_t positions = 0;
+	size_t texcoords = 0;
+	size_t normals = 0;
+	size_t faceCorners = 0;
+	size_t triangleVertices = 0;
+};
+
+// 「位置/UV/法線」のインデックスの組 → 頂点番号 の表（オープンアドレス法）
+// 同じ組を参照する面の頂点を 1 つにまとめる（溶接）のに使う
+class VertexWeldTable {
+public:
+	explicit VertexWeldTable(size_t expectedCount) {
+		entries_.resize(std::bit_ceil(std::max<size_t>(expectedCount * 2, 16)));
+	}
+
+	// 登録済みならその頂点番号を、未登録なら newIndex を登録して返す
+	uint32_t FindOrInsert(uint32_t position, uint32_t texcoord, uint32_t normal, uint32_t newIndex) {
+		if ((count_ + 1) * 2 > entries_.size()) {
+			Grow();
+		}
+		const size_t mask = entries_.size() - 1;
+		for (size_t i = Hash(position, texcoord, normal) & mask;; i = (i + 1) & mask) {
+			Entry& entry = entries_[i];
+			if (entry.position == 0) {
+				entry = { position, texcoord, normal, newIndex };
+				++count_;
+				return newIndex;
+			}
+			if (entry.position == position && entry.texcoord == texcoord && entry.normal == normal) {
+				return entry.vertex;
+			}
+		}
+	}
+
+private:
+	// OBJ のインデックスは 1 始まりなので position == 0 を空きとする
+	struct Entry {
+		uint32_t position = 0;
+		uint32_t texcoord = 0;
+		uint32_t normal = 0;
+		uint32_t vertex = 0;
+	};
+
+	static size_t Hash(uint32_t position, uint32_t texcoord, uint32_t normal) {
+		uint64_t h = position * 0x9E3779B97F4A7C15ull;
+		h ^= texcoord * 0xC2B2AE3D27D4EB4Full + (h >> 29);
+		h ^= normal * 0x165667B19E3779F9ull + (h >> 32);
+		return static_cast<size_t>(h ^ (h >> 31));
+	}
+
+	void Grow() {
+		std::vector<Entry> old = std::move(entries_);
+		entries_.assign(old.size() * 2, Entry{});
+		const size_t mask = entries_.size() - 1;
+		for (const Entry& entry : old) {
+			if (entry.position == 0) {
+				continue;
+			}
+			size_t i = Hash(entry.position, entry.texcoord, entry.normal) & mask;
+			while (entries_[i].position != 0) {
+				i = (i + 1) & mask;
+			}
+			entries_[i] = entry;
+		}
+	}
+
+	std::vector<Entry> entries_;
+	size_t count_ = 0;
+};
+
+// 1 パス目：各要素の数と三角形分割後の頂点数を数える
+ObjCounts CountElements(const char* data, const char* end) {
+	ObjCounts counts;
+	for (const char* line = data; line < end;) {
+		const char* lineEnd = FindLineEnd(line, end);
+		const char* p = line;
+		const std::string_view identifier = NextToken(p, lineEnd);
+
+		if (identifier == "v") {
+			++counts.positions;
+		} else if (identifier == "vt") {
+			++counts.texcoords;
+		} else if (identifier == "vn") {
+			++counts.normals;
+		} else if (identifier == "f") {
+			size_t corners = 0;
+			while (!NextToken(p, lineEnd).empty()) {
+				++corners;
+			}
+			counts.faceCorners += corners;
+			if (corners >= 3) {
+				counts.triangleVertices += (corners - 2) * 3;
+			}
+		}
+		line = lineEnd < end ? lineEnd + 1 : end;
+	}
+	return counts;
+}
+// 区間の切れ目になる行（o / g / usemtl）
+struct ObjGroupEvent {
+	enum class Kind { Group, Material };
+	Kind kind;
+	size_t indexOffset;    // この行より前に出力した三角形リストの長さ（区間内）
+	std::string_view name;
+};
+
+// ファイルを行の境界で分割した 1 区間と、その区間の解析結果
+struct ObjChunk {
+	const char* begin = nullptr;
+	const char* end = nullptr;
+	ObjCounts counts; // この区間の要素数
+	ObjCounts base;   // この区間より前の要素数の合計（プレフィックス和）
+
+	// 区間内で初めて現れた「位置/UV/法線」の組（1 始まりの通し番号、出現順）
+	std::vector<std::array<uint32_t, 3>> uniqueCorners;
+	// 区間内の頂点番号 → ファイル全体の頂点番号
+	std::vector<uint32_t> remap;
+	// 区間内の o / g / usemtl と mtllib（出現順）
+	std::vector<ObjGroupEvent> groupEvents;
+	std::vector<std::string_view> materialLibraries;
+};
+
+// 行の途中で切らないように、ほぼ等しい大きさの区間に分ける
+std::vector<ObjChunk> SplitIntoChunks(const char* data, const char* end, size_t chunkCount) {
+	std::vector<ObjChunk> chunks(chunkCount);
+	const size_t size = static_cast<size_t>(end - data);
+	const char* begin = data;
+	for (size_t i = 0; i < chunkCount; ++i) {
+		const char* chunkEnd = end;
+		if (i + 1 < chunkCount) {
+			chunkEnd = FindLineEnd(std::max(begin, data + size * (i + 1) / chunkCount), end);
+			if (chunkEnd < end) {
+				++chunkEnd; // 改行の次から次の区間
+			}
+		}
+		chunks[i].begin = begin;
+		chunks[i].end = chunkEnd;
+		begin = chunkEnd;
+	}
+	return chunks;
+}
+
+// 区間ごとに func(i) を並列に実行する（0 番は呼び出し元のスレッドで実行）
+template <typename Func>
+void ParallelForEachChunk(size_t chunkCount, const Func& func) {
+	std::vector<std::thread> workers;
+	for (size_t i = 1; i < chunkCount; ++i) {
+		workers.emplace_back([&func, i] { func(i); });
+	}
+	if (chunkCount > 0) {
+		func(0);
+	}
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+}
+
+// 2 パス目：v/vt/vn を全体の配列の担当範囲に書き込み、面は区間内だけで溶接する
+// indices には区間内の頂点番号で三角形リストを書き込む（後で全体の番号に置き換える）
+void ParseChunk(ObjChunk& chunk, size_t expectedUniqueCount,
+	Vector4* positions, Vector2* texcoords, Vector3* normals, uint32_t* indices)
+{
+	size_t positionCount = 0;
+	size_t texcoordCount = 0;
+	size_t normalCount = 0;
+	size_t indexCount = 0;
+
+	chunk.uniqueCorners.reserve(expectedUniqueCount);
+	VertexWeldTable weldTable(expectedUniqueCount);
+
+	// 面の頂点番号（多角形1つ分、使い回す）
+	std::vector<uint32_t> polygon;
+
+	for (const char* line = chunk.begin; line < chunk.end;) {
+		const char* lineEnd = FindLineEnd(line, chunk.end);
+		const char* p = line;
+		const std::string_view identifier = NextToken(p, lineEnd); // 行の先頭識別子
 
 		// identifierごとに応じた処理
 
 		if (identifier == "v") {
 			// 頂点座標
 			Vector4 position;
-			s >> position.x >> position.y >> position.z;
+			position.x = ParseFloat(p, lineEnd);
+			position.y = ParseFloat(p, lineEnd);
+			position.z = ParseFloat(p, lineEnd);
 			position.w = 1.0f; // w成分は1.0fに設定
 			position.x *= -1.0f;
-			positions.push_back(position);
-
+			positions[chunk.base.positions + positionCount++] = position;
 		}
 		else if (identifier == "vt") { // UV座標
 			Vector2 texcoord;
-			s >> texcoord.x >> texcoord.y;
+			texcoord.x = ParseFloat(p, lineEnd);
+			texcoord.y = ParseFloat(p, lineEnd);
 			texcoord.y = 1.0f - texcoord.y;
-			texcoords.push_back(texcoord);
+			texcoords[chunk.base.texcoords + texcoordCount++] = texcoord;
 		}
 		else if (identifier == "vn") { // 法線ベクトル
 			Vector3 normal;
-			s >> normal.x >> normal.y >> normal.z;
+			normal.x = ParseFloat(p, lineEnd);
+			normal.y = ParseFloat(p, lineEnd);
+			normal.z = ParseFloat(p, lineEnd);
 			normal.x *= -1.0f;
-			normals.push_back(normal);
+			normals[chunk.base.normals + normalCount++] = normal;
 		}
 		else if (identifier == "f") { // 面情報
-			std::vector<VertexData> polygon;
+			polygon.clear();
+
+			// この面より前に定義された要素の数（負のインデックスの基準）
+			const size_t definedCounts[3] = {
+				chunk.base.positions + positionCount,
+				chunk.base.texcoords + texcoordCount,
+				chunk.base.normals + normalCount,
+			};
 
 			// 面の全頂点を読み込む（三角形、四角形、多角形に対応）
-			std::string vertexDefinition;
-			while (s >> vertexDefinition) {
+			for (std::string_view vertexDefinition = NextToken(p, lineEnd); !vertexDefinition.empty(); vertexDefinition = NextToken(p, lineEnd)) {
 				// 頂点の要素へのIndexは「位置/UV/法線」で格納されているので、分解してIndexを取得する
-				std::istringstream v(vertexDefinition);
+				const char* q = vertexDefinition.data();
+				const char* definitionEnd = q + vertexDefinition.size();
 				uint32_t elementIndices[3];
 				for (int32_t element = 0; element < 3; ++element) {
-					std::string index;
-					std::getline(v, index, '/'); // 区切りでインデックスを読んでいく
-					elementIndices[element] = std::stoi(index);
+					elementIndices[element] = ResolveIndex(ParseIndex(q, definitionEnd), definedCounts[element]);
+					if (q < definitionEnd && *q == '/') {
+						++q; // 区切りを読み飛ばす
+					}
 				}
 
-				// 要素へのIndexから、実際の要素の値を取得して、頂点を構築する
-				Vector4 position = positions[elementIndices[0] - 1];
-				Vector2 texcoord = texcoords[elementIndices[1] - 1];
-				Vector3 normal = normals[elementIndices[2] - 1];
-				polygon.push_back({ position, texcoord, normal });
+				// 区間内で同じ組が既にあればその頂点を使い回す
+				const uint32_t newIndex = static_cast<uint32_t>(chunk.uniqueCorners.size());
+				const uint32_t vertexIndex = weldTable.FindOrInsert(elementIndices[0], elementIndices[1], elementIndices[2], newIndex);
+				if (vertexIndex == newIndex) {
+					chunk.uniqueCorners.push_back({ elementIndices[0], elementIndices[1], elementIndices[2] });
+				}
+				polygon.push_back(vertexIndex);
 			}
 
 			// 多角形を三角形に分割（Fan Triangulation）
 			// 頂点が v0, v1, v2, v3 の四角形の場合
 			// 三角形1: v0, v1, v2
 			// 三角形2: v0, v2, v3
+			uint32_t* triangles = indices + chunk.base.triangleVertices;
 			for (size_t i = 1; i + 1 < polygon.size(); ++i) {
-				modelData.vertices.push_back(polygon[0]);      // 基準頂点（逆順のため最後）
-				modelData.vertices.push_back(polygon[i + 1]);  // 次の頂点
-				modelData.vertices.push_back(polygon[i]);      // 現在の頂点
+				triangles[indexCount++] = polygon[0];      // 基準頂点（逆順のため最後）
+				triangles[indexCount++] = polygon[i + 1];  // 次の頂点
+				triangles[indexCount++] = polygon[i];      // 現在の頂点
 			}
 		}
+		else if (identifier == "usemtl") {
+			// 以降の面のマテリアル
+			chunk.groupEvents.push_back({ ObjGroupEvent::Kind::Material, indexCount, NextToken(p, lineEnd) });
+		}
+		else if (identifier == "o" || identifier == "g") {
+			// オブジェクト / グループの切れ目
+			chunk.groupEvents.push_back({ ObjGroupEvent::Kind::Group, indexCount, NextToken(p, lineEnd) });
+		}
 		else if (identifier == "mtllib") {
-			// materialTemplateLibraryファイルの名前を取得する
-			std::string materialFilename;
-			s >> materialFilename;
+			// materialTemplateLibraryファイルの名前（読み込みは全区間の解析後）
+			chunk.materialLibraries.push_back(NextToken(p, lineEnd));
+		}
+
+		line = lineEnd < chunk.end ? lineEnd + 1 : chunk.end;
+	}
+}
+
+
+constexpr uint32_t kNoMaterial = std::numeric_limits<uint32_t>::max();
+
+uint32_t FindMaterial(const std::vector<MaterialData>& materials, std::string_view name) {
+	for (size_t i = 0; i < materials.size(); ++i) {
+		if (materials[i].name == name) {
+			return static_cast<uint32_t>(i);
+		}
+	}
+	return kNoMaterial;
+}
+
+// usemtl より前の面のマテリアル（従来どおり最後に書かれた map_Kd を使う）
+uint32_t DefaultMaterial(std::vector<MaterialData>& materials) {
+	for (size_t i = materials.size(); i-- > 0;) {
+		if (!materials[i].textureFilePath.empty()) {
+			return static_cast<uint32_t>(i);
+		}
+	}
+	if (materials.empty()) {
+		materials.emplace_back();
+	}
+	return 0;
+}
+
+// 各区間の o / g / usemtl をファイルの順に辿って SubMesh を作り、マテリアル順に並べ替える
+void BuildSubMeshes(const std::vector<ObjChunk>& chunks, ModelData& modelData) {
+	std::vector<MaterialData>& materials = modelData.materials;
+	std::vector<SubMesh>& subMeshes = modelData.subMeshes;
+
+	std::string_view groupName;
+	std::string_view materialName;
+	bool hasMaterial = false;
+	size_t begin = 0;
+
+	// [begin, end) を今の名前とマテリアルの区間として閉じる
+	auto close = [&](size_t end) {
+		if (end > begin) {
+			uint32_t materialIndex = hasMaterial ? FindMaterial(materials, materialName) : DefaultMaterial(materials);
+			if (materialIndex == kNoMaterial) {
+				// mtl に無い名前は既定値（テクスチャなし）のマテリアルにする
+				materials.push_back({ std::string(materialName), {} });
+				materialIndex = static_cast<uint32_t>(materials.size() - 1);
+			}
+			SubMesh* last = subMeshes.empty() ? nullptr : &subMeshes.back();
+			if (last && last->materialIndex == materialIndex && last->name == groupName) {
+				last->indexCount += static_cast<uint32_t>(end - begin); // 同じ組の続きはまとめる
+			} else {
+				subMeshes.push_back({ std::string(groupName), static_cast<uint32_t>(begin), static_cast<uint32_t>(end - begin), materialIndex });
+			}
+		}
+		begin = end;
+	};
+
+	for (const ObjChunk& chunk : chunks) {
+		for (const ObjGroupEvent& event : chunk.groupEvents) {
+			close(chunk.base.triangleVertices + event.indexOffset);
+			if (event.kind == ObjGroupEvent::Kind::Material) {
+				materialName = event.name;
+				hasMaterial = true;
+			} else {
+				groupName = event.name;
+			}
+		}
+	}
+	close(modelData.indices.size());
+
+	// マテリアルごとに連続させ、描画時の切り替えを減らす（同じマテリアル内はファイルの順のまま）
+	auto byMaterial = [](const SubMesh& a, const SubMesh& b) { return a.materialIndex < b.materialIndex; };
+	if (!std::is_sorted(subMeshes.begin(), subMeshes.end(), byMaterial)) {
+		std::stable_sort(subMeshes.begin(), subMeshes.end(), byMaterial);
+		std::vector<uint32_t> sorted;
+		sorted.reserve(modelData.indices.size());
+		for (SubMesh& subMesh : subMeshes) {
+			const auto first = modelData.indices.begin() + subMesh.indexOffset;
+			subMesh.indexOffset = static_cast<uint32_t>(sorted.size());
+			sorted.insert(sorted.end(), first, first + subMesh.indexCount);
+		}
+		modelData.indices.swap(sorted);
+	}
+
+	// 単一マテリアルとして扱うコード向けに、先頭の区間のマテリアルも入れておく
+	if (!subMeshes.empty()) {
+		modelData.material = materials[subMeshes.front().materialIndex];
+	} else if (!materials.empty()) {
+		modelData.material = materials[DefaultMaterial(materials)];
+	}
+}
+}
+
+ModelData LoadObjFile(const std::string& directoryPath, const std::string& fileName, uint32_t threadCount) {
+	// ================================
+	// 1.ファイルをメモリにマップし、行の境界で区間に分ける
+	// ================================
+	MappedFile file(directoryPath + "/" + fileName);
+	assert(file.IsOpen()); // ファイルが開けなかった場合は停止
+
+	const char* data = file.GetData();
+	const char* end = data + file.GetSize();
+
+	if (threadCount == 0) {
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+	}
+	// 小さいファイルはスレッドを立てる方が高くつくので分けない
+	constexpr size_t kMinChunkBytes = 1 << 20;
+	const size_t chunkCount = std::clamp<size_t>(file.GetSize() / kMinChunkBytes, 1, threadCount);
+	std::vector<ObjChunk> chunks = SplitIntoChunks(data, end, chunkCount);
+
+	// ================================
+	// 2.区間ごとに要素数を数え、プレフィックス和で書き込み位置を決める
+	// ================================
+	ParallelForEachChunk(chunkCount, [&](size_t i) {
+		chunks[i].counts = CountElements(chunks[i].begin, chunks[i].end);
+	});
+
+	ObjCounts total;
+	for (ObjChunk& chunk : chunks) {
+		chunk.base = total;
+		total.positions += chunk.counts.positions;
+		total.texcoords += chunk.counts.texcoords;
+		total.normals += chunk.counts.normals;
+		total.faceCorners += chunk.counts.faceCorners;
+		total.triangleVertices += chunk.counts.triangleVertices;
+	}
+
+	ModelData modelData; // 構築するModelData
+	std::vector<Vector4> positions(total.positions); // 頂点座標格
+	std::vector<Vector3> normals(total.normals);     // 法線ベクトル格納
+	std::vector<Vector2> texcoords(total.texcoords); // UV座標格納
+	modelData.indices.resize(total.triangleVertices);
+
+	// ================================
+	// 3.区間ごとに並列に解析
+	// ================================
+	// 頂点数は溶接後に決まるので、位置の数を目安にする
+	const size_t expectedVertexCount = std::min(total.faceCorners, total.positions * 2);
+	ParallelForEachChunk(chunkCount, [&](size_t i) {
+		const size_t expectedUniqueCount = total.faceCorners > 0 ? chunks[i].counts.faceCorners * expectedVertexCount / total.faceCorners : 0;
+		ParseChunk(chunks[i], expectedUniqueCount, positions.data(), texcoords.data(), normals.data(), modelData.indices.data());
+	});
+
+	// ================================
+	// 4.区間ごとの頂点をファイル全体で溶接し直す
+	// ================================
+	// 区間の順に、区間内の出現順で登録するので、頂点の並びは先頭から順に解析した場合と一致する
+	modelData.vertices.reserve(expectedVertexCount);
+	VertexWeldTable weldTable(chunkCount > 1 ? expectedVertexCount : 0);
+	for (ObjChunk& chunk : chunks) {
+		chunk.remap.resize(chunk.uniqueCorners.size());
+		for (size_t i = 0; i < chunk.uniqueCorners.size(); ++i) {
+			const std::array<uint32_t, 3>& corner = chunk.uniqueCorners[i];
+			const uint32_t newIndex = static_cast<uint32_t>(modelData.vertices.size());
+			// 区間が 1 つなら区間内の溶接で済んでいる
+			const uint32_t vertexIndex = chunkCount > 1 ? weldTable.FindOrInsert(corner[0], corner[1], corner[2], newIndex) : newIndex;
+			if (vertexIndex == newIndex) {
+				assert(corner[0] <= positions.size() && corner[1] <= texcoords.size() && corner[2] <= normals.size() && "OBJの面のインデックスが範囲外");
+				modelData.vertices.push_back({ positions[corner[0] - 1], texcoords[corner[1] - 1], normals[corner[2] - 1] });
+			}
+			chunk.remap[i] = vertexIndex;
+		}
+	}
+
+	// 区間内の頂点番号を全体の番号に置き換える
+	if (chunkCount > 1) {
+		ParallelForEachChunk(chunkCount, [&](size_t i) {
+			const ObjChunk& chunk = chunks[i];
+			uint32_t* triangles = modelData.indices.data() + chunk.base.triangleVertices;
+			for (size_t k = 0; k < chunk.counts.triangleVertices; ++k) {
+				triangles[k] = chunk.remap[triangles[k]];
+			}
+		});
+	}
+
+	// ================================
+	// 5.マテリアル表（全 mtllib を出現順に読む。同じ名前は先に定義された方を使う）
+	// ================================
+	for (const ObjChunk& chunk : chunks) {
+		for (std::string_view materialLibrary : chunk.materialLibraries) {
 			// 基本的にobjファイルと同一階層にmtlは存在させるのでディレクトリ名とファイル名を渡す
-			modelData.material = LoadMaterialTemplateFile(directoryPath, materialFilename);
+			for (MaterialData& material : LoadMaterialTemplateLibrary(directoryPath, std::string(materialLibrary))) {
+				if (FindMaterial(modelData.materials, material.name) == kNoMaterial) {
+					modelData.materials.push_back(std::move(material));
+				}
+			}
 		}
 	}
 
+	// ================================
+	// 6.o / g / usemtl の切れ目で区間に分け、マテリアル順に並べる
+	// ================================
+	BuildSubMeshes(chunks, modelData);
+
+	// ================================
+	// 7.境界ボリューム（使う側で頂点を走査しなくて済むようにここで 1 度だけ求める）
+	// ================================
+	if (!modelData.vertices.empty()) {
+		const Vector4* positions = &modelData.vertices[0].position;
+		modelData.bounds = AABB::FromPoints(positions, modelData.vertices.size(), sizeof(VertexData));
+		modelData.boundingSphere = BoundingSphere::FromPoints(positions, modelData.vertices.size(), modelData.bounds, sizeof(VertexData));
+	}
+
 	return modelData;
-}
\ No newline at end of file
+}
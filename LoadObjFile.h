@@ -1,4 +1,6 @@
 #include "ModelData.h"
+#include <cstdint>
 #include <string>
 
-ModelData LoadObjFile(const std::string& directoryPath, const std::string& fileName);
\ No newline at end of file
+// threadCount : 解析に使うスレッド数（0 ならハードウェアのスレッド数）。小さいファイルは常に 1
+ModelData LoadObjFile(const std::string& directoryPath, const std::string& fileName, uint32_t threadCount = 0);
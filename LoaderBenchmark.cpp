@@ -0,0 +1,412 @@
+#include "LoaderBenchmark.h"
+#include "LoadObjFile.h"
+#include "LoadMaterialTemplateFile.h"
+#include "MapChipField.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <system_error>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#include <Psapi.h>
+#include "ResourcesUtility.h"
+#else
+#include <fstream>
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+// ================================
+// コーパスの生成
+// ================================
+// 大きなファイルを 1 行ずつ fprintf すると生成の方が遅くなるので、まとめて書き出す
+class FileWriter {
+public:
+	explicit FileWriter(const std::filesystem::path& path) : file_(std::fopen(path.string().c_str(), "wb")) {}
+	~FileWriter() {
+		if (file_) {
+			Flush();
+			std::fclose(file_);
+		}
+	}
+
+	bool IsOpen() const { return file_ != nullptr; }
+
+	template <typename... Args>
+	void Print(const char* format, Args... args) {
+		char line[256];
+		const int length = std::snprintf(line, sizeof(line), format, args...);
+		buffer_.append(line, static_cast<size_t>(std::clamp(length, 0, static_cast<int>(sizeof(line) - 1))));
+		if (buffer_.size() >= kFlushSize) {
+			Flush();
+		}
+	}
+
+	void Write(const void* data, size_t size) {
+		buffer_.append(static_cast<const char*>(data), size);
+		if (buffer_.size() >= kFlushSize) {
+			Flush();
+		}
+	}
+
+private:
+	static constexpr size_t kFlushSize = 1 << 20;
+
+	void Flush() {
+		std::fwrite(buffer_.data(), 1, buffer_.size(), file_);
+		buffer_.clear();
+	}
+
+	std::FILE* file_;
+	std::string buffer_;
+};
+
+// 格子状の面（三角形 triangleCount 個）。4096 三角形ごとに 4 つのマテリアルを切り替える
+void WriteObj(const std::filesystem::path& directory, size_t triangleCount) {
+	const size_t quads = (triangleCount + 1) / 2;
+	const size_t width = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(quads))));
+	const size_t height = (quads + width - 1) / width;
+
+	{
+		FileWriter mtl(directory / "a.mtl");
+		for (int i = 0; i < 4; ++i) {
+			mtl.Print("newmtl material%d\nKd 1 1 1\nmap_Kd texture%d.png\n", i, i);
+		}
+	}
+
+	FileWriter obj(directory / "a.obj");
+	obj.Print("# synthetic grid: %zu triangles\nmtllib a.mtl\n", triangleCount);
+	for (size_t y = 0; y <= height; ++y) {
+		for (size_t x = 0; x <= width; ++x) {
+			const float u = static_cast<float>(x) / static_cast<float>(width);
+			const float v = static_cast<float>(y) / static_cast<float>(height);
+			obj.Print("v %.6f %.6f %.6f\nvt %.6f %.6f\nvn 0 0 1\n", u * 10.0f, v * 10.0f, 0.1f * std::sin(u * 40.0f) * std::cos(v * 40.0f), u, v);
+		}
+	}
+	size_t written = 0;
+	for (size_t q = 0; q < quads && written < triangleCount; ++q) {
+		if (written % 4096 == 0) {
+			obj.Print("usemtl material%zu\n", (written / 4096) % 4);
+		}
+		const size_t x = q % width;
+		const size_t y = q / width;
+		const size_t a = y * (width + 1) + x + 1; // OBJ は 1 始まり
+		const size_t b = a + 1;
+		const size_t c = a + width + 2;
+		const size_t d = a + width + 1;
+		obj.Print("f %zu/%zu/%zu %zu/%zu/%zu %zu/%zu/%zu\n", a, a, a, b, b, b, c, c, c);
+		++written;
+		if (written < triangleCount) {
+			obj.Print("f %zu/%zu/%zu %zu/%zu/%zu %zu/%zu/%zu\n", a, a, a, c, c, c, d, d, d);
+			++written;
+		}
+	}
+}
+
+void WriteMtl(const std::filesystem::path& directory, size_t materialCount) {
+	FileWriter mtl(directory / "a.mtl");
+	for (size_t i = 0; i < materialCount; ++i) {
+		mtl.Print("newmtl material%zu\nNs 96.0\nKa 1 1 1\nKd 0.8 0.8 0.8\nKs 0.5 0.5 0.5\nd 1.0\nillum 2\nmap_Kd texture%zu.png\n\n", i, i % 64);
+	}
+}
+
+// 100 列（MapChipField の横幅）の 0 / 1
+void WriteCsv(const std::filesystem::path& path, size_t cellCount) {
+	FileWriter csv(path);
+	for (size_t i = 0; i < cellCount; ++i) {
+		const size_t column = i % kNumBlockHorizontal;
+		csv.Print(column + 1 == kNumBlockHorizontal || i + 1 == cellCount ? "%d\n" : "%d,", ((i * 7919) >> 3) % 5 == 0 ? 1 : 0);
+	}
+}
+
+// 32bit の BMP（WIC で読める一番単純な形式）
+void WriteBmp(const std::filesystem::path& path, size_t pixelCount) {
+	const uint32_t width = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(pixelCount))));
+	const uint32_t height = static_cast<uint32_t>((pixelCount + width - 1) / width);
+	const uint32_t imageSize = width * height * 4;
+
+	unsigned char header[54] = {};
+	auto put32 = [&](size_t offset, uint32_t value) { std::memcpy(header + offset, &value, sizeof(value)); };
+	header[0] = 'B';
+	header[1] = 'M';
+	put32(2, 54 + imageSize); // ファイルサイズ
+	put32(10, 54);            // 画素の位置
+	put32(14, 40);            // BITMAPINFOHEADER
+	put32(18, width);
+	put32(22, height);
+	header[26] = 1;           // プレーン数
+	header[28] = 32;          // ビット数
+	put32(34, imageSize);
+
+	FileWriter bmp(path);
+	bmp.Write(header, sizeof(header));
+	std::vector<uint32_t> row(width);
+	for (uint32_t y = 0; y < height; ++y) {
+		for (uint32_t x = 0; x < width; ++x) {
+			row[x] = 0xFF000000u | ((x * 255 / width) << 16) | ((y * 255 / height) << 8) | (((x ^ y) & 0x20) ? 0xFF : 0x00);
+		}
+		bmp.Write(row.data(), row.size() * sizeof(uint32_t));
+	}
+}
+
+// ================================
+// 計測
+// ================================
+struct CorpusResult {
+	std::string loader;
+	size_t elements;
+	size_t bytes;
+	double milliseconds;
+	size_t peakRss;
+};
+
+// 最速の回の時間と、計測中のピーク RSS
+CorpusResult Measure(const char* loader, size_t elements, size_t bytes, uint32_t repeatCount, const std::function<void()>& load) {
+	LoaderBenchmark::ResetPeakRss();
+	double best = 0.0;
+	for (uint32_t repeat = 0; repeat < std::max(repeatCount, 1u); ++repeat) {
+		const auto start = std::chrono::steady_clock::now();
+		load();
+		const auto end = std::chrono::steady_clock::now();
+		const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+		best = repeat == 0 ? ms : std::min(best, ms);
+	}
+	return { loader, elements, bytes, best, LoaderBenchmark::GetPeakRss() };
+}
+
+std::string ToJson(const std::vector<CorpusResult>& results) {
+	std::string json = "{\n  \"corpus\": [\n";
+	char line[320];
+	for (size_t i = 0; i < results.size(); ++i) {
+		const CorpusResult& r = results[i];
+		const double seconds = std::max(r.milliseconds, 1e-6) / 1000.0;
+		std::snprintf(line, sizeof(line),
+			"    { \"loader\": \"%s\", \"elements\": %zu, \"bytes\": %zu, \"ms\": %.3f, \"mb_per_s\": %.1f, \"elements_per_s\": %.0f, \"peak_rss_mb\": %.1f }%s\n",
+			r.loader.c_str(), r.elements, r.bytes, r.milliseconds,
+			static_cast<double>(r.bytes) / (1024.0 * 1024.0) / seconds,
+			static_cast<double>(r.elements) / seconds,
+			static_cast<double>(r.peakRss) / (1024.0 * 1024.0),
+			i + 1 < results.size() ? "," : "");
+		json += line;
+	}
+	json += "  ]\n}\n";
+	return json;
+}
+
+struct Result {
+	uint32_t threadCount;
+	double milliseconds;
+	double megabytesPerSecond;
+	double speedup; // 1 スレッドに対する倍率
+};
+
+std::string ToJson(const std::string& fileName, size_t fileSize, size_t vertexCount, size_t indexCount, const std::vector<Result>& results) {
+	char line[256];
+	std::snprintf(line, sizeof(line),
+		"{\n  \"file\": \"%s\",\n  \"bytes\": %zu,\n  \"vertices\": %zu,\n  \"indices\": %zu,\n  \"thread_scaling\": [\n",
+		fileName.c_str(), fileSize, vertexCount, indexCount);
+	std::string json = line;
+	for (size_t i = 0; i < results.size(); ++i) {
+		std::snprintf(line, sizeof(line),
+			"    { \"threads\": %u, \"ms\": %.2f, \"mb_per_s\": %.1f, \"speedup\": %.2f }%s\n",
+			results[i].threadCount, results[i].milliseconds, results[i].megabytesPerSecond, results[i].speedup,
+			i + 1 < results.size() ? "," : "");
+		json += line;
+	}
+	json += "  ]\n}\n";
+	return json;
+}
+
+}
+
+// ===================================
+// ピーク RSS
+// ===================================
+size_t LoaderBenchmark::GetPeakRss() {
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters{};
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+		return counters.PeakWorkingSetSize;
+	}
+	return 0;
+#else
+	// clear_refs でリセットできる VmHWM を優先する（ru_maxrss はリセットできない）
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while (std::getline(status, line)) {
+		if (line.rfind("VmHWM:", 0) == 0) {
+			return static_cast<size_t>(std::strtoull(line.c_str() + 6, nullptr, 10)) * 1024;
+		}
+	}
+	rusage usage{};
+	getrusage(RUSAGE_SELF, &usage);
+	return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+}
+
+void LoaderBenchmark::ResetPeakRss() {
+#if defined(_WIN32)
+	// Windows にはピークだけを戻す方法が無いので何もしない（大きいケースを後に測る）
+#else
+	std::ofstream clearRefs("/proc/self/clear_refs");
+	clearRefs << "5";
+#endif
+}
+
+// ===================================
+// コーパス
+// ===================================
+size_t LoaderBenchmark::GenerateCorpus(const std::string& rootDirectory, size_t maxElementCount) {
+	namespace fs = std::filesystem;
+	const fs::path root(rootDirectory);
+	std::error_code error;
+	size_t writtenCount = 0;
+
+	for (size_t elements : kCorpusSizes) {
+		if (elements > maxElementCount) {
+			break;
+		}
+		const std::string size = std::to_string(elements);
+
+		const fs::path objDirectory = root / "obj" / size;
+		if (!fs::exists(objDirectory / "a.obj", error)) {
+			fs::create_directories(objDirectory, error);
+			WriteObj(objDirectory, elements);
+			++writtenCount;
+		}
+		const fs::path mtlDirectory = root / "mtl" / size;
+		if (!fs::exists(mtlDirectory / "a.mtl", error)) {
+			fs::create_directories(mtlDirectory, error);
+			WriteMtl(mtlDirectory, elements);
+			++writtenCount;
+		}
+		const fs::path csvPath = root / "csv" / (size + ".csv");
+		if (!fs::exists(csvPath, error)) {
+			fs::create_directories(csvPath.parent_path(), error);
+			WriteCsv(csvPath, elements);
+			++writtenCount;
+		}
+		const fs::path texturePath = root / "texture" / (size + ".bmp");
+		if (!fs::exists(texturePath, error)) {
+			fs::create_directories(texturePath.parent_path(), error);
+			WriteBmp(texturePath, elements);
+			++writtenCount;
+		}
+	}
+	return writtenCount;
+}
+
+std::string LoaderBenchmark::RunCorpus(const std::string& rootDirectory, uint32_t repeatCount) {
+	namespace fs = std::filesystem;
+	const fs::path root(rootDirectory);
+	std::error_code error;
+	std::vector<CorpusResult> results;
+
+	// 小さい順に測る（リセットできない環境でもピーク RSS がそのケースまでの最大になる）
+	for (size_t elements : kCorpusSizes) {
+		const std::string size = std::to_string(elements);
+		const fs::path objDirectory = root / "obj" / size;
+		if (fs::exists(objDirectory / "a.obj", error)) {
+			const size_t bytes = static_cast<size_t>(fs::file_size(objDirectory / "a.obj", error));
+			results.push_back(Measure("LoadObjFile", elements, bytes, repeatCount, [&]() {
+				const ModelData modelData = LoadObjFile(objDirectory.generic_string(), "a.obj");
+			}));
+		}
+	}
+	for (size_t elements : kCorpusSizes) {
+		const fs::path mtlDirectory = root / "mtl" / std::to_string(elements);
+		if (fs::exists(mtlDirectory / "a.mtl", error)) {
+			const size_t bytes = static_cast<size_t>(fs::file_size(mtlDirectory / "a.mtl", error));
+			results.push_back(Measure("LoadMaterialTemplateLibrary", elements, bytes, repeatCount, [&]() {
+				const std::vector<MaterialData> materials = LoadMaterialTemplateLibrary(mtlDirectory.generic_string(), "a.mtl");
+			}));
+		}
+	}
+	for (size_t elements : kCorpusSizes) {
+		const fs::path csvPath = root / "csv" / (std::to_string(elements) + ".csv");
+		if (fs::exists(csvPath, error)) {
+			const size_t bytes = static_cast<size_t>(fs::file_size(csvPath, error));
+			results.push_back(Measure("MapChipField::LoadMapChipCsv", elements, bytes, repeatCount, [&]() {
+				MapChipField field;
+				field.LoadMapChipCsv(csvPath.generic_string());
+			}));
+		}
+	}
+#if defined(_WIN32)
+	for (size_t elements : kCorpusSizes) {
+		const fs::path texturePath = root / "texture" / (std::to_string(elements) + ".bmp");
+		if (fs::exists(texturePath, error)) {
+			const size_t bytes = static_cast<size_t>(fs::file_size(texturePath, error));
+			results.push_back(Measure("LoadTexture", elements, bytes, repeatCount, [&]() {
+				const DirectX::ScratchImage image = LoadTexture(texturePath.generic_string());
+			}));
+		}
+	}
+#endif
+
+	return ToJson(results);
+}
+
+std::string LoaderBenchmark::RunObjThreadScaling(const std::string& directoryPath, const std::string& fileName,
+	uint32_t maxThreadCount, uint32_t repeatCount)
+{
+	const size_t fileSize = MappedFile(directoryPath + "/" + fileName).GetSize();
+
+	// ウォームアップ（ファイルをページキャッシュに載せる）
+	ModelData modelData = LoadObjFile(directoryPath, fileName, 1);
+
+	std::vector<Result> results;
+	for (uint32_t threadCount = 1; threadCount <= std::max(maxThreadCount, 1u); threadCount *= 2) {
+		double best = 0.0;
+		for (uint32_t repeat = 0; repeat < std::max(repeatCount, 1u); ++repeat) {
+			const auto start = std::chrono::steady_clock::now();
+			modelData = LoadObjFile(directoryPath, fileName, threadCount);
+			const auto end = std::chrono::steady_clock::now();
+			const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+			best = repeat == 0 ? ms : std::min(best, ms);
+		}
+		const double speedup = results.empty() ? 1.0 : results.front().milliseconds / best;
+		results.push_back({ threadCount, best, static_cast<double>(fileSize) / (best * 1000.0), speedup });
+	}
+
+	return ToJson(fileName, fileSize, modelData.vertices.size(), modelData.indices.size(), results);
+}
+
+#if defined(TOMO_LOADER_BENCH_MAIN)
+int main(int argc, char** argv) {
+	const std::string command = argc > 1 ? argv[1] : "";
+	if (command == "generate" && argc > 2) {
+		const size_t maxElementCount = argc > 3 ? static_cast<size_t>(std::strtoull(argv[3], nullptr, 10)) : 10'000'000;
+		const size_t writtenCount = LoaderBenchmark::GenerateCorpus(argv[2], maxElementCount);
+		std::printf("%zu corpus file(s) written to %s\n", writtenCount, argv[2]);
+		return 0;
+	}
+	if (command == "run" && argc > 2) {
+		const uint32_t repeatCount = argc > 3 ? static_cast<uint32_t>(std::atoi(argv[3])) : 3u;
+		std::fputs(LoaderBenchmark::RunCorpus(argv[2], repeatCount).c_str(), stdout);
+		return 0;
+	}
+	if (command == "scaling" && argc > 3) {
+		const uint32_t maxThreadCount = argc > 4 ? static_cast<uint32_t>(std::atoi(argv[4])) : 16u;
+		std::fputs(LoaderBenchmark::RunObjThreadScaling(argv[2], argv[3], maxThreadCount).c_str(), stdout);
+		return 0;
+	}
+	std::fputs(
+		"usage: loaderbench generate <root> [maxElements (default 10000000)]\n"
+		"       loaderbench run <root> [repeat]\n"
+		"       loaderbench scaling <directory> <file.obj> [maxThreads]\n", stderr);
+	return 1;
+}
+#endif
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// ==================================
+// アセットローダーのベンチマーク
+// ==================================
+// D3D12 に依存しないローダー部分だけを測る。結果は MathBenchmark と同じく JSON で返す。
+//
+// 合成データ（コーパス）を生成して、ローダーごと・サイズごとに時間、MB/s、要素/s、ピーク RSS を測る。
+//   obj     : LoadObjFile（要素 = 三角形）
+//   mtl     : LoadMaterialTemplateLibrary（要素 = マテリアル）
+//   csv     : MapChipField::LoadMapChipCsv（要素 = セル。ローダーは先頭 20 x 100 しか解釈しない）
+//   texture : LoadTexture（要素 = ピクセル。DirectXTex を使うので Windows のみ。他では生成だけ行う）
+//
+// 単体の実行ファイルにする場合は TOMO_LOADER_BENCH_MAIN を定義してビルドする（Linux でもビルドできる）。
+//   g++ -std=c++20 -O2 -pthread -DTOMO_LOADER_BENCH_MAIN LoaderBenchmark.cpp LoadObjFile.cpp LoadMaterialTemplateFile.cpp MappedFile.cpp
+//       MapChipField.cpp BoundingVolume.cpp Affine3x4.cpp Matrix4x4.cpp Quaternion.cpp
+//   （CMakeLists.txt の loader_bench ターゲットでも同じものができる）
+//   ./a.out generate bench_corpus           # 1K, 10K, ... 10M 要素のコーパスを作る（約 2.2GB。1M までにするなら 1000000 を指定）
+//   ./a.out run bench_corpus                # 全ローダーを測る
+//   ./a.out scaling resources/player player.obj
+namespace LoaderBenchmark {
+
+// コーパスの要素数（1K ～ 10M）
+inline constexpr size_t kCorpusSizes[] = { 1'000, 10'000, 100'000, 1'000'000, 10'000'000 };
+
+// rootDirectory 以下に maxElementCount 以下の全サイズのコーパスを書き出す（既にあるファイルは作り直さない）
+// 書き出したファイル数を返す
+size_t GenerateCorpus(const std::string& rootDirectory, size_t maxElementCount = 10'000'000);
+
+// GenerateCorpus で作ったコーパスのうち存在するものを全部測る
+// repeatCount : 各ケースを読む回数（最速の回を採る）
+std::string RunCorpus(const std::string& rootDirectory, uint32_t repeatCount = 3);
+
+// 現在のプロセスのピーク RSS（バイト）。ResetPeakRss 以降の最大値（リセットできない環境ではプロセス開始からの最大値）
+size_t GetPeakRss();
+void ResetPeakRss();
+
+// LoadObjFile をスレッド数 1, 2, 4, ... maxThreadCount で読み、スレッド数ごとの時間と 1 スレッド比を返す
+// repeatCount : 各スレッド数で読む回数（最速の回を採る）
+std::string RunObjThreadScaling(const std::string& directoryPath, const std::string& fileName,
+	uint32_t maxThreadCount = 16, uint32_t repeatCount = 3);
+
+}
@@ -1,10 +1,24 @@
 #include "Logger.h"
+#ifdef _WIN32
 #include <Windows.h>
+#else
+#include <cstdio>
+#include <cwchar>
+#endif
 
+// Windows ではデバッガの出力へ、それ以外（Linux でのツール実行など）は標準エラーへ出す
 void Log(const std::string& message) {
+#ifdef _WIN32
 	OutputDebugStringA(message.c_str());
+#else
+	std::fputs(message.c_str(), stderr);
+#endif
 }
 
 void Log(const std::wstring& message) {
+#ifdef _WIN32
 	OutputDebugStringW(message.c_str());
-}
\ No newline at end of file
+#else
+	std::fprintf(stderr, "%ls", message.c_str());
+#endif
+}
@@ -56,11 +56,12 @@ void MapChipField::LoadMapChipCsv(const std::string& filePath) {
 }
 
 MapChipType MapChipField::GetMapChipTypeByIndex(uint32_t xIndex, uint32_t yIndex) {
-	if (xIndex < 0 || kNumBlockHorizontal - 1 < xIndex) {
+	// 符号なしなので、負の番号（0 - 1 など）も大きな値になってここで弾かれる
+	if (kNumBlockHorizontal - 1 < xIndex) {
 		return MapChipType::kBlank;
 	}
 
-	if (yIndex < 0 || kNumBlockVertical - 1 < yIndex) {
+	if (kNumBlockVertical - 1 < yIndex) {
 		return MapChipType::kBlank;
 	}
 
@@ -1,5 +1,5 @@
 #pragma once
-#include "Math.h"
+#include "Vector3.h"
 #include <cstdint>
 #include <string>
 #include <vector>
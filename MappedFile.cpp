@@ -0,0 +1,139 @@
+#include "MappedFile.h"
+#include <utility>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+	*this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+	if (this != &other) {
+		Close();
+		data_ = std::exchange(other.data_, nullptr);
+		size_ = std::exchange(other.size_, 0);
+		isOpen_ = std::exchange(other.isOpen_, false);
+#ifdef _WIN32
+		fileHandle_ = std::exchange(other.fileHandle_, nullptr);
+		mappingHandle_ = std::exchange(other.mappingHandle_, nullptr);
+#else
+		fileDescriptor_ = std::exchange(other.fileDescriptor_, -1);
+#endif
+	}
+	return *this;
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string& path) {
+	Close();
+
+	HANDLE file = CreateFileA(
+		path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER fileSize = {};
+	if (!GetFileSizeEx(file, &fileSize)) {
+		CloseHandle(file);
+		return false;
+	}
+
+	fileHandle_ = file;
+	size_ = static_cast<size_t>(fileSize.QuadPart);
+	isOpen_ = true;
+
+	// 0 バイトのファイルはマップできないので、開けた扱いにだけする
+	if (size_ == 0) {
+		return true;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr) {
+		Close();
+		return false;
+	}
+	mappingHandle_ = mapping;
+
+	data_ = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	if (data_ == nullptr) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void MappedFile::Close() {
+	if (data_) {
+		UnmapViewOfFile(data_);
+	}
+	if (mappingHandle_) {
+		CloseHandle(static_cast<HANDLE>(mappingHandle_));
+	}
+	if (fileHandle_) {
+		CloseHandle(static_cast<HANDLE>(fileHandle_));
+	}
+	data_ = nullptr;
+	mappingHandle_ = nullptr;
+	fileHandle_ = nullptr;
+	size_ = 0;
+	isOpen_ = false;
+}
+
+#else
+
+bool MappedFile::Open(const std::string& path) {
+	Close();
+
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+
+	struct stat status = {};
+	if (::fstat(fd, &status) != 0) {
+		::close(fd);
+		return false;
+	}
+
+	fileDescriptor_ = fd;
+	size_ = static_cast<size_t>(status.st_size);
+	isOpen_ = true;
+
+	if (size_ == 0) {
+		return true;
+	}
+
+	void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (mapped == MAP_FAILED) {
+		Close();
+		return false;
+	}
+	::madvise(mapped, size_, MADV_SEQUENTIAL);
+	data_ = static_cast<const char*>(mapped);
+	return true;
+}
+
+void MappedFile::Close() {
+	if (data_) {
+		::munmap(const_cast<char*>(data_), size_);
+	}
+	if (fileDescriptor_ >= 0) {
+		::close(fileDescriptor_);
+	}
+	data_ = nullptr;
+	fileDescriptor_ = -1;
+	size_ = 0;
+	isOpen_ = false;
+}
+
+#endif
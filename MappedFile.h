@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// ==================================
+// 読み取り専用のメモリマップドファイル
+// ==================================
+// ファイル全体をアドレス空間に割り当て、コピーせずに直接読む。
+// 破棄時（またはClose）にマッピングを解除する。
+class MappedFile {
+public:
+	MappedFile() = default;
+	explicit MappedFile(const std::string& path) { Open(path); }
+	~MappedFile() { Close(); }
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+
+	// 開けなかった場合は false（空ファイルは開けた扱いでサイズ 0）
+	bool Open(const std::string& path);
+	void Close();
+
+	bool IsOpen() const { return isOpen_; }
+	const char* GetData() const { return data_; }
+	size_t GetSize() const { return size_; }
+	std::string_view GetView() const { return { data_, size_ }; }
+
+private:
+	const char* data_ = nullptr;
+	size_t size_ = 0;
+	bool isOpen_ = false;
+
+#ifdef _WIN32
+	void* fileHandle_ = nullptr;
+	void* mappingHandle_ = nullptr;
+#else
+	int fileDescriptor_ = -1;
+#endif
+};
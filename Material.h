@@ -1,5 +1,5 @@
 #pragma once
-#include "math.h"
+#include "Math.h"
 
 struct Material {
 	Vector4 color; // RGBA
@@ -2,5 +2,6 @@
 #include <string>
 
 struct MaterialData {
+	std::string name;            // newmtl の名前
 	std::string textureFilePath;
 };
\ No newline at end of file
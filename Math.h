@@ -7,8 +7,12 @@
 #include "Vector2.h"
 #include "Vector3.h"
 #include "Vector4.h"
+#include "Quaternion.h"
 #include "Transform.h"
 #include "Affine3D.h"
+#include "Affine3x4.h"
+#include "TransformBatch.h"
+#include "BoundingVolume.h"
 
 // ==================================
 // Geometry Structures
@@ -0,0 +1,306 @@
+#include "MathBenchmark.h"
+#include "Affine3D.h"
+#include "Easing.h"
+#include "Matrix4x4.h"
+#include "TransformBatch.h"
+#include "Vector3.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+// 最適化で計算が消されないよう、結果をここへ書き込む
+volatile float g_sink = 0.0f;
+
+// 入力を毎回少しずつ変えるための配列長（2の累乗）
+constexpr uint32_t kInputCount = 256;
+
+struct Result {
+	const char* name;
+	uint64_t iterations;
+	double nsPerOp;
+};
+
+struct Inputs {
+	std::array<Matrix4x4, kInputCount> matrices;
+	std::array<Vector3, kInputCount> vectors;
+	std::array<float, kInputCount> scalars;
+};
+
+Inputs MakeInputs() {
+	Inputs inputs{};
+	// 再現性のため固定シードの線形合同法で生成する
+	uint32_t state = 12345u;
+	auto next = [&state]() {
+		state = state * 1664525u + 1013904223u;
+		return static_cast<float>(state >> 8) / static_cast<float>(1u << 24);
+	};
+	for (uint32_t i = 0; i < kInputCount; ++i) {
+		const Vector3 scale = { 0.5f + next(), 0.5f + next(), 0.5f + next() };
+		const Vector3 rotate = { next() * 6.0f, next() * 6.0f, next() * 6.0f };
+		const Vector3 translate = { next() * 10.0f, next() * 10.0f, next() * 10.0f };
+		inputs.matrices[i] = MakeAffineMatrix(scale, rotate, translate);
+		inputs.vectors[i] = { next() - 0.5f, next() - 0.5f, next() + 0.1f };
+		inputs.scalars[i] = next();
+	}
+	return inputs;
+}
+
+// ================================
+// Player 風の角の当たり判定
+// ================================
+// Player::Update と同じ形の処理（重力・落下速度制限・移動量・4 つの角の位置・マップチップ判定）を Vector3 の演算で行う。
+// Ops で Vector3 の呼び方を切り替え、ヘッダーのインライン展開と、翻訳単位をまたぐ呼び出し（旧 Vector3.cpp）を比べる。
+struct CollisionBody {
+	Vector3 position;
+	Vector3 velocity;
+};
+
+// ヘッダーの constexpr 演算をそのまま使う（インライン展開される）
+struct InlineVectorOps {
+	static Vector3 Add(const Vector3& a, const Vector3& b) { return a + b; }
+	static Vector3 Multiply(float s, const Vector3& v) { return s * v; }
+};
+
+// 関数ポインタ経由にしてインライン展開を止め、別の .cpp に定義があったときの呼び出しを再現する
+Vector3 AddOutOfLine(const Vector3& a, const Vector3& b) { return a + b; }
+Vector3 MultiplyOutOfLine(float s, const Vector3& v) { return s * v; }
+Vector3 (*volatile g_addCall)(const Vector3&, const Vector3&) = &AddOutOfLine;
+Vector3 (*volatile g_multiplyCall)(float, const Vector3&) = &MultiplyOutOfLine;
+
+struct OutOfLineVectorOps {
+	static Vector3 Add(const Vector3& a, const Vector3& b) { return g_addCall(a, b); }
+	static Vector3 Multiply(float s, const Vector3& v) { return g_multiplyCall(s, v); }
+};
+
+// 1 マス 1.0。y < 0 の床と、x が 16 マスごとの壁がブロック
+bool IsBlock(const Vector3& position) {
+	const int x = static_cast<int>(std::floor(position.x));
+	const int y = static_cast<int>(std::floor(position.y));
+	return y < 0 || (x & 15) == 0;
+}
+
+// Player::CornerPosition と同じ並び（右下・左下・右上・左上）
+constexpr Vector3 kCornerOffsets[] = {
+	{ 0.5f, -0.5f, 0.0f },
+	{ -0.5f, -0.5f, 0.0f },
+	{ 0.5f, 0.5f, 0.0f },
+	{ -0.5f, 0.5f, 0.0f },
+};
+
+template <class Ops>
+void StepCollisionBody(CollisionBody& body) {
+	constexpr float kDeltaTime = 1.0f / 60.0f;
+	constexpr Vector3 kGravity = { 0.0f, -0.98f, 0.0f };
+	constexpr float kLimitFallSpeed = 20.0f;
+
+	body.velocity = Ops::Add(body.velocity, kGravity);
+	body.velocity.y = std::max(body.velocity.y, -kLimitFallSpeed);
+	Vector3 moveAmount = Ops::Multiply(kDeltaTime, body.velocity);
+
+	// 縦の移動で角がブロックに入るなら止める（床・天井）
+	const Vector3 movedY = Ops::Add(body.position, { 0.0f, moveAmount.y, 0.0f });
+	for (const Vector3& offset : kCornerOffsets) {
+		if (IsBlock(Ops::Add(movedY, offset))) {
+			moveAmount.y = 0.0f;
+			body.velocity.y = 0.0f;
+			break;
+		}
+	}
+	// 横の移動で角がブロックに入るなら跳ね返す（壁）
+	const Vector3 movedX = Ops::Add(body.position, { moveAmount.x, 0.0f, 0.0f });
+	for (const Vector3& offset : kCornerOffsets) {
+		if (IsBlock(Ops::Add(movedX, offset))) {
+			moveAmount.x = 0.0f;
+			body.velocity.x = -body.velocity.x;
+			break;
+		}
+	}
+	body.position = Ops::Add(body.position, moveAmount);
+}
+
+// body(i) を iterations 回呼び、1回あたりの時間を測る
+template <typename Body>
+Result Measure(const char* name, uint64_t iterations, Body body) {
+	// ウォームアップ
+	for (uint64_t i = 0; i < iterations / 10; ++i) {
+		body(static_cast<uint32_t>(i) & (kInputCount - 1));
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	for (uint64_t i = 0; i < iterations; ++i) {
+		body(static_cast<uint32_t>(i) & (kInputCount - 1));
+	}
+	const auto end = std::chrono::steady_clock::now();
+
+	const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+	return { name, iterations, ns / static_cast<double>(iterations) };
+}
+
+// 要素数 elementCount の処理 body() を repeats 回行い、1 要素あたりの時間を測る（iterations は要素数の合計）
+template <typename Body>
+Result MeasureBatch(const char* name, uint64_t repeats, size_t elementCount, Body body) {
+	// ウォームアップ（キャッシュに載せる）
+	body();
+
+	const auto start = std::chrono::steady_clock::now();
+	for (uint64_t i = 0; i < repeats; ++i) {
+		body();
+	}
+	const auto end = std::chrono::steady_clock::now();
+
+	const uint64_t iterations = repeats * elementCount;
+	const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+	return { name, iterations, ns / static_cast<double>(iterations) };
+}
+
+std::string ToJson(const std::vector<Result>& results) {
+	std::string json = "{\n  \"benchmarks\": [\n";
+	char line[256];
+	for (size_t i = 0; i < results.size(); ++i) {
+		std::snprintf(line, sizeof(line),
+			"    { \"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.3f }%s\n",
+			results[i].name, static_cast<unsigned long long>(results[i].iterations), results[i].nsPerOp,
+			i + 1 < results.size() ? "," : "");
+		json += line;
+	}
+	json += "  ]\n}\n";
+	return json;
+}
+
+}
+
+std::string MathBenchmark::RunAll(double iterationScale) {
+	const Inputs inputs = MakeInputs();
+	const auto& m = inputs.matrices;
+	const auto& v = inputs.vectors;
+	const auto& s = inputs.scalars;
+
+	auto count = [iterationScale](uint64_t base) {
+		const uint64_t n = static_cast<uint64_t>(static_cast<double>(base) * iterationScale);
+		return n > 0 ? n : 1;
+	};
+
+	std::vector<Result> results;
+
+	// Matrix4x4
+	results.push_back(Measure("Matrix4x4::Multiply", count(10'000'000), [&](uint32_t i) {
+		g_sink = Matrix4x4::Multiply(m[i], m[(i + 1) & (kInputCount - 1)]).m[3][3];
+	}));
+	results.push_back(Measure("Matrix4x4::Inverse", count(5'000'000), [&](uint32_t i) {
+		g_sink = Matrix4x4::Inverse(m[i]).m[3][0];
+	}));
+	results.push_back(Measure("Matrix4x4::Transpose", count(10'000'000), [&](uint32_t i) {
+		g_sink = Matrix4x4::Transpose(m[i]).m[0][3];
+	}));
+	results.push_back(Measure("MakeAffineMatrix", count(5'000'000), [&](uint32_t i) {
+		g_sink = MakeAffineMatrix(v[i], v[(i + 1) & (kInputCount - 1)], v[(i + 2) & (kInputCount - 1)]).m[3][0];
+	}));
+	results.push_back(Measure("Matrix4x4::MakeParspectiveFovMatrix", count(5'000'000), [&](uint32_t i) {
+		g_sink = Matrix4x4::MakeParspectiveFovMatrix(0.3f + s[i], 16.0f / 9.0f, 0.1f, 100.0f).m[1][1];
+	}));
+	results.push_back(Measure("Matrix4x4::MakeOrthographicMatrix", count(10'000'000), [&](uint32_t i) {
+		g_sink = Matrix4x4::MakeOrthographicMatrix(0.0f, 0.0f, 1280.0f + s[i], 720.0f, 0.0f, 100.0f).m[3][0];
+	}));
+
+	// Vector3
+	results.push_back(Measure("Vector3::Normalize", count(20'000'000), [&](uint32_t i) {
+		g_sink = Vector3::Normalize(v[i]).x;
+	}));
+	results.push_back(Measure("Vector3::Transform", count(20'000'000), [&](uint32_t i) {
+		g_sink = Vector3::Transform(v[i], m[(i + 3) & (kInputCount - 1)]).y;
+	}));
+
+	// まとめて変換（1M 点。1 点あたりの時間）
+	{
+		constexpr size_t kPointCount = 1'000'000;
+		std::vector<Vector3> points(kPointCount);
+		std::vector<float> xs(kPointCount);
+		std::vector<float> ys(kPointCount);
+		std::vector<float> zs(kPointCount);
+		for (size_t i = 0; i < kPointCount; ++i) {
+			points[i] = v[i & (kInputCount - 1)] + Vector3{ static_cast<float>(i & 1023), 0.0f, static_cast<float>(i >> 10) } * 0.01f;
+			xs[i] = points[i].x;
+			ys[i] = points[i].y;
+			zs[i] = points[i].z;
+		}
+		std::vector<Vector3> transformed(kPointCount);
+		std::vector<float> outXs(kPointCount);
+		std::vector<float> outYs(kPointCount);
+		std::vector<float> outZs(kPointCount);
+		const Matrix4x4& matrix = m[3];
+		const uint64_t repeats = count(20);
+
+		results.push_back(MeasureBatch("Vector3::Transform loop (1M points)", repeats, kPointCount, [&]() {
+			for (size_t i = 0; i < kPointCount; ++i) {
+				transformed[i] = Vector3::Transform(points[i], matrix);
+			}
+			g_sink = transformed[kPointCount / 2].x;
+		}));
+		results.push_back(MeasureBatch("TransformPoints AoS (1M points)", repeats, kPointCount, [&]() {
+			TransformPoints(points, transformed, matrix);
+			g_sink = transformed[kPointCount / 2].x;
+		}));
+		results.push_back(MeasureBatch("TransformPoints SoA (1M points)", repeats, kPointCount, [&]() {
+			TransformPoints(ConstVector3SoA{ xs, ys, zs }, Vector3SoA{ outXs, outYs, outZs }, matrix);
+			g_sink = outXs[kPointCount / 2];
+		}));
+		results.push_back(MeasureBatch("TransformDirections AoS (1M points)", repeats, kPointCount, [&]() {
+			TransformDirections(points, transformed, matrix);
+			g_sink = transformed[kPointCount / 2].x;
+		}));
+	}
+
+	// Player 風の当たり判定（1 体 1 フレームあたりの時間）
+	{
+		std::array<CollisionBody, kInputCount> initialBodies{};
+		for (uint32_t i = 0; i < kInputCount; ++i) {
+			initialBodies[i].position = { 2.0f + 12.0f * s[i], 1.0f + 8.0f * v[i].z, 0.0f };
+			initialBodies[i].velocity = { (i & 1) ? 3.0f : -3.0f, 0.0f, 0.0f };
+		}
+		std::array<CollisionBody, kInputCount> bodies = initialBodies;
+		results.push_back(Measure("PlayerCollision (header-only Vector3)", count(10'000'000), [&](uint32_t i) {
+			StepCollisionBody<InlineVectorOps>(bodies[i]);
+			g_sink = bodies[i].position.x;
+		}));
+		bodies = initialBodies;
+		results.push_back(Measure("PlayerCollision (out-of-line Vector3 calls)", count(10'000'000), [&](uint32_t i) {
+			StepCollisionBody<OutOfLineVectorOps>(bodies[i]);
+			g_sink = bodies[i].position.x;
+		}));
+	}
+
+	// Easing
+	results.push_back(Measure("Easing::EaseInOutSine", count(20'000'000), [&](uint32_t i) {
+		g_sink = Easing::EaseInOutSine(s[i]);
+	}));
+	results.push_back(Measure("Easing::EaseInOutCubic", count(20'000'000), [&](uint32_t i) {
+		g_sink = Easing::EaseInOutCubic(s[i]);
+	}));
+	results.push_back(Measure("Easing::EaseInOut", count(20'000'000), [&](uint32_t i) {
+		g_sink = Easing::EaseInOut(s[i]);
+	}));
+	results.push_back(Measure("Easing::EaseOutBounce", count(20'000'000), [&](uint32_t i) {
+		g_sink = Easing::EaseOutBounce(s[i]);
+	}));
+	results.push_back(Measure("Easing::EaseOutBack", count(20'000'000), [&](uint32_t i) {
+		g_sink = Easing::EaseOutBack(s[i]);
+	}));
+	results.push_back(Measure("Easing::EaseOutElastic", count(20'000'000), [&](uint32_t i) {
+		g_sink = Easing::EaseOutElastic(s[i]);
+	}));
+
+	return ToJson(results);
+}
+
+#if defined(TOMO_MATH_BENCH_MAIN)
+int main() {
+	std::fputs(MathBenchmark::RunAll().c_str(), stdout);
+	return 0;
+}
+#endif
@@ -0,0 +1,20 @@
+#pragma once
+#include <string>
+
+// ==================================
+// 数学ライブラリのマイクロベンチマーク
+// ==================================
+// D3D12 / Win32 に依存しないので、数学系の .cpp だけで単体ビルドできる。
+// 結果は JSON 文字列で返すので、コミット間の比較にそのまま使える。
+//
+// 単体の実行ファイルにする場合は TOMO_MATH_BENCH_MAIN を定義してビルドする（CMakeLists.txt の math_bench ターゲット）。
+//   cmake -S . -B build && cmake --build build --target math_bench && ./build/math_bench > math.json
+// CMake を使わない場合:
+//   g++ -std=c++20 -O2 -DTOMO_MATH_BENCH_MAIN MathBenchmark.cpp TransformBatch.cpp Matrix4x4.cpp Affine3D.cpp Affine3x4.cpp Quaternion.cpp
+namespace MathBenchmark {
+
+// 全ケースを実行し、結果を JSON で返す
+// iterationScale : 反復回数の倍率（デバッグビルドでは小さくする）
+std::string RunAll(double iterationScale = 1.0);
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+// ==================================
+// SIMD命令セットの選択（コンパイル時）
+// ==================================
+// TOMO_MATH_NO_SIMD を定義するとスカラー実装に固定される（比較・デバッグ用）
+//
+//   TOMO_MATH_AVX  : AVX (/arch:AVX, /arch:AVX2, -mavx)
+//   TOMO_MATH_SSE  : SSE2 (x64 では常に有効)
+//   TOMO_MATH_NEON : ARM NEON (AArch64)
+//
+// AVX が有効な場合は SSE も有効になる
+
+#if !defined(TOMO_MATH_NO_SIMD)
+#if defined(__AVX__)
+#define TOMO_MATH_AVX 1
+#define TOMO_MATH_SSE 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TOMO_MATH_SSE 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define TOMO_MATH_NEON 1
+#endif
+#endif
+
+#if defined(TOMO_MATH_AVX)
+#include <immintrin.h>
+#elif defined(TOMO_MATH_SSE)
+#include <emmintrin.h>
+#elif defined(TOMO_MATH_NEON)
+#include <arm_neon.h>
+#endif
+
+#if defined(TOMO_MATH_SSE)
+// _mm_shuffle_ps 用のマスク生成 (x,y,z,w の順に要素番号を指定)
+#define TOMO_SHUFFLE_MASK(x, y, z, w) ((x) | ((y) << 2) | ((z) << 4) | ((w) << 6))
+#endif
@@ -1,191 +1,247 @@
 #include "Matrix4x4.h"
-#include <cmath> // tanf
+#include "MathSimd.h"
+#include <cmath>
+
+namespace {
+
+#pragma region Scalar
+
+// スカラー実装の逆行列
+// 上2行・下2行の2x2小行列式12個から余因子を組み立て、行列式の逆数は1回だけ求める
+[[maybe_unused]] Matrix4x4 InverseScalar(const Matrix4x4& m) {
+	const float (&a)[4][4] = m.m;
+
+	// 上2行の2x2小行列式
+	const float s0 = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+	const float s1 = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+	const float s2 = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+	const float s3 = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+	const float s4 = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+	const float s5 = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+
+	// 下2行の2x2小行列式
+	const float c5 = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+	const float c4 = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+	const float c3 = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+	const float c2 = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+	const float c1 = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+	const float c0 = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+
+	const float determinant = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+	const float invDet = 1.0f / determinant;
+
+	Matrix4x4 result;
+	result.m[0][0] = (a[1][1] * c5 - a[1][2] * c4 + a[1][3] * c3) * invDet;
+	result.m[0][1] = (-a[0][1] * c5 + a[0][2] * c4 - a[0][3] * c3) * invDet;
+	result.m[0][2] = (a[3][1] * s5 - a[3][2] * s4 + a[3][3] * s3) * invDet;
+	result.m[0][3] = (-a[2][1] * s5 + a[2][2] * s4 - a[2][3] * s3) * invDet;
+
+	result.m[1][0] = (-a[1][0] * c5 + a[1][2] * c2 - a[1][3] * c1) * invDet;
+	result.m[1][1] = (a[0][0] * c5 - a[0][2] * c2 + a[0][3] * c1) * invDet;
+	result.m[1][2] = (-a[3][0] * s5 + a[3][2] * s2 - a[3][3] * s1) * invDet;
+	result.m[1][3] = (a[2][0] * s5 - a[2][2] * s2 + a[2][3] * s1) * invDet;
+
+	result.m[2][0] = (a[1][0] * c4 - a[1][1] * c2 + a[1][3] * c0) * invDet;
+	result.m[2][1] = (-a[0][0] * c4 + a[0][1] * c2 - a[0][3] * c0) * invDet;
+	result.m[2][2] = (a[3][0] * s4 - a[3][1] * s2 + a[3][3] * s0) * invDet;
+	result.m[2][3] = (-a[2][0] * s4 + a[2][1] * s2 - a[2][3] * s0) * invDet;
+
+	result.m[3][0] = (-a[1][0] * c3 + a[1][1] * c1 - a[1][2] * c0) * invDet;
+	result.m[3][1] = (a[0][0] * c3 - a[0][1] * c1 + a[0][2] * c0) * invDet;
+	result.m[3][2] = (-a[3][0] * s3 + a[3][1] * s1 - a[3][2] * s0) * invDet;
+	result.m[3][3] = (a[2][0] * s3 - a[2][1] * s1 + a[2][2] * s0) * invDet;
+	return result;
+}
 
-Matrix4x4 Matrix4x4::Add(const Matrix4x4& m1, const Matrix4x4& m2) {
-	Matrix4x4 result = { 0 };
-	for (int i = 0; i < 4; ++i) {
-		for (int j = 0; j < 4; ++j) {
-			result.m[i][j] = m1.m[i][j] + m2.m[i][j];
-		}
-	}
+#pragma endregion
+
+#if defined(TOMO_MATH_SSE)
+#pragma region SSE
+
+// 4要素のうち1つを全レーンに複製
+#define TOMO_SPLAT(v, i) _mm_shuffle_ps((v), (v), TOMO_SHUFFLE_MASK(i, i, i, i))
+#define TOMO_SWIZZLE(v, x, y, z, w) _mm_shuffle_ps((v), (v), TOMO_SHUFFLE_MASK(x, y, z, w))
+
+// 結果の1行 = m1の行の各要素をブロードキャストして m2 の各行に掛けて足し合わせる
+inline __m128 MultiplyRowSSE(__m128 row, __m128 r0, __m128 r1, __m128 r2, __m128 r3) {
+	__m128 result = _mm_mul_ps(TOMO_SPLAT(row, 0), r0);
+	result = _mm_add_ps(result, _mm_mul_ps(TOMO_SPLAT(row, 1), r1));
+	result = _mm_add_ps(result, _mm_mul_ps(TOMO_SPLAT(row, 2), r2));
+	result = _mm_add_ps(result, _mm_mul_ps(TOMO_SPLAT(row, 3), r3));
 	return result;
 }
 
-Matrix4x4 Matrix4x4::Subtract(const Matrix4x4& m1, const Matrix4x4& m2) {
-	Matrix4x4 result = { 0 };
-	for (int i = 0; i < 4; ++i) {
-		for (int j = 0; j < 4; ++j) {
-			result.m[i][j] = m1.m[i][j] - m2.m[i][j];
-		}
+#if defined(TOMO_MATH_AVX)
+// AVX: 2行ずつまとめて計算する
+Matrix4x4 MultiplySIMD(const Matrix4x4& m1, const Matrix4x4& m2) {
+	const __m256 r0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[0]));
+	const __m256 r1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[1]));
+	const __m256 r2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[2]));
+	const __m256 r3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[3]));
+
+	Matrix4x4 result;
+	for (int i = 0; i < 4; i += 2) {
+		const __m256 rows = _mm256_loadu_ps(m1.m[i]);
+		__m256 sum = _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, TOMO_SHUFFLE_MASK(0, 0, 0, 0)), r0);
+		sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, TOMO_SHUFFLE_MASK(1, 1, 1, 1)), r1));
+		sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, TOMO_SHUFFLE_MASK(2, 2, 2, 2)), r2));
+		sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_shuffle_ps(rows, rows, TOMO_SHUFFLE_MASK(3, 3, 3, 3)), r3));
+		_mm256_storeu_ps(result.m[i], sum);
 	}
 	return result;
-};
-
-Matrix4x4 Matrix4x4::Multiply(const Matrix4x4& m1, const Matrix4x4& m2) {
-	Matrix4x4 result = { 0 };
+}
+#else
+Matrix4x4 MultiplySIMD(const Matrix4x4& m1, const Matrix4x4& m2) {
+	const __m128 r0 = _mm_loadu_ps(m2.m[0]);
+	const __m128 r1 = _mm_loadu_ps(m2.m[1]);
+	const __m128 r2 = _mm_loadu_ps(m2.m[2]);
+	const __m128 r3 = _mm_loadu_ps(m2.m[3]);
+
+	Matrix4x4 result;
 	for (int i = 0; i < 4; ++i) {
-		for (int j = 0; j < 4; ++j) {
-			for (int k = 0; k < 4; ++k) {
-				result.m[i][j] += m1.m[i][k] * m2.m[k][j];
-			}
-		}
+		_mm_storeu_ps(result.m[i], MultiplyRowSSE(_mm_loadu_ps(m1.m[i]), r0, r1, r2, r3));
 	}
 	return result;
-};
+}
+#endif
 
-#pragma region Inverse4x4
+// 2x2行列(行優先で4要素に格納)の積 A*B
+inline __m128 Mat2Mul(__m128 a, __m128 b) {
+	return _mm_add_ps(
+		_mm_mul_ps(a, TOMO_SWIZZLE(b, 0, 3, 0, 3)),
+		_mm_mul_ps(TOMO_SWIZZLE(a, 1, 0, 3, 2), TOMO_SWIZZLE(b, 2, 1, 2, 1)));
+}
 
-// 4x4行列の逆行列を求める
-Matrix4x4 Matrix4x4::Inverse(const Matrix4x4& m) {
+// 2x2行列の 随伴(A)*B
+inline __m128 Mat2AdjMul(__m128 a, __m128 b) {
+	return _mm_sub_ps(
+		_mm_mul_ps(TOMO_SWIZZLE(a, 3, 3, 0, 0), b),
+		_mm_mul_ps(TOMO_SWIZZLE(a, 1, 1, 2, 2), TOMO_SWIZZLE(b, 2, 3, 0, 1)));
+}
 
-	float determinant = 0;
-	Matrix4x4 result = { 0 };
+// 2x2行列の A*随伴(B)
+inline __m128 Mat2MulAdj(__m128 a, __m128 b) {
+	return _mm_sub_ps(
+		_mm_mul_ps(a, TOMO_SWIZZLE(b, 3, 0, 3, 0)),
+		_mm_mul_ps(TOMO_SWIZZLE(a, 1, 0, 3, 2), TOMO_SWIZZLE(b, 2, 1, 2, 1)));
+}
 
-	// 4x4行列の逆行列を求めるためのDeterminant計算
-	determinant = Determinant4x4(m);
-
-	//0行目の計算
-	result.m[0][0] = {
-		(m.m[1][1] * m.m[2][2] * m.m[3][3] + m.m[1][2] * m.m[2][3] * m.m[3][1]
-		+ m.m[1][3] * m.m[2][1] * m.m[3][2] - m.m[1][3] * m.m[2][2] * m.m[3][1]
-		- m.m[1][2] * m.m[2][1] * m.m[3][3] - m.m[1][1] * m.m[2][3] * m.m[3][2])
-			/ determinant
-	};
-
-	result.m[0][1] = {
-		(-m.m[0][1] * m.m[2][2] * m.m[3][3] - m.m[0][2] * m.m[2][3] * m.m[3][1]
-		- m.m[0][3] * m.m[2][1] * m.m[3][2] + m.m[0][3] * m.m[2][2] * m.m[3][1]
-		+ m.m[0][2] * m.m[2][1] * m.m[3][3] + m.m[0][1] * m.m[2][3] * m.m[3][2])
-			/ determinant
-	};
-
-	result.m[0][2] = {
-		(m.m[0][1] * m.m[1][2] * m.m[3][3] + m.m[0][2] * m.m[1][3] * m.m[3][1]
-			+ m.m[0][3] * m.m[1][1] * m.m[3][2] - m.m[0][3] * m.m[1][2] * m.m[3][1]
-			- m.m[0][2] * m.m[1][1] * m.m[3][3] - m.m[0][1] * m.m[1][3] * m.m[3][2])
-		/ determinant
-	};
-
-	result.m[0][3] = {
-		(-m.m[0][1] * m.m[1][2] * m.m[2][3] - m.m[0][2] * m.m[1][3] * m.m[2][1]
-		- m.m[0][3] * m.m[1][1] * m.m[2][2] + m.m[0][3] * m.m[1][2] * m.m[2][1]
-		+ m.m[0][2] * m.m[1][1] * m.m[2][3] + m.m[0][1] * m.m[1][3] * m.m[2][2])
-			/ determinant
-	};
-
-	//1行目の計算
-	result.m[1][0] = {
-	(-m.m[1][0] * m.m[2][2] * m.m[3][3] - m.m[1][2] * m.m[2][3] * m.m[3][0]
-	- m.m[1][3] * m.m[2][0] * m.m[3][2] + m.m[1][3] * m.m[2][2] * m.m[3][0]
-	+ m.m[1][2] * m.m[2][0] * m.m[3][3] + m.m[1][0] * m.m[2][3] * m.m[3][2])
-		/ determinant
-	};
-
-	result.m[1][1] = {
-		(m.m[0][0] * m.m[2][2] * m.m[3][3] + m.m[0][2] * m.m[2][3] * m.m[3][0]
-		+ m.m[0][3] * m.m[2][0] * m.m[3][2] - m.m[0][3] * m.m[2][2] * m.m[3][0]
-		- m.m[0][2] * m.m[2][0] * m.m[3][3] - m.m[0][0] * m.m[2][3] * m.m[3][2])
-			/ determinant
-	};
-
-	result.m[1][2] = {
-		(-m.m[0][0] * m.m[1][2] * m.m[3][3] - m.m[0][2] * m.m[1][3] * m.m[3][0]
-		- m.m[0][3] * m.m[1][0] * m.m[3][2] + m.m[0][3] * m.m[1][2] * m.m[3][0]
-		+ m.m[0][2] * m.m[1][0] * m.m[3][3] + m.m[0][0] * m.m[1][3] * m.m[3][2])
-			/ determinant
-	};
-
-	result.m[1][3] = {
-		(m.m[0][0] * m.m[1][2] * m.m[2][3] + m.m[0][2] * m.m[1][3] * m.m[2][0]
-		+ m.m[0][3] * m.m[1][0] * m.m[2][2] - m.m[0][3] * m.m[1][2] * m.m[2][0]
-		- m.m[0][2] * m.m[1][0] * m.m[2][3] - m.m[0][0] * m.m[1][3] * m.m[2][2])
-			/ determinant
-	};
-
-	//2行目の計算
-	result.m[2][0] = {
-		(m.m[1][0] * m.m[2][1] * m.m[3][3] + m.m[1][1] * m.m[2][3] * m.m[3][0]
-		+ m.m[1][3] * m.m[2][0] * m.m[3][1] - m.m[1][3] * m.m[2][1] * m.m[3][0]
-		- m.m[1][1] * m.m[2][0] * m.m[3][3] - m.m[1][0] * m.m[2][3] * m.m[3][1])
-			/ determinant
-	};
-
-	result.m[2][1] = {
-		(-m.m[0][0] * m.m[2][1] * m.m[3][3] - m.m[0][1] * m.m[2][3] * m.m[3][0]
-		- m.m[0][3] * m.m[2][0] * m.m[3][1] + m.m[0][3] * m.m[2][1] * m.m[3][0]
-		+ m.m[0][1] * m.m[2][0] * m.m[3][3] + m.m[0][0] * m.m[2][3] * m.m[3][1])
-			/ determinant
-	};
-
-	result.m[2][2] = {
-		(m.m[0][0] * m.m[1][1] * m.m[3][3] + m.m[0][1] * m.m[1][3] * m.m[3][0]
-		+ m.m[0][3] * m.m[1][0] * m.m[3][1] - m.m[0][3] * m.m[1][1] * m.m[3][0]
-		- m.m[0][1] * m.m[1][0] * m.m[3][3] - m.m[0][0] * m.m[1][3] * m.m[3][1])
-			/ determinant
-	};
-
-	result.m[2][3] = {
-		(-m.m[0][0] * m.m[1][1] * m.m[2][3] - m.m[0][1] * m.m[1][3] * m.m[2][0]
-		- m.m[0][3] * m.m[1][0] * m.m[2][1] + m.m[0][3] * m.m[1][1] * m.m[2][0]
-		+ m.m[0][1] * m.m[1][0] * m.m[2][3] + m.m[0][0] * m.m[1][3] * m.m[2][1])
-			/ determinant
-	};
-
-	//3行目の計算
-	result.m[3][0] = {
-		(-m.m[1][0] * m.m[2][1] * m.m[3][2] - m.m[1][1] * m.m[2][2] * m.m[3][0]
-		- m.m[1][2] * m.m[2][0] * m.m[3][1] + m.m[1][2] * m.m[2][1] * m.m[3][0]
-		+ m.m[1][1] * m.m[2][0] * m.m[3][2] + m.m[1][0] * m.m[2][2] * m.m[3][1])
-			/ determinant
-	};
-
-	result.m[3][1] = {
-		(m.m[0][0] * m.m[2][1] * m.m[3][2] + m.m[0][1] * m.m[2][2] * m.m[3][0]
-		+ m.m[0][2] * m.m[2][0] * m.m[3][1] - m.m[0][2] * m.m[2][1] * m.m[3][0]
-		- m.m[0][1] * m.m[2][0] * m.m[3][2] - m.m[0][0] * m.m[2][2] * m.m[3][1])
-			/ determinant
-	};
-
-	result.m[3][2] = {
-		(-m.m[0][0] * m.m[1][1] * m.m[3][2] - m.m[0][1] * m.m[1][2] * m.m[3][0]
-		- m.m[0][2] * m.m[1][0] * m.m[3][1] + m.m[0][2] * m.m[1][1] * m.m[3][0]
-		+ m.m[0][1] * m.m[1][0] * m.m[3][2] + m.m[0][0] * m.m[1][2] * m.m[3][1])
-			/ determinant
-	};
-
-	result.m[3][3] = {
-		(m.m[0][0] * m.m[1][1] * m.m[2][2] + m.m[0][1] * m.m[1][2] * m.m[2][0]
-		+ m.m[0][2] * m.m[1][0] * m.m[2][1] - m.m[0][2] * m.m[1][1] * m.m[2][0]
-		- m.m[0][1] * m.m[1][0] * m.m[2][2] - m.m[0][0] * m.m[1][2] * m.m[2][1])
-			/ determinant
-	};
+// 2x2ブロックに分割して逆行列を求める
+//   M = | A B |    M^-1 = 1/|M| * | X Y |
+//       | C D |                   | Z W |
+Matrix4x4 InverseSIMD(const Matrix4x4& m) {
+	const __m128 row0 = _mm_loadu_ps(m.m[0]);
+	const __m128 row1 = _mm_loadu_ps(m.m[1]);
+	const __m128 row2 = _mm_loadu_ps(m.m[2]);
+	const __m128 row3 = _mm_loadu_ps(m.m[3]);
+
+	// 2x2小行列
+	const __m128 A = _mm_movelh_ps(row0, row1);
+	const __m128 B = _mm_movehl_ps(row1, row0);
+	const __m128 C = _mm_movelh_ps(row2, row3);
+	const __m128 D = _mm_movehl_ps(row3, row2);
+
+	// 各小行列の行列式 (|A| |B| |C| |D|)
+	const __m128 detSub = _mm_sub_ps(
+		_mm_mul_ps(
+			_mm_shuffle_ps(row0, row2, TOMO_SHUFFLE_MASK(0, 2, 0, 2)),
+			_mm_shuffle_ps(row1, row3, TOMO_SHUFFLE_MASK(1, 3, 1, 3))),
+		_mm_mul_ps(
+			_mm_shuffle_ps(row0, row2, TOMO_SHUFFLE_MASK(1, 3, 1, 3)),
+			_mm_shuffle_ps(row1, row3, TOMO_SHUFFLE_MASK(0, 2, 0, 2))));
+	const __m128 detA = TOMO_SPLAT(detSub, 0);
+	const __m128 detB = TOMO_SPLAT(detSub, 1);
+	const __m128 detC = TOMO_SPLAT(detSub, 2);
+	const __m128 detD = TOMO_SPLAT(detSub, 3);
+
+	const __m128 D_C = Mat2AdjMul(D, C);
+	const __m128 A_B = Mat2AdjMul(A, B);
+
+	// 各ブロックの随伴（符号と並びは最後にまとめて適用）
+	__m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), Mat2Mul(B, D_C));
+	__m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), Mat2Mul(C, A_B));
+	__m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), Mat2MulAdj(D, A_B));
+	__m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), Mat2MulAdj(A, D_C));
+
+	// |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+	__m128 tr = _mm_mul_ps(A_B, TOMO_SWIZZLE(D_C, 0, 2, 1, 3));
+	tr = _mm_add_ps(tr, TOMO_SWIZZLE(tr, 1, 0, 3, 2));
+	tr = _mm_add_ps(tr, TOMO_SWIZZLE(tr, 2, 3, 0, 1));
+	__m128 detM = _mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC));
+	detM = _mm_sub_ps(detM, tr);
+
+	const __m128 rDetM = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+	X = _mm_mul_ps(X, rDetM);
+	Y = _mm_mul_ps(Y, rDetM);
+	Z = _mm_mul_ps(Z, rDetM);
+	W = _mm_mul_ps(W, rDetM);
+
+	// 随伴の並び替えと格納を同時に行う
+	Matrix4x4 result;
+	_mm_storeu_ps(result.m[0], _mm_shuffle_ps(X, Y, TOMO_SHUFFLE_MASK(3, 1, 3, 1)));
+	_mm_storeu_ps(result.m[1], _mm_shuffle_ps(X, Y, TOMO_SHUFFLE_MASK(2, 0, 2, 0)));
+	_mm_storeu_ps(result.m[2], _mm_shuffle_ps(Z, W, TOMO_SHUFFLE_MASK(3, 1, 3, 1)));
+	_mm_storeu_ps(result.m[3], _mm_shuffle_ps(Z, W, TOMO_SHUFFLE_MASK(2, 0, 2, 0)));
 	return result;
 }
 
-// 4x4行列の転置
-Matrix4x4 Matrix4x4::Transpose(const Matrix4x4& m) {
-	Matrix4x4 result = { 0 };
+#undef TOMO_SWIZZLE
+#undef TOMO_SPLAT
+
+#pragma endregion
+#elif defined(TOMO_MATH_NEON)
+#pragma region NEON
+
+Matrix4x4 MultiplySIMD(const Matrix4x4& m1, const Matrix4x4& m2) {
+	const float32x4_t r0 = vld1q_f32(m2.m[0]);
+	const float32x4_t r1 = vld1q_f32(m2.m[1]);
+	const float32x4_t r2 = vld1q_f32(m2.m[2]);
+	const float32x4_t r3 = vld1q_f32(m2.m[3]);
+
+	Matrix4x4 result;
 	for (int i = 0; i < 4; ++i) {
-		for (int j = 0; j < 4; ++j) {
-			result.m[i][j] = m.m[j][i];
-		}
+		const float32x4_t row = vld1q_f32(m1.m[i]);
+		float32x4_t sum = vmulq_laneq_f32(r0, row, 0);
+		sum = vfmaq_laneq_f32(sum, r1, row, 1);
+		sum = vfmaq_laneq_f32(sum, r2, row, 2);
+		sum = vfmaq_laneq_f32(sum, r3, row, 3);
+		vst1q_f32(result.m[i], sum);
 	}
 	return result;
 }
 
-Matrix4x4 Matrix4x4::MakeIdentity4x4() {
-	Matrix4x4 result = { 0 };
-	for (int i = 0; i < 4; ++i) {
-		result.m[i][i] = 1.0f;
-	}
-	return result;
+// NEON版の逆行列は未実装のためスカラー版を使う
+Matrix4x4 InverseSIMD(const Matrix4x4& m) { return InverseScalar(m); }
+
+#pragma endregion
+#endif
+
+}
+
+Matrix4x4 Matrix4x4::MultiplyRuntime(const Matrix4x4& m1, const Matrix4x4& m2) {
+#if defined(TOMO_MATH_SSE) || defined(TOMO_MATH_NEON)
+	return MultiplySIMD(m1, m2);
+#else
+	return MultiplyScalar(m1, m2);
+#endif
+}
+
+#pragma region Inverse4x4
+
+// 4x4行列の逆行列を求める
+Matrix4x4 Matrix4x4::Inverse(const Matrix4x4& m) {
+#if defined(TOMO_MATH_SSE) || defined(TOMO_MATH_NEON)
+	return InverseSIMD(m);
+#else
+	return InverseScalar(m);
+#endif
 }
 
 Matrix4x4 Matrix4x4::MakeParspectiveFovMatrix(float fovY, float aspect, float nearZ, float farZ) {
 	Matrix4x4 result = { 0 };
 
 	// cot(fovY/2) = 1 / tan(fovY/2)
-	const float cotHalfFovY = 1.0f / std::tanf(fovY * 0.5f);
+	const float cotHalfFovY = 1.0f / std::tan(fovY * 0.5f);
 
 	// 1/a * cot(fovY/2)
 	result.m[0][0] = (1.0f / aspect) * cotHalfFovY; // 行0,列0
@@ -239,34 +295,112 @@ Matrix4x4 Matrix4x4::MakeOrthographicMatrix(float left, float top, float right,
 }
 
 #pragma endregion
-float Matrix4x4::Determinant3x3(
-	float a00, float a01, float a02,
-	float a10, float a11, float a12,
-	float a20, float a21, float a22) {
-	return
-		a00 * (a11 * a22 - a12 * a21)
-		- a01 * (a10 * a22 - a12 * a20)
-		+ a02 * (a10 * a21 - a11 * a20);
+
+#if defined(TOMO_MATRIX4X4_TEST_MAIN)
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include "Vector2.h"
+#include "Vector4.h"
+
+namespace {
+
+// ヘッダーだけで定数式として評価できること（コンパイルが通れば成功）
+constexpr Vector3 kA = { 1.0f, 2.0f, 3.0f };
+constexpr Vector3 kB = { 4.0f, 5.0f, 6.0f };
+static_assert(Vector3::Dot(kA, kB) == 32.0f);
+static_assert((kA + kB).z == 9.0f);
+static_assert((kB - kA * 2.0f).y == 1.0f);
+static_assert(Vector3::Cross(kA, kB).x == -3.0f);
+static_assert((-kA).x == -1.0f);
+static_assert(Vector2::Cross({ 1.0f, 0.0f }, { 0.0f, 1.0f }) == 1.0f);
+
+constexpr Matrix4x4 kIdentity = Matrix4x4::MakeIdentity4x4();
+constexpr Matrix4x4 kM = { { { 1, 2, 3, 4 }, { 5, 6, 7, 8 }, { 9, 10, 11, 12 }, { 13, 14, 15, 16 } } };
+static_assert((kIdentity * kM).m[2][3] == 12.0f);
+static_assert((kM + kM - kM).m[1][2] == 7.0f);
+static_assert(Matrix4x4::Transpose(kM).m[0][3] == 13.0f);
+static_assert(Vector3::Transform(kA, kIdentity).y == 2.0f);
+static_assert(Vector3::Transform(kA, Matrix4x4::MakeScaleMatrix({ 2.0f, 3.0f, 4.0f })).z == 12.0f);
+static_assert(Matrix4x4::MakeTranslateMatrix(kA).m[1][3] == 2.0f);
+static_assert(TransformWithW(kA, kIdentity).w == 1.0f);
+
+// max |a * inverse - I| を double で求める（逆行列の精度の目安）
+double InverseResidual(const Matrix4x4& a, const Matrix4x4& inverse) {
+	double residual = 0.0;
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			double sum = 0.0;
+			for (int k = 0; k < 4; ++k) {
+				sum += static_cast<double>(a.m[i][k]) * inverse.m[k][j];
+			}
+			residual = std::max(residual, std::fabs(sum - (i == j ? 1.0 : 0.0)));
+		}
+	}
+	return residual;
 }
 
-float Matrix4x4::Determinant4x4(const Matrix4x4& m) {
-	return
-		m.m[0][0] * Matrix4x4::Determinant3x3(
-			m.m[1][1], m.m[1][2], m.m[1][3],
-			m.m[2][1], m.m[2][2], m.m[2][3],
-			m.m[3][1], m.m[3][2], m.m[3][3])
-		- m.m[0][1] * Matrix4x4::Determinant3x3(
-			m.m[1][0], m.m[1][2], m.m[1][3],
-			m.m[2][0], m.m[2][2], m.m[2][3],
-			m.m[3][0], m.m[3][2], m.m[3][3])
-		+ m.m[0][2] * Matrix4x4::Determinant3x3(
-			m.m[1][0], m.m[1][1], m.m[1][3],
-			m.m[2][0], m.m[2][1], m.m[2][3],
-			m.m[3][0], m.m[3][1], m.m[3][3])
-		- m.m[0][3] * Matrix4x4::Determinant3x3(
-			m.m[1][0], m.m[1][1], m.m[1][2],
-			m.m[2][0], m.m[2][1], m.m[2][2],
-			m.m[3][0], m.m[3][1], m.m[3][2]);
 }
 
-#pragma endregion
\ No newline at end of file
+// SIMD 実装（Multiply / Inverse）をスカラー実装と比べる（上の static_assert でヘッダーの constexpr も確かめる）。TOMO_MATH_NO_SIMD を付けてもビルドできる（比較相手が自分になるだけ）
+// 逆行列は計算の順序が違うので値は一致しない。特異に近い行列ではどちらも誤差が大きくなるため、
+// 残差 |A * A^-1 - I| がスカラー実装と同程度（4 倍 + 1e-5 以内）であることを確かめる
+int main() {
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> distribution(-3.0f, 3.0f);
+
+	double maxMultiplyError = 0.0;
+	double maxResidual = 0.0;
+	double maxResidualScalar = 0.0;
+	int inverseFailures = 0;
+	for (int n = 0; n < 100000; ++n) {
+		Matrix4x4 a;
+		Matrix4x4 b;
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				a.m[i][j] = distribution(random);
+				b.m[i][j] = distribution(random);
+			}
+		}
+
+		const Matrix4x4 product = Matrix4x4::Multiply(a, b);
+		const Matrix4x4 productScalar = Matrix4x4::MultiplyScalar(a, b);
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				maxMultiplyError = std::max(maxMultiplyError, static_cast<double>(std::fabs(product.m[i][j] - productScalar.m[i][j])));
+			}
+		}
+
+		const double residual = InverseResidual(a, Matrix4x4::Inverse(a));
+		const double residualScalar = InverseResidual(a, InverseScalar(a));
+		if (!(residual <= residualScalar * 4.0 + 1.0e-5)) {
+			++inverseFailures;
+		}
+		maxResidual = std::max(maxResidual, residual);
+		maxResidualScalar = std::max(maxResidualScalar, residualScalar);
+	}
+
+	// 定数式（スカラー実装）と実行時（SIMD 実装）の行列積が一致する
+	constexpr Matrix4x4 kProduct = kM * Matrix4x4::Transpose(kM);
+	volatile float runtimeScale = 1.0f;
+	Matrix4x4 m = kM;
+	m.m[0][0] *= runtimeScale;
+	const Matrix4x4 runtimeProduct = m * Matrix4x4::Transpose(kM);
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			maxMultiplyError = std::max(maxMultiplyError, static_cast<double>(std::fabs(runtimeProduct.m[i][j] - kProduct.m[i][j])));
+		}
+	}
+
+	// アフィン行列は逆行列を掛けると単位行列に戻る
+	const Matrix4x4 affine = Matrix4x4::Multiply(Matrix4x4::MakeRotateYMatrix(0.7f), Matrix4x4::MakeTranslateMatrix({ 1.0f, 2.0f, 3.0f }));
+	const double identityError = InverseResidual(affine, Matrix4x4::Inverse(affine));
+
+	std::printf("multiply max error %g\n", maxMultiplyError);
+	std::printf("inverse max residual %g (scalar %g), worse than scalar: %d\n", maxResidual, maxResidualScalar, inverseFailures);
+	std::printf("affine inverse residual %g\n", identityError);
+	const bool passed = maxMultiplyError < 1.0e-4 && inverseFailures == 0 && identityError < 1.0e-5;
+	std::puts(passed ? "PASSED" : "FAILED");
+	return passed ? 0 : 1;
+}
+#endif
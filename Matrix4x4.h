@@ -1,17 +1,74 @@
 #pragma once
 #include <cmath>
+#include <type_traits>
 #include "Vector3.h"
 
 class Matrix4x4 {
 public:
 	float m[4][4];
 
-	static Matrix4x4 Add(const Matrix4x4& m1, const Matrix4x4& m2);
-	static Matrix4x4 Subtract(const Matrix4x4& m1, const Matrix4x4& m2);
-	static Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2);
-	static Matrix4x4 Inverse(const Matrix4x4& m);
-	static Matrix4x4 Transpose(const Matrix4x4& m);
-	static Matrix4x4 MakeIdentity4x4();
+	[[nodiscard]] static constexpr Matrix4x4 Add(const Matrix4x4& m1, const Matrix4x4& m2) {
+		Matrix4x4 result = {};
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				result.m[i][j] = m1.m[i][j] + m2.m[i][j];
+			}
+		}
+		return result;
+	}
+
+	[[nodiscard]] static constexpr Matrix4x4 Subtract(const Matrix4x4& m1, const Matrix4x4& m2) {
+		Matrix4x4 result = {};
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				result.m[i][j] = m1.m[i][j] - m2.m[i][j];
+			}
+		}
+		return result;
+	}
+
+	// 定数式ではスカラー実装、実行時は Matrix4x4.cpp の SIMD 実装を使う
+	[[nodiscard]] static constexpr Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2) {
+		if (std::is_constant_evaluated()) {
+			return MultiplyScalar(m1, m2);
+		}
+		return MultiplyRuntime(m1, m2);
+	}
+
+	[[nodiscard]] static Matrix4x4 Inverse(const Matrix4x4& m);
+
+	[[nodiscard]] static constexpr Matrix4x4 Transpose(const Matrix4x4& m) {
+		Matrix4x4 result = {};
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				result.m[i][j] = m.m[j][i];
+			}
+		}
+		return result;
+	}
+
+	[[nodiscard]] static constexpr Matrix4x4 MakeIdentity4x4() {
+		Matrix4x4 result = {};
+		for (int i = 0; i < 4; ++i) {
+			result.m[i][i] = 1.0f;
+		}
+		return result;
+	}
+
+	// スカラー実装の行列積（SIMD が使えない環境と定数式で使う）
+	[[nodiscard]] static constexpr Matrix4x4 MultiplyScalar(const Matrix4x4& m1, const Matrix4x4& m2) {
+		Matrix4x4 result = {};
+		for (int i = 0; i < 4; ++i) {
+			const float a0 = m1.m[i][0];
+			const float a1 = m1.m[i][1];
+			const float a2 = m1.m[i][2];
+			const float a3 = m1.m[i][3];
+			for (int j = 0; j < 4; ++j) {
+				result.m[i][j] = a0 * m2.m[0][j] + a1 * m2.m[1][j] + a2 * m2.m[2][j] + a3 * m2.m[3][j];
+			}
+		}
+		return result;
+	}
 
 	/// <summary>
 	/// 縦方向の視野角、アスペクト比、近接/遠方クリップ平面から透視投影行列を作成します。
@@ -29,7 +86,7 @@ public:
 	/// <summary>
 	/// スケーリング、回転、平行移動を組み合わせたアフィン変換行列を作成します。
 	/// </summary>
-	static Matrix4x4 MakeTranslateMatrix(const Vector3& translation) {
+	[[nodiscard]] static constexpr Matrix4x4 MakeTranslateMatrix(const Vector3& translation) {
 		Matrix4x4 result = MakeIdentity4x4();
 		result.m[0][3] = translation.x;
 		result.m[1][3] = translation.y;
@@ -37,7 +94,7 @@ public:
 		return result;
 	}
 
-	static Matrix4x4 MakeScaleMatrix(const Vector3& scale) {
+	[[nodiscard]] static constexpr Matrix4x4 MakeScaleMatrix(const Vector3& scale) {
 		Matrix4x4 result = MakeIdentity4x4();
 		result.m[0][0] = scale.x;
 		result.m[1][1] = scale.y;
@@ -79,12 +136,37 @@ public:
 	}
 
 private:
-	static float Determinant3x3(
-		float a00, float a01, float a02,
-		float a10, float a11, float a12,
-		float a20, float a21, float a22);
-	static float Determinant4x4(const Matrix4x4& m);
+	// 実行時の行列積（SIMD の有無で切り替える）
+	static Matrix4x4 MultiplyRuntime(const Matrix4x4& m1, const Matrix4x4& m2);
 };
 
+[[nodiscard]] constexpr Matrix4x4 operator+(const Matrix4x4& m1, const Matrix4x4& m2) { return Matrix4x4::Add(m1, m2); }
+[[nodiscard]] constexpr Matrix4x4 operator-(const Matrix4x4& m1, const Matrix4x4& m2) { return Matrix4x4::Subtract(m1, m2); }
+[[nodiscard]] constexpr Matrix4x4 operator*(const Matrix4x4& m1, const Matrix4x4& m2) { return Matrix4x4::Multiply(m1, m2); }
+
+// Vector3 の行列変換（Matrix4x4 の定義が必要なためここに置く）
+constexpr Vector3 Vector3::Transform(const Vector3& vector, const Matrix4x4& matrix) {
+	Vector3 result = {
+		vector.x * matrix.m[0][0] + vector.y * matrix.m[1][0] + vector.z * matrix.m[2][0] + matrix.m[3][0],
+		vector.x * matrix.m[0][1] + vector.y * matrix.m[1][1] + vector.z * matrix.m[2][1] + matrix.m[3][1],
+		vector.x * matrix.m[0][2] + vector.y * matrix.m[1][2] + vector.z * matrix.m[2][2] + matrix.m[3][2],
+	};
+	const float w = vector.x * matrix.m[0][3] + vector.y * matrix.m[1][3] + vector.z * matrix.m[2][3] + matrix.m[3][3];
+	if (w != 0.0f) {
+		result.x /= w;
+		result.y /= w;
+		result.z /= w;
+	}
+	return result;
+}
+
+constexpr Vector3 Vector3::ViewportTransform(const Vector3& ndc, const Matrix4x4& viewportMatrix) {
+	return {
+		ndc.x * viewportMatrix.m[0][0] + ndc.y * viewportMatrix.m[1][0] + ndc.z * viewportMatrix.m[2][0] + viewportMatrix.m[3][0],
+		ndc.x * viewportMatrix.m[0][1] + ndc.y * viewportMatrix.m[1][1] + ndc.z * viewportMatrix.m[2][1] + viewportMatrix.m[3][1],
+		ndc.x * viewportMatrix.m[0][2] + ndc.y * viewportMatrix.m[1][2] + ndc.z * viewportMatrix.m[2][2] + viewportMatrix.m[3][2],
+	};
+}
+
 #pragma endregion
 
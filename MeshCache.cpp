@@ -0,0 +1,624 @@
+#include "MeshCache.h"
+#include "Fnv1a.h"
+#include "LoadObjFile.h"
+#include "Logger.h"
+#include "MappedFile.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "MeshletBuilder.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+std::string MeshCache::cacheDirectory_ = "resources/.meshcache";
+
+static_assert(std::is_trivially_copyable_v<Meshlet> && sizeof(Meshlet) == 64, "Meshlet はそのままキャッシュに書き出すので隙間なく並んでいる必要がある");
+
+namespace {
+
+using Fnv1a::HashString;
+using Fnv1a::HashValue;
+
+// 行頭の "mtllib <name>" を列挙する（LoadObjFile と同じく同一ディレクトリの MTL を指す）
+template <typename Func>
+void ForEachMaterialLibrary(std::string_view source, Func&& func) {
+	constexpr std::string_view kKeyword = "mtllib";
+	size_t pos = source.find(kKeyword);
+	while (pos != std::string_view::npos) {
+		const bool atLineStart = pos == 0 || source[pos - 1] == '\n';
+		size_t lineEnd = source.find('\n', pos);
+		if (lineEnd == std::string_view::npos) {
+			lineEnd = source.size();
+		}
+		if (atLineStart) {
+			std::string_view rest = source.substr(pos + kKeyword.size(), lineEnd - pos - kKeyword.size());
+			const size_t first = rest.find_first_not_of(" \t");
+			if (first != std::string_view::npos) {
+				rest.remove_prefix(first);
+				rest = rest.substr(0, rest.find_first_of(" \t\r"));
+				func(rest);
+			}
+		}
+		pos = source.find(kKeyword, lineEnd);
+	}
+}
+
+// 表の書き出し（固定長の値と長さ付き文字列を詰めていく）
+void AppendValue(std::string& table, uint32_t value) {
+	table.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void AppendValue(std::string& table, float value) {
+	table.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void AppendVector(std::string& table, const Vector3& value) {
+	AppendValue(table, value.x);
+	AppendValue(table, value.y);
+	AppendValue(table, value.z);
+}
+
+// 要素数 + 中身をそのまま（Meshlet のような隙間の無い構造体の配列用）
+template <typename T>
+void AppendArray(std::string& table, const std::vector<T>& values) {
+	AppendValue(table, static_cast<uint32_t>(values.size()));
+	table.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+void AppendString(std::string& table, const std::string& text) {
+	AppendValue(table, static_cast<uint32_t>(text.size()));
+	table.append(text);
+}
+
+void AppendMaterial(std::string& table, const MaterialData& material) {
+	AppendString(table, material.name);
+	AppendString(table, material.textureFilePath);
+}
+
+// 表の読み込み（範囲外を読もうとしたら以降すべて失敗にする）
+class TableReader {
+public:
+	explicit TableReader(std::string_view table) : table_(table) {}
+
+	bool Read(uint32_t& value) {
+		if (table_.size() < sizeof(value)) {
+			return Fail();
+		}
+		std::memcpy(&value, table_.data(), sizeof(value));
+		table_.remove_prefix(sizeof(value));
+		return true;
+	}
+
+	bool Read(float& value) {
+		uint32_t bits = 0;
+		if (!Read(bits)) {
+			return false;
+		}
+		std::memcpy(&value, &bits, sizeof(value));
+		return true;
+	}
+
+	bool Read(Vector3& value) {
+		return Read(value.x) && Read(value.y) && Read(value.z);
+	}
+
+	bool Read(std::string& text) {
+		uint32_t length = 0;
+		if (!Read(length) || table_.size() < length) {
+			return Fail();
+		}
+		text.assign(table_.data(), length);
+		table_.remove_prefix(length);
+		return true;
+	}
+
+	template <typename T>
+	bool Read(std::vector<T>& values) {
+		uint32_t count = 0;
+		if (!Read(count) || table_.size() / sizeof(T) < count) {
+			return Fail();
+		}
+		values.resize(count);
+		std::memcpy(values.data(), table_.data(), count * sizeof(T));
+		table_.remove_prefix(count * sizeof(T));
+		return true;
+	}
+
+	bool Read(MaterialData& material) {
+		return Read(material.name) && Read(material.textureFilePath);
+	}
+
+	// すべて読めて、余りも無いか
+	bool IsComplete() const { return ok_ && table_.empty(); }
+
+private:
+	bool Fail() {
+		ok_ = false;
+		table_ = {};
+		return false;
+	}
+
+	std::string_view table_;
+	bool ok_ = true;
+};
+
+} // namespace
+
+// ===================================
+// キャッシュ置き場
+// ===================================
+void MeshCache::SetCacheDirectory(const std::string& cacheDirectory) {
+	cacheDirectory_ = cacheDirectory;
+}
+
+const std::string& MeshCache::GetCacheDirectory() {
+	return cacheDirectory_;
+}
+
+std::string MeshCache::GetCachePath(uint64_t sourceHash) {
+	char name[32];
+	std::snprintf(name, sizeof(name), "%016llx.tmesh", static_cast<unsigned long long>(sourceHash));
+	return cacheDirectory_ + "/" + name;
+}
+
+// ===================================
+// キャッシュキー
+// ===================================
+uint64_t MeshCache::ComputeSourceHash(const std::string& directoryPath, const std::string& fileName, bool optimize) {
+	MappedFile objFile;
+	if (!objFile.Open(directoryPath + "/" + fileName)) {
+		return 0;
+	}
+
+	uint64_t hash = Fnv1a::kOffsetBasis;
+	hash = HashValue(hash, (static_cast<uint64_t>(kFormatVersion) << 32) | kLoaderVersion);
+	hash = HashValue(hash, optimize ? 1 : 0);
+	// テクスチャパスにディレクトリ名が入るので、同じ内容でも置き場所が違えば別キャッシュ
+	hash = HashString(hash, directoryPath);
+	hash = HashString(hash, objFile.GetView());
+
+	ForEachMaterialLibrary(objFile.GetView(), [&](std::string_view materialFileName) {
+		hash = HashString(hash, materialFileName);
+		MappedFile materialFile;
+		if (materialFile.Open(directoryPath + "/" + std::string(materialFileName))) {
+			hash = HashString(hash, materialFile.GetView());
+		}
+	});
+
+	// 0 は「読めなかった」に使うので避ける
+	return hash != 0 ? hash : 1;
+}
+
+// ===================================
+// 読み込み（メモリマップしてコピーするだけ）
+// ===================================
+bool MeshCache::TryRead(const std::string& cachePath, uint64_t sourceHash, ModelData& modelData) {
+	MappedFile file;
+	if (!file.Open(cachePath) || file.GetSize() < sizeof(Header)) {
+		return false;
+	}
+
+	Header header;
+	std::memcpy(&header, file.GetData(), sizeof(header));
+	if (header.magic != kMagic ||
+		header.formatVersion != kFormatVersion ||
+		header.sourceHash != sourceHash ||
+		header.vertexStride != sizeof(VertexData)) {
+		return false;
+	}
+
+	const size_t vertexBytes = static_cast<size_t>(header.vertexCount) * sizeof(VertexData);
+	const size_t indexBytes = static_cast<size_t>(header.indexCount) * sizeof(uint32_t);
+	if (file.GetSize() != sizeof(Header) + vertexBytes + indexBytes + header.tableSize) {
+		// 書き込み途中で落ちた等の壊れたファイル
+		return false;
+	}
+
+	const char* p = file.GetData() + sizeof(Header);
+	modelData.vertices.resize(header.vertexCount);
+	std::memcpy(modelData.vertices.data(), p, vertexBytes);
+	p += vertexBytes;
+
+	modelData.indices.resize(header.indexCount);
+	std::memcpy(modelData.indices.data(), p, indexBytes);
+	p += indexBytes;
+	// 範囲外のインデックスは CPU（IsTexcoordInUnitRange など）でも GPU でも頂点配列の外を読む
+	for (uint32_t index : modelData.indices) {
+		if (index >= header.vertexCount) {
+			return false;
+		}
+	}
+
+	TableReader table({ p, header.tableSize });
+	table.Read(modelData.material);
+	modelData.materials.resize(header.materialCount);
+	for (MaterialData& material : modelData.materials) {
+		table.Read(material);
+	}
+	modelData.subMeshes.resize(header.subMeshCount);
+	for (SubMesh& subMesh : modelData.subMeshes) {
+		table.Read(subMesh.indexOffset);
+		table.Read(subMesh.indexCount);
+		table.Read(subMesh.materialIndex);
+		table.Read(subMesh.name);
+		if (static_cast<uint64_t>(subMesh.indexOffset) + subMesh.indexCount > header.indexCount ||
+			subMesh.materialIndex >= header.materialCount) {
+			return false;
+		}
+	}
+	modelData.lods.resize(header.lodCount);
+	for (MeshLod& lod : modelData.lods) {
+		table.Read(lod.subMeshOffset);
+		table.Read(lod.subMeshCount);
+		table.Read(lod.indexCount);
+		table.Read(lod.error);
+		if (static_cast<uint64_t>(lod.subMeshOffset) + lod.subMeshCount > header.subMeshCount) {
+			return false;
+		}
+	}
+	table.Read(modelData.bounds.min);
+	table.Read(modelData.bounds.max);
+	table.Read(modelData.boundingSphere.center);
+	table.Read(modelData.boundingSphere.radius);
+	table.Read(modelData.meshlets);
+	table.Read(modelData.meshletVertices);
+	table.Read(modelData.meshletTriangles);
+	for (const Meshlet& meshlet : modelData.meshlets) {
+		if (static_cast<uint64_t>(meshlet.vertexOffset) + meshlet.vertexCount > modelData.meshletVertices.size() ||
+			static_cast<uint64_t>(meshlet.triangleOffset) + meshlet.triangleCount * 3ull > modelData.meshletTriangles.size()) {
+			return false;
+		}
+		// 三角形は meshlet 内の頂点番号で持つ
+		for (uint32_t i = 0; i < meshlet.triangleCount * 3u; ++i) {
+			if (modelData.meshletTriangles[meshlet.triangleOffset + i] >= meshlet.vertexCount) {
+				return false;
+			}
+		}
+	}
+	for (uint32_t vertex : modelData.meshletVertices) {
+		if (vertex >= header.vertexCount) {
+			return false;
+		}
+	}
+	return table.IsComplete();
+}
+
+// ===================================
+// 書き出し（一時ファイルに書いてから置き換える）
+// ===================================
+bool MeshCache::Write(const std::string& cachePath, uint64_t sourceHash, const ModelData& modelData) {
+	std::error_code error;
+	const std::filesystem::path path(cachePath);
+	std::filesystem::create_directories(path.parent_path(), error);
+
+	std::string table;
+	AppendMaterial(table, modelData.material);
+	for (const MaterialData& material : modelData.materials) {
+		AppendMaterial(table, material);
+	}
+	for (const SubMesh& subMesh : modelData.subMeshes) {
+		AppendValue(table, subMesh.indexOffset);
+		AppendValue(table, subMesh.indexCount);
+		AppendValue(table, subMesh.materialIndex);
+		AppendString(table, subMesh.name);
+	}
+	for (const MeshLod& lod : modelData.lods) {
+		AppendValue(table, lod.subMeshOffset);
+		AppendValue(table, lod.subMeshCount);
+		AppendValue(table, lod.indexCount);
+		AppendValue(table, lod.error);
+	}
+	AppendVector(table, modelData.bounds.min);
+	AppendVector(table, modelData.bounds.max);
+	AppendVector(table, modelData.boundingSphere.center);
+	AppendValue(table, modelData.boundingSphere.radius);
+	AppendArray(table, modelData.meshlets);
+	AppendArray(table, modelData.meshletVertices);
+	AppendArray(table, modelData.meshletTriangles);
+
+	Header header{};
+	header.magic = kMagic;
+	header.formatVersion = kFormatVersion;
+	header.sourceHash = sourceHash;
+	header.vertexStride = sizeof(VertexData);
+	header.vertexCount = static_cast<uint32_t>(modelData.vertices.size());
+	header.indexCount = static_cast<uint32_t>(modelData.indices.size());
+	header.materialCount = static_cast<uint32_t>(modelData.materials.size());
+	header.subMeshCount = static_cast<uint32_t>(modelData.subMeshes.size());
+	header.lodCount = static_cast<uint32_t>(modelData.lods.size());
+	header.tableSize = static_cast<uint32_t>(table.size());
+
+	std::filesystem::path temporaryPath = path;
+	temporaryPath += ".tmp";
+	{
+		std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+		if (!stream) {
+			return false;
+		}
+		stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		stream.write(reinterpret_cast<const char*>(modelData.vertices.data()),
+			static_cast<std::streamsize>(modelData.vertices.size() * sizeof(VertexData)));
+		stream.write(reinterpret_cast<const char*>(modelData.indices.data()),
+			static_cast<std::streamsize>(modelData.indices.size() * sizeof(uint32_t)));
+		stream.write(table.data(), static_cast<std::streamsize>(table.size()));
+		if (!stream) {
+			stream.close();
+			std::filesystem::remove(temporaryPath, error);
+			return false;
+		}
+	}
+
+	std::filesystem::rename(temporaryPath, path, error);
+	if (error) {
+		std::filesystem::remove(temporaryPath, error);
+		return false;
+	}
+	return true;
+}
+
+// ===================================
+// キャッシュが無いときの構築
+// ===================================
+ModelData MeshCache::Build(const std::string& directoryPath, const std::string& fileName, bool optimize) {
+	ModelData modelData = LoadObjFile(directoryPath, fileName);
+	// LOD は最適化の前に作る（LOD の区間も含めて頂点の並べ替えをかけるため）
+	MeshSimplifier::GenerateLods(modelData);
+	Log("MeshCache: " + directoryPath + "/" + fileName + " " + MeshSimplifier::ToString(modelData) + "\n");
+	if (optimize) {
+		const MeshOptimizeResult result = MeshOptimizer::Optimize(modelData);
+		Log("MeshCache: " + directoryPath + "/" + fileName + " " + MeshOptimizer::ToString(result) + "\n");
+	}
+	// 頂点番号を使うので並べ替えの後に作る
+	MeshletBuilder::Build(modelData);
+	Log("MeshCache: " + directoryPath + "/" + fileName + " " + MeshletBuilder::ToString(modelData) + "\n");
+	return modelData;
+}
+
+// ===================================
+// キャッシュ経由の読み込み
+// ===================================
+ModelData MeshCache::Load(const std::string& directoryPath, const std::string& fileName, bool optimize) {
+	const uint64_t sourceHash = ComputeSourceHash(directoryPath, fileName, optimize);
+	if (sourceHash == 0) {
+		// 元ファイルが無い（LoadObjFile 側で assert させる）
+		return LoadObjFile(directoryPath, fileName);
+	}
+
+	const std::string cachePath = GetCachePath(sourceHash);
+	ModelData modelData;
+	if (TryRead(cachePath, sourceHash, modelData)) {
+		return modelData;
+	}
+
+	modelData = Build(directoryPath, fileName, optimize);
+	// 書けなくても（読み取り専用の場所など）次回また解析するだけなので無視する
+	Write(cachePath, sourceHash, modelData);
+	return modelData;
+}
+
+// ===================================
+// 事前ビルド
+// ===================================
+size_t MeshCache::Prebuild(const std::string& rootDirectory, bool optimize) {
+	size_t builtCount = 0;
+	std::error_code error;
+	for (std::filesystem::recursive_directory_iterator it(rootDirectory, error), last; !error && it != last; it.increment(error)) {
+		const std::filesystem::path& path = it->path();
+		if (!it->is_regular_file(error) || path.extension() != ".obj") {
+			continue;
+		}
+
+		const std::string directoryPath = path.parent_path().generic_string();
+		const std::string fileName = path.filename().generic_string();
+		const uint64_t sourceHash = ComputeSourceHash(directoryPath, fileName, optimize);
+		if (sourceHash == 0) {
+			continue;
+		}
+		// 名前がキーなので、あれば作り直さない（壊れていれば Load 時に書き直される）
+		const std::string cachePath = GetCachePath(sourceHash);
+		if (std::filesystem::exists(cachePath, error)) {
+			continue;
+		}
+		if (Write(cachePath, sourceHash, Build(directoryPath, fileName, optimize))) {
+			++builtCount;
+		}
+	}
+	return builtCount;
+}
+
+#if defined(TOMO_MESH_CACHE_TOOL_MAIN)
+// 使い方: meshcache [リソースのルート] [キャッシュ置き場]
+int main(int argc, char** argv) {
+	const std::string root = argc > 1 ? argv[1] : "resources";
+	if (argc > 2) {
+		MeshCache::SetCacheDirectory(argv[2]);
+	}
+	const size_t builtCount = MeshCache::Prebuild(root);
+	std::printf("%zu mesh cache file(s) written to %s\n", builtCount, MeshCache::GetCacheDirectory().c_str());
+	return 0;
+}
+#endif
+
+#if defined(TOMO_MESH_CACHE_TEST_MAIN)
+namespace {
+
+// 2 マテリアル・2 オブジェクトの格子（n x n 個の四角形を 2 枚）を OBJ + MTL として書く
+void WriteTestObj(const std::filesystem::path& directory, uint32_t n) {
+	std::ofstream material(directory / "grid.mtl");
+	material << "newmtl red\nmap_Kd red.png\nnewmtl blue\nmap_Kd blue.png\n";
+
+	std::ofstream obj(directory / "grid.obj");
+	obj << "mtllib grid.mtl\n";
+	for (uint32_t plane = 0; plane < 2; ++plane) {
+		for (uint32_t y = 0; y <= n; ++y) {
+			for (uint32_t x = 0; x <= n; ++x) {
+				obj << "v " << x << " " << y << " " << (plane * 2.0f + 0.05f * static_cast<float>((x * 7 + y * 3) % 5)) << "\n";
+				obj << "vt " << static_cast<float>(x) / n << " " << static_cast<float>(y) / n << "\n";
+			}
+		}
+	}
+	obj << "vn 0 0 1\n";
+	const uint32_t rowLength = n + 1;
+	for (uint32_t plane = 0; plane < 2; ++plane) {
+		obj << "o plane" << plane << "\nusemtl " << (plane == 0 ? "red" : "blue") << "\n";
+		const uint32_t base = plane * rowLength * rowLength + 1;
+		for (uint32_t y = 0; y < n; ++y) {
+			for (uint32_t x = 0; x < n; ++x) {
+				const uint32_t a = base + y * rowLength + x;
+				const uint32_t b = a + 1;
+				const uint32_t c = a + rowLength + 1;
+				const uint32_t d = a + rowLength;
+				obj << "f " << a << "/" << a << "/1 " << b << "/" << b << "/1 " << c << "/" << c << "/1 " << d << "/" << d << "/1\n";
+			}
+		}
+	}
+}
+
+bool SameMaterial(const MaterialData& a, const MaterialData& b) {
+	return a.name == b.name && a.textureFilePath == b.textureFilePath;
+}
+
+// 頂点・インデックス・区間・マテリアル・LOD・meshlet が一致するか
+bool SameModel(const ModelData& a, const ModelData& b) {
+	if (a.vertices.size() != b.vertices.size() || a.indices != b.indices ||
+		a.subMeshes.size() != b.subMeshes.size() || a.materials.size() != b.materials.size() ||
+		a.lods.size() != b.lods.size() || a.meshlets.size() != b.meshlets.size() ||
+		a.meshletVertices != b.meshletVertices || a.meshletTriangles != b.meshletTriangles ||
+		!SameMaterial(a.material, b.material)) {
+		return false;
+	}
+	if (std::memcmp(a.vertices.data(), b.vertices.data(), a.vertices.size() * sizeof(VertexData)) != 0 ||
+		std::memcmp(a.meshlets.data(), b.meshlets.data(), a.meshlets.size() * sizeof(Meshlet)) != 0) {
+		return false;
+	}
+	for (size_t i = 0; i < a.subMeshes.size(); ++i) {
+		const SubMesh& x = a.subMeshes[i];
+		const SubMesh& y = b.subMeshes[i];
+		if (x.name != y.name || x.indexOffset != y.indexOffset || x.indexCount != y.indexCount || x.materialIndex != y.materialIndex) {
+			return false;
+		}
+	}
+	for (size_t i = 0; i < a.materials.size(); ++i) {
+		if (!SameMaterial(a.materials[i], b.materials[i])) {
+			return false;
+		}
+	}
+	for (size_t i = 0; i < a.lods.size(); ++i) {
+		const MeshLod& x = a.lods[i];
+		const MeshLod& y = b.lods[i];
+		if (x.subMeshOffset != y.subMeshOffset || x.subMeshCount != y.subMeshCount || x.indexCount != y.indexCount || x.error != y.error) {
+			return false;
+		}
+	}
+	return std::memcmp(&a.bounds, &b.bounds, sizeof(AABB)) == 0 &&
+		std::memcmp(&a.boundingSphere, &b.boundingSphere, sizeof(BoundingSphere)) == 0;
+}
+
+// path の中身を書き換えたコピーを作る
+bool WriteModified(const std::string& sourcePath, const std::string& path, const std::function<void(std::string&)>& modify) {
+	std::ifstream input(sourcePath, std::ios::binary);
+	std::string bytes((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+	modify(bytes);
+	std::ofstream output(path, std::ios::binary | std::ios::trunc);
+	output.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+	return static_cast<bool>(output);
+}
+
+}
+
+// .tmesh の書き出し → 読み戻しで LoadObjFile の結果がそのまま戻ること、Load の 2 回目（キャッシュ）が 1 回目（構築）と同じこと、
+// 壊れたファイルを読まないことを確かめる。一時ディレクトリに OBJ を書いて使う
+int main() {
+	const std::filesystem::path directory = std::filesystem::temp_directory_path() / "tomo_mesh_cache_test";
+	std::error_code error;
+	std::filesystem::remove_all(directory, error);
+	std::filesystem::create_directories(directory);
+	WriteTestObj(directory, 16);
+	MeshCache::SetCacheDirectory((directory / "cache").generic_string());
+
+	int failureCount = 0;
+	auto check = [&](bool condition, const char* name) {
+		std::printf("%-48s %s\n", name, condition ? "ok" : "NG");
+		failureCount += condition ? 0 : 1;
+	};
+
+	// ================================
+	// 1.LoadObjFile の結果の書き出しと読み戻し
+	// ================================
+	const std::string directoryPath = directory.generic_string();
+	const ModelData source = LoadObjFile(directoryPath, "grid.obj");
+	check(source.vertices.size() == 2 * 17 * 17 && source.indices.size() == 2 * 16 * 16 * 6 && source.subMeshes.size() == 2,
+		"LoadObjFile reads the test grid");
+
+	const uint64_t sourceHash = MeshCache::ComputeSourceHash(directoryPath, "grid.obj", false);
+	const std::string cachePath = (directory / "grid.tmesh").generic_string();
+	check(sourceHash != 0 && MeshCache::Write(cachePath, sourceHash, source), "Write");
+	ModelData readBack;
+	check(MeshCache::TryRead(cachePath, sourceHash, readBack), "TryRead");
+	check(SameModel(source, readBack), "read back == LoadObjFile output");
+
+	// ================================
+	// 2.Load（1 回目は構築して書き出し、2 回目はキャッシュから）
+	// ================================
+	for (bool optimize : { false, true }) {
+		const ModelData built = MeshCache::Load(directoryPath, "grid.obj", optimize);
+		const std::string path = MeshCache::GetCachePath(MeshCache::ComputeSourceHash(directoryPath, "grid.obj", optimize));
+		check(std::filesystem::exists(path, error), optimize ? "Load(optimize) writes the cache" : "Load writes the cache");
+		const ModelData cached = MeshCache::Load(directoryPath, "grid.obj", optimize);
+		check(SameModel(built, cached), optimize ? "Load(optimize): cached == built" : "Load: cached == built");
+	}
+
+	// ================================
+	// 3.壊れたファイル・合わないファイルは読まない
+	// ================================
+	const std::string brokenPath = (directory / "broken.tmesh").generic_string();
+	ModelData broken;
+	check(!MeshCache::TryRead(cachePath, sourceHash + 1, broken), "rejects a different source hash");
+	check(WriteModified(cachePath, brokenPath, [](std::string& bytes) { bytes.resize(bytes.size() - 1); }) &&
+		!MeshCache::TryRead(brokenPath, sourceHash, broken), "rejects a truncated file (1 byte short)");
+	check(WriteModified(cachePath, brokenPath, [](std::string& bytes) { bytes.resize(sizeof(MeshCache::Header) / 2); }) &&
+		!MeshCache::TryRead(brokenPath, sourceHash, broken), "rejects a truncated header");
+	check(WriteModified(cachePath, brokenPath, [](std::string& bytes) { bytes[0] ^= 0x01; }) &&
+		!MeshCache::TryRead(brokenPath, sourceHash, broken), "rejects a corrupted magic");
+	check(WriteModified(cachePath, brokenPath, [](std::string& bytes) { bytes += '\0'; }) &&
+		!MeshCache::TryRead(brokenPath, sourceHash, broken), "rejects trailing bytes");
+	// 先頭の区間の indexOffset（表の中、マテリアルの後ろ）を範囲外にする
+	check(WriteModified(cachePath, brokenPath, [&](std::string& bytes) {
+		size_t offset = sizeof(MeshCache::Header) + source.vertices.size() * sizeof(VertexData) + source.indices.size() * sizeof(uint32_t);
+		for (size_t i = 0; i < 1 + source.materials.size(); ++i) {
+			for (int field = 0; field < 2; ++field) {
+				uint32_t length;
+				std::memcpy(&length, bytes.data() + offset, sizeof(length));
+				offset += sizeof(length) + length;
+			}
+		}
+		const uint32_t outOfRange = 0xFFFFFF00u;
+		std::memcpy(bytes.data() + offset, &outOfRange, sizeof(outOfRange));
+	}) && !MeshCache::TryRead(brokenPath, sourceHash, broken), "rejects an out-of-range sub-mesh");
+	// 頂点数ちょうど（1 つ外）のインデックス
+	check(WriteModified(cachePath, brokenPath, [&](std::string& bytes) {
+		const uint32_t outOfRange = static_cast<uint32_t>(source.vertices.size());
+		std::memcpy(bytes.data() + sizeof(MeshCache::Header) + source.vertices.size() * sizeof(VertexData) + 5 * sizeof(uint32_t),
+			&outOfRange, sizeof(outOfRange));
+	}) && !MeshCache::TryRead(brokenPath, sourceHash, broken), "rejects an out-of-range index");
+	// meshlet 内の頂点番号（meshletTriangles は表の最後なので、ファイルの最後のバイト）
+	{
+		const uint64_t meshletHash = MeshCache::ComputeSourceHash(directoryPath, "grid.obj", false);
+		const std::string meshletPath = MeshCache::GetCachePath(meshletHash);
+		ModelData withMeshlets;
+		check(MeshCache::TryRead(meshletPath, meshletHash, withMeshlets) && !withMeshlets.meshlets.empty() &&
+			WriteModified(meshletPath, brokenPath, [](std::string& bytes) { bytes.back() = static_cast<char>(0xFF); }) &&
+			!MeshCache::TryRead(brokenPath, meshletHash, broken), "rejects an out-of-range meshlet triangle");
+	}
+
+	std::filesystem::remove_all(directory, error);
+	std::puts(failureCount == 0 ? "PASSED" : "FAILED");
+	return failureCount == 0 ? 0 : 1;
+}
+#endif
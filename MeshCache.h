@@ -0,0 +1,68 @@
+#pragma once
+#include "ModelData.h"
+#include <cstdint>
+#include <string>
+
+// ==================================
+// OBJ のバイナリメッシュキャッシュ
+// ==================================
+// 初回読み込み時に LoadObjFile の結果（と MeshSimplifier の LOD、MeshOptimizer の並べ替え、MeshletBuilder の meshlet）を .tmesh として書き出し、
+// 2 回目以降はメモリマップして頂点・インデックスをそのまま取り出す（テキスト解析も簡略化も最適化もなし）。
+//
+// キャッシュのキーは「OBJ と参照している MTL の内容ハッシュ + ローダーバージョン + 最適化の有無」。
+// ファイル名がキーそのものなので、元ファイルが変われば自動的に別のキャッシュになる。
+// LoadObjFile / MeshSimplifier / MeshOptimizer / MeshletBuilder の出力が変わる修正を入れたら kLoaderVersion を上げること。
+//
+// 事前ビルド用の実行ファイルにする場合は TOMO_MESH_CACHE_TOOL_MAIN を定義してビルドする。
+//   g++ -std=c++20 -O2 -pthread -DTOMO_MESH_CACHE_TOOL_MAIN MeshCache.cpp MeshSimplifier.cpp MeshOptimizer.cpp MeshletBuilder.cpp BoundingVolume.cpp Affine3x4.cpp Matrix4x4.cpp Quaternion.cpp LoadObjFile.cpp LoadMaterialTemplateFile.cpp MappedFile.cpp Logger.cpp
+//   （CMakeLists.txt の mesh_cache_tool ターゲットでも同じものができる）
+class MeshCache {
+public:
+	// .tmesh のバイナリレイアウト（ヘッダ → 頂点 → インデックス → 表）
+	// 表 : material、materials、subMeshes、lods、境界（AABB と球）、meshlet の順。文字列は「uint32 の長さ + 終端なしのバイト列」
+	static constexpr uint32_t kMagic = 0x48534D54; // 'TMSH'
+	static constexpr uint32_t kFormatVersion = 5;
+	// LoadObjFile / MeshSimplifier / MeshOptimizer / MeshletBuilder の出力の版（出力が変わったら上げる）
+	static constexpr uint32_t kLoaderVersion = 5;
+
+	struct Header {
+		uint32_t magic;
+		uint32_t formatVersion;
+		uint64_t sourceHash;        // OBJ + MTL + ローダーバージョン + 設定のハッシュ
+		uint32_t vertexStride;      // sizeof(VertexData)
+		uint32_t vertexCount;
+		uint32_t indexCount;
+		uint32_t materialCount;
+		uint32_t subMeshCount;
+		uint32_t lodCount;
+		uint32_t tableSize;         // 表のバイト数
+		uint32_t reserved;          // 0（8 バイト境界に揃える）
+	};
+	static_assert(sizeof(Header) == 48, "MeshCache::Header layout changed");
+
+	// キャッシュがあればそれを、無ければ OBJ を読んでキャッシュを書き出して返す
+	// optimize : 頂点キャッシュ向けに三角形と頂点を並べ替える（結果ごとキャッシュされる）
+	static ModelData Load(const std::string& directoryPath, const std::string& fileName, bool optimize = true);
+
+	// rootDirectory 以下の全 .obj のキャッシュを作る。新しく書き出した数を返す
+	static size_t Prebuild(const std::string& rootDirectory, bool optimize = true);
+
+	// キャッシュの置き場所（既定は "resources/.meshcache"）
+	static void SetCacheDirectory(const std::string& cacheDirectory);
+	static const std::string& GetCacheDirectory();
+
+	// 元ファイルの内容と読み込み設定からキャッシュキーを求める（読めなければ 0）
+	static uint64_t ComputeSourceHash(const std::string& directoryPath, const std::string& fileName, bool optimize);
+
+	// 個別の読み書き（Load の中身。失敗したら false）
+	static bool TryRead(const std::string& cachePath, uint64_t sourceHash, ModelData& modelData);
+	static bool Write(const std::string& cachePath, uint64_t sourceHash, const ModelData& modelData);
+
+	static std::string GetCachePath(uint64_t sourceHash);
+
+private:
+	// OBJ を解析して LOD を作り、必要なら最適化し、meshlet に分ける（キャッシュが無いときの処理）
+	static ModelData Build(const std::string& directoryPath, const std::string& fileName, bool optimize);
+
+	static std::string cacheDirectory_;
+};
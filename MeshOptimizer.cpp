@@ -0,0 +1,260 @@
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+namespace {
+
+// ================================
+// Forsyth のスコア関数
+// ================================
+// 最適化のときに想定する LRU キャッシュのサイズ（実機より大きめが良い結果になる）
+constexpr uint32_t kCacheSize = 32;
+constexpr float kCacheDecayPower = 1.5f;
+constexpr float kLastTriangleScore = 0.75f;
+constexpr float kValenceBoostScale = 2.0f;
+constexpr float kValenceBoostPower = 0.5f;
+// 残り三角形数によるスコアはこれ以上で頭打ち
+constexpr uint32_t kMaxValence = 32;
+
+constexpr uint32_t kInvalidTriangle = std::numeric_limits<uint32_t>::max();
+
+struct ScoreTable {
+	std::array<float, kCacheSize> cache;
+	std::array<float, kMaxValence + 1> valence;
+};
+
+ScoreTable MakeScoreTable() {
+	ScoreTable table{};
+	for (uint32_t i = 0; i < kCacheSize; ++i) {
+		// 直前の三角形の頂点は、どれを先に使っても同じなので一律のスコア
+		table.cache[i] = i < 3
+			? kLastTriangleScore
+			: std::pow(1.0f - static_cast<float>(i - 3) / static_cast<float>(kCacheSize - 3), kCacheDecayPower);
+	}
+	table.valence[0] = 0.0f;
+	for (uint32_t i = 1; i <= kMaxValence; ++i) {
+		// 残りの少ない頂点を優先して片付け、後で孤立させない
+		table.valence[i] = kValenceBoostScale * std::pow(static_cast<float>(i), -kValenceBoostPower);
+	}
+	return table;
+}
+
+float VertexScore(const ScoreTable& table, int32_t cachePosition, uint32_t remainingTriangles) {
+	if (remainingTriangles == 0) {
+		return -1.0f; // もう使われない頂点
+	}
+	float score = cachePosition >= 0 ? table.cache[cachePosition] : 0.0f;
+	score += table.valence[std::min(remainingTriangles, kMaxValence)];
+	return score;
+}
+
+}
+
+// ===================================
+// 頂点キャッシュの計測
+// ===================================
+VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(std::span<const uint32_t> indices, size_t vertexCount, uint32_t cacheSize) {
+	VertexCacheStatistics statistics;
+	if (indices.empty() || vertexCount == 0) {
+		return statistics;
+	}
+
+	// FIFO は「最後に入った時刻が直近 cacheSize 回のミス以内か」で判定できる
+	std::vector<uint32_t> insertedAt(vertexCount, 0);
+	uint32_t time = cacheSize + 1;
+	size_t misses = 0;
+	for (uint32_t index : indices) {
+		assert(index < vertexCount);
+		if (time - insertedAt[index] > cacheSize) {
+			insertedAt[index] = time++;
+			++misses;
+		}
+	}
+
+	statistics.acmr = static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+	statistics.atvr = static_cast<float>(misses) / static_cast<float>(vertexCount);
+	return statistics;
+}
+
+// ===================================
+// 三角形の並べ替え（Forsyth, "Linear-Speed Vertex Cache Optimisation"）
+// ===================================
+void MeshOptimizer::OptimizeVertexCache(std::span<uint32_t> indices, size_t vertexCount) {
+	const size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0) {
+		return;
+	}
+	static const ScoreTable kScoreTable = MakeScoreTable();
+
+	// 頂点 → それを使う三角形 の表（前半が未出力の三角形）
+	std::vector<uint32_t> remaining(vertexCount, 0);
+	for (uint32_t index : indices) {
+		assert(index < vertexCount);
+		++remaining[index];
+	}
+	std::vector<uint32_t> offsets(vertexCount + 1, 0);
+	for (size_t v = 0; v < vertexCount; ++v) {
+		offsets[v + 1] = offsets[v] + remaining[v];
+	}
+	std::vector<uint32_t> adjacency(indices.size());
+	{
+		std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+		for (size_t i = 0; i < indices.size(); ++i) {
+			adjacency[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+		}
+	}
+
+	std::vector<int32_t> cachePosition(vertexCount, -1);
+	std::vector<float> vertexScore(vertexCount);
+	for (size_t v = 0; v < vertexCount; ++v) {
+		vertexScore[v] = VertexScore(kScoreTable, -1, remaining[v]);
+	}
+
+	auto triangleScore = [&](size_t t) {
+		return vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+	};
+
+	std::vector<uint8_t> emitted(triangleCount, 0);
+	uint32_t bestTriangle = 0;
+	float bestScore = triangleScore(0);
+	for (size_t t = 1; t < triangleCount; ++t) {
+		const float score = triangleScore(t);
+		if (score > bestScore) {
+			bestScore = score;
+			bestTriangle = static_cast<uint32_t>(t);
+		}
+	}
+
+	std::vector<uint32_t> output(indices.size());
+	// 3 つ多いのは、新しい三角形の頂点を先頭に入れてから溢れた分を追い出すため
+	std::array<uint32_t, kCacheSize + 3> cache;
+	std::array<uint32_t, kCacheSize + 3> newCache;
+	size_t cacheCount = 0;
+	size_t scanCursor = 0;
+
+	for (size_t outputTriangle = 0; outputTriangle < triangleCount; ++outputTriangle) {
+		if (bestTriangle == kInvalidTriangle) {
+			// キャッシュ内の頂点に未出力の三角形が無い：先頭から順に次の三角形を探す
+			while (emitted[scanCursor]) {
+				++scanCursor;
+			}
+			bestTriangle = static_cast<uint32_t>(scanCursor);
+		}
+
+		const uint32_t* triangle = &indices[static_cast<size_t>(bestTriangle) * 3];
+		std::copy(triangle, triangle + 3, &output[outputTriangle * 3]);
+		emitted[bestTriangle] = 1;
+
+		// 出力した三角形を各頂点の未出力リストから外し、新しいキャッシュの先頭に入れる
+		size_t newCacheCount = 0;
+		for (int32_t corner = 0; corner < 3; ++corner) {
+			const uint32_t v = triangle[corner];
+			uint32_t* begin = &adjacency[offsets[v]];
+			uint32_t* end = begin + remaining[v];
+			uint32_t* found = std::find(begin, end, bestTriangle);
+			assert(found != end);
+			std::swap(*found, *(end - 1));
+			--remaining[v];
+
+			if (std::find(newCache.begin(), newCache.begin() + newCacheCount, v) == newCache.begin() + newCacheCount) {
+				newCache[newCacheCount++] = v;
+			}
+		}
+		// 残りは以前のキャッシュの順番のまま後ろに並べる
+		for (size_t i = 0; i < cacheCount; ++i) {
+			const uint32_t v = cache[i];
+			if (v != triangle[0] && v != triangle[1] && v != triangle[2]) {
+				newCache[newCacheCount++] = v;
+			}
+		}
+
+		// 位置とスコアを更新（溢れた頂点はキャッシュ外として扱う）
+		for (size_t i = 0; i < newCacheCount; ++i) {
+			const uint32_t v = newCache[i];
+			cachePosition[v] = i < kCacheSize ? static_cast<int32_t>(i) : -1;
+			vertexScore[v] = VertexScore(kScoreTable, cachePosition[v], remaining[v]);
+		}
+
+		// スコアの変わった頂点を使う三角形だけを見直し、次に出す三角形を選ぶ
+		bestTriangle = kInvalidTriangle;
+		bestScore = -1.0f;
+		for (size_t i = 0; i < newCacheCount; ++i) {
+			const uint32_t v = newCache[i];
+			for (uint32_t k = offsets[v]; k < offsets[v] + remaining[v]; ++k) {
+				const uint32_t t = adjacency[k];
+				const float score = triangleScore(t);
+				if (score > bestScore) {
+					bestScore = score;
+					bestTriangle = t;
+				}
+			}
+		}
+
+		cacheCount = std::min<size_t>(newCacheCount, kCacheSize);
+		std::copy(newCache.begin(), newCache.begin() + cacheCount, cache.begin());
+	}
+
+	std::copy(output.begin(), output.end(), indices.begin());
+}
+
+// ===================================
+// 頂点の並べ替え
+// ===================================
+void MeshOptimizer::OptimizeVertexFetch(std::vector<VertexData>& vertices, std::span<uint32_t> indices) {
+	constexpr uint32_t kUnused = std::numeric_limits<uint32_t>::max();
+	std::vector<uint32_t> remap(vertices.size(), kUnused);
+
+	uint32_t next = 0;
+	for (uint32_t& index : indices) {
+		assert(index < vertices.size());
+		if (remap[index] == kUnused) {
+			remap[index] = next++;
+		}
+		index = remap[index];
+	}
+	for (uint32_t& destination : remap) {
+		if (destination == kUnused) {
+			destination = next++;
+		}
+	}
+
+	std::vector<VertexData> reordered(vertices.size());
+	for (size_t v = 0; v < vertices.size(); ++v) {
+		reordered[remap[v]] = vertices[v];
+	}
+	vertices.swap(reordered);
+}
+
+// ===================================
+// まとめて最適化
+// ===================================
+MeshOptimizeResult MeshOptimizer::Optimize(ModelData& modelData) {
+	MeshOptimizeResult result;
+	if (modelData.indices.empty()) {
+		return result;
+	}
+
+	result.before = AnalyzeVertexCache(modelData.indices, modelData.vertices.size());
+	// 区間（マテリアル）をまたいで並べ替えると描画範囲が壊れるので、区間ごとに行う
+	if (modelData.subMeshes.empty()) {
+		OptimizeVertexCache(modelData.indices, modelData.vertices.size());
+	} else {
+		for (const SubMesh& subMesh : modelData.subMeshes) {
+			OptimizeVertexCache(std::span<uint32_t>(modelData.indices).subspan(subMesh.indexOffset, subMesh.indexCount), modelData.vertices.size());
+		}
+	}
+	OptimizeVertexFetch(modelData.vertices, modelData.indices);
+	result.after = AnalyzeVertexCache(modelData.indices, modelData.vertices.size());
+	return result;
+}
+
+std::string MeshOptimizer::ToString(const MeshOptimizeResult& result) {
+	char text[128];
+	std::snprintf(text, sizeof(text), "ACMR %.3f -> %.3f, ATVR %.3f -> %.3f",
+		result.before.acmr, result.after.acmr, result.before.atvr, result.after.atvr);
+	return text;
+}
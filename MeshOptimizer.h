@@ -0,0 +1,49 @@
+#pragma once
+#include "ModelData.h"
+#include <cstdint>
+#include <span>
+#include <string>
+
+// ==================================
+// 読み込み後のメッシュ最適化
+// ==================================
+// OBJ は書き出したツールの順番のままなので、頂点キャッシュが効くかどうかが運任せになる。
+//   1. 三角形の並べ替え（Forsyth の線形時間アルゴリズム）で変換済み頂点の再利用を増やす
+//   2. 頂点を初めて使われる順に並べ替え、頂点フェッチを連続アクセスにする
+// どちらも描画結果は変わらない（三角形の向きも保つ）。
+
+// 頂点キャッシュの効率
+//   ACMR : 三角形 1 つあたりの頂点シェーダー実行回数（理想 0.5 前後、最悪 3.0）
+//   ATVR : 頂点 1 つあたりの頂点シェーダー実行回数（理想 1.0）
+struct VertexCacheStatistics {
+	float acmr = 0.0f;
+	float atvr = 0.0f;
+};
+
+struct MeshOptimizeResult {
+	VertexCacheStatistics before;
+	VertexCacheStatistics after;
+};
+
+class MeshOptimizer {
+public:
+	// 計測に使う FIFO キャッシュのエントリ数（一般的な GPU の変換後キャッシュ相当）
+	static constexpr uint32_t kAnalyzeCacheSize = 16;
+
+	// 三角形リストを FIFO キャッシュで再生し、ACMR / ATVR を求める
+	static VertexCacheStatistics AnalyzeVertexCache(std::span<const uint32_t> indices, size_t vertexCount, uint32_t cacheSize = kAnalyzeCacheSize);
+
+	// 三角形の順番を頂点キャッシュ向けに並べ替える（インデックスをその場で書き換える）
+	static void OptimizeVertexCache(std::span<uint32_t> indices, size_t vertexCount);
+
+	// 頂点をインデックスで初めて参照される順に並べ替え、インデックスを付け替える
+	// どこからも参照されない頂点は末尾に残す
+	static void OptimizeVertexFetch(std::vector<VertexData>& vertices, std::span<uint32_t> indices);
+
+	// 上の 2 つを順に行い、前後の統計を返す（インデックスが無いモデルは何もしない）
+	// 三角形の並べ替えは SubMesh の区間ごとに行うので、区間の範囲は変わらない
+	static MeshOptimizeResult Optimize(ModelData& modelData);
+
+	// ログ用の 1 行（"ACMR 1.23 -> 0.71, ATVR 2.10 -> 1.22"）
+	static std::string ToString(const MeshOptimizeResult& result);
+};
@@ -0,0 +1,522 @@
+#include "MeshSimplifier.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+
+namespace {
+
+// 平面からの距離の二乗和を表す対称 4x4 行列（上三角だけ保持）
+struct Quadric {
+	double a00 = 0.0, a01 = 0.0, a02 = 0.0, a03 = 0.0;
+	double a11 = 0.0, a12 = 0.0, a13 = 0.0;
+	double a22 = 0.0, a23 = 0.0;
+	double a33 = 0.0;
+	double weight = 0.0; // 足し込んだ面積の合計（誤差を平均の距離に直すため）
+
+	// 平面 nx*x + ny*y + nz*z + d = 0 を重み w で足す
+	void AddPlane(double nx, double ny, double nz, double d, double w) {
+		a00 += w * nx * nx; a01 += w * nx * ny; a02 += w * nx * nz; a03 += w * nx * d;
+		a11 += w * ny * ny; a12 += w * ny * nz; a13 += w * ny * d;
+		a22 += w * nz * nz; a23 += w * nz * d;
+		a33 += w * d * d;
+		weight += w;
+	}
+
+	void Add(const Quadric& q) {
+		a00 += q.a00; a01 += q.a01; a02 += q.a02; a03 += q.a03;
+		a11 += q.a11; a12 += q.a12; a13 += q.a13;
+		a22 += q.a22; a23 += q.a23;
+		a33 += q.a33;
+		weight += q.weight;
+	}
+
+	// 点 p での平均二乗距離
+	double Evaluate(const Vector3& p) const {
+		const double x = p.x, y = p.y, z = p.z;
+		const double r =
+			a00 * x * x + 2.0 * a01 * x * y + 2.0 * a02 * x * z + 2.0 * a03 * x +
+			a11 * y * y + 2.0 * a12 * y * z + 2.0 * a13 * y +
+			a22 * z * z + 2.0 * a23 * z +
+			a33;
+		return weight > 0.0 ? std::max(r, 0.0) / weight : 0.0;
+	}
+};
+
+// 頂点 from を頂点 to の位置へ寄せる候補
+struct Collapse {
+	uint32_t from;
+	uint32_t to;
+	double cost; // 寄せた後の平均二乗距離
+};
+
+Vector3 PositionOf(const VertexData& vertex) {
+	return { vertex.position.x, vertex.position.y, vertex.position.z };
+}
+
+Vector3 NormalOf(const VertexData& vertex) {
+	return { vertex.normal.x, vertex.normal.y, vertex.normal.z };
+}
+
+bool LessPosition(const Vector3& a, const Vector3& b) {
+	if (a.x != b.x) { return a.x < b.x; }
+	if (a.y != b.y) { return a.y < b.y; }
+	return a.z < b.z;
+}
+
+bool SamePosition(const Vector3& a, const Vector3& b) {
+	return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+}
+
+// ===================================
+// 簡略化
+// ===================================
+std::vector<uint32_t> MeshSimplifier::Simplify(
+	std::span<const VertexData> vertices, std::span<const uint32_t> indices,
+	size_t targetIndexCount, float targetError, float* resultError)
+{
+	std::vector<uint32_t> result(indices.begin(), indices.end());
+	double maxCost = 0.0;
+	const size_t vertexCount = vertices.size();
+
+	if (result.size() > targetIndexCount) {
+		// ================================
+		// 1.動かせない頂点を決める
+		// ================================
+		// 同じ位置の頂点を 1 つの番号にまとめる（UV / 法線の継ぎ目は同じ位置に複数の頂点がある）
+		std::vector<uint32_t> positionId(vertexCount);
+		std::vector<uint8_t> locked(vertexCount, 0);
+		{
+			std::vector<uint32_t> order(vertexCount);
+			std::iota(order.begin(), order.end(), 0u);
+			std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+				return LessPosition(PositionOf(vertices[a]), PositionOf(vertices[b]));
+			});
+			for (size_t begin = 0; begin < vertexCount;) {
+				size_t end = begin + 1;
+				while (end < vertexCount && SamePosition(PositionOf(vertices[order[begin]]), PositionOf(vertices[order[end]]))) {
+					++end;
+				}
+				for (size_t i = begin; i < end; ++i) {
+					positionId[order[i]] = order[begin];
+					locked[order[i]] = end - begin > 1 ? 1 : 0; // 継ぎ目
+				}
+				begin = end;
+			}
+		}
+
+		// 三角形 1 つにしか使われない辺（穴の縁）と 3 つ以上の辺（非多様体）の頂点も動かさない
+		{
+			std::vector<uint64_t> edges;
+			edges.reserve(result.size());
+			for (size_t t = 0; t < result.size(); t += 3) {
+				for (size_t k = 0; k < 3; ++k) {
+					const uint64_t a = positionId[result[t + k]];
+					const uint64_t b = positionId[result[t + (k + 1) % 3]];
+					if (a != b) {
+						edges.push_back(std::min(a, b) << 32 | std::max(a, b));
+					}
+				}
+			}
+			std::sort(edges.begin(), edges.end());
+			std::vector<uint8_t> lockedPosition(vertexCount, 0);
+			for (size_t begin = 0; begin < edges.size();) {
+				size_t end = begin + 1;
+				while (end < edges.size() && edges[end] == edges[begin]) {
+					++end;
+				}
+				if (end - begin != 2) {
+					lockedPosition[edges[begin] >> 32] = 1;
+					lockedPosition[edges[begin] & 0xFFFFFFFFu] = 1;
+				}
+				begin = end;
+			}
+			for (size_t v = 0; v < vertexCount; ++v) {
+				locked[v] |= lockedPosition[positionId[v]];
+			}
+		}
+
+		// ================================
+		// 2.各頂点の二次誤差（周りの面の平面を面積で重み付けして足す）
+		// ================================
+		std::vector<Quadric> quadrics(vertexCount);
+		for (size_t t = 0; t < result.size(); t += 3) {
+			const Vector3 p0 = PositionOf(vertices[result[t]]);
+			const Vector3 p1 = PositionOf(vertices[result[t + 1]]);
+			const Vector3 p2 = PositionOf(vertices[result[t + 2]]);
+			const Vector3 normal = Vector3::Cross(p1 - p0, p2 - p0);
+			const double length = Vector3::Length(normal);
+			if (length <= 0.0) {
+				continue;
+			}
+			const double nx = normal.x / length, ny = normal.y / length, nz = normal.z / length;
+			const double d = -(nx * p0.x + ny * p0.y + nz * p0.z);
+			for (size_t k = 0; k < 3; ++k) {
+				quadrics[result[t + k]].AddPlane(nx, ny, nz, d, length * 0.5);
+			}
+		}
+
+		// ================================
+		// 3.誤差の小さい縮約から、隣り合わないものをまとめて行う（目標に届くまで繰り返す）
+		// ================================
+		const double costLimit = static_cast<double>(targetError) * targetError;
+		std::vector<uint32_t> offsets;
+		std::vector<uint32_t> adjacency;
+		std::vector<Collapse> candidates;
+		std::vector<uint32_t> remap(vertexCount);
+		std::vector<uint8_t> touched;
+
+		while (result.size() > targetIndexCount) {
+			// 頂点 → 三角形の表
+			offsets.assign(vertexCount + 1, 0);
+			for (uint32_t index : result) {
+				++offsets[index + 1];
+			}
+			std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+			adjacency.resize(result.size());
+			{
+				std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+				for (size_t i = 0; i < result.size(); ++i) {
+					adjacency[cursor[result[i]]++] = static_cast<uint32_t>(i - i % 3);
+				}
+			}
+
+			// 候補（辺の両向き）
+			candidates.clear();
+			for (size_t t = 0; t < result.size(); t += 3) {
+				for (size_t k = 0; k < 3; ++k) {
+					const uint32_t a = result[t + k];
+					const uint32_t b = result[t + (k + 1) % 3];
+					if (!locked[a]) {
+						candidates.push_back({ a, b, quadrics[a].Evaluate(PositionOf(vertices[b])) });
+					}
+					if (!locked[b]) {
+						candidates.push_back({ b, a, quadrics[b].Evaluate(PositionOf(vertices[a])) });
+					}
+				}
+			}
+			std::sort(candidates.begin(), candidates.end(), [](const Collapse& a, const Collapse& b) { return a.cost < b.cost; });
+
+			std::iota(remap.begin(), remap.end(), 0u);
+			touched.assign(vertexCount, 0);
+			size_t triangleCount = result.size() / 3;
+			const size_t targetTriangleCount = targetIndexCount / 3;
+			size_t collapseCount = 0;
+
+			for (const Collapse& collapse : candidates) {
+				if (collapse.cost > costLimit || triangleCount <= targetTriangleCount) {
+					break;
+				}
+				if (touched[collapse.from] || touched[collapse.to]) {
+					continue;
+				}
+
+				// 寄せたときに裏返る三角形があれば見送る
+				const Vector3 target = PositionOf(vertices[collapse.to]);
+				bool flips = false;
+				size_t removed = 0;
+				for (uint32_t k = offsets[collapse.from]; k < offsets[collapse.from + 1] && !flips; ++k) {
+					const uint32_t* corners = &result[adjacency[k]];
+					if (corners[0] == collapse.to || corners[1] == collapse.to || corners[2] == collapse.to) {
+						++removed; // この三角形は潰れて消える
+						continue;
+					}
+					Vector3 before[3];
+					Vector3 after[3];
+					for (size_t c = 0; c < 3; ++c) {
+						before[c] = PositionOf(vertices[corners[c]]);
+						after[c] = corners[c] == collapse.from ? target : before[c];
+					}
+					const Vector3 normalBefore = Vector3::Cross(before[1] - before[0], before[2] - before[0]);
+					const Vector3 normalAfter = Vector3::Cross(after[1] - after[0], after[2] - after[0]);
+					const float lengths = Vector3::Length(normalBefore) * Vector3::Length(normalAfter);
+					flips = lengths > 0.0f && Vector3::Dot(normalBefore, normalAfter) < 0.2f * lengths;
+					// 1 回ごとの判定だけだと何度も縮約するうちに少しずつ裏返るので、頂点の法線とも比べる
+					const Vector3 vertexNormal = NormalOf(vertices[corners[0]]) + NormalOf(vertices[corners[1]]) + NormalOf(vertices[corners[2]]);
+					const float normalLengths = Vector3::Length(vertexNormal) * Vector3::Length(normalAfter);
+					flips = flips || (normalLengths > 0.0f && Vector3::Dot(vertexNormal, normalAfter) < 0.05f * normalLengths);
+				}
+				if (flips) {
+					continue;
+				}
+
+				remap[collapse.from] = collapse.to;
+				quadrics[collapse.to].Add(quadrics[collapse.from]);
+				// 周りの頂点はこの回ではもう動かさない（裏返りの判定が古くならないように）
+				for (uint32_t k = offsets[collapse.from]; k < offsets[collapse.from + 1]; ++k) {
+					const uint32_t* corners = &result[adjacency[k]];
+					touched[corners[0]] = touched[corners[1]] = touched[corners[2]] = 1;
+				}
+				triangleCount -= std::min(removed, triangleCount);
+				maxCost = std::max(maxCost, collapse.cost);
+				++collapseCount;
+			}
+
+			if (collapseCount == 0) {
+				break; // これ以上は誤差の上限を超えるか、動かせる頂点が無い
+			}
+
+			// 付け替えて、潰れた三角形（同じ位置を 2 回以上含む）を除く
+			size_t write = 0;
+			for (size_t t = 0; t < result.size(); t += 3) {
+				const uint32_t a = remap[result[t]];
+				const uint32_t b = remap[result[t + 1]];
+				const uint32_t c = remap[result[t + 2]];
+				if (positionId[a] == positionId[b] || positionId[b] == positionId[c] || positionId[a] == positionId[c]) {
+					continue;
+				}
+				result[write++] = a;
+				result[write++] = b;
+				result[write++] = c;
+			}
+			result.resize(write);
+		}
+	}
+
+	if (resultError) {
+		*resultError = static_cast<float>(std::sqrt(maxCost));
+	}
+	return result;
+}
+
+// ===================================
+// LOD の生成
+// ===================================
+void MeshSimplifier::GenerateLods(ModelData& modelData, const MeshLodSettings& settings) {
+	if (modelData.indices.empty()) {
+		return;
+	}
+	if (modelData.subMeshes.empty()) {
+		modelData.subMeshes.push_back({ {}, 0, static_cast<uint32_t>(modelData.indices.size()), 0 });
+	}
+
+	const uint32_t baseSubMeshCount = static_cast<uint32_t>(modelData.subMeshes.size());
+	modelData.lods.clear();
+	modelData.lods.push_back({ 0, baseSubMeshCount, static_cast<uint32_t>(modelData.indices.size()), 0.0f });
+
+	// 誤差の上限はメッシュの大きさに比例させる（AABB の対角の半分を半径とする）
+	const AABB bounds = AABB::FromPoints(&modelData.vertices[0].position, modelData.vertices.size(), sizeof(VertexData));
+	const float radius = Vector3::Length(bounds.GetExtents());
+	const float targetError = settings.maxRelativeError * radius;
+
+	size_t previousIndexCount = modelData.indices.size();
+	float triangleRatio = 1.0f;
+	for (uint32_t level = 1; level < settings.lodCount; ++level) {
+		triangleRatio *= settings.triangleRatio;
+
+		// 累積の誤差を正しく測るため、毎回 LOD0 から簡略化する
+		MeshLod lod;
+		lod.subMeshOffset = static_cast<uint32_t>(modelData.subMeshes.size());
+		std::vector<uint32_t> lodIndices;
+		std::vector<SubMesh> lodSubMeshes;
+		for (uint32_t i = 0; i < baseSubMeshCount; ++i) {
+			const SubMesh& base = modelData.subMeshes[i];
+			const size_t targetIndexCount = static_cast<size_t>(static_cast<float>(base.indexCount / 3) * triangleRatio) * 3;
+			float error = 0.0f;
+			const std::vector<uint32_t> simplified = Simplify(
+				modelData.vertices,
+				std::span<const uint32_t>(modelData.indices).subspan(base.indexOffset, base.indexCount),
+				targetIndexCount, targetError, &error);
+			if (simplified.empty()) {
+				continue;
+			}
+			lodSubMeshes.push_back({ base.name, static_cast<uint32_t>(modelData.indices.size() + lodIndices.size()),
+				static_cast<uint32_t>(simplified.size()), base.materialIndex });
+			lodIndices.insert(lodIndices.end(), simplified.begin(), simplified.end());
+			lod.error = std::max(lod.error, error);
+		}
+
+		// 誤差の上限や継ぎ目でほとんど減らなくなったら、それ以上の段は作らない
+		if (static_cast<float>(lodIndices.size()) > static_cast<float>(previousIndexCount) * (1.0f - settings.minReduction)) {
+			break;
+		}
+
+		lod.subMeshCount = static_cast<uint32_t>(lodSubMeshes.size());
+		lod.indexCount = static_cast<uint32_t>(lodIndices.size());
+		modelData.indices.insert(modelData.indices.end(), lodIndices.begin(), lodIndices.end());
+		modelData.subMeshes.insert(modelData.subMeshes.end(), lodSubMeshes.begin(), lodSubMeshes.end());
+		modelData.lods.push_back(lod);
+		previousIndexCount = lodIndices.size();
+	}
+}
+
+std::string MeshSimplifier::ToString(const ModelData& modelData) {
+	std::string text;
+	char part[96];
+	for (size_t i = 0; i < modelData.lods.size(); ++i) {
+		const MeshLod& lod = modelData.lods[i];
+		std::snprintf(part, sizeof(part), "%sLOD%zu %u tris (error %.5f)",
+			i == 0 ? "" : ", ", i, lod.indexCount / 3, lod.error);
+		text += part;
+	}
+	return text;
+}
+
+#if defined(TOMO_MESH_SIMPLIFIER_TEST_MAIN)
+#include <map>
+#include <utility>
+
+namespace {
+
+// でこぼこのある閉じた球（正二十面体を分割。同じ位置の頂点は 1 つだけ = 継ぎ目なし）
+ModelData MakeBumpySphere(uint32_t subdivisionCount) {
+	const float t = (1.0f + std::sqrt(5.0f)) * 0.5f;
+	std::vector<Vector3> positions = {
+		{ -1, t, 0 }, { 1, t, 0 }, { -1, -t, 0 }, { 1, -t, 0 }, { 0, -1, t }, { 0, 1, t },
+		{ 0, -1, -t }, { 0, 1, -t }, { t, 0, -1 }, { t, 0, 1 }, { -t, 0, -1 }, { -t, 0, 1 },
+	};
+	std::vector<uint32_t> indices = {
+		0, 11, 5, 0, 5, 1, 0, 1, 7, 0, 7, 10, 0, 10, 11, 1, 5, 9, 5, 11, 4, 11, 10, 2, 10, 7, 6, 7, 1, 8,
+		3, 9, 4, 3, 4, 2, 3, 2, 6, 3, 6, 8, 3, 8, 9, 4, 9, 5, 2, 4, 11, 6, 2, 10, 8, 6, 7, 9, 8, 1,
+	};
+	for (Vector3& p : positions) {
+		p = Vector3::Normalize(p);
+	}
+	for (uint32_t level = 0; level < subdivisionCount; ++level) {
+		std::map<std::pair<uint32_t, uint32_t>, uint32_t> midpoints;
+		auto midpoint = [&](uint32_t a, uint32_t b) {
+			const auto key = std::minmax(a, b);
+			auto [it, inserted] = midpoints.try_emplace(key, static_cast<uint32_t>(positions.size()));
+			if (inserted) {
+				positions.push_back(Vector3::Normalize(positions[a] + positions[b]));
+			}
+			return it->second;
+		};
+		std::vector<uint32_t> next;
+		for (size_t i = 0; i < indices.size(); i += 3) {
+			const uint32_t a = indices[i], b = indices[i + 1], c = indices[i + 2];
+			const uint32_t ab = midpoint(a, b), bc = midpoint(b, c), ca = midpoint(c, a);
+			next.insert(next.end(), { a, ab, ca, b, bc, ab, c, ca, bc, ab, bc, ca });
+		}
+		indices = std::move(next);
+	}
+
+	ModelData model;
+	for (const Vector3& p : positions) {
+		// 半径を緩やかに揺らす（平らな所は粗くでき、起伏のある所は残る）
+		const float radius = 1.0f + 0.08f * std::sin(3.0f * p.x) * std::sin(4.0f * p.y + 1.0f) * std::sin(2.0f * p.z);
+		const Vector3 position = p * radius;
+		model.vertices.push_back({ { position.x, position.y, position.z, 1.0f }, { p.x * 0.5f + 0.5f, p.y * 0.5f + 0.5f }, p });
+	}
+	// 三角形の向き（外向き）を揃える
+	for (size_t i = 0; i < indices.size(); i += 3) {
+		const Vector3 a = PositionOf(model.vertices[indices[i]]);
+		const Vector3 b = PositionOf(model.vertices[indices[i + 1]]);
+		const Vector3 c = PositionOf(model.vertices[indices[i + 2]]);
+		if (Vector3::Dot(Vector3::Cross(b - a, c - a), a + b + c) < 0.0f) {
+			std::swap(indices[i + 1], indices[i + 2]);
+		}
+	}
+	model.indices = std::move(indices);
+	model.subMeshes.push_back({ "sphere", 0, static_cast<uint32_t>(model.indices.size()), 0 });
+	return model;
+}
+
+// 点 p から三角形 abc までの距離（Ericson "Real-Time Collision Detection" 5.1.5）
+double DistanceToTriangle(const Vector3& p, const Vector3& a, const Vector3& b, const Vector3& c) {
+	const Vector3 ab = b - a, ac = c - a, ap = p - a;
+	const float d1 = Vector3::Dot(ab, ap), d2 = Vector3::Dot(ac, ap);
+	Vector3 closest;
+	if (d1 <= 0.0f && d2 <= 0.0f) {
+		closest = a;
+	} else {
+		const Vector3 bp = p - b;
+		const float d3 = Vector3::Dot(ab, bp), d4 = Vector3::Dot(ac, bp);
+		const Vector3 cp = p - c;
+		const float d5 = Vector3::Dot(ab, cp), d6 = Vector3::Dot(ac, cp);
+		const float vc = d1 * d4 - d3 * d2, vb = d5 * d2 - d1 * d6, va = d3 * d6 - d5 * d4;
+		if (d3 >= 0.0f && d4 <= d3) {
+			closest = b;
+		} else if (d6 >= 0.0f && d5 <= d6) {
+			closest = c;
+		} else if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+			closest = a + ab * (d1 / (d1 - d3));
+		} else if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+			closest = a + ac * (d2 / (d2 - d6));
+		} else if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+			closest = b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+		} else {
+			const float denominator = 1.0f / (va + vb + vc);
+			closest = a + ab * (vb * denominator) + ac * (vc * denominator);
+		}
+	}
+	return Vector3::Length(p - closest);
+}
+
+// 点群から三角形の集まりまでの最大距離（総当たり）
+double MaxDistance(std::span<const Vector3> points, const std::vector<VertexData>& vertices, std::span<const uint32_t> indices) {
+	double maxDistance = 0.0;
+	for (const Vector3& p : points) {
+		double distance = std::numeric_limits<double>::max();
+		for (size_t i = 0; i < indices.size(); i += 3) {
+			distance = std::min(distance, DistanceToTriangle(p,
+				PositionOf(vertices[indices[i]]), PositionOf(vertices[indices[i + 1]]), PositionOf(vertices[indices[i + 2]])));
+		}
+		maxDistance = std::max(maxDistance, distance);
+	}
+	return maxDistance;
+}
+
+}
+
+// 閉じたメッシュの LOD を作り、段ごとの三角形数と、報告された誤差 / 実際に測った形状のずれを表示する。
+// ずれは「LOD0 の頂点と三角形の重心から LOD の面まで」と「LOD の三角形の重心から LOD0 の面まで」の大きい方。
+// 報告された誤差がずれ以上（保守的）でずれの 4 倍以内であること、段が進むほど三角形が減ることを確かめる
+int main() {
+	ModelData model = MakeBumpySphere(4);
+	const std::vector<uint32_t> baseIndices = model.indices;
+	MeshSimplifier::GenerateLods(model);
+	std::printf("%s\n", MeshSimplifier::ToString(model).c_str());
+
+	std::vector<Vector3> basePoints;
+	for (const VertexData& vertex : model.vertices) {
+		basePoints.push_back(PositionOf(vertex));
+	}
+	for (size_t i = 0; i < baseIndices.size(); i += 3) {
+		basePoints.push_back((PositionOf(model.vertices[baseIndices[i]]) + PositionOf(model.vertices[baseIndices[i + 1]]) +
+			PositionOf(model.vertices[baseIndices[i + 2]])) * (1.0f / 3.0f));
+	}
+
+	int failureCount = model.lods.size() >= 3 ? 0 : 1;
+	for (size_t level = 0; level < model.lods.size(); ++level) {
+		const MeshLod& lod = model.lods[level];
+		const SubMesh& subMesh = model.subMeshes[lod.subMeshOffset];
+		const std::span<const uint32_t> lodIndices(model.indices.data() + subMesh.indexOffset, subMesh.indexCount);
+
+		std::vector<Vector3> lodPoints;
+		for (size_t i = 0; i < lodIndices.size(); i += 3) {
+			lodPoints.push_back((PositionOf(model.vertices[lodIndices[i]]) + PositionOf(model.vertices[lodIndices[i + 1]]) +
+				PositionOf(model.vertices[lodIndices[i + 2]])) * (1.0f / 3.0f));
+		}
+		const double deviation = std::max(
+			MaxDistance(basePoints, model.vertices, lodIndices),
+			MaxDistance(lodPoints, model.vertices, baseIndices));
+
+		// 報告された誤差は二次誤差（面積で重み付けした平面までの距離）から求めた目安なので、ずれの 4 倍以内であることも見る
+		const bool conservative = lod.error >= deviation * 0.999 - 1.0e-6;
+		const bool tight = lod.error <= deviation * 4.0 + 1.0e-6;
+		const bool reduced = level == 0 || lod.indexCount < model.lods[level - 1].indexCount;
+		const bool passed = conservative && tight && reduced;
+		std::printf("LOD%zu %5u tris  reported error %.5f  measured deviation %.5f  %s\n",
+			level, lod.indexCount / 3, lod.error, deviation, passed ? "ok" : "NG");
+		failureCount += passed ? 0 : 1;
+	}
+
+	// 三角形ごとに頂点を分けた（フラットシェーディングの）メッシュは全頂点が継ぎ目になり、LOD0 しか作られない
+	ModelData flat = MakeBumpySphere(4);
+	std::vector<VertexData> flatVertices;
+	for (uint32_t& index : flat.indices) {
+		flatVertices.push_back(flat.vertices[index]);
+		index = static_cast<uint32_t>(flatVertices.size() - 1);
+	}
+	flat.vertices = std::move(flatVertices);
+	MeshSimplifier::GenerateLods(flat);
+	std::printf("split vertices: %s %s\n", MeshSimplifier::ToString(flat).c_str(), flat.lods.size() == 1 ? "ok" : "NG");
+	failureCount += flat.lods.size() == 1 ? 0 : 1;
+
+	std::puts(failureCount == 0 ? "PASSED" : "FAILED");
+	return failureCount == 0 ? 0 : 1;
+}
+#endif
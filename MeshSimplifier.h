@@ -0,0 +1,39 @@
+#pragma once
+#include "ModelData.h"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+// LOD 生成の設定
+struct MeshLodSettings {
+	uint32_t lodCount = 4;           // LOD0 を含む最大段数
+	float triangleRatio = 0.5f;      // 1 段ごとの三角形数の比
+	float maxRelativeError = 0.05f;  // 許容する誤差（メッシュの半径に対する比）。これを超える縮約はしない
+	float minReduction = 0.1f;       // 前の段より三角形がこの割合以上減らなければ打ち切る
+};
+
+// ==================================
+// 二次誤差（QEM）によるメッシュの簡略化
+// ==================================
+// Garland-Heckbert の二次誤差で辺を短い順（誤差の小さい順）に縮約する。
+// 頂点は元の頂点の中から選ぶ（新しい位置を作らない）ので、LOD 同士で頂点バッファを共有できる。
+// UV / 法線の継ぎ目の頂点と、穴の縁（SubMesh の境界を含む）の頂点は動かさない。
+// 継ぎ目は「同じ位置にほかの頂点がある頂点」で判定するので、法線や UV が面ごとに分かれたメッシュ
+// （フラットシェーディングなど、全頂点が分かれているもの）は 1 頂点も動かせず、LOD0 しか作られない。
+// LOD の誤差は二次誤差（周りの面の平面までの距離を面積で平均したもの）から求めた目安で、厳密な最大距離ではない。
+class MeshSimplifier {
+public:
+	// indices を targetIndexCount 以下まで簡略化した新しいインデックスを返す
+	// targetError : 許容する誤差（モデル空間の距離）
+	// resultError : 実際に生じた最大誤差（nullptr 可）
+	static std::vector<uint32_t> Simplify(
+		std::span<const VertexData> vertices, std::span<const uint32_t> indices,
+		size_t targetIndexCount, float targetError, float* resultError = nullptr);
+
+	// LOD0（今の subMeshes）から粗い LOD を作り、indices / subMeshes / lods に追加する
+	static void GenerateLods(ModelData& modelData, const MeshLodSettings& settings = {});
+
+	// ログ用（"LOD0 1000 tris, LOD1 500 tris (err 0.0012), ..."）
+	static std::string ToString(const ModelData& modelData);
+};
@@ -0,0 +1,461 @@
+#include "MeshletBuilder.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+namespace {
+
+constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+constexpr uint8_t kNotInMeshlet = 0xFF;
+static_assert(MeshletBuilder::kMaxVertices < kNotInMeshlet, "meshlet 内の頂点番号は uint8_t に収まる必要がある");
+
+Vector3 PositionOf(const VertexData& vertex) {
+	return { vertex.position.x, vertex.position.y, vertex.position.z };
+}
+
+// 組み立て中の meshlet
+struct MeshletState {
+	std::vector<uint32_t> vertices;   // 区間内の頂点番号
+	std::vector<uint32_t> triangles;  // 区間内の三角形番号
+};
+
+// ================================
+// 境界球と法線の円錐
+// ================================
+void ComputeBounds(
+	std::span<const VertexData> vertices, std::span<const uint32_t> indices,
+	const std::vector<uint32_t>& localToGlobal, const MeshletState& state, Meshlet& meshlet)
+{
+	// 境界球（AABB の中心から最も遠い頂点まで）
+	AABB box = AABB::MakeEmpty();
+	for (uint32_t v : state.vertices) {
+		const Vector3 p = PositionOf(vertices[localToGlobal[v]]);
+		box = AABB::Merge(box, { p, p });
+	}
+	meshlet.bounds.center = box.GetCenter();
+	meshlet.bounds.radius = 0.0f;
+	for (uint32_t v : state.vertices) {
+		meshlet.bounds.radius = std::max(meshlet.bounds.radius, Vector3::Length(PositionOf(vertices[localToGlobal[v]]) - meshlet.bounds.center));
+	}
+
+	// 円錐の軸 = 面法線の平均
+	struct Face {
+		Vector3 point;
+		Vector3 normal;
+	};
+	std::vector<Face> faces;
+	faces.reserve(state.triangles.size());
+	Vector3 axis = { 0.0f, 0.0f, 0.0f };
+	for (uint32_t t : state.triangles) {
+		const Vector3 p0 = PositionOf(vertices[indices[t * 3]]);
+		const Vector3 p1 = PositionOf(vertices[indices[t * 3 + 1]]);
+		const Vector3 p2 = PositionOf(vertices[indices[t * 3 + 2]]);
+		const Vector3 normal = Vector3::Cross(p1 - p0, p2 - p0);
+		const float length = Vector3::Length(normal);
+		if (length <= 0.0f) {
+			continue; // 面積 0 の三角形は向きを持たない
+		}
+		faces.push_back({ p0, normal * (1.0f / length) });
+		axis += faces.back().normal;
+	}
+
+	const float axisLength = Vector3::Length(axis);
+	meshlet.coneAxis = axisLength > 0.0f ? axis * (1.0f / axisLength) : Vector3{ 0.0f, 0.0f, 1.0f };
+	meshlet.coneApex = meshlet.bounds.center;
+	meshlet.coneCutoff = 2.0f;
+	if (faces.empty() || axisLength <= 0.0f) {
+		return;
+	}
+
+	// 軸と最も離れた法線との角度 α（cos が 0 以下 = 90 度以上なら裏面カリングできない）
+	float minCos = 1.0f;
+	for (const Face& face : faces) {
+		minCos = std::min(minCos, Vector3::Dot(face.normal, meshlet.coneAxis));
+	}
+	if (minCos <= 0.0f) {
+		return;
+	}
+
+	// 頂点：全三角形の平面の裏側に来るまで中心から軸の逆向きに下げた点
+	float apexDistance = 0.0f;
+	for (const Face& face : faces) {
+		const float distance = Vector3::Dot(meshlet.bounds.center - face.point, face.normal) / Vector3::Dot(meshlet.coneAxis, face.normal);
+		apexDistance = std::max(apexDistance, distance);
+	}
+	meshlet.coneApex = meshlet.bounds.center - meshlet.coneAxis * apexDistance;
+	// 頂点から見た視線が軸と sin α 以上そろっていれば、どの法線とも 90 度以上離れる
+	meshlet.coneCutoff = std::sqrt(std::max(0.0f, 1.0f - minCos * minCos));
+}
+
+}
+
+// ===================================
+// 区間 1 つ分の分割
+// ===================================
+void MeshletBuilder::Build(
+	std::span<const VertexData> vertices, std::span<const uint32_t> indices, uint32_t materialIndex,
+	std::vector<Meshlet>& meshlets, std::vector<uint32_t>& meshletVertices, std::vector<uint8_t>& meshletTriangles)
+{
+	const size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0) {
+		return;
+	}
+
+	// ================================
+	// 1.区間で使われる頂点だけの番号に詰める
+	// ================================
+	std::vector<uint32_t> localToGlobal(indices.begin(), indices.end());
+	std::sort(localToGlobal.begin(), localToGlobal.end());
+	localToGlobal.erase(std::unique(localToGlobal.begin(), localToGlobal.end()), localToGlobal.end());
+	const size_t vertexCount = localToGlobal.size();
+
+	std::vector<uint32_t> localIndices(indices.size());
+	for (size_t i = 0; i < indices.size(); ++i) {
+		assert(indices[i] < vertices.size());
+		localIndices[i] = static_cast<uint32_t>(std::lower_bound(localToGlobal.begin(), localToGlobal.end(), indices[i]) - localToGlobal.begin());
+	}
+
+	// 頂点 → 三角形の表
+	std::vector<uint32_t> offsets(vertexCount + 1, 0);
+	for (uint32_t v : localIndices) {
+		++offsets[v + 1];
+	}
+	for (size_t v = 0; v < vertexCount; ++v) {
+		offsets[v + 1] += offsets[v];
+	}
+	std::vector<uint32_t> adjacency(localIndices.size());
+	{
+		std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+		for (size_t i = 0; i < localIndices.size(); ++i) {
+			adjacency[cursor[localIndices[i]]++] = static_cast<uint32_t>(i / 3);
+		}
+	}
+
+	// ================================
+	// 2.貪欲に詰める
+	// ================================
+	std::vector<uint8_t> emitted(triangleCount, 0);
+	std::vector<uint8_t> slot(vertexCount, kNotInMeshlet); // 頂点の meshlet 内の番号
+	MeshletState state;
+	state.vertices.reserve(kMaxVertices);
+	state.triangles.reserve(kMaxTriangles);
+	size_t scanCursor = 0;
+
+	// 頂点ごとの未出力の三角形数（少ない頂点を先に使い切ると塊が丸く詰まる）
+	std::vector<uint32_t> live(vertexCount);
+	for (size_t v = 0; v < vertexCount; ++v) {
+		live[v] = offsets[v + 1] - offsets[v];
+	}
+
+	auto newVertexCount = [&](uint32_t t) {
+		uint32_t count = 0;
+		for (size_t k = 0; k < 3; ++k) {
+			count += slot[localIndices[t * 3 + k]] == kNotInMeshlet ? 1 : 0;
+		}
+		return count;
+	};
+
+	// 頂点 v を使う未出力の三角形のうち、新しい頂点が最も少なく、その中で残りの少ない頂点を使うもの
+	auto findBest = [&](uint32_t v, uint32_t& best, uint32_t& bestNew, uint32_t& bestLive) {
+		for (uint32_t k = offsets[v]; k < offsets[v + 1]; ++k) {
+			const uint32_t t = adjacency[k];
+			if (emitted[t]) {
+				continue;
+			}
+			const uint32_t added = newVertexCount(t);
+			const uint32_t liveSum = live[localIndices[t * 3]] + live[localIndices[t * 3 + 1]] + live[localIndices[t * 3 + 2]];
+			if (added < bestNew || (added == bestNew && liveSum < bestLive)) {
+				best = t;
+				bestNew = added;
+				bestLive = liveSum;
+			}
+		}
+	};
+
+	auto flush = [&]() {
+		Meshlet meshlet;
+		meshlet.vertexOffset = static_cast<uint32_t>(meshletVertices.size());
+		meshlet.triangleOffset = static_cast<uint32_t>(meshletTriangles.size());
+		meshlet.vertexCount = static_cast<uint32_t>(state.vertices.size());
+		meshlet.triangleCount = static_cast<uint32_t>(state.triangles.size());
+		meshlet.materialIndex = materialIndex;
+		for (uint32_t v : state.vertices) {
+			meshletVertices.push_back(localToGlobal[v]);
+		}
+		for (uint32_t t : state.triangles) {
+			for (size_t k = 0; k < 3; ++k) {
+				meshletTriangles.push_back(slot[localIndices[t * 3 + k]]);
+			}
+		}
+		ComputeBounds(vertices, indices, localToGlobal, state, meshlet);
+		meshlets.push_back(meshlet);
+
+		for (uint32_t v : state.vertices) {
+			slot[v] = kNotInMeshlet;
+		}
+		state.vertices.clear();
+		state.triangles.clear();
+	};
+
+	for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+		// 塊の頂点まわり → 未出力の先頭、の順に候補を探す
+		uint32_t best = kNone;
+		uint32_t bestNew = 4;
+		uint32_t bestLive = kNone;
+		for (uint32_t v : state.vertices) {
+			if (live[v] > 0) {
+				findBest(v, best, bestNew, bestLive);
+			}
+		}
+		if (best == kNone) {
+			while (emitted[scanCursor]) {
+				++scanCursor;
+			}
+			best = static_cast<uint32_t>(scanCursor);
+			bestNew = newVertexCount(best);
+		}
+
+		// 入りきらなければ今の塊を閉じる（閉じた後は 3 頂点とも新しい）
+		if (state.vertices.size() + bestNew > kMaxVertices || state.triangles.size() + 1 > kMaxTriangles) {
+			flush();
+		}
+
+		for (size_t k = 0; k < 3; ++k) {
+			const uint32_t v = localIndices[best * 3 + k];
+			if (slot[v] == kNotInMeshlet) {
+				slot[v] = static_cast<uint8_t>(state.vertices.size());
+				state.vertices.push_back(v);
+			}
+			--live[v];
+		}
+		state.triangles.push_back(best);
+		emitted[best] = 1;
+	}
+	flush();
+}
+
+// ===================================
+// モデル全体
+// ===================================
+void MeshletBuilder::Build(ModelData& modelData) {
+	modelData.meshlets.clear();
+	modelData.meshletVertices.clear();
+	modelData.meshletTriangles.clear();
+	if (modelData.indices.empty()) {
+		return;
+	}
+
+	// LOD0 の区間（表が無ければ全体で 1 区間）
+	std::vector<SubMesh> subMeshes;
+	if (modelData.subMeshes.empty()) {
+		subMeshes.push_back({ {}, 0, static_cast<uint32_t>(modelData.indices.size()), 0 });
+	} else if (modelData.lods.empty()) {
+		subMeshes = modelData.subMeshes;
+	} else {
+		const MeshLod& lod = modelData.lods[0];
+		subMeshes.assign(modelData.subMeshes.begin() + lod.subMeshOffset, modelData.subMeshes.begin() + lod.subMeshOffset + lod.subMeshCount);
+	}
+
+	for (const SubMesh& subMesh : subMeshes) {
+		Build(modelData.vertices,
+			std::span<const uint32_t>(modelData.indices).subspan(subMesh.indexOffset, subMesh.indexCount),
+			subMesh.materialIndex, modelData.meshlets, modelData.meshletVertices, modelData.meshletTriangles);
+	}
+}
+
+bool MeshletBuilder::IsBackFacing(const Meshlet& meshlet, const Vector3& cameraPosition) {
+	const Vector3 view = meshlet.coneApex - cameraPosition;
+	const float length = Vector3::Length(view);
+	return length > 0.0f && Vector3::Dot(view, meshlet.coneAxis) >= meshlet.coneCutoff * length;
+}
+
+std::string MeshletBuilder::ToString(const ModelData& modelData) {
+	const size_t count = modelData.meshlets.size();
+	const double denominator = count > 0 ? static_cast<double>(count) : 1.0;
+	char text[96];
+	std::snprintf(text, sizeof(text), "%zu meshlets, %.1f verts / %.1f tris avg",
+		count,
+		static_cast<double>(modelData.meshletVertices.size()) / denominator,
+		static_cast<double>(modelData.meshletTriangles.size() / 3) / denominator);
+	return text;
+}
+
+// ===================================
+// テスト（ctest の meshlet_builder_test）
+// ===================================
+// 上限（64 頂点 / 124 三角形）、すべての三角形がちょうど 1 つの meshlet に入ること、
+// 円錐で裏向きと判定したカメラ位置からは塊のどの三角形も表が見えないことを確かめる。
+#if defined(TOMO_MESHLET_BUILDER_TEST_MAIN)
+#include <array>
+#include <map>
+#include <random>
+
+namespace {
+
+// 格子状のメッシュ（緯度経度の球、または起伏のある平面）。左右で SubMesh とマテリアルを分ける
+ModelData MakeGridMesh(uint32_t columns, uint32_t rows, bool sphere) {
+	constexpr float kPi = 3.14159265f;
+	ModelData model;
+	for (uint32_t y = 0; y <= rows; ++y) {
+		for (uint32_t x = 0; x <= columns; ++x) {
+			const float u = static_cast<float>(x) / static_cast<float>(columns);
+			const float v = static_cast<float>(y) / static_cast<float>(rows);
+			Vector3 p;
+			if (sphere) {
+				const float theta = v * kPi;
+				const float phi = u * 2.0f * kPi;
+				const float radius = 1.0f + 0.1f * std::sin(5.0f * phi) * std::sin(3.0f * theta);
+				p = { radius * std::sin(theta) * std::cos(phi), radius * std::cos(theta), radius * std::sin(theta) * std::sin(phi) };
+			} else {
+				p = { u * 4.0f - 2.0f, 0.3f * std::sin(6.0f * u) * std::cos(4.0f * v), v * 4.0f - 2.0f };
+			}
+			model.vertices.push_back({ { p.x, p.y, p.z, 1.0f }, { u, v }, { 0.0f, 1.0f, 0.0f } });
+		}
+	}
+	auto appendHalf = [&](uint32_t begin, uint32_t end, uint32_t materialIndex) {
+		const uint32_t indexOffset = static_cast<uint32_t>(model.indices.size());
+		for (uint32_t y = 0; y < rows; ++y) {
+			for (uint32_t x = begin; x < end; ++x) {
+				const uint32_t i0 = y * (columns + 1) + x;
+				const uint32_t i1 = i0 + 1;
+				const uint32_t i2 = i0 + columns + 1;
+				const uint32_t i3 = i2 + 1;
+				model.indices.insert(model.indices.end(), { i0, i2, i1, i1, i2, i3 });
+			}
+		}
+		model.subMeshes.push_back({ "half", indexOffset, static_cast<uint32_t>(model.indices.size()) - indexOffset, materialIndex });
+	};
+	appendHalf(0, columns / 2, 0);
+	appendHalf(columns / 2, columns, 1);
+	return model;
+}
+
+// 三角形の向きを保ったまま、一番小さい頂点番号が先頭に来るように回す
+std::array<uint32_t, 4> CanonicalTriangle(uint32_t a, uint32_t b, uint32_t c, uint32_t materialIndex) {
+	if (b < a && b < c) {
+		return { b, c, a, materialIndex };
+	}
+	if (c < a && c < b) {
+		return { c, a, b, materialIndex };
+	}
+	return { a, b, c, materialIndex };
+}
+
+// 失敗した項目の数を返す
+int Check(const char* name, const ModelData& model) {
+	int failureCount = 0;
+
+	// ================================
+	// 1.上限と範囲
+	// ================================
+	std::map<std::array<uint32_t, 4>, int> triangles;
+	for (const Meshlet& meshlet : model.meshlets) {
+		if (meshlet.vertexCount == 0 || meshlet.vertexCount > MeshletBuilder::kMaxVertices ||
+			meshlet.triangleCount == 0 || meshlet.triangleCount > MeshletBuilder::kMaxTriangles) {
+			std::printf("%s: meshlet %u verts / %u tris exceeds the limit\n", name, meshlet.vertexCount, meshlet.triangleCount);
+			++failureCount;
+			continue;
+		}
+		for (uint32_t i = 0; i < meshlet.triangleCount * 3; i += 3) {
+			uint32_t corners[3];
+			for (uint32_t k = 0; k < 3; ++k) {
+				const uint8_t local = model.meshletTriangles[meshlet.triangleOffset + i + k];
+				if (local >= meshlet.vertexCount) {
+					std::printf("%s: local vertex %u out of range\n", name, local);
+					++failureCount;
+				}
+				corners[k] = model.meshletVertices[meshlet.vertexOffset + (std::min)(static_cast<uint32_t>(local), meshlet.vertexCount - 1)];
+			}
+			++triangles[CanonicalTriangle(corners[0], corners[1], corners[2], meshlet.materialIndex)];
+		}
+	}
+
+	// ================================
+	// 2.元の三角形がちょうど 1 回ずつ（向きとマテリアルも同じ）
+	// ================================
+	for (const SubMesh& subMesh : model.subMeshes) {
+		for (uint32_t i = subMesh.indexOffset; i < subMesh.indexOffset + subMesh.indexCount; i += 3) {
+			--triangles[CanonicalTriangle(model.indices[i], model.indices[i + 1], model.indices[i + 2], subMesh.materialIndex)];
+		}
+	}
+	size_t mismatchCount = 0;
+	for (const auto& [triangle, count] : triangles) {
+		mismatchCount += count != 0 ? 1 : 0;
+	}
+	if (mismatchCount > 0) {
+		std::printf("%s: %zu triangles are missing or duplicated\n", name, mismatchCount);
+		++failureCount;
+	}
+
+	// ================================
+	// 3.円錐が保守的（裏向きと判定したら、どの三角形の平面でもカメラが裏側）
+	// ================================
+	std::mt19937 random(12345);
+	std::uniform_real_distribution<float> coordinate(-4.0f, 4.0f);
+	std::vector<Vector3> cameras;
+	for (int i = 0; i < 2000; ++i) {
+		cameras.push_back({ coordinate(random), coordinate(random), coordinate(random) });
+	}
+	// 表面すれすれの位置（判定が際どくなる）
+	std::uniform_real_distribution<float> offset(-0.05f, 0.05f);
+	for (size_t v = 0; v < model.vertices.size(); v += 7) {
+		const Vector4& p = model.vertices[v].position;
+		cameras.push_back({ p.x + offset(random), p.y + offset(random), p.z + offset(random) });
+	}
+
+	size_t culledCount = 0;
+	size_t violationCount = 0;
+	for (const Meshlet& meshlet : model.meshlets) {
+		for (const Vector3& camera : cameras) {
+			if (!MeshletBuilder::IsBackFacing(meshlet, camera)) {
+				continue;
+			}
+			++culledCount;
+			for (uint32_t i = 0; i < meshlet.triangleCount * 3; i += 3) {
+				const uint8_t* local = &model.meshletTriangles[meshlet.triangleOffset + i];
+				const Vector3 p0 = PositionOf(model.vertices[model.meshletVertices[meshlet.vertexOffset + local[0]]]);
+				const Vector3 p1 = PositionOf(model.vertices[model.meshletVertices[meshlet.vertexOffset + local[1]]]);
+				const Vector3 p2 = PositionOf(model.vertices[model.meshletVertices[meshlet.vertexOffset + local[2]]]);
+				const Vector3 normal = Vector3::Cross(p1 - p0, p2 - p0);
+				const float length = Vector3::Length(normal);
+				// 表側（カメラが平面の外向き側）にあれば見えてしまう。丸め誤差の分だけ許す
+				if (length > 0.0f && Vector3::Dot(camera - p0, normal) > 1.0e-5f * length * (1.0f + Vector3::Length(camera - p0))) {
+					++violationCount;
+				}
+			}
+		}
+	}
+	if (violationCount > 0) {
+		std::printf("%s: %zu front-facing triangles in back-facing meshlets\n", name, violationCount);
+		++failureCount;
+	}
+	// どこからも裏向きにならないなら、判定が正しくても役に立っていない
+	if (culledCount == 0) {
+		std::printf("%s: no meshlet was ever back-facing\n", name);
+		++failureCount;
+	}
+
+	std::printf("%s: %s, %zu back-facing (meshlet, camera) pairs  %s\n",
+		name, MeshletBuilder::ToString(model).c_str(), culledCount, failureCount == 0 ? "ok" : "NG");
+	return failureCount;
+}
+
+}
+
+int main() {
+	int failureCount = 0;
+
+	ModelData sphere = MakeGridMesh(96, 64, true);
+	MeshletBuilder::Build(sphere);
+	failureCount += Check("sphere", sphere);
+
+	ModelData terrain = MakeGridMesh(80, 80, false);
+	MeshletBuilder::Build(terrain);
+	failureCount += Check("terrain", terrain);
+
+	std::puts(failureCount == 0 ? "PASSED" : "FAILED");
+	return failureCount == 0 ? 0 : 1;
+}
+#endif
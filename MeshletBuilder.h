@@ -0,0 +1,35 @@
+#pragma once
+#include "ModelData.h"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+// ==================================
+// meshlet（頂点・三角形数に上限のある小さな塊）への分割
+// ==================================
+// 三角形を隣接する順に貪欲に詰め、共有頂点の多い（新しい頂点の少ない）三角形を優先する。
+// 塊ごとに境界球と法線の円錐を持つので、CPU で塊単位の視錐台カリング・裏面カリングができ、
+// 後でメッシュシェーダーに移るときはそのままディスパッチの単位になる。
+//
+// 頂点番号は最終的な頂点配列を指すので、MeshOptimizer の並べ替えの後に作ること。
+class MeshletBuilder {
+public:
+	// メッシュシェーダーの一般的な上限（出力頂点 64 / プリミティブ 124 で 1 スレッドグループ）
+	static constexpr uint32_t kMaxVertices = 64;
+	static constexpr uint32_t kMaxTriangles = 124;
+
+	// indices の三角形を meshlet に分け、各配列の末尾に追加する
+	static void Build(
+		std::span<const VertexData> vertices, std::span<const uint32_t> indices, uint32_t materialIndex,
+		std::vector<Meshlet>& meshlets, std::vector<uint32_t>& meshletVertices, std::vector<uint8_t>& meshletTriangles);
+
+	// LOD0 の全区間から meshlet を作り直す（インデックスが無いモデルは何もしない）
+	static void Build(ModelData& modelData);
+
+	// モデル空間のカメラ位置から見て、塊の三角形がすべて裏向きか
+	static bool IsBackFacing(const Meshlet& meshlet, const Vector3& cameraPosition);
+
+	// ログ用（"812 meshlets, 61.3 verts / 123.1 tris avg"）
+	static std::string ToString(const ModelData& modelData);
+};
@@ -3,7 +3,13 @@
 #include "ResourcesUtility.h"
 #include "DescriptorUtility.h"
 #include "TextureManager.h"
+#include "MeshCache.h"
+#include "MeshletBuilder.h"
+#include "Window.h"
+#include <algorithm>
 #include <cassert>
+#include <limits>
+#include <span>
 
 // ===================================
 // ファクトリメソッド
@@ -11,15 +17,24 @@
 Model* Model::CreateFromOBJ(
     const std::string& directoryPath,
     const std::string& filename,
-    ID3D12GraphicsCommandList* commandList)
+    ID3D12GraphicsCommandList* commandList,
+    VertexFormat vertexFormat)
 {
-    Model* model = new Model();
+    // OBJファイルを読み込む（バイナリキャッシュがあればそちらから）
+    ModelData modelData = MeshCache::Load(directoryPath, filename);
 
-    // OBJファイルを読み込む
-    ModelData modelData = LoadObjFile(directoryPath, filename);
+    return CreateFromModelData(modelData, commandList, vertexFormat);
+}
+
+Model* Model::CreateFromModelData(
+    const ModelData& modelData,
+    ID3D12GraphicsCommandList* commandList,
+    VertexFormat vertexFormat)
+{
+    Model* model = new Model();
 
     // モデルを初期化
-    model->Initialize(modelData, commandList);
+    model->Initialize(modelData, commandList, vertexFormat);
 
     return model;
 }
@@ -29,9 +44,11 @@ Model* Model::CreateFromOBJ(
 // ===================================
 void Model::Initialize(
     const ModelData& modelData,
-    ID3D12GraphicsCommandList* commandList)
+    ID3D12GraphicsCommandList* commandList,
+    VertexFormat vertexFormat)
 {
     modelData_ = modelData;
+    vertexFormat_ = vertexFormat;
 
     ID3D12Device* device = GraphicsCore::GetInstance()->GetDevice();
     assert(device && "Device is null");
@@ -39,44 +56,231 @@ void Model::Initialize(
     // ===================================
     // 頂点バッファの生成
     // ===================================
-    size_t vertexBufferSize = sizeof(VertexData) * modelData_.vertices.size();
+    const size_t vertexCount = modelData_.vertices.size();
+    const size_t vertexStride = vertexFormat_ == VertexFormat::Packed ? sizeof(PackedVertexData) : sizeof(VertexData);
+    size_t vertexBufferSize = vertexStride * vertexCount;
     vertexBuffer_ = CreateBufferResource(device, vertexBufferSize);
 
     // 頂点バッファビューの作成
     vertexBufferView_.BufferLocation = vertexBuffer_.Get()->GetGPUVirtualAddress();
     vertexBufferView_.SizeInBytes = static_cast<UINT>(vertexBufferSize);
-    vertexBufferView_.StrideInBytes = sizeof(VertexData);
+    vertexBufferView_.StrideInBytes = static_cast<UINT>(vertexStride);
 
-    // 頂点データをバッファにコピー
-    VertexData* vertexData = nullptr;
-    vertexBuffer_.Get()->Map(0, nullptr, reinterpret_cast<void**>(&vertexData));
-    std::memcpy(vertexData, modelData_.vertices.data(), vertexBufferSize);
+    // 頂点データをバッファにコピー（Packed は圧縮しながら直接書き込む）
+    void* mappedVertexData = nullptr;
+    vertexBuffer_.Get()->Map(0, nullptr, &mappedVertexData);
+    if (vertexFormat_ == VertexFormat::Packed) {
+        vertexQuantization_ = VertexPacker::ComputeQuantization(modelData_.vertices);
+        VertexPacker::Pack(
+            modelData_.vertices, vertexQuantization_,
+            std::span<PackedVertexData>(static_cast<PackedVertexData*>(mappedVertexData), vertexCount));
+    } else {
+        std::memcpy(mappedVertexData, modelData_.vertices.data(), vertexBufferSize);
+    }
    
     // マップしたままにする（パフォーマンス向上）
 
     // ===================================
-    // マテリアルリソースの生成
+    // インデックスバッファの生成（インデックスが無いモデルは頂点をそのまま描く）
+    // ===================================
+    // LOD の後ろに meshlet 順の三角形を並べ、塊ごとに視錐台・裏面カリングした残りだけを描けるようにする
+    if (!modelData_.indices.empty()) {
+        const size_t lodIndexCount = modelData_.indices.size();
+        const size_t indexCount = lodIndexCount + modelData_.meshletTriangles.size();
+        const bool use16Bit = vertexCount <= 0xFFFF;
+        const size_t indexBufferSize = (use16Bit ? sizeof(uint16_t) : sizeof(uint32_t)) * indexCount;
+        indexBuffer_ = CreateBufferResource(device, indexBufferSize);
+
+        indexBufferView_.BufferLocation = indexBuffer_.Get()->GetGPUVirtualAddress();
+        indexBufferView_.SizeInBytes = static_cast<UINT>(indexBufferSize);
+        indexBufferView_.Format = use16Bit ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+
+        void* mappedIndexData = nullptr;
+        indexBuffer_.Get()->Map(0, nullptr, &mappedIndexData);
+        auto writeIndex = [&](size_t i, uint32_t index) {
+            if (use16Bit) {
+                static_cast<uint16_t*>(mappedIndexData)[i] = static_cast<uint16_t>(index);
+            } else {
+                static_cast<uint32_t*>(mappedIndexData)[i] = index;
+            }
+        };
+        if (use16Bit) {
+            for (size_t i = 0; i < lodIndexCount; ++i) {
+                writeIndex(i, modelData_.indices[i]);
+            }
+        } else {
+            std::memcpy(mappedIndexData, modelData_.indices.data(), sizeof(uint32_t) * lodIndexCount);
+        }
+
+        // meshlet 内の頂点番号を頂点配列の番号に戻して書き込む
+        meshletRanges_.reserve(modelData_.meshlets.size());
+        size_t cursor = lodIndexCount;
+        for (const Meshlet& meshlet : modelData_.meshlets) {
+            meshletRanges_.push_back({ static_cast<uint32_t>(cursor), meshlet.triangleCount * 3, meshlet.materialIndex });
+            for (uint32_t i = 0; i < meshlet.triangleCount * 3; ++i) {
+                const uint8_t local = modelData_.meshletTriangles[meshlet.triangleOffset + i];
+                writeIndex(cursor++, modelData_.meshletVertices[meshlet.vertexOffset + local]);
+            }
+        }
+        visibleRanges_.reserve(meshletRanges_.size());
+    }
+
     // ===================================
-    materialResource_ = CreateBufferResource(device, Align256(sizeof(Material)));
+    // 描画範囲（LOD ごとに、同じマテリアルで隣り合う区間は 1 回の描画にまとめる）
+    // ===================================
+    if (!modelData_.indices.empty()) {
+        std::vector<SubMesh> wholeMesh;
+        if (modelData_.subMeshes.empty()) {
+            wholeMesh.push_back({ {}, 0, static_cast<uint32_t>(modelData_.indices.size()), 0 });
+        }
+        const std::span<const SubMesh> subMeshes = modelData_.subMeshes.empty()
+            ? std::span<const SubMesh>(wholeMesh)
+            : std::span<const SubMesh>(modelData_.subMeshes);
+
+        // LOD の表が無いモデルは全区間で 1 段
+        std::vector<MeshLod> lods = modelData_.lods;
+        if (lods.empty()) {
+            lods.push_back({ 0, static_cast<uint32_t>(subMeshes.size()), static_cast<uint32_t>(modelData_.indices.size()), 0.0f });
+        }
+
+        for (const MeshLod& lod : lods) {
+            LodRange lodRange;
+            lodRange.drawRangeOffset = static_cast<uint32_t>(drawRanges_.size());
+            lodRange.error = lod.error;
+            for (const SubMesh& subMesh : subMeshes.subspan(lod.subMeshOffset, lod.subMeshCount)) {
+                if (drawRanges_.size() > lodRange.drawRangeOffset &&
+                    drawRanges_.back().materialIndex == subMesh.materialIndex &&
+                    drawRanges_.back().indexOffset + drawRanges_.back().indexCount == subMesh.indexOffset) {
+                    drawRanges_.back().indexCount += subMesh.indexCount;
+                } else {
+                    drawRanges_.push_back({ subMesh.indexOffset, subMesh.indexCount, subMesh.materialIndex });
+                }
+            }
+            lodRange.drawRangeCount = static_cast<uint32_t>(drawRanges_.size()) - lodRange.drawRangeOffset;
+            lodRanges_.push_back(lodRange);
+        }
+    }
+
+    // ===================================
+    // 境界（ローダーを通らずに作られたモデルデータはここで求める）
+    // ===================================
+    if (modelData_.bounds.IsEmpty() && vertexCount > 0) {
+        const Vector4* positions = &modelData_.vertices[0].position;
+        modelData_.bounds = AABB::FromPoints(positions, vertexCount, sizeof(VertexData));
+        modelData_.boundingSphere = BoundingSphere::FromPoints(positions, vertexCount, modelData_.bounds, sizeof(VertexData));
+    }
+
+    // ===================================
+    // マテリアルリソースの生成（マテリアル表が無いモデルは material 1 つ）
+    // ===================================
+    const std::span<const MaterialData> materials = modelData_.materials.empty()
+        ? std::span<const MaterialData>(&modelData_.material, 1)
+        : std::span<const MaterialData>(modelData_.materials);
+    materialCount_ = static_cast<uint32_t>(materials.size());
+
+    materialResource_ = CreateBufferResource(device, Align256(sizeof(Material)) * materialCount_);
     materialResource_.Get()->Map(0, nullptr, reinterpret_cast<void**>(&materialData_));
 
     // デフォルト値を設定
-    materialData_->color = { 1.0f, 1.0f, 1.0f, 1.0f };
-    materialData_->enableLighting = true;
-    materialData_->uvTransform = Matrix4x4::MakeIdentity4x4();
+    for (uint32_t i = 0; i < materialCount_; ++i) {
+        Material* material = GetMaterialData(i);
+        material->color = { 1.0f, 1.0f, 1.0f, 1.0f };
+        material->enableLighting = true;
+        material->uvTransform = Matrix4x4::MakeIdentity4x4();
+    }
     // マップしたままにする
 
     // ===================================
     // テクスチャの読み込み（TextureManager使用）
     // ===================================
-    if (!modelData_.material.textureFilePath.empty()) {
-        const Texture* tex = TextureManager::GetInstance()->Load(
-            modelData_.material.textureFilePath,
+    // SRV はストリーミングで差し替わるので、ハンドルを持っておいて描画のたびに引く
+    TextureManager* textureManager = TextureManager::GetInstance();
+    textureHandles_.resize(materialCount_);
+    textureRequestScales_.assign(materialCount_, 1.0f);
+    for (uint32_t i = 0; i < materialCount_; ++i) {
+        if (materials[i].textureFilePath.empty()) {
+            // テクスチャが無くても前のマテリアルのテクスチャが残らないように白を設定する（色は Material::color だけになる）
+            textureHandles_[i] = textureManager->LoadWhiteHandle(commandList);
+            continue;
+        }
+        // アトラスに入っていて UV が 0～1 に収まるならページを使い、uvTransform でタイルに移す
+        // （UV が繰り返すメッシュは隣のタイルを読んでしまうので個別のテクスチャを読む）
+        const AtlasTile* tile = textureManager->FindAtlasTile(materials[i].textureFilePath);
+        if (tile && IsTexcoordInUnitRange(i)) {
+            textureHandles_[i] = tile->page;
+            GetMaterialData(i)->uvTransform = tile->uvTransform;
+            // ページ全体ではなくタイルの大きさでミップを選ぶ
+            textureRequestScales_[i] = 1.0f / (std::max)(tile->uvTransform.m[0][0], tile->uvTransform.m[1][1]);
+            continue;
+        }
+        textureHandles_[i] = textureManager->LoadHandle(
+            materials[i].textureFilePath,
             commandList);
+    }
+}
 
-        if (tex) {
-            textureSrvHandleGPU_ = tex->gpuHandle;
+bool Model::IsTexcoordInUnitRange(uint32_t materialIndex) const {
+    constexpr float kEpsilon = 1.0e-4f;
+    auto inRange = [&](uint32_t vertexIndex) {
+        const Vector2& texcoord = modelData_.vertices[vertexIndex].texcoord;
+        return texcoord.x >= -kEpsilon && texcoord.x <= 1.0f + kEpsilon &&
+            texcoord.y >= -kEpsilon && texcoord.y <= 1.0f + kEpsilon;
+    };
+
+    // インデックスが無いモデルはマテリアル 1 つで全頂点
+    if (modelData_.indices.empty()) {
+        for (uint32_t v = 0; v < modelData_.vertices.size(); ++v) {
+            if (!inRange(v)) {
+                return false;
+            }
         }
+        return true;
+    }
+    for (const DrawRange& range : drawRanges_) {
+        if (range.materialIndex != materialIndex) {
+            continue;
+        }
+        for (uint32_t i = range.indexOffset; i < range.indexOffset + range.indexCount; ++i) {
+            if (!inRange(modelData_.indices[i])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+Material* Model::GetMaterialData(uint32_t materialIndex) {
+    assert(materialIndex < materialCount_);
+    return reinterpret_cast<Material*>(reinterpret_cast<uint8_t*>(materialData_) + Align256(sizeof(Material)) * materialIndex);
+}
+
+const Material* Model::GetMaterialData(uint32_t materialIndex) const {
+    return const_cast<Model*>(this)->GetMaterialData(materialIndex);
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE Model::GetTextureSrvHandleGPU(uint32_t materialIndex) const {
+    return materialIndex < textureHandles_.size() ? TextureManager::GetInstance()->GetGpuHandle(textureHandles_[materialIndex]) : D3D12_GPU_DESCRIPTOR_HANDLE{};
+}
+
+void Model::BindMaterial(
+    ID3D12GraphicsCommandList* commandList,
+    uint32_t materialIndex,
+    uint32_t rootParameterIndexMaterial,
+    uint32_t rootParameterIndexTexture,
+    D3D12_GPU_DESCRIPTOR_HANDLE& boundTexture) const
+{
+    commandList->SetGraphicsRootConstantBufferView(
+        rootParameterIndexMaterial,
+        materialResource_.Get()->GetGPUVirtualAddress() + Align256(sizeof(Material)) * materialIndex);
+
+    // 同じアトラスのページを使うマテリアルが続くときは設定し直さない
+    const D3D12_GPU_DESCRIPTOR_HANDLE textureSrvHandle = TextureManager::GetInstance()->GetGpuHandle(textureHandles_[materialIndex]);
+    assert(textureSrvHandle.ptr != 0 && "マテリアルのテクスチャが無い（Initialize で白いテクスチャを設定しているはず）");
+    if (textureSrvHandle.ptr != boundTexture.ptr) {
+        commandList->SetGraphicsRootDescriptorTable(
+            rootParameterIndexTexture,
+            textureSrvHandle);
+        boundTexture = textureSrvHandle;
     }
 }
 
@@ -85,41 +289,233 @@ void Model::Draw(
     const WorldTransform& worldTransform,
     uint32_t rootParameterIndexWVP,
     uint32_t rootParameterIndexMaterial,
-    uint32_t rootParameterIndexTexture)
+    uint32_t rootParameterIndexTexture,
+    uint32_t rootParameterIndexQuantization)
+{
+    // カメラが無いと画面上の大きさが分からないので、粗いミップのまま残らないように全段を要求する
+    for (uint32_t i = 0; i < materialCount_; ++i) {
+        TextureManager::GetInstance()->RequestMip(textureHandles_[i], std::numeric_limits<float>::max());
+    }
+
+    DrawLod(commandList, worldTransform, 0,
+        rootParameterIndexWVP, rootParameterIndexMaterial, rootParameterIndexTexture, rootParameterIndexQuantization);
+}
+
+void Model::Draw(
+    ID3D12GraphicsCommandList* commandList,
+    const WorldTransform& worldTransform,
+    const Camera& camera,
+    uint32_t rootParameterIndexWVP,
+    uint32_t rootParameterIndexMaterial,
+    uint32_t rootParameterIndexTexture,
+    uint32_t rootParameterIndexQuantization)
+{
+    const uint32_t lodIndex = SelectLod(worldTransform, camera, static_cast<float>(kClientHeight));
+
+    // 画面上の大きさに見合うミップを要求する（ストリーミングしていなければ何もしない）
+    const float screenSize = ComputeScreenSize(worldTransform, camera, static_cast<float>(kClientHeight));
+    for (uint32_t i = 0; i < materialCount_; ++i) {
+        TextureManager::GetInstance()->RequestMip(textureHandles_[i], screenSize * textureRequestScales_[i]);
+    }
+
+    // 最も細かい LOD は meshlet 単位でカリングして描く（meshlet は LOD0 からしか作っていない）
+    if (lodIndex == 0 && !meshletRanges_.empty()) {
+        CullMeshlets(worldTransform, camera);
+        if (visibleRanges_.empty()) {
+            return;
+        }
+        SetDrawState(commandList, worldTransform, rootParameterIndexWVP, rootParameterIndexQuantization);
+        DrawRanges(commandList, visibleRanges_, rootParameterIndexMaterial, rootParameterIndexTexture);
+        return;
+    }
+
+    DrawLod(commandList, worldTransform, lodIndex,
+        rootParameterIndexWVP, rootParameterIndexMaterial, rootParameterIndexTexture, rootParameterIndexQuantization);
+}
+
+// ===================================
+// meshlet 単位のカリング
+// ===================================
+void Model::CullMeshlets(const WorldTransform& worldTransform, const Camera& camera) {
+    const Affine3x4& world = worldTransform.GetWorldMatrix();
+
+    // WVP から取り出した平面はモデル空間なので、境界球を変換せずに比べられる
+    const Frustum frustum = Frustum::FromMatrix(Affine3x4::Multiply(world, camera.GetViewProjectionMatrix()));
+
+    // カメラ位置もモデル空間へ（ビュー行列の逆の平行移動がワールド空間のカメラ位置）
+    const Affine3x4 inverseView = Affine3x4::Inverse(Affine3x4::FromMatrix4x4(camera.GetViewMatrix()));
+    const Vector3 cameraPosition = Affine3x4::TransformPoint(inverseView.GetTranslation(), Affine3x4::Inverse(world));
+
+    // 負のスケールで裏返ったモデルは表裏が逆になるので、円錐での裏面カリングはしない
+    const float determinant =
+        world.m[0][0] * (world.m[1][1] * world.m[2][2] - world.m[1][2] * world.m[2][1]) -
+        world.m[0][1] * (world.m[1][0] * world.m[2][2] - world.m[1][2] * world.m[2][0]) +
+        world.m[0][2] * (world.m[1][0] * world.m[2][1] - world.m[1][1] * world.m[2][0]);
+    const bool cullBackFaces = determinant > 0.0f;
+
+    visibleRanges_.clear();
+    for (size_t i = 0; i < meshletRanges_.size(); ++i) {
+        const Meshlet& meshlet = modelData_.meshlets[i];
+        if (!frustum.Intersects(meshlet.bounds) ||
+            (cullBackFaces && MeshletBuilder::IsBackFacing(meshlet, cameraPosition))) {
+            continue;
+        }
+        // 同じマテリアルでインデックスが続いていれば 1 回の描画にまとめる
+        const DrawRange& range = meshletRanges_[i];
+        if (!visibleRanges_.empty() &&
+            visibleRanges_.back().materialIndex == range.materialIndex &&
+            visibleRanges_.back().indexOffset + visibleRanges_.back().indexCount == range.indexOffset) {
+            visibleRanges_.back().indexCount += range.indexCount;
+        } else {
+            visibleRanges_.push_back(range);
+        }
+    }
+}
+
+// ===================================
+// LOD の選択
+// ===================================
+uint32_t Model::SelectLod(const WorldTransform& worldTransform, const Camera& camera, float screenHeight) const {
+    if (lodRanges_.size() <= 1) {
+        return 0;
+    }
+
+    // 境界球をワールド空間、ビュー空間へ
+    const Affine3x4& world = worldTransform.GetWorldMatrix();
+    const BoundingSphere worldSphere = BoundingSphere::Transform(modelData_.boundingSphere, world);
+    const Vector3 viewCenter = Vector3::Transform(worldSphere.center, camera.GetViewMatrix());
+    // ワールド空間の誤差 = モデル空間の誤差 × 一番大きい軸のスケール
+    const float scale = modelData_.boundingSphere.radius > 0.0f ? worldSphere.radius / modelData_.boundingSphere.radius : 1.0f;
+
+    // 球の一番手前の深さで見積もる（カメラが球の中にあれば最も細かい LOD）
+    const float nearestDepth = viewCenter.z - worldSphere.radius;
+    if (nearestDepth <= 0.0f) {
+        return 0;
+    }
+
+    // 距離 1 のときの 1 ワールド単位あたりのピクセル数（射影行列の m[1][1] = 1 / tan(fovY / 2)）
+    const float pixelsPerUnit = camera.GetProjectionMatrix().m[1][1] * screenHeight * 0.5f / nearestDepth;
+
+    uint32_t lodIndex = 0;
+    for (uint32_t i = 1; i < lodRanges_.size(); ++i) {
+        if (lodRanges_[i].error * scale * pixelsPerUnit > kLodPixelError) {
+            break;
+        }
+        lodIndex = i;
+    }
+    return lodIndex;
+}
+
+float Model::ComputeScreenSize(const WorldTransform& worldTransform, const Camera& camera, float screenHeight) const {
+    const BoundingSphere worldSphere = BoundingSphere::Transform(modelData_.boundingSphere, worldTransform.GetWorldMatrix());
+    const Vector3 viewCenter = Vector3::Transform(worldSphere.center, camera.GetViewMatrix());
+
+    // カメラが球の中にあれば画面いっぱい以上
+    const float nearestDepth = viewCenter.z - worldSphere.radius;
+    if (nearestDepth <= 0.0f) {
+        return std::numeric_limits<float>::max();
+    }
+    return 2.0f * worldSphere.radius * camera.GetProjectionMatrix().m[1][1] * screenHeight * 0.5f / nearestDepth;
+}
+
+// ===================================
+// 描画
+// ===================================
+void Model::DrawLod(
+    ID3D12GraphicsCommandList* commandList,
+    const WorldTransform& worldTransform,
+    uint32_t lodIndex,
+    uint32_t rootParameterIndexWVP,
+    uint32_t rootParameterIndexMaterial,
+    uint32_t rootParameterIndexTexture,
+    uint32_t rootParameterIndexQuantization)
+{
+    SetDrawState(commandList, worldTransform, rootParameterIndexWVP, rootParameterIndexQuantization);
+
+    if (!indexBuffer_.Get()) {
+        D3D12_GPU_DESCRIPTOR_HANDLE boundTexture{};
+        BindMaterial(commandList, 0, rootParameterIndexMaterial, rootParameterIndexTexture, boundTexture);
+        commandList->DrawInstanced(
+            static_cast<UINT>(modelData_.vertices.size()), 1, 0, 0);
+        return;
+    }
+
+    assert(lodIndex < lodRanges_.size());
+    const LodRange& lod = lodRanges_[lodIndex];
+    DrawRanges(commandList,
+        std::span<const DrawRange>(drawRanges_).subspan(lod.drawRangeOffset, lod.drawRangeCount),
+        rootParameterIndexMaterial, rootParameterIndexTexture);
+}
+
+void Model::SetDrawState(
+    ID3D12GraphicsCommandList* commandList,
+    const WorldTransform& worldTransform,
+    uint32_t rootParameterIndexWVP,
+    uint32_t rootParameterIndexQuantization) const
 {
     commandList->IASetVertexBuffers(0, 1, &vertexBufferView_);
-    commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
-    commandList->SetGraphicsRootConstantBufferView(
-        rootParameterIndexMaterial,
-        materialResource_.Get()->GetGPUVirtualAddress());
+    if (vertexFormat_ == VertexFormat::Packed) {
+        commandList->SetGraphicsRoot32BitConstants(
+            rootParameterIndexQuantization,
+            sizeof(VertexQuantization) / sizeof(uint32_t), &vertexQuantization_, 0);
+    }
+    commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
     // 外部のWorldTransformを直接使う（コピーしない）
     commandList->SetGraphicsRootConstantBufferView(
         rootParameterIndexWVP,
         worldTransform.GetGPUVirtualAddress());
+}
 
-    if (textureResource_.Get() || textureSrvHandleGPU_.ptr != 0) {
-        commandList->SetGraphicsRootDescriptorTable(
-            rootParameterIndexTexture,
-            textureSrvHandleGPU_);
+void Model::DrawRanges(
+    ID3D12GraphicsCommandList* commandList,
+    std::span<const DrawRange> ranges,
+    uint32_t rootParameterIndexMaterial,
+    uint32_t rootParameterIndexTexture) const
+{
+    // バッファは 1 度だけ設定し、マテリアルが変わるときだけ設定し直す
+    commandList->IASetIndexBuffer(&indexBufferView_);
+    D3D12_GPU_DESCRIPTOR_HANDLE boundTexture{};
+    uint32_t boundMaterial = materialCount_;
+    for (const DrawRange& range : ranges) {
+        if (range.materialIndex != boundMaterial) {
+            BindMaterial(commandList, range.materialIndex, rootParameterIndexMaterial, rootParameterIndexTexture, boundTexture);
+            boundMaterial = range.materialIndex;
+        }
+        commandList->DrawIndexedInstanced(range.indexCount, 1, range.indexOffset, 0, 0);
     }
-
-    commandList->DrawInstanced(
-        static_cast<UINT>(modelData_.vertices.size()), 1, 0, 0);
 }
 
 void Model::ShowDebugUI(std::string tag, WorldTransform& worldTransform) {
     if (ImGui::TreeNode(tag.c_str())) {
-        ImGui::DragFloat3("Position", &worldTransform.translation_.x, 0.1f);
-        ImGui::DragFloat3("Rotation", &worldTransform.rotation_.x, 0.1f);
-        ImGui::DragFloat3("Scale", &worldTransform.scale_.x, 0.1f);
+        Vector3 translation = worldTransform.GetTranslation();
+        Vector3 rotation = worldTransform.GetRotation();
+        Vector3 scale = worldTransform.GetScale();
+        if (ImGui::DragFloat3("Position", &translation.x, 0.1f)) {
+            worldTransform.SetTranslation(translation);
+        }
+        if (ImGui::DragFloat3("Rotation", &rotation.x, 0.1f)) {
+            worldTransform.SetRotation(rotation);
+        }
+        if (ImGui::DragFloat3("Scale", &scale.x, 0.1f)) {
+            worldTransform.SetScale(scale);
+        }
 
         //// マテリアル情報の表示
         ImGui::Separator();
         ImGui::Text("Material:");
-        ImGui::ColorEdit4("Color", reinterpret_cast<float*>(&materialData_->color));
-        ImGui::Checkbox("Enable Lighting", reinterpret_cast<bool*>(&materialData_->enableLighting));
+        for (uint32_t i = 0; i < materialCount_; ++i) {
+            Material* material = GetMaterialData(i);
+            ImGui::PushID(static_cast<int>(i));
+            if (materialCount_ > 1) {
+                const std::string& name = modelData_.materials[i].name;
+                ImGui::Text("%s", name.empty() ? "(default)" : name.c_str());
+            }
+            ImGui::ColorEdit4("Color", reinterpret_cast<float*>(&material->color));
+            ImGui::Checkbox("Enable Lighting", reinterpret_cast<bool*>(&material->enableLighting));
+            ImGui::PopID();
+        }
         ImGui::TreePop();
     }
 }
\ No newline at end of file
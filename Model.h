@@ -1,9 +1,12 @@
 #pragma once
 #include "ModelData.h"
+#include "PackedVertexData.h"
 #include "ResourceObject.h"
 #include "WorldTransform.h"
 #include "Camera.h"
+#include "TextureManager.h"
 #include <d3d12.h>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -14,23 +17,57 @@ public:
     /// <summary>
     /// OBJファイルからモデルを生成（テクスチャはTextureManagerで管理）
     /// </summary>
+    /// <param name="vertexFormat">頂点バッファの形式（Packed は PipelineType::Object3DPacked で描画する）</param>
     static Model* CreateFromOBJ(
         const std::string& directoryPath,
         const std::string& filename,
-        ID3D12GraphicsCommandList* commandList);
+        ID3D12GraphicsCommandList* commandList,
+        VertexFormat vertexFormat = VertexFormat::Standard);
 
     /// <summary>
-    /// 描画
+    /// 読み込み済みのモデルデータから生成（共有したい場合は ModelRegistry を使う）
+    /// </summary>
+    static Model* CreateFromModelData(
+        const ModelData& modelData,
+        ID3D12GraphicsCommandList* commandList,
+        VertexFormat vertexFormat = VertexFormat::Standard);
+
+    /// <summary>
+    /// 描画（最も細かい LOD。画面上の大きさが分からないので、テクスチャは一番細かいミップを要求する）
     /// </summary>
     /// <param name="worldTransform">ワールドトランスフォーム</param>
-    /// <param name="camera">カメラ</param>
-    /// <param name="objectColor">オブジェクトカラー</param>
     void Draw(
         ID3D12GraphicsCommandList* commandList,
         const WorldTransform& worldTransform,
         uint32_t rootParameterIndexWVP = 1,
         uint32_t rootParameterIndexMaterial = 0,
-        uint32_t rootParameterIndexTexture = 2);
+        uint32_t rootParameterIndexTexture = 2,
+        uint32_t rootParameterIndexQuantization = 4);
+
+    /// <summary>
+    /// カメラからの見え方で LOD を選んで描画
+    /// </summary>
+    /// <param name="camera">LOD の選択に使うカメラ（行列は更新済みであること）</param>
+    void Draw(
+        ID3D12GraphicsCommandList* commandList,
+        const WorldTransform& worldTransform,
+        const Camera& camera,
+        uint32_t rootParameterIndexWVP = 1,
+        uint32_t rootParameterIndexMaterial = 0,
+        uint32_t rootParameterIndexTexture = 2,
+        uint32_t rootParameterIndexQuantization = 4);
+
+    /// <summary>
+    /// 画面上の誤差が kLodPixelError ピクセル以下になる最も粗い LOD を選ぶ
+    /// </summary>
+    /// <param name="screenHeight">描画先の高さ（ピクセル）</param>
+    uint32_t SelectLod(const WorldTransform& worldTransform, const Camera& camera, float screenHeight) const;
+
+    /// <summary>
+    /// 境界球が画面上に占める直径（ピクセル）。テクスチャのミップの要求に使う
+    /// </summary>
+    /// <param name="screenHeight">描画先の高さ（ピクセル）</param>
+    float ComputeScreenSize(const WorldTransform& worldTransform, const Camera& camera, float screenHeight) const;
 
     /// <summary>
 	/// デバッグ用GUI表示
@@ -40,9 +77,17 @@ public:
     void ShowDebugUI(std::string tag, WorldTransform& worldTransform);
 
     const ModelData& GetModelData() const { return modelData_; }  // モデルデータへのアクセス
-    Material* GetMaterialData() { return materialData_; }  // マテリアルデータへのアクセス
-    const Material* GetMaterialData() const { return materialData_; } 
-	D3D12_GPU_DESCRIPTOR_HANDLE GetTextureSrvHandleGPU() const { return textureSrvHandleGPU_; } // テクスチャSRVハンドルへのアクセス
+    Material* GetMaterialData(uint32_t materialIndex = 0);  // マテリアルデータへのアクセス
+    const Material* GetMaterialData(uint32_t materialIndex = 0) const;
+	D3D12_GPU_DESCRIPTOR_HANDLE GetTextureSrvHandleGPU(uint32_t materialIndex = 0) const; // テクスチャSRVハンドルへのアクセス
+    uint32_t GetMaterialCount() const { return materialCount_; }
+    VertexFormat GetVertexFormat() const { return vertexFormat_; }
+    uint32_t GetLodCount() const { return static_cast<uint32_t>(lodRanges_.size()); }
+    const AABB& GetBounds() const { return modelData_.bounds; }                       // モデル空間の境界
+    const BoundingSphere& GetBoundingSphere() const { return modelData_.boundingSphere; }
+
+    // LOD を切り替える画面上の誤差（ピクセル）
+    static constexpr float kLodPixelError = 1.0f;
 
 private:
 
@@ -51,24 +96,102 @@ private:
     /// </summary>
     void Initialize(
         const ModelData& modelData,
-        ID3D12GraphicsCommandList* commandList);
+        ID3D12GraphicsCommandList* commandList,
+        VertexFormat vertexFormat);
+
+    /// <summary>
+    /// マテリアルの定数バッファとテクスチャを設定
+    /// </summary>
+    /// <param name="boundTexture">直前に設定したテクスチャ（同じなら設定し直さず、設定したら書き換える）</param>
+    void BindMaterial(
+        ID3D12GraphicsCommandList* commandList,
+        uint32_t materialIndex,
+        uint32_t rootParameterIndexMaterial,
+        uint32_t rootParameterIndexTexture,
+        D3D12_GPU_DESCRIPTOR_HANDLE& boundTexture) const;
+
+    /// <summary>
+    /// マテリアルを使う頂点の UV が全て 0～1 に収まるか（アトラスのタイルに移せるか）
+    /// </summary>
+    bool IsTexcoordInUnitRange(uint32_t materialIndex) const;
+
+    // 1 回の DrawIndexedInstanced で描く範囲（同じマテリアルで連続する SubMesh をまとめたもの）
+    struct DrawRange {
+        uint32_t indexOffset = 0;
+        uint32_t indexCount = 0;
+        uint32_t materialIndex = 0;
+    };
+
+    /// <summary>
+    /// 指定した LOD を描画（Draw の中身）
+    /// </summary>
+    void DrawLod(
+        ID3D12GraphicsCommandList* commandList,
+        const WorldTransform& worldTransform,
+        uint32_t lodIndex,
+        uint32_t rootParameterIndexWVP,
+        uint32_t rootParameterIndexMaterial,
+        uint32_t rootParameterIndexTexture,
+        uint32_t rootParameterIndexQuantization);
+
+    /// <summary>
+    /// 視錐台の外と裏向きの meshlet を除き、残りを同じマテリアルで連続する範囲にまとめて visibleRanges_ に入れる
+    /// </summary>
+    void CullMeshlets(const WorldTransform& worldTransform, const Camera& camera);
+
+    /// <summary>
+    /// 頂点バッファ・トポロジ・WVP を設定（DrawLod と meshlet 単位の描画で共通）
+    /// </summary>
+    void SetDrawState(
+        ID3D12GraphicsCommandList* commandList,
+        const WorldTransform& worldTransform,
+        uint32_t rootParameterIndexWVP,
+        uint32_t rootParameterIndexQuantization) const;
+
+    /// <summary>
+    /// インデックスバッファの範囲を順に描く（マテリアルが変わるときだけ設定し直す）
+    /// </summary>
+    void DrawRanges(
+        ID3D12GraphicsCommandList* commandList,
+        std::span<const DrawRange> ranges,
+        uint32_t rootParameterIndexMaterial,
+        uint32_t rootParameterIndexTexture) const;
 	
 private:
+
     // モデルデータ
     ModelData modelData_;
 
     // 頂点バッファ
     ResourceObject vertexBuffer_;
     D3D12_VERTEX_BUFFER_VIEW vertexBufferView_{};
+    VertexFormat vertexFormat_ = VertexFormat::Standard;
+    VertexQuantization vertexQuantization_{}; // Packed のときの位置の復元用
+
+    // インデックスバッファ（頂点数が 65535 以下なら 16bit、それ以外は 32bit）
+    ResourceObject indexBuffer_;
+    D3D12_INDEX_BUFFER_VIEW indexBufferView_{};
+    std::vector<DrawRange> drawRanges_; // LOD ごとにマテリアル順
 
-    // マテリアル
+    // LOD 1 段分の描画範囲（drawRanges_ の連続した区間）
+    struct LodRange {
+        uint32_t drawRangeOffset = 0;
+        uint32_t drawRangeCount = 0;
+        float error = 0.0f; // モデル空間での誤差
+    };
+    std::vector<LodRange> lodRanges_; // 細かい順（インデックスが無いモデルは空）
+
+    // meshlet ごとの描画範囲（modelData_.meshlets と同じ順。三角形はインデックスバッファの LOD の後ろに並べ直してある）
+    std::vector<DrawRange> meshletRanges_;
+    std::vector<DrawRange> visibleRanges_; // CullMeshlets の結果（描画のたびに確保し直さないように持っておく）
+
+    // マテリアル（1 つのバッファに 256 バイト境界で並べる）
     ResourceObject materialResource_;
     Material* materialData_ = nullptr;
+    uint32_t materialCount_ = 0;
 
-    // テクスチャ（TextureManager管理の場合は空）
-    ResourceObject textureResource_;
-    D3D12_GPU_DESCRIPTOR_HANDLE textureSrvHandleGPU_{};
-
-    // アップロード用中間リソース
-    std::vector<ResourceObject> intermediateResources_;
+    // テクスチャ（マテリアルごと。テクスチャなしは無効なハンドル）
+    // アトラスのページを使うマテリアルは uvTransform にタイルへの変換が入っている
+    std::vector<TextureHandle> textureHandles_;
+    std::vector<float> textureRequestScales_; // ミップを要求するときの画面上の大きさの倍率（ページ / タイル）
 };
\ No newline at end of file
@@ -1,10 +1,60 @@
 #pragma once
+#include <cstdint>
+#include <string>
 #include <vector>
 #include "VertexData.h"
 #include "MaterialData.h"
+#include "BoundingVolume.h"
+
+// インデックスバッファの一区間（OBJ の o / g / usemtl の切れ目ごと）
+struct SubMesh {
+	std::string name;           // o / g の名前（無ければ空）
+	uint32_t indexOffset = 0;   // indices の先頭位置
+	uint32_t indexCount = 0;
+	uint32_t materialIndex = 0; // ModelData::materials の番号
+};
+
+// 詳細度（LOD）1 段分。各 LOD は subMeshes の連続した範囲で、インデックスは同じ頂点を指す
+struct MeshLod {
+	uint32_t subMeshOffset = 0; // subMeshes の先頭
+	uint32_t subMeshCount = 0;
+	uint32_t indexCount = 0;    // この LOD の全インデックス数（三角形数 × 3）
+	float error = 0.0f;         // 元の形状からの誤差（モデル空間の距離の目安。MeshSimplifier 参照。LOD0 は 0）
+};
+
+// 頂点 64 / 三角形 124 以下の小さな塊（メッシュシェーダーや塊単位のカリング用）
+// 三角形は meshletTriangles に「この meshlet 内の頂点番号」3 バイトずつで並ぶ
+struct Meshlet {
+	uint32_t vertexOffset = 0;   // ModelData::meshletVertices の先頭
+	uint32_t triangleOffset = 0; // ModelData::meshletTriangles の先頭（バイト単位）
+	uint32_t vertexCount = 0;
+	uint32_t triangleCount = 0;
+	uint32_t materialIndex = 0;
+	BoundingSphere bounds;       // モデル空間
+	// 法線の円錐。dot(normalize(coneApex - カメラ位置), coneAxis) >= coneCutoff なら全三角形が裏向き
+	Vector3 coneApex{};
+	Vector3 coneAxis{};
+	float coneCutoff = 1.0f;     // 法線が広がりすぎて判定できない塊は 1 より大きい
+};
 
 struct ModelData {
 	std::vector<VertexData> vertices;
-	MaterialData material;
-};
+	std::vector<uint32_t> indices; // 三角形リストのインデックス（空なら vertices をそのまま三角形リストとして描く）
+	MaterialData material;         // 単一マテリアルのモデル用（OBJ から読んだ場合は先頭の区間のマテリアル）
+
+	// 複数マテリアル用。区間はマテリアル順に並べてある（空なら全体を material で描く）
+	std::vector<MaterialData> materials;
+	std::vector<SubMesh> subMeshes;
+
+	// 粗くなる順の LOD。lods[0] が元の形状（空なら subMeshes 全体が 1 つの LOD）
+	std::vector<MeshLod> lods;
 
+	// LOD0 を分割した meshlet（MeshletBuilder が作る。SubMesh をまたがない）
+	std::vector<Meshlet> meshlets;
+	std::vector<uint32_t> meshletVertices;  // meshlet の頂点番号 → vertices の番号
+	std::vector<uint8_t> meshletTriangles;  // meshlet 内の頂点番号 3 つで 1 三角形
+
+	// モデル空間の境界（全頂点を包む。ローダーが求める）
+	AABB bounds = AABB::MakeEmpty();
+	BoundingSphere boundingSphere;
+};
@@ -0,0 +1,148 @@
+#include "ModelRegistry.h"
+#include "GraphicsCore.h"
+#include "MeshCache.h"
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <exception>
+#include <filesystem>
+#include <iterator>
+
+ModelRegistry* ModelRegistry::GetInstance() {
+    static ModelRegistry instance;
+    return &instance;
+}
+
+// ===================================
+// キー
+// ===================================
+std::string ModelRegistry::MakeKey(const std::string& directoryPath, const std::string& filename, VertexFormat vertexFormat) {
+    std::string key = (std::filesystem::path(directoryPath) / filename).lexically_normal().generic_string();
+#ifdef _WIN32
+    std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+#endif
+    if (vertexFormat == VertexFormat::Packed) {
+        key += "|packed"; // 頂点バッファが別物なので別のモデルとして扱う
+    }
+    return key;
+}
+
+// ===================================
+// 読み込み
+// ===================================
+ModelHandle ModelRegistry::Load(
+    const std::string& directoryPath,
+    const std::string& filename,
+    ID3D12GraphicsCommandList* commandList,
+    VertexFormat vertexFormat)
+{
+    const std::string key = MakeKey(directoryPath, filename, vertexFormat);
+
+    std::promise<ModelHandle> promise;
+    {
+        // ハンドルの破棄（削除子がこのロックを取る）はロックの外で行うこと
+        ModelHandle loaded;
+        std::shared_future<ModelHandle> pending;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            Entry& entry = entries_[key];
+            loaded = entry.model.lock();
+            if (!loaded) {
+                if (entry.pending.valid()) {
+                    pending = entry.pending;
+                } else {
+                    // 自分が読み込む。他のスレッドは pending を待つ
+                    entry.pending = promise.get_future().share();
+                }
+            }
+        }
+        if (loaded) {
+            return loaded;
+        }
+        if (pending.valid()) {
+            return pending.get();
+        }
+    }
+
+    // 解析はロックの外で（別のアセットの読み込みと並行できる）
+    Model* model = nullptr;
+    try {
+        const ModelData modelData = MeshCache::Load(directoryPath, filename);
+
+        std::lock_guard<std::mutex> gpuLock(gpuMutex_);
+        model = Model::CreateFromModelData(modelData, commandList, vertexFormat);
+    } catch (...) {
+        // 待っているスレッドにも同じ例外を届け、次の Load で読み直せるように登録を消す
+        promise.set_exception(std::current_exception());
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = entries_.find(key);
+            if (it != entries_.end() && it->second.model.expired()) {
+                entries_.erase(it);
+            }
+        }
+        throw;
+    }
+    ModelHandle handle(model, [this, key](Model* released) { Release(key, released); });
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Entry& entry = entries_[key];
+        entry.model = handle;
+        entry.pending = {};
+    }
+    promise.set_value(handle);
+    return handle;
+}
+
+// 最後のハンドルが消えたとき（GPU がまだ使っているかもしれないので、すぐには消さない）
+void ModelRegistry::Release(const std::string& key, Model* model) {
+    // 次に実行されるコマンドリストのフェンス値。記録済みで未実行の描画もそのコマンドリストで送られるので、これまでに終わる
+    const uint64_t fenceValue = GraphicsCore::GetInstance()->GetGraphicsQueue().GetNextFenceValue();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end() && it->second.model.expired() && !it->second.pending.valid()) {
+        entries_.erase(it);
+    }
+    pendingReleases_.push_back({ fenceValue, std::unique_ptr<Model>(model) });
+}
+
+// ===================================
+// 解放
+// ===================================
+void ModelRegistry::Update() {
+    CommandQueue& graphicsQueue = GraphicsCore::GetInstance()->GetGraphicsQueue();
+
+    // 破棄はロックの外で行う
+    std::vector<PendingRelease> completed;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto firstCompleted = std::partition(pendingReleases_.begin(), pendingReleases_.end(),
+            [&](const PendingRelease& release) { return !graphicsQueue.IsFenceComplete(release.fenceValue); });
+        std::move(firstCompleted, pendingReleases_.end(), std::back_inserter(completed));
+        pendingReleases_.erase(firstCompleted, pendingReleases_.end());
+    }
+}
+
+void ModelRegistry::Shutdown() {
+    std::vector<PendingRelease> released;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // まだハンドルを持っている利用者がいれば解放漏れ
+        assert(std::all_of(entries_.begin(), entries_.end(), [](const auto& entry) { return entry.second.model.expired(); }) &&
+            "ModelRegistry::Shutdown の前に全ての ModelHandle を破棄すること");
+        entries_.clear();
+        released.swap(pendingReleases_);
+    }
+}
+
+size_t ModelRegistry::GetLoadedCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<size_t>(std::count_if(entries_.begin(), entries_.end(), [](const auto& entry) { return !entry.second.model.expired(); }));
+}
+
+size_t ModelRegistry::GetPendingReleaseCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pendingReleases_.size();
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "Model.h"
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// モデルの共有ハンドル（最後のハンドルが消えると GPU の使用が終わってから解放される）
+using ModelHandle = std::shared_ptr<Model>;
+
+// ==================================
+// モデルの読み込み窓口
+// ==================================
+// 正規化したパス（+ 頂点形式）ごとに Model を 1 つだけ作り、共有ハンドルで配る。
+// 同じアセットを複数のスレッドが同時に要求しても、解析と GPU バッファの作成は 1 回だけ。
+// 参照が無くなったモデルは、そのフレームのコマンドがフェンスを通過するまで Update で解放を待つ。
+class ModelRegistry {
+public:
+    static ModelRegistry* GetInstance();
+
+    // 読み込み済みならそれを返し、無ければ OBJ（キャッシュ経由）から作る
+    // commandList : テクスチャ転送などを積む（GPU 側の作成は内部でスレッド間の順番を取る）
+    // 読み込みが例外で失敗したら、同じアセットを待っていたスレッドにも同じ例外を投げる（登録は残さない）
+    ModelHandle Load(
+        const std::string& directoryPath,
+        const std::string& filename,
+        ID3D12GraphicsCommandList* commandList,
+        VertexFormat vertexFormat = VertexFormat::Standard);
+
+    // GPU の使用が終わったモデルを解放する（毎フレーム呼ぶ）
+    void Update();
+
+    // 解放待ちのモデルをすべて解放する（GPU の完了を待ってから呼ぶこと）
+    void Shutdown();
+
+    // 読み込み済み（まだハンドルが残っている）モデルの数
+    size_t GetLoadedCount();
+    // 解放待ちのモデルの数
+    size_t GetPendingReleaseCount();
+
+    // キーの正規化（"a/./b\\c.obj" と "a/b/c.obj" を同じにする。Windows では大文字小文字も無視）
+    static std::string MakeKey(const std::string& directoryPath, const std::string& filename, VertexFormat vertexFormat);
+
+private:
+    ModelRegistry() = default;
+    ~ModelRegistry() = default;
+    ModelRegistry(const ModelRegistry&) = delete;
+    ModelRegistry& operator=(const ModelRegistry&) = delete;
+
+    struct Entry {
+        std::weak_ptr<Model> model;
+        // 読み込み中のときだけ有効（同じキーの要求はこれを待つ）
+        std::shared_future<ModelHandle> pending;
+    };
+
+    struct PendingRelease {
+        uint64_t fenceValue; // このフェンス値を GPU が通過したら解放してよい
+        std::unique_ptr<Model> model;
+    };
+
+    // ハンドルの削除子から呼ばれる
+    void Release(const std::string& key, Model* model);
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::vector<PendingRelease> pendingReleases_;
+
+    // コマンドリストへの記録はスレッドセーフではないので、GPU 側の作成は 1 つずつ
+    std::mutex gpuMutex_;
+};
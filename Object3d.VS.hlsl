@@ -3,7 +3,7 @@
 struct TransfomationMartrix
 {
     float4x4 WVP;
-    float4x4 World;
+    float3x4 World; // 3x4 アフィン（C++ 側の Affine3x4）
 };
 
 ConstantBuffer<TransfomationMartrix> gTransformationMatrix : register(b0);
@@ -21,6 +21,6 @@ VertexShaderOutput main(VertexShaderInput input)
     VertexShaderOutput output;
     output.position = mul(input.position, gTransformationMatrix.WVP);
     output.texcoord = input.texcoord;
-    output.normal = normalize(mul(input.normal, (float3x3) gTransformationMatrix.World));
+    output.normal = normalize(mul((float3x3) gTransformationMatrix.World, input.normal));
     return output;
 }
\ No newline at end of file
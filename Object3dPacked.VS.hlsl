@@ -0,0 +1,48 @@
+#include "Object3d.hlsli"
+
+struct TransfomationMartrix
+{
+    float4x4 WVP;
+    float3x4 World; // 3x4 アフィン（C++ 側の Affine3x4）
+};
+
+// 位置の復元用（C++ 側の VertexQuantization、ルート定数）
+struct VertexQuantization
+{
+    float3 positionMin;
+    float padding0;
+    float3 positionExtent;
+    float padding1;
+};
+
+ConstantBuffer<TransfomationMartrix> gTransformationMatrix : register(b0);
+ConstantBuffer<VertexQuantization> gVertexQuantization : register(b1);
+
+// C++ 側の PackedVertexData
+struct VertexShaderInput
+{
+    float4 position : POSITION0; // R16G16B16A16_UNORM（AABB 内の 0～1）
+    float2 texcoord : TEXCOORD0; // R16G16_FLOAT
+    float2 normal : NORMAL0;     // R16G16_SNORM（八面体写像）
+};
+
+// 八面体写像から単位ベクトルに戻す（VertexPacker::DecodeOctahedral と同じ計算）
+float3 DecodeOctahedral(float2 encoded)
+{
+    float3 normal = float3(encoded, 1.0f - abs(encoded.x) - abs(encoded.y));
+    float t = max(-normal.z, 0.0f);
+    normal.x += normal.x >= 0.0f ? -t : t;
+    normal.y += normal.y >= 0.0f ? -t : t;
+    return normalize(normal);
+}
+
+VertexShaderOutput main(VertexShaderInput input)
+{
+    float3 position = gVertexQuantization.positionMin + input.position.xyz * gVertexQuantization.positionExtent;
+
+    VertexShaderOutput output;
+    output.position = mul(float4(position, 1.0f), gTransformationMatrix.WVP);
+    output.texcoord = input.texcoord;
+    output.normal = normalize(mul((float3x3) gTransformationMatrix.World, DecodeOctahedral(input.normal)));
+    return output;
+}
@@ -0,0 +1,331 @@
+#include "PackedVertexData.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+constexpr float kUnorm16Max = 65535.0f;
+constexpr float kSnorm16Max = 32767.0f;
+
+uint16_t QuantizeUnorm16(float value, float minValue, float extent) {
+	if (extent <= 0.0f) {
+		return 0;
+	}
+	const float normalized = std::clamp((value - minValue) / extent, 0.0f, 1.0f);
+	return static_cast<uint16_t>(normalized * kUnorm16Max + 0.5f);
+}
+
+int16_t QuantizeSnorm16(float value) {
+	return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * kSnorm16Max));
+}
+
+float DequantizeSnorm16(int16_t value) {
+	// D3D の SNORM と同じく -32768 と -32767 はどちらも -1
+	return std::max(static_cast<float>(value) / kSnorm16Max, -1.0f);
+}
+
+float SignNotZero(float value) { return value >= 0.0f ? 1.0f : -1.0f; }
+
+}
+
+VertexQuantization VertexPacker::ComputeQuantization(std::span<const VertexData> vertices) {
+	VertexQuantization quantization = {};
+	if (vertices.empty()) {
+		return quantization;
+	}
+
+	Vector3 minPosition = { vertices[0].position.x, vertices[0].position.y, vertices[0].position.z };
+	Vector3 maxPosition = minPosition;
+	for (const VertexData& vertex : vertices) {
+		minPosition.x = std::min(minPosition.x, vertex.position.x);
+		minPosition.y = std::min(minPosition.y, vertex.position.y);
+		minPosition.z = std::min(minPosition.z, vertex.position.z);
+		maxPosition.x = std::max(maxPosition.x, vertex.position.x);
+		maxPosition.y = std::max(maxPosition.y, vertex.position.y);
+		maxPosition.z = std::max(maxPosition.z, vertex.position.z);
+	}
+
+	quantization.positionMin = minPosition;
+	quantization.positionExtent = maxPosition - minPosition;
+	return quantization;
+}
+
+PackedVertexData VertexPacker::Pack(const VertexData& vertex, const VertexQuantization& quantization) {
+	const Vector3& minPosition = quantization.positionMin;
+	const Vector3& extent = quantization.positionExtent;
+
+	PackedVertexData packed;
+	packed.position[0] = QuantizeUnorm16(vertex.position.x, minPosition.x, extent.x);
+	packed.position[1] = QuantizeUnorm16(vertex.position.y, minPosition.y, extent.y);
+	packed.position[2] = QuantizeUnorm16(vertex.position.z, minPosition.z, extent.z);
+	packed.position[3] = 0;
+	packed.texcoord[0] = FloatToHalf(vertex.texcoord.x);
+	packed.texcoord[1] = FloatToHalf(vertex.texcoord.y);
+	EncodeOctahedral(vertex.normal, packed.normal);
+	return packed;
+}
+
+VertexData VertexPacker::Unpack(const PackedVertexData& packed, const VertexQuantization& quantization) {
+	const Vector3& minPosition = quantization.positionMin;
+	const Vector3& extent = quantization.positionExtent;
+
+	VertexData vertex;
+	vertex.position = {
+		minPosition.x + static_cast<float>(packed.position[0]) / kUnorm16Max * extent.x,
+		minPosition.y + static_cast<float>(packed.position[1]) / kUnorm16Max * extent.y,
+		minPosition.z + static_cast<float>(packed.position[2]) / kUnorm16Max * extent.z,
+		1.0f,
+	};
+	vertex.texcoord = { HalfToFloat(packed.texcoord[0]), HalfToFloat(packed.texcoord[1]) };
+	vertex.normal = DecodeOctahedral(packed.normal);
+	return vertex;
+}
+
+void VertexPacker::Pack(std::span<const VertexData> vertices, const VertexQuantization& quantization, std::span<PackedVertexData> output) {
+	assert(output.size() >= vertices.size());
+	for (size_t i = 0; i < vertices.size(); ++i) {
+		output[i] = Pack(vertices[i], quantization);
+	}
+}
+
+uint16_t VertexPacker::FloatToHalf(float value) {
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+	const uint32_t absBits = bits & 0x7FFFFFFFu;
+
+	// Inf / NaN
+	if (absBits >= 0x7F800000u) {
+		return static_cast<uint16_t>(sign | 0x7C00u | (absBits > 0x7F800000u ? 0x0200u : 0u));
+	}
+	// 丸めると 65520 以上になるものは Inf
+	if (absBits >= 0x477FF000u) {
+		return static_cast<uint16_t>(sign | 0x7C00u);
+	}
+	// 半精度の非正規化数（2^-14 未満）
+	if (absBits < 0x38800000u) {
+		if (absBits < 0x33000000u) {
+			return sign;
+		}
+		const uint32_t mantissa = (absBits & 0x007FFFFFu) | 0x00800000u;
+		const uint32_t shift = 126u - (absBits >> 23);
+		uint32_t half = mantissa >> shift;
+		const uint32_t remainder = mantissa & ((1u << shift) - 1u);
+		const uint32_t halfway = 1u << (shift - 1u);
+		if (remainder > halfway || (remainder == halfway && (half & 1u))) {
+			++half;
+		}
+		return static_cast<uint16_t>(sign | half);
+	}
+
+	// 正規化数：指数のバイアスを 127 -> 15 に付け替えて仮数を 13bit 落とす
+	uint32_t half = (absBits - 0x38000000u) >> 13;
+	const uint32_t remainder = absBits & 0x1FFFu;
+	if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) {
+		++half;
+	}
+	return static_cast<uint16_t>(sign | half);
+}
+
+float VertexPacker::HalfToFloat(uint16_t value) {
+	const uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+	const uint32_t exponent = (value >> 10) & 0x1Fu;
+	const uint32_t mantissa = value & 0x03FFu;
+
+	uint32_t bits;
+	if (exponent == 0) {
+		// 0 または非正規化数
+		const float magnitude = static_cast<float>(mantissa) * (1.0f / 16777216.0f);
+		return sign ? -magnitude : magnitude;
+	} else if (exponent == 0x1Fu) {
+		bits = sign | 0x7F800000u | (mantissa << 13);
+	} else {
+		bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+	}
+
+	float result;
+	std::memcpy(&result, &bits, sizeof(result));
+	return result;
+}
+
+void VertexPacker::EncodeOctahedral(const Vector3& normal, int16_t output[2]) {
+	// 八面体へ射影し、下半球は外側へ折り返す
+	const float l1 = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+	if (l1 <= 0.0f) {
+		output[0] = 0;
+		output[1] = 0;
+		return;
+	}
+	float u = normal.x / l1;
+	float v = normal.y / l1;
+	if (normal.z < 0.0f) {
+		const float foldedU = (1.0f - std::abs(v)) * SignNotZero(u);
+		const float foldedV = (1.0f - std::abs(u)) * SignNotZero(v);
+		u = foldedU;
+		v = foldedV;
+	}
+
+	// 切り捨て・切り上げの 4 通りから復元誤差が最小のものを選ぶ
+	const float scaledU = std::clamp(u, -1.0f, 1.0f) * kSnorm16Max;
+	const float scaledV = std::clamp(v, -1.0f, 1.0f) * kSnorm16Max;
+	const float baseU = std::floor(scaledU);
+	const float baseV = std::floor(scaledV);
+
+	const Vector3 target = Vector3::Normalize(normal);
+	float bestDot = -2.0f;
+	for (int i = 0; i < 4; ++i) {
+		const int16_t candidate[2] = {
+			QuantizeSnorm16((baseU + static_cast<float>(i & 1)) / kSnorm16Max),
+			QuantizeSnorm16((baseV + static_cast<float>(i >> 1)) / kSnorm16Max),
+		};
+		const float dot = Vector3::Dot(DecodeOctahedral(candidate), target);
+		if (dot > bestDot) {
+			bestDot = dot;
+			output[0] = candidate[0];
+			output[1] = candidate[1];
+		}
+	}
+}
+
+Vector3 VertexPacker::DecodeOctahedral(const int16_t encoded[2]) {
+	Vector3 normal = { DequantizeSnorm16(encoded[0]), DequantizeSnorm16(encoded[1]), 0.0f };
+	normal.z = 1.0f - std::abs(normal.x) - std::abs(normal.y);
+
+	// 下半球（z < 0）は折り返しを戻す
+	const float t = std::max(-normal.z, 0.0f);
+	normal.x += normal.x >= 0.0f ? -t : t;
+	normal.y += normal.y >= 0.0f ? -t : t;
+	return Vector3::Normalize(normal);
+}
+
+#if defined(TOMO_PACKED_VERTEX_TEST_MAIN)
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+// value に最も近い半精度（同じ距離なら仮数が偶数の方）が half であるか
+bool IsNearestHalf(float value, uint16_t half) {
+	const double target = std::fabs(static_cast<double>(value));
+	const uint16_t magnitude = half & 0x7FFFu;
+	if ((half & 0x8000u) != (std::signbit(value) ? 0x8000u : 0u) && magnitude != 0) {
+		return false;
+	}
+	if (magnitude == 0x7C00u) {
+		return target >= 65520.0; // 65504 と 65536（Inf）の中間以上
+	}
+	const double error = std::fabs(VertexPacker::HalfToFloat(magnitude) - target);
+	for (int neighbor : { static_cast<int>(magnitude) - 1, static_cast<int>(magnitude) + 1 }) {
+		if (neighbor < 0 || neighbor >= 0x7C00) {
+			continue;
+		}
+		const double neighborError = std::fabs(VertexPacker::HalfToFloat(static_cast<uint16_t>(neighbor)) - target);
+		if (neighborError < error || (neighborError == error && (magnitude & 1u))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+}
+
+// 半精度の丸め、八面体写像の角度誤差、頂点全体の復元誤差がヘッダーに書いた上限に収まることを確かめる
+int main() {
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> wide(-70000.0f, 70000.0f);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	std::uniform_int_distribution<int> exponent(-30, 30);
+	int failureCount = 0;
+
+	// ================================
+	// 1.半精度：全ビットパターンの往復と、ランダムな float の最近接偶数丸め
+	// ================================
+	int halfMismatchCount = 0;
+	for (uint32_t half = 0; half < 0x10000u; ++half) {
+		const float value = VertexPacker::HalfToFloat(static_cast<uint16_t>(half));
+		if (!std::isnan(value) && VertexPacker::FloatToHalf(value) != half) {
+			++halfMismatchCount;
+		}
+	}
+	for (int i = 0; i < 2'000'000; ++i) {
+		const float value = (i & 1) ? wide(random) : std::ldexp(unit(random), exponent(random));
+		if (!IsNearestHalf(value, VertexPacker::FloatToHalf(value))) {
+			if (halfMismatchCount++ < 4) {
+				std::printf("FloatToHalf(%.9g) = 0x%04x\n", value, VertexPacker::FloatToHalf(value));
+			}
+		}
+	}
+	std::printf("half mismatches %d\n", halfMismatchCount);
+	failureCount += halfMismatchCount;
+
+	// ================================
+	// 2.八面体写像：復元した法線との角度
+	// ================================
+	double maxAngle = 0.0;
+	for (int i = 0; i < 2'000'000; ++i) {
+		Vector3 normal = { unit(random), unit(random), unit(random) };
+		if (Vector3::Length(normal) < 1.0e-3f) {
+			continue;
+		}
+		normal = Vector3::Normalize(normal);
+		int16_t encoded[2];
+		VertexPacker::EncodeOctahedral(normal, encoded);
+		const Vector3 decoded = VertexPacker::DecodeOctahedral(encoded);
+		const double crossX = static_cast<double>(normal.y) * decoded.z - static_cast<double>(normal.z) * decoded.y;
+		const double crossY = static_cast<double>(normal.z) * decoded.x - static_cast<double>(normal.x) * decoded.z;
+		const double crossZ = static_cast<double>(normal.x) * decoded.y - static_cast<double>(normal.y) * decoded.x;
+		const double dot = static_cast<double>(normal.x) * decoded.x + static_cast<double>(normal.y) * decoded.y + static_cast<double>(normal.z) * decoded.z;
+		maxAngle = std::max(maxAngle, std::atan2(std::sqrt(crossX * crossX + crossY * crossY + crossZ * crossZ), dot));
+	}
+	std::printf("octahedral max angle %g rad (bound 1.3e-4)\n", maxAngle);
+	failureCount += maxAngle <= 1.3e-4 ? 0 : 1;
+
+	// ================================
+	// 3.頂点：位置と UV の復元誤差
+	// ================================
+	std::vector<VertexData> vertices(100000);
+	for (VertexData& vertex : vertices) {
+		vertex.position = { wide(random) / 1000.0f, wide(random) / 7000.0f, unit(random) * 3.0f, 1.0f };
+		vertex.texcoord = { unit(random) * 0.5f + 0.5f, unit(random) * 0.5f + 0.5f };
+		vertex.normal = Vector3::Normalize({ unit(random), unit(random), unit(random) + 0.01f });
+	}
+	const VertexQuantization quantization = VertexPacker::ComputeQuantization(vertices);
+	std::vector<PackedVertexData> packed(vertices.size());
+	VertexPacker::Pack(vertices, quantization, packed);
+
+	float positionError[3] = {};
+	float texcoordError = 0.0f;
+	for (size_t i = 0; i < vertices.size(); ++i) {
+		const VertexData unpacked = VertexPacker::Unpack(packed[i], quantization);
+		positionError[0] = std::max(positionError[0], std::abs(unpacked.position.x - vertices[i].position.x));
+		positionError[1] = std::max(positionError[1], std::abs(unpacked.position.y - vertices[i].position.y));
+		positionError[2] = std::max(positionError[2], std::abs(unpacked.position.z - vertices[i].position.z));
+		texcoordError = std::max({ texcoordError,
+			std::abs(unpacked.texcoord.x - vertices[i].texcoord.x), std::abs(unpacked.texcoord.y - vertices[i].texcoord.y) });
+	}
+	// 量子化幅の半分 + 復元時の float の丸め（座標の絶対値の 2 ulp 程度）
+	auto positionBoundOf = [](float minValue, float extent) {
+		const float maxAbs = std::max(std::abs(minValue), std::abs(minValue + extent));
+		return extent / 131070.0f + 2.0f * std::numeric_limits<float>::epsilon() * maxAbs;
+	};
+	const float positionBound[3] = {
+		positionBoundOf(quantization.positionMin.x, quantization.positionExtent.x),
+		positionBoundOf(quantization.positionMin.y, quantization.positionExtent.y),
+		positionBoundOf(quantization.positionMin.z, quantization.positionExtent.z),
+	};
+	const float texcoordBound = std::ldexp(1.0f, -12);
+	std::printf("position error %g %g %g (bound %g %g %g), texcoord error %g (bound %g)\n",
+		positionError[0], positionError[1], positionError[2], positionBound[0], positionBound[1], positionBound[2], texcoordError, texcoordBound);
+	for (int axis = 0; axis < 3; ++axis) {
+		failureCount += positionError[axis] <= positionBound[axis] ? 0 : 1;
+	}
+	failureCount += texcoordError <= texcoordBound ? 0 : 1;
+
+	std::puts(failureCount == 0 ? "PASSED" : "FAILED");
+	return failureCount == 0 ? 0 : 1;
+}
+#endif
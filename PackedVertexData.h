@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include "Vector3.h"
+#include "VertexData.h"
+
+// 頂点バッファの形式
+enum class VertexFormat {
+	Standard, // VertexData（36 バイト）
+	Packed,   // PackedVertexData（16 バイト）
+};
+
+// ==================================
+// 圧縮頂点（16 バイト）
+// ==================================
+//   position : メッシュの AABB を基準に 16bit 正規化（DXGI_FORMAT_R16G16B16A16_UNORM、w は未使用）
+//   texcoord : 半精度浮動小数（DXGI_FORMAT_R16G16_FLOAT）
+//   normal   : 八面体写像で 2 成分にしたもの（DXGI_FORMAT_R16G16_SNORM）
+//
+// 復元時の誤差の上限
+//   position : 各軸 AABB の幅 / 131070 程度（量子化幅の半分 + float の丸め）
+//   texcoord : |uv| < 1 なら 2^-12、|uv| < 2^k なら 2^(k-12)
+//   normal   : 1.3e-4 ラジアン程度（0.01 度未満）
+struct PackedVertexData {
+	uint16_t position[4];
+	uint16_t texcoord[2];
+	int16_t normal[2];
+};
+static_assert(sizeof(PackedVertexData) == 16, "PackedVertexData は 16 バイト");
+
+// 位置の復元用パラメータ（頂点シェーダーにはルート定数 b1 で渡す）
+//   position = positionMin + unorm * positionExtent
+struct VertexQuantization {
+	Vector3 positionMin;
+	float padding0;
+	Vector3 positionExtent;
+	float padding1;
+};
+static_assert(sizeof(VertexQuantization) == 32, "VertexQuantization は 32bit 値 8 個");
+
+// ==================================
+// VertexData <-> PackedVertexData の変換
+// ==================================
+class VertexPacker {
+public:
+	// 全頂点の位置を囲む AABB から量子化パラメータを求める
+	static VertexQuantization ComputeQuantization(std::span<const VertexData> vertices);
+
+	// 圧縮・復元（復元は Object3dPacked.VS.hlsl と同じ計算）
+	static PackedVertexData Pack(const VertexData& vertex, const VertexQuantization& quantization);
+	static VertexData Unpack(const PackedVertexData& packed, const VertexQuantization& quantization);
+
+	// まとめて圧縮する（output はアップロードバッファを直接指してよい）
+	static void Pack(std::span<const VertexData> vertices, const VertexQuantization& quantization, std::span<PackedVertexData> output);
+
+	// float <-> 半精度（最近接偶数丸め）
+	static uint16_t FloatToHalf(float value);
+	static float HalfToFloat(uint16_t value);
+
+	// 単位ベクトル <-> 八面体写像（SNORM16 x 2）
+	static void EncodeOctahedral(const Vector3& normal, int16_t output[2]);
+	static Vector3 DecodeOctahedral(const int16_t encoded[2]);
+};
@@ -3,7 +3,7 @@
 struct TransformationMatrix
 {
     float4x4 WVP;
-    float4x4 World;
+    float3x4 World; // 3x4 アフィン（C++ 側の Affine3x4）
 };
 
 StructuredBuffer<TransformationMatrix> gTransformationMatrices : register(t0);
@@ -21,6 +21,6 @@ VertexShaderOutput main(VertexShaderInput input, uint instanceId : SV_InstanceID
     VertexShaderOutput output;
     output.position = mul(input.position, gTransformationMatrices[instanceId].WVP);
     output.texcoord = input.texcoord;
-    output.normal = normalize(mul(input.normal, (float3x3) gTransformationMatrices[instanceId].World));
+    output.normal = normalize(mul((float3x3) gTransformationMatrices[instanceId].World, input.normal));
     return output;
 }
\ No newline at end of file
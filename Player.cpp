@@ -1,5 +1,4 @@
 #include "Player.h"
-#include "Easing.h"
 #include <algorithm>
 #include <cassert>
 #include <numbers>
@@ -7,11 +6,13 @@
 
 #include "MapChipField.h"
 #include "InputManager.h"
-#include "GraphicsCore.h"
 
 Player::Player() {}
 
-Player::~Player() {}
+Player::~Player() {
+	TweenSystem::GetInstance()->Stop(turnTween_);
+	TweenSystem::GetInstance()->Stop(squashTween_);
+}
 
 void Player::Initialize(Model* model, Camera* camera, const Vector3& position) {
 	assert(model); // Nullptrチェック
@@ -20,15 +21,16 @@ void Player::Initialize(Model* model, Camera* camera, const Vector3& position) {
 	model_ = model;
 	camera_ = camera;
 
-	worldTransform_.Initialize(GraphicsCore::GetInstance()->GetDevice());
-	worldTransform_.scale_ = { 1.0f, 1.0f, 1.0f };
-	baseScale_ = worldTransform_.scale_;
+	worldTransform_.Initialize();
+	worldTransform_.SetScale({ 1.0f, 1.0f, 1.0f });
+	baseScale_ = worldTransform_.GetScale();
 
-	worldTransform_.rotation_.y = -std::numbers::pi_v<float> / 0.12f;
-	worldTransform_.translation_ = position;
+	worldTransform_.SetRotation({ 0.0f, -std::numbers::pi_v<float> / 0.12f, 0.0f });
+	worldTransform_.SetTranslation(position);
+	worldTransform_.SetLocalBounds(model_->GetBounds(), model_->GetBoundingSphere());
 }
 
-void Player::Update(const Camera& camera) {
+void Player::Update() {
 	float dt = 1.0f / 60.0f;
 
 	// ===================================
@@ -54,8 +56,8 @@ void Player::Update(const Camera& camera) {
 					// 左向きに変更
 					lrDirection_ = LRDirection::kLeft;
 
-					turnFirstRotationY_ = worldTransform_.rotation_.y;
-					turnTimer_ = kTurnTime;
+					turnFirstRotation_ = worldTransform_.GetRotationQuaternion();
+					StartTurn();
 				}
 			}
 			else if (input->PushKey('D')) {
@@ -69,8 +71,8 @@ void Player::Update(const Camera& camera) {
 				if (lrDirection_ != LRDirection::kRight) {
 					// 右向きに変更
 					lrDirection_ = LRDirection::kRight;
-					turnFirstRotationY_ = worldTransform_.rotation_.y;
-					turnTimer_ = kTurnTime;
+					turnFirstRotation_ = worldTransform_.GetRotationQuaternion();
+					StartTurn();
 				}
 			}
 
@@ -142,14 +144,6 @@ void Player::Update(const Camera& camera) {
 	// 7.旋回制御
 	// ==================================
 
-	// 旋回タイマー更新
-	if (turnTimer_ > 0.0f) {
-		turnTimer_ -= dt;
-		if (turnTimer_ < 0.0f) {
-			turnTimer_ = 0.0f;
-		}
-	}
-
 	// 旋回制御
 	{
 		// 左右自機キャラの角度テーブル
@@ -161,36 +155,19 @@ void Player::Update(const Camera& camera) {
 		// 状態に応じた目標角度
 		float destinationRotationY = destinationRotationTable[static_cast<uint32_t>(lrDirection_)];
 
-		// 0～1 の補間係数
-		float t = 1.0f - (turnTimer_ / kTurnTime);
-
-		// イージングをかける
-		t = Easing::EaseInOut(t);
-
-		// 現在角度と目標角度の差を求める
-		float delta = destinationRotationY - turnFirstRotationY_;
+		// イージング済みの 0～1 の補間係数（TweenSystem が進める。旋回していなければ 1）
+		const TweenSystem* tweens = TweenSystem::GetInstance();
+		const float t = tweens->IsAlive(turnTween_) ? tweens->GetValue(turnTween_) : 1.0f;
 
-		// 差を -π ～ +π に正規化して「最短方向の差」にする
-		const float twoPi = std::numbers::pi_v<float> *2.0f;
-		while (delta > std::numbers::pi_v<float>) {
-			delta -= twoPi;
-		}
-		while (delta < -std::numbers::pi_v<float>) {
-			delta += twoPi;
-		}
-
-		// 旋回開始角度から「最短方向」に補間
-		worldTransform_.rotation_.y = turnFirstRotationY_ + delta * t;
+		// 旋回開始時の向きから目標の向きへ球面線形補間（Slerp は常に最短方向で回る）
+		Quaternion destinationRotation = Quaternion::MakeRotateAxisAngle({ 0.0f, 1.0f, 0.0f }, destinationRotationY);
+		worldTransform_.SetRotationQuaternion(Quaternion::Slerp(turnFirstRotation_, destinationRotation, t));
 	}
 
 	// スライムのつぶし・伸ばし
-	UpdateSquash(dt);
+	UpdateSquash();
 
-	// ==================================
-	// 8.ワールド行列の更新
-	// ==================================
-
-	worldTransform_.UpdateMatrix(camera);
+	// ワールド行列は TransformSystem::Update でまとめて更新する
 }
 
 void Player::MapChipCollisionCheck(CollisionMapInfo& info) {
@@ -221,7 +198,7 @@ void Player::GroundCollisionCheck(CollisionMapInfo& info) {
 	// 移動後の4つの角の座標
 	std::array<Vector3, static_cast<uint32_t>(Corner::kNumConer)> positionsNew{};
 	for (uint32_t i = 0; i < positionsNew.size(); ++i) {
-		positionsNew[i] = CornerPosition(worldTransform_.translation_ + info.moveAmount, static_cast<Corner>(i));
+		positionsNew[i] = CornerPosition(worldTransform_.GetTranslation() + info.moveAmount, static_cast<Corner>(i));
 	}
 
 	MapChipType mapChipType;
@@ -235,7 +212,7 @@ void Player::GroundCollisionCheck(CollisionMapInfo& info) {
 	mapChipTypeNext = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex - 1);
 	if (mapChipType == MapChipType::kBlock && mapChipTypeNext != MapChipType::kBlock) {
 		// 移動前のセル番号を取得
-		Vector3 currentLeftBottom = CornerPosition(worldTransform_.translation_, Corner::kLeftBottom);
+		Vector3 currentLeftBottom = CornerPosition(worldTransform_.GetTranslation(), Corner::kLeftBottom);
 		IndexSet indexSetNow = mapChipField_->GetMapChipIndexSetByPosition(currentLeftBottom);
 
 		// Y方向のセル境界をまたいだ場合のみ判定
@@ -250,7 +227,7 @@ void Player::GroundCollisionCheck(CollisionMapInfo& info) {
 	mapChipTypeNext = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex - 1);
 	if (mapChipType == MapChipType::kBlock && mapChipTypeNext != MapChipType::kBlock) {
 		// 移動前のセル番号を取得
-		Vector3 currentRightBottom = CornerPosition(worldTransform_.translation_, Corner::kRightBottom);
+		Vector3 currentRightBottom = CornerPosition(worldTransform_.GetTranslation(), Corner::kRightBottom);
 		IndexSet indexSetNow = mapChipField_->GetMapChipIndexSetByPosition(currentRightBottom);
 
 		// Y方向のセル境界をまたいだ場合のみ判定
@@ -260,7 +237,7 @@ void Player::GroundCollisionCheck(CollisionMapInfo& info) {
 	}
 
 	if (hit) {
-		const Vector3 centerNew = worldTransform_.translation_ + info.moveAmount;
+		const Vector3 centerNew = worldTransform_.GetTranslation() + info.moveAmount;
 		const Vector3 bottomCenterNew = centerNew + Vector3{ 0.0f, -kHeight / 2.0f, 0.0f };
 		indexSet = mapChipField_->GetMapChipIndexSetByPosition(bottomCenterNew);
 		// めり込み先ブロックの範囲矩形
@@ -281,7 +258,7 @@ void Player::CeilingCollisionCheck(CollisionMapInfo& info) {
 	// 移動後の4つの角の座標
 	std::array<Vector3, static_cast<uint32_t>(Corner::kNumConer)> positionsNew{};
 	for (uint32_t i = 0; i < positionsNew.size(); ++i) {
-		positionsNew[i] = CornerPosition(worldTransform_.translation_ + info.moveAmount, static_cast<Corner>(i));
+		positionsNew[i] = CornerPosition(worldTransform_.GetTranslation() + info.moveAmount, static_cast<Corner>(i));
 	}
 
 	MapChipType mapChipType;
@@ -293,7 +270,7 @@ void Player::CeilingCollisionCheck(CollisionMapInfo& info) {
 	mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
 	if (mapChipType == MapChipType::kBlock) {
 		// 移動前のセル番号を取得
-		Vector3 currentLeftTop = CornerPosition(worldTransform_.translation_, Corner::kLeftTop);
+		Vector3 currentLeftTop = CornerPosition(worldTransform_.GetTranslation(), Corner::kLeftTop);
 		IndexSet indexSetNow = mapChipField_->GetMapChipIndexSetByPosition(currentLeftTop);
 
 		// Y方向のセル境界をまたいだ場合のみ判定
@@ -307,7 +284,7 @@ void Player::CeilingCollisionCheck(CollisionMapInfo& info) {
 	mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
 	if (mapChipType == MapChipType::kBlock) {
 		// 移動前のセル番号を取得
-		Vector3 currentRightTop = CornerPosition(worldTransform_.translation_, Corner::kRightTop);
+		Vector3 currentRightTop = CornerPosition(worldTransform_.GetTranslation(), Corner::kRightTop);
 		IndexSet indexSetNow = mapChipField_->GetMapChipIndexSetByPosition(currentRightTop);
 
 		// Y方向のセル境界をまたいだ場合のみ判定
@@ -318,7 +295,7 @@ void Player::CeilingCollisionCheck(CollisionMapInfo& info) {
 
 	if (hit) {
 		// めり込みを排除する方向に移動量を設定する
-		const Vector3 centerNew = worldTransform_.translation_ + info.moveAmount;
+		const Vector3 centerNew = worldTransform_.GetTranslation() + info.moveAmount;
 		const Vector3 topCenterNew = centerNew + Vector3{ 0.0f, kHeight / 2.0f, 0.0f };
 		indexSet = mapChipField_->GetMapChipIndexSetByPosition(topCenterNew);
 		// めり込み先ブロックの範囲矩形
@@ -339,7 +316,7 @@ void Player::RightWallCollisionCheck(CollisionMapInfo& info) {
 	// 移動後の4つの角の座標
 	std::array<Vector3, static_cast<uint32_t>(Corner::kNumConer)> positionsNew{};
 	for (uint32_t i = 0; i < positionsNew.size(); ++i) {
-		positionsNew[i] = CornerPosition(worldTransform_.translation_ + info.moveAmount, static_cast<Corner>(i));
+		positionsNew[i] = CornerPosition(worldTransform_.GetTranslation() + info.moveAmount, static_cast<Corner>(i));
 	}
 
 	MapChipType mapChipType;
@@ -351,7 +328,7 @@ void Player::RightWallCollisionCheck(CollisionMapInfo& info) {
 	mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
 	if (mapChipType == MapChipType::kBlock) {
 		// 移動前のセル番号を取得
-		Vector3 currentRightTop = CornerPosition(worldTransform_.translation_, Corner::kRightTop);
+		Vector3 currentRightTop = CornerPosition(worldTransform_.GetTranslation(), Corner::kRightTop);
 		IndexSet indexSetNow = mapChipField_->GetMapChipIndexSetByPosition(currentRightTop);
 
 		// X方向のセル境界をまたいだ場合のみ判定
@@ -365,7 +342,7 @@ void Player::RightWallCollisionCheck(CollisionMapInfo& info) {
 	mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
 	if (mapChipType == MapChipType::kBlock) {
 		// 移動前のセル番号を取得
-		Vector3 currentRightBottom = CornerPosition(worldTransform_.translation_, Corner::kRightBottom);
+		Vector3 currentRightBottom = CornerPosition(worldTransform_.GetTranslation(), Corner::kRightBottom);
 		IndexSet indexSetNow = mapChipField_->GetMapChipIndexSetByPosition(currentRightBottom);
 
 		// X方向のセル境界をまたいだ場合のみ判定
@@ -376,7 +353,7 @@ void Player::RightWallCollisionCheck(CollisionMapInfo& info) {
 
 	if (hit) {
 		// めり込みを排除する方向に移動量を設定する
-		const Vector3 centerNew = worldTransform_.translation_ + info.moveAmount;
+		const Vector3 centerNew = worldTransform_.GetTranslation() + info.moveAmount;
 		const Vector3 rightCenterNew = centerNew + Vector3{ kWidth / 2.0f, 0.0f, 0.0f };
 		indexSet = mapChipField_->GetMapChipIndexSetByPosition(rightCenterNew);
 		// めり込み先ブロックの範囲矩形
@@ -397,7 +374,7 @@ void Player::LeftWallCollisionCheck(CollisionMapInfo& info) {
 	// 移動後の4つの角の座標
 	std::array<Vector3, static_cast<uint32_t>(Corner::kNumConer)> positionsNew{};
 	for (uint32_t i = 0; i < positionsNew.size(); ++i) {
-		positionsNew[i] = CornerPosition(worldTransform_.translation_ + info.moveAmount, static_cast<Corner>(i));
+		positionsNew[i] = CornerPosition(worldTransform_.GetTranslation() + info.moveAmount, static_cast<Corner>(i));
 	}
 
 	MapChipType mapChipType;
@@ -409,7 +386,7 @@ void Player::LeftWallCollisionCheck(CollisionMapInfo& info) {
 	mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
 	if (mapChipType == MapChipType::kBlock) {
 		// 移動前のセル番号を取得
-		Vector3 currentLeftTop = CornerPosition(worldTransform_.translation_, Corner::kLeftTop);
+		Vector3 currentLeftTop = CornerPosition(worldTransform_.GetTranslation(), Corner::kLeftTop);
 		IndexSet indexSetNow = mapChipField_->GetMapChipIndexSetByPosition(currentLeftTop);
 
 		// X方向のセル境界をまたいだ場合のみ判定
@@ -423,7 +400,7 @@ void Player::LeftWallCollisionCheck(CollisionMapInfo& info) {
 	mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
 	if (mapChipType == MapChipType::kBlock) {
 		// 移動前のセル番号を取得
-		Vector3 currentLeftBottom = CornerPosition(worldTransform_.translation_, Corner::kLeftBottom);
+		Vector3 currentLeftBottom = CornerPosition(worldTransform_.GetTranslation(), Corner::kLeftBottom);
 		IndexSet indexSetNow = mapChipField_->GetMapChipIndexSetByPosition(currentLeftBottom);
 
 		// X方向のセル境界をまたいだ場合のみ判定
@@ -434,7 +411,7 @@ void Player::LeftWallCollisionCheck(CollisionMapInfo& info) {
 
 	if (hit) {
 		// めり込みを排除する方向に移動量を設定する
-		const Vector3 centerNew = worldTransform_.translation_ + info.moveAmount;
+		const Vector3 centerNew = worldTransform_.GetTranslation() + info.moveAmount;
 		const Vector3 leftCenterNew = centerNew + Vector3{ -kWidth / 2.0f, 0.0f, 0.0f };
 		indexSet = mapChipField_->GetMapChipIndexSetByPosition(leftCenterNew);
 		// めり込み先ブロックの範囲矩形
@@ -460,14 +437,14 @@ void Player::SetOnGroundState(const CollisionMapInfo& info) {
 			// 左下点の判定
 			IndexSet indexSet;
 			indexSet = mapChipField_->GetMapChipIndexSetByPosition(
-				CornerPosition({ worldTransform_.translation_.x, worldTransform_.translation_.y - kBlank, worldTransform_.translation_.z }, Corner::kLeftBottom));
+				CornerPosition({ worldTransform_.GetTranslation().x, worldTransform_.GetTranslation().y - kBlank, worldTransform_.GetTranslation().z }, Corner::kLeftBottom));
 			mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
 			if (mapChipType == MapChipType::kBlank) {
 				hit = false;
 			}
 			// 右下点の判定
 			indexSet = mapChipField_->GetMapChipIndexSetByPosition(
-				CornerPosition({ worldTransform_.translation_.x, worldTransform_.translation_.y - kBlank, worldTransform_.translation_.z }, Corner::kRightBottom));
+				CornerPosition({ worldTransform_.GetTranslation().x, worldTransform_.GetTranslation().y - kBlank, worldTransform_.GetTranslation().z }, Corner::kRightBottom));
 			mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
 			if (mapChipType == MapChipType::kBlank) {
 				hit = false;
@@ -517,7 +494,7 @@ Vector3 Player::CornerPosition(const Vector3& center, Corner corner) {
 // 判定結果を反映して移動させる
 void Player::ApplyCollisionResult(const CollisionMapInfo& info) {
 	// 移動量を反映
-	worldTransform_.translation_ += info.moveAmount;
+	worldTransform_.SetTranslation(worldTransform_.GetTranslation() + info.moveAmount);
 }
 
 /////////////////////////////////////////////////////
@@ -526,7 +503,7 @@ void Player::ApplyCollisionResult(const CollisionMapInfo& info) {
 void Player::Draw(ID3D12GraphicsCommandList* list) {
 	// 描画処理
 	//model_->Draw(list,worldTransform_);
-	model_->Draw(list, worldTransform_);
+	model_->Draw(list, worldTransform_, *camera_);
 }
 
 // ================================
@@ -535,7 +512,7 @@ void Player::Draw(ID3D12GraphicsCommandList* list) {
 // ジャンプ直後の「縦に伸びる」アニメ開始
 void Player::StartJumpStretch() {
 	squashState_ = SquashState::kJumpStretch;
-	squashTimer_ = squashDuration_;
+	StartSquashTween();
 
 	// XZを少し細く、Yを伸ばす
 	squashStart_ = baseScale_;
@@ -549,7 +526,7 @@ void Player::StartJumpStretch() {
 // 着地直後の「横につぶれる」アニメ開始
 void Player::StartLandSquash() {
 	squashState_ = SquashState::kLandSquash;
-	squashTimer_ = squashDuration_;
+	StartSquashTween();
 
 	// XZを太く、Yを低く
 	squashStart_ = baseScale_;
@@ -561,24 +538,17 @@ void Player::StartLandSquash() {
 }
 
 // 毎フレームの更新
-void Player::UpdateSquash(float dt) {
-	if (squashState_ == SquashState::kNone) {
+void Player::UpdateSquash() {
+	const TweenSystem* tweens = TweenSystem::GetInstance();
+	if (squashState_ == SquashState::kNone || !tweens->IsAlive(squashTween_)) {
 		// 何も再生中でなければベーススケールにしておく
-		worldTransform_.scale_ = baseScale_;
+		worldTransform_.SetScale(baseScale_);
+		squashState_ = SquashState::kNone;
 		return;
 	}
 
-	squashTimer_ -= dt;
-	if (squashTimer_ < 0.0f) {
-		squashTimer_ = 0.0f;
-	}
-
-	// 0～1 の正規化時間
-	float t = 1.0f - (squashTimer_ / squashDuration_);
-	t = std::clamp(t, 0.0f, 1.0f);
-
-	// イージング
-	float e = Easing::EaseInOut(t);
+	// イージング済みの 0～1（TweenSystem が進める）
+	float e = tweens->GetValue(squashTween_);
 
 	// 開始→終了への補間
 	Vector3 scale{};
@@ -586,11 +556,25 @@ void Player::UpdateSquash(float dt) {
 	scale.y = squashStart_.y + (squashEnd_.y - squashStart_.y) * e;
 	scale.z = squashStart_.z + (squashEnd_.z - squashStart_.z) * e;
 
-	worldTransform_.scale_ = scale;
+	worldTransform_.SetScale(scale);
 
 	// 終了したら状態を戻す
-	if (squashTimer_ <= 0.0f) {
-		worldTransform_.scale_ = baseScale_;
+	if (tweens->IsFinished(squashTween_)) {
+		worldTransform_.SetScale(baseScale_);
 		squashState_ = SquashState::kNone;
 	}
-}
\ No newline at end of file
+}
+
+// 旋回の補間係数を 0→1 で再生し直す
+void Player::StartTurn() {
+	TweenSystem* tweens = TweenSystem::GetInstance();
+	tweens->Stop(turnTween_);
+	turnTween_ = tweens->Start(0.0f, 1.0f, kTurnTime, EaseType::InOut);
+}
+
+// つぶし・伸ばしの補間係数を 0→1 で再生し直す
+void Player::StartSquashTween() {
+	TweenSystem* tweens = TweenSystem::GetInstance();
+	tweens->Stop(squashTween_);
+	squashTween_ = tweens->Start(0.0f, 1.0f, squashDuration_, EaseType::InOut);
+}
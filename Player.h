@@ -2,6 +2,7 @@
 #include "Camera.h"
 #include "Model.h"
 #include "WorldTransform.h"
+#include "TweenSystem.h"
 #include "Vector3.h"
 
 class MapChipField;
@@ -35,8 +36,7 @@ public:
 	void Initialize(Model* model, Camera* camera, const Vector3& position);
 
 	// 更新
-	//void Update();
-	void Update(const Camera& camera);
+	void Update();
 
 	// 描画
 	void Draw(ID3D12GraphicsCommandList* list);
@@ -106,10 +106,12 @@ private:
 
 	LRDirection lrDirection_ = LRDirection::kRight;
 
-	// 旋回開始時の角度
-	float turnFirstRotationY_ = 0.0f;
-	// 旋回タイマー
-	float turnTimer_ = 0.0f;
+	// 旋回開始時の向き
+	Quaternion turnFirstRotation_ = Quaternion::MakeIdentity();
+	// 旋回の補間係数（イージング済みの 0～1）
+	TweenHandle turnTween_;
+
+	void StartTurn();
 
 	// ===================================
 	// ジャンプ時のつぶしと伸ばし制御
@@ -121,7 +123,7 @@ private:
 	};
 
 	SquashState squashState_ = SquashState::kNone;
-	float squashTimer_ = 0.0f;
+	TweenHandle squashTween_; // イージング済みの 0～1
 	float squashDuration_ = 0.15f; // 1アニメーションの時間(秒)
 
 	// ベーススケールと開始/終了スケール
@@ -131,7 +133,8 @@ private:
 
 	void StartJumpStretch();
 	void StartLandSquash();
-	void UpdateSquash(float dt);
+	void UpdateSquash();
+	void StartSquashTween();
 
 	// ===================================
 	// 定数
@@ -0,0 +1,368 @@
+#include "Quaternion.h"
+#include "MathSimd.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+static_assert(sizeof(Quaternion) == sizeof(float) * 4, "Quaternion は float4 個で隙間なく並んでいる必要がある");
+
+namespace {
+
+// ハミルトン積 a * b
+Quaternion Hamilton(const Quaternion& a, const Quaternion& b) {
+	return {
+		a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+		a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+		a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+		a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+	};
+}
+
+// ==================================
+// acos / sin を使わない SLERP 係数の近似
+// ==================================
+// D. Eberly "A Fast and Accurate Algorithm for Computing SLERP" の多項式近似。
+// sin(t * θ) / sin(θ) を cosθ の多項式で表す（0 <= cosθ <= 1 の範囲）。
+// 論文は 8 項（係数の誤差 1.9e-5、補間結果の各成分では 3e-5 を超える）なので 9 項に増やし、
+// 最後の項の補正係数 μ を 9 項用に求め直した（係数の誤差 8.3e-6、補間結果の各成分で 2e-5 未満）
+constexpr int kSlerpTermCount = 9;
+constexpr float kSlerpMu = 1.8658732524f;
+constexpr float kSlerpU[kSlerpTermCount] = {
+	1.0f / (1 * 3), 1.0f / (2 * 5), 1.0f / (3 * 7), 1.0f / (4 * 9),
+	1.0f / (5 * 11), 1.0f / (6 * 13), 1.0f / (7 * 15), 1.0f / (8 * 17), kSlerpMu / (9 * 19),
+};
+constexpr float kSlerpV[kSlerpTermCount] = {
+	1.0f / 3, 2.0f / 5, 3.0f / 7, 4.0f / 9,
+	5.0f / 11, 6.0f / 13, 7.0f / 15, 8.0f / 17, kSlerpMu * 9 / 19,
+};
+
+// cosThetaMinusOne = cosθ - 1
+inline float SlerpCoefficient(float t, float cosThetaMinusOne) {
+	const float t2 = t * t;
+	float c = 1.0f;
+	for (int i = kSlerpTermCount - 1; i >= 0; --i) {
+		c = 1.0f + (kSlerpU[i] * t2 - kSlerpV[i]) * cosThetaMinusOne * c;
+	}
+	return c * t;
+}
+
+// 1要素分の近似 SLERP（端数処理とSIMD無効時に使用）
+inline Quaternion SlerpApprox(const Quaternion& q0, const Quaternion& q1, float t) {
+	float dot = Quaternion::Dot(q0, q1);
+	const float sign = (dot < 0.0f) ? -1.0f : 1.0f;
+	dot *= sign;
+	const float c0 = SlerpCoefficient(1.0f - t, dot - 1.0f);
+	const float c1 = SlerpCoefficient(t, dot - 1.0f) * sign;
+	return {
+		q0.x * c0 + q1.x * c1,
+		q0.y * c0 + q1.y * c1,
+		q0.z * c0 + q1.z * c1,
+		q0.w * c0 + q1.w * c1,
+	};
+}
+
+#if defined(TOMO_MATH_SSE)
+inline __m128 SlerpCoefficientSSE(__m128 t, __m128 cosThetaMinusOne) {
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 t2 = _mm_mul_ps(t, t);
+	__m128 c = one;
+	for (int i = kSlerpTermCount - 1; i >= 0; --i) {
+		__m128 b = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(_mm_set1_ps(kSlerpU[i]), t2), _mm_set1_ps(kSlerpV[i])), cosThetaMinusOne);
+		c = _mm_add_ps(one, _mm_mul_ps(b, c));
+	}
+	return _mm_mul_ps(c, t);
+}
+#elif defined(TOMO_MATH_NEON)
+inline float32x4_t SlerpCoefficientNEON(float32x4_t t, float32x4_t cosThetaMinusOne) {
+	const float32x4_t one = vdupq_n_f32(1.0f);
+	const float32x4_t t2 = vmulq_f32(t, t);
+	float32x4_t c = one;
+	for (int i = kSlerpTermCount - 1; i >= 0; --i) {
+		float32x4_t b = vmulq_f32(vsubq_f32(vmulq_n_f32(t2, kSlerpU[i]), vdupq_n_f32(kSlerpV[i])), cosThetaMinusOne);
+		c = vaddq_f32(one, vmulq_f32(b, c));
+	}
+	return vmulq_f32(c, t);
+}
+#endif
+
+} // namespace
+
+Quaternion Quaternion::MakeIdentity() {
+	return { 0.0f, 0.0f, 0.0f, 1.0f };
+}
+
+Quaternion Quaternion::MakeRotateAxisAngle(const Vector3& axis, float angle) {
+	const float s = std::sin(angle * 0.5f);
+	return { axis.x * s, axis.y * s, axis.z * s, std::cos(angle * 0.5f) };
+}
+
+Quaternion Quaternion::MakeFromEuler(const Vector3& rotate) {
+	// qz * qy * qx を展開したもの
+	const float sx = std::sin(rotate.x * 0.5f), cx = std::cos(rotate.x * 0.5f);
+	const float sy = std::sin(rotate.y * 0.5f), cy = std::cos(rotate.y * 0.5f);
+	const float sz = std::sin(rotate.z * 0.5f), cz = std::cos(rotate.z * 0.5f);
+	return {
+		sx * cy * cz - cx * sy * sz,
+		cx * sy * cz + sx * cy * sz,
+		cx * cy * sz - sx * sy * cz,
+		cx * cy * cz + sx * sy * sz,
+	};
+}
+
+Vector3 Quaternion::ToEuler(const Quaternion& q) {
+	// 回転行列 Rx * Ry * Rz の要素から逆算する
+	//   r02 = -sin(y), r01 / r00 = tan(z), r12 / r22 = tan(x)
+	const float r00 = 1.0f - 2.0f * (q.y * q.y + q.z * q.z);
+	const float r01 = 2.0f * (q.x * q.y + q.w * q.z);
+	const float r02 = 2.0f * (q.x * q.z - q.w * q.y);
+	const float r10 = 2.0f * (q.x * q.y - q.w * q.z);
+	const float r11 = 1.0f - 2.0f * (q.x * q.x + q.z * q.z);
+	const float r12 = 2.0f * (q.y * q.z + q.w * q.x);
+	const float r22 = 1.0f - 2.0f * (q.x * q.x + q.y * q.y);
+
+	const float sinY = std::clamp(-r02, -1.0f, 1.0f);
+	Vector3 result;
+	result.y = std::asin(sinY);
+	if (std::fabs(sinY) < 0.999999f) {
+		result.x = std::atan2(r12, r22);
+		result.z = std::atan2(r01, r00);
+	} else {
+		// ジンバルロック：Z を 0 に固定して X に寄せる
+		result.x = std::atan2(r10 * sinY, r11);
+		result.z = 0.0f;
+	}
+	return result;
+}
+
+Quaternion Quaternion::Multiply(const Quaternion& q1, const Quaternion& q2) {
+	return Hamilton(q2, q1);
+}
+
+Quaternion Quaternion::Conjugate(const Quaternion& q) {
+	return { -q.x, -q.y, -q.z, q.w };
+}
+
+Quaternion Quaternion::Inverse(const Quaternion& q) {
+	const float lengthSq = Dot(q, q);
+	assert(lengthSq > 0.0f);
+	const float inv = 1.0f / lengthSq;
+	return { -q.x * inv, -q.y * inv, -q.z * inv, q.w * inv };
+}
+
+Quaternion Quaternion::Normalize(const Quaternion& q) {
+	const float length = Length(q);
+	if (length == 0.0f) {
+		return MakeIdentity();
+	}
+	const float inv = 1.0f / length;
+	return { q.x * inv, q.y * inv, q.z * inv, q.w * inv };
+}
+
+float Quaternion::Dot(const Quaternion& q1, const Quaternion& q2) {
+	return q1.x * q2.x + q1.y * q2.y + q1.z * q2.z + q1.w * q2.w;
+}
+
+float Quaternion::Length(const Quaternion& q) {
+	return std::sqrt(Dot(q, q));
+}
+
+Vector3 Quaternion::RotateVector(const Vector3& vector, const Quaternion& q) {
+	// v' = v + w * t + q.xyz × t  (t = 2 * q.xyz × v)
+	const Vector3 axis = { q.x, q.y, q.z };
+	const Vector3 t = Vector3::Cross(axis, vector) * 2.0f;
+	return vector + t * q.w + Vector3::Cross(axis, t);
+}
+
+Matrix4x4 Quaternion::MakeRotateMatrix(const Quaternion& q) {
+	const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+	const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+	const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+	Matrix4x4 result;
+	result.m[0][0] = 1.0f - 2.0f * (yy + zz);
+	result.m[0][1] = 2.0f * (xy + wz);
+	result.m[0][2] = 2.0f * (xz - wy);
+	result.m[0][3] = 0.0f;
+
+	result.m[1][0] = 2.0f * (xy - wz);
+	result.m[1][1] = 1.0f - 2.0f * (xx + zz);
+	result.m[1][2] = 2.0f * (yz + wx);
+	result.m[1][3] = 0.0f;
+
+	result.m[2][0] = 2.0f * (xz + wy);
+	result.m[2][1] = 2.0f * (yz - wx);
+	result.m[2][2] = 1.0f - 2.0f * (xx + yy);
+	result.m[2][3] = 0.0f;
+
+	result.m[3][0] = 0.0f;
+	result.m[3][1] = 0.0f;
+	result.m[3][2] = 0.0f;
+	result.m[3][3] = 1.0f;
+	return result;
+}
+
+Quaternion Quaternion::Nlerp(const Quaternion& q0, const Quaternion& q1, float t) {
+	// 最短経路になるよう符号を合わせる
+	const float sign = (Dot(q0, q1) < 0.0f) ? -1.0f : 1.0f;
+	const float s = 1.0f - t;
+	const float u = t * sign;
+	return Normalize({
+		q0.x * s + q1.x * u,
+		q0.y * s + q1.y * u,
+		q0.z * s + q1.z * u,
+		q0.w * s + q1.w * u,
+	});
+}
+
+Quaternion Quaternion::Slerp(const Quaternion& q0, const Quaternion& q1, float t) {
+	float dot = Dot(q0, q1);
+	float sign = 1.0f;
+	if (dot < 0.0f) {
+		dot = -dot;
+		sign = -1.0f;
+	}
+
+	// ほぼ同じ向きなら sinθ が 0 に近く不安定なので Nlerp で代用
+	if (dot > 0.9995f) {
+		return Nlerp(q0, q1, t);
+	}
+
+	const float theta = std::acos(dot);
+	const float invSin = 1.0f / std::sin(theta);
+	const float s = std::sin((1.0f - t) * theta) * invSin;
+	const float u = std::sin(t * theta) * invSin * sign;
+	return {
+		q0.x * s + q1.x * u,
+		q0.y * s + q1.y * u,
+		q0.z * s + q1.z * u,
+		q0.w * s + q1.w * u,
+	};
+}
+
+Quaternion operator*(const Quaternion& q1, const Quaternion& q2) { return Quaternion::Multiply(q1, q2); }
+
+void SlerpQuaternions(
+	std::span<const Quaternion> from, std::span<const Quaternion> to,
+	std::span<const float> t, std::span<Quaternion> output) {
+	const size_t count = output.size();
+	assert(from.size() == count && to.size() == count && t.size() == count);
+	size_t i = 0;
+
+#if defined(TOMO_MATH_SSE)
+	// 4要素ずつ転置して x / y / z / w をレーンに並べる
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	const __m128 one = _mm_set1_ps(1.0f);
+	for (; i + 4 <= count; i += 4) {
+		__m128 ax = _mm_loadu_ps(&from[i + 0].x);
+		__m128 ay = _mm_loadu_ps(&from[i + 1].x);
+		__m128 az = _mm_loadu_ps(&from[i + 2].x);
+		__m128 aw = _mm_loadu_ps(&from[i + 3].x);
+		_MM_TRANSPOSE4_PS(ax, ay, az, aw);
+		__m128 bx = _mm_loadu_ps(&to[i + 0].x);
+		__m128 by = _mm_loadu_ps(&to[i + 1].x);
+		__m128 bz = _mm_loadu_ps(&to[i + 2].x);
+		__m128 bw = _mm_loadu_ps(&to[i + 3].x);
+		_MM_TRANSPOSE4_PS(bx, by, bz, bw);
+		const __m128 tt = _mm_loadu_ps(&t[i]);
+
+		__m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+		const __m128 sign = _mm_and_ps(dot, signMask);
+		dot = _mm_andnot_ps(signMask, dot);
+		const __m128 cosThetaMinusOne = _mm_sub_ps(dot, one);
+
+		const __m128 c0 = SlerpCoefficientSSE(_mm_sub_ps(one, tt), cosThetaMinusOne);
+		const __m128 c1 = _mm_xor_ps(SlerpCoefficientSSE(tt, cosThetaMinusOne), sign);
+
+		__m128 rx = _mm_add_ps(_mm_mul_ps(ax, c0), _mm_mul_ps(bx, c1));
+		__m128 ry = _mm_add_ps(_mm_mul_ps(ay, c0), _mm_mul_ps(by, c1));
+		__m128 rz = _mm_add_ps(_mm_mul_ps(az, c0), _mm_mul_ps(bz, c1));
+		__m128 rw = _mm_add_ps(_mm_mul_ps(aw, c0), _mm_mul_ps(bw, c1));
+		_MM_TRANSPOSE4_PS(rx, ry, rz, rw);
+		_mm_storeu_ps(&output[i + 0].x, rx);
+		_mm_storeu_ps(&output[i + 1].x, ry);
+		_mm_storeu_ps(&output[i + 2].x, rz);
+		_mm_storeu_ps(&output[i + 3].x, rw);
+	}
+#elif defined(TOMO_MATH_NEON)
+	// vld4q / vst4q がそのまま転置になる
+	const float32x4_t one = vdupq_n_f32(1.0f);
+	const uint32x4_t signMask = vdupq_n_u32(0x80000000u);
+	for (; i + 4 <= count; i += 4) {
+		const float32x4x4_t a = vld4q_f32(&from[i].x);
+		const float32x4x4_t b = vld4q_f32(&to[i].x);
+		const float32x4_t tt = vld1q_f32(&t[i]);
+
+		float32x4_t dot = vmulq_f32(a.val[0], b.val[0]);
+		dot = vfmaq_f32(dot, a.val[1], b.val[1]);
+		dot = vfmaq_f32(dot, a.val[2], b.val[2]);
+		dot = vfmaq_f32(dot, a.val[3], b.val[3]);
+		const uint32x4_t sign = vandq_u32(vreinterpretq_u32_f32(dot), signMask);
+		dot = vabsq_f32(dot);
+		const float32x4_t cosThetaMinusOne = vsubq_f32(dot, one);
+
+		const float32x4_t c0 = SlerpCoefficientNEON(vsubq_f32(one, tt), cosThetaMinusOne);
+		const float32x4_t c1 = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(SlerpCoefficientNEON(tt, cosThetaMinusOne)), sign));
+
+		float32x4x4_t r;
+		for (int k = 0; k < 4; ++k) {
+			r.val[k] = vfmaq_f32(vmulq_f32(a.val[k], c0), b.val[k], c1);
+		}
+		vst4q_f32(&output[i].x, r);
+	}
+#endif
+
+	// 端数
+	for (; i < count; ++i) {
+		output[i] = SlerpApprox(from[i], to[i], t[i]);
+	}
+}
+
+#if defined(TOMO_QUATERNION_TEST_MAIN)
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// SlerpQuaternions（多項式近似）を double で計算した厳密な SLERP と比べ、各成分の誤差が 2e-5 未満であることを確かめる。
+// 要素数は 4 の倍数 + 端数にして SIMD とスカラーの両方を通す
+int main() {
+	std::mt19937 random(5);
+	std::normal_distribution<float> normal;
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+	const size_t count = 1'000'003;
+	std::vector<Quaternion> from(count), to(count), output(count);
+	std::vector<float> t(count);
+	auto randomQuaternion = [&]() { return Quaternion::Normalize({ normal(random), normal(random), normal(random), normal(random) }); };
+	for (size_t i = 0; i < count; ++i) {
+		from[i] = randomQuaternion();
+		// 3 つに 1 つはほぼ同じ向き（cosθ が 1 に近い側）にする
+		to[i] = (i % 3 == 0)
+			? Quaternion::Normalize({ from[i].x + 0.01f * normal(random), from[i].y, from[i].z, from[i].w })
+			: randomQuaternion();
+		t[i] = unit(random);
+	}
+	SlerpQuaternions(from, to, t, output);
+
+	double maxError = 0.0;
+	for (size_t i = 0; i < count; ++i) {
+		const double a[4] = { from[i].x, from[i].y, from[i].z, from[i].w };
+		const double b[4] = { to[i].x, to[i].y, to[i].z, to[i].w };
+		const double r[4] = { output[i].x, output[i].y, output[i].z, output[i].w };
+		double dot = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+		const double sign = dot < 0.0 ? -1.0 : 1.0;
+		dot = std::min(std::fabs(dot), 1.0);
+		const double theta = std::acos(dot);
+		const double s = theta < 1.0e-9 ? 1.0 - t[i] : std::sin((1.0 - t[i]) * theta) / std::sin(theta);
+		const double u = (theta < 1.0e-9 ? t[i] : std::sin(t[i] * theta) / std::sin(theta)) * sign;
+		for (int k = 0; k < 4; ++k) {
+			maxError = std::max(maxError, std::fabs(r[k] - (a[k] * s + b[k] * u)));
+		}
+	}
+
+	std::printf("SlerpQuaternions max component error %g (bound 2e-5)\n", maxError);
+	const bool passed = maxError < 2.0e-5;
+	std::puts(passed ? "PASSED" : "FAILED");
+	return passed ? 0 : 1;
+}
+#endif
@@ -0,0 +1,54 @@
+#pragma once
+#include <span>
+#include "Vector3.h"
+#include "Matrix4x4.h"
+
+// ==================================
+// クォータニオン（回転）
+// ==================================
+// 合成の順序は Matrix4x4 と同じ行ベクトル規約に合わせてある。
+//   Multiply(q1, q2) : q1 を適用してから q2 を適用する回転（ハミルトン積では q2 * q1）
+//   MakeFromEuler    : MakeAffineMatrix と同じ X → Y → Z の順
+class Quaternion {
+public:
+	float x, y, z, w;
+
+	static Quaternion MakeIdentity();
+
+	// 任意軸回転（axis は正規化済みであること）
+	static Quaternion MakeRotateAxisAngle(const Vector3& axis, float angle);
+
+	// オイラー角（X → Y → Z の順に回転）から生成
+	static Quaternion MakeFromEuler(const Vector3& rotate);
+
+	// オイラー角（X → Y → Z の順）に分解する。各角度は -π ～ π に収まる
+	static Vector3 ToEuler(const Quaternion& q);
+
+	static Quaternion Multiply(const Quaternion& q1, const Quaternion& q2);
+	static Quaternion Conjugate(const Quaternion& q);
+	static Quaternion Inverse(const Quaternion& q);
+	static Quaternion Normalize(const Quaternion& q);
+	static float Dot(const Quaternion& q1, const Quaternion& q2);
+	static float Length(const Quaternion& q);
+
+	// ベクトルを回転させる
+	static Vector3 RotateVector(const Vector3& vector, const Quaternion& q);
+
+	// 回転行列（行ベクトル規約、MakeRotateXYZMatrix と同じ並び）
+	static Matrix4x4 MakeRotateMatrix(const Quaternion& q);
+
+	// 正規化線形補間（高速・角速度は一定にならない）
+	static Quaternion Nlerp(const Quaternion& q0, const Quaternion& q1, float t);
+
+	// 球面線形補間（常に最短経路で補間する）
+	static Quaternion Slerp(const Quaternion& q0, const Quaternion& q1, float t);
+};
+
+Quaternion operator*(const Quaternion& q1, const Quaternion& q2);
+
+// 配列どうしの球面線形補間 output[i] = Slerp(from[i], to[i], t[i])
+// acos / sin を使わない多項式近似（各成分の誤差 2e-5 未満）で、SIMD で 4 要素ずつ処理する。
+// 全要素の要素数は同じであること。output が from / to と同じ配列でもよい
+void SlerpQuaternions(
+	std::span<const Quaternion> from, std::span<const Quaternion> to,
+	std::span<const float> t, std::span<Quaternion> output);
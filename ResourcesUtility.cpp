@@ -6,7 +6,9 @@
 
 // UpdateSubresourcesなどのヘルパー関数用
 #include "externals/DirectXTex/d3dx12.h" 
+#include "UploadHeap.h"
 
+#include <algorithm>
 #include <cassert>
 #include <format>
 
@@ -134,30 +136,63 @@ DirectX::ScratchImage LoadTexture(const std::string& filePath) {
 	return mipImages;
 }
 
-Microsoft::WRL::ComPtr<ID3D12Resource> UploadTextureData(const Microsoft::WRL::ComPtr<ID3D12Resource>& texture, const DirectX::ScratchImage& mipImages, const Microsoft::WRL::ComPtr<ID3D12Device>& device, const Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList>& commandList) {
+namespace {
+
+// 中間バッファの offset から texture へのコピーと、読み取り状態へのバリアを積む（mipImages のミップ firstMip 以降）
+void RecordTextureUpload(
+	ID3D12Resource* texture, const DirectX::ScratchImage& mipImages, uint32_t firstMip, ID3D12Device* device,
+	ID3D12GraphicsCommandList* commandList, ID3D12Resource* intermediate, uint64_t intermediateOffset) {
 
+	const DirectX::TexMetadata metadata = GetMipRangeMetadata(mipImages.GetMetadata(), firstMip);
 	std::vector<D3D12_SUBRESOURCE_DATA> subresources;
 	// DirectXTexのヘルパーを使ってアップロード用データを準備
-	DirectX::PrepareUpload(device.Get(), mipImages.GetImages(), mipImages.GetImageCount(), mipImages.GetMetadata(), subresources);
-
-	// 中間バッファに必要なサイズを計算
-	uint64_t intermediateSize = GetRequiredIntermediateSize(texture.Get(), 0, UINT(subresources.size()));
-
-	// 中間バッファ（Upload Heap）を作成
-	Microsoft::WRL::ComPtr<ID3D12Resource> intermediateResource = CreateBufferResource(device, intermediateSize);
+	// 配列なしの 2D テクスチャはミップ順に並んでいるので、firstMip 枚目からがそのまま部分の画像列になる
+	DirectX::PrepareUpload(device, mipImages.GetImages() + firstMip, mipImages.GetImageCount() - firstMip, metadata, subresources);
 
 	// データ転送コマンドの発行（CPU -> 中間バッファ -> GPU）
-	UpdateSubresources(commandList.Get(), texture.Get(), intermediateResource.Get(), 0, 0, UINT(subresources.size()), subresources.data());
+	UpdateSubresources(commandList, texture, intermediate, intermediateOffset, 0, UINT(subresources.size()), subresources.data());
 
 	// 転送後はPixelShader等で読めるようにバリアを張る
 	D3D12_RESOURCE_BARRIER barrier{};
 	barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
 	barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-	barrier.Transition.pResource = texture.Get();
+	barrier.Transition.pResource = texture;
 	barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
 	barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
 	barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_GENERIC_READ;
 	commandList->ResourceBarrier(1, &barrier);
+}
+
+}
+
+Microsoft::WRL::ComPtr<ID3D12Resource> UploadTextureData(const Microsoft::WRL::ComPtr<ID3D12Resource>& texture, const DirectX::ScratchImage& mipImages, const Microsoft::WRL::ComPtr<ID3D12Device>& device, const Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList>& commandList) {
+
+	// 中間バッファ（Upload Heap）を作成
+	Microsoft::WRL::ComPtr<ID3D12Resource> intermediateResource = CreateBufferResource(device, GetTextureUploadSize(texture, mipImages));
+
+	RecordTextureUpload(texture.Get(), mipImages, 0, device.Get(), commandList.Get(), intermediateResource.Get(), 0);
 
 	return intermediateResource;
-}
\ No newline at end of file
+}
+
+DirectX::TexMetadata GetMipRangeMetadata(const DirectX::TexMetadata& metadata, uint32_t firstMip) {
+	assert(firstMip < metadata.mipLevels);
+	assert(firstMip == 0 || (metadata.arraySize == 1 && metadata.dimension == DirectX::TEX_DIMENSION_TEXTURE2D));
+	DirectX::TexMetadata range = metadata;
+	range.width = (std::max)(metadata.width >> firstMip, size_t(1));
+	range.height = (std::max)(metadata.height >> firstMip, size_t(1));
+	range.mipLevels = metadata.mipLevels - firstMip;
+	return range;
+}
+
+uint64_t GetTextureUploadSize(const Microsoft::WRL::ComPtr<ID3D12Resource>& texture, const DirectX::ScratchImage& mipImages, uint32_t firstMip) {
+	return GetRequiredIntermediateSize(texture.Get(), 0, UINT(mipImages.GetImageCount() - firstMip));
+}
+
+void UploadTextureData(const Microsoft::WRL::ComPtr<ID3D12Resource>& texture, const DirectX::ScratchImage& mipImages, const Microsoft::WRL::ComPtr<ID3D12Device>& device, const Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList>& commandList, const UploadAllocation& upload, uint32_t firstMip) {
+	assert(upload.resource != nullptr);
+	assert(upload.offset % D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT == 0);
+	assert(upload.size >= GetTextureUploadSize(texture, mipImages, firstMip));
+
+	RecordTextureUpload(texture.Get(), mipImages, firstMip, device.Get(), commandList.Get(), upload.resource, upload.offset);
+}
@@ -7,6 +7,8 @@
 // DirectXTexのインクルード
 #include "externals/DirectXTex/DirectXTex.h"
 
+struct UploadAllocation;
+
 	// 256バイトアライメント計算
 	// 定数バッファのサイズ調整などで頻繁に使用します
 inline size_t Align256(size_t size) {
@@ -45,4 +47,27 @@ Microsoft::WRL::ComPtr<ID3D12Resource> UploadTextureData(
 	const DirectX::ScratchImage& mipImages,
 	const Microsoft::WRL::ComPtr<ID3D12Device>& device,
 	const Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList>& commandList
-);
\ No newline at end of file
+);
+
+// metadata のミップ firstMip 以降だけを持つテクスチャの情報（ミップストリーミングで一部だけ常駐させるとき用）
+DirectX::TexMetadata GetMipRangeMetadata(const DirectX::TexMetadata& metadata, uint32_t firstMip);
+
+// テクスチャの転送に必要な中間バッファのサイズ（firstMip 以降を転送する場合）
+uint64_t GetTextureUploadSize(
+	const Microsoft::WRL::ComPtr<ID3D12Resource>& texture,
+	const DirectX::ScratchImage& mipImages,
+	uint32_t firstMip = 0
+);
+
+// テクスチャデータのアップロード（UploadHeap から切り出した領域を中間バッファに使う）
+// upload は GetTextureUploadSize 以上の大きさで、D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT 境界にあること。
+// 領域はコマンドリストのフェンス値で UploadHeap::Submit するまで使用中になる。
+// firstMip : mipImages のこのミップ以降を転送する（texture は GetMipRangeMetadata の情報で作ってあること。配列テクスチャは 0 のみ）
+void UploadTextureData(
+	const Microsoft::WRL::ComPtr<ID3D12Resource>& texture,
+	const DirectX::ScratchImage& mipImages,
+	const Microsoft::WRL::ComPtr<ID3D12Device>& device,
+	const Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList>& commandList,
+	const UploadAllocation& upload,
+	uint32_t firstMip = 0
+);
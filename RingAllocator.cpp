@@ -0,0 +1,274 @@
+#include "RingAllocator.h"
+
+namespace {
+
+size_t AlignUp(size_t value, size_t alignment) {
+	assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+}
+
+void RingAllocator::Reset(size_t capacity) {
+	capacity_ = capacity;
+	head_ = 0;
+	tail_ = 0;
+	used_ = 0;
+	allocatedTotal_ = 0;
+	closedTotal_ = 0;
+	releasedTotal_ = 0;
+	fences_.clear();
+}
+
+// ===================================
+// 確保
+// ===================================
+size_t RingAllocator::Allocate(size_t size, size_t alignment) {
+	if (size == 0 || size > capacity_ || used_ == capacity_) {
+		return kInvalidOffset;
+	}
+
+	// 空なら先頭に戻して、連続した空きを最大にする
+	if (used_ == 0) {
+		head_ = 0;
+		tail_ = 0;
+	}
+
+	size_t offset = AlignUp(head_, alignment);
+	size_t consumed = 0; // head から進む量（詰め物込み）
+
+	if (head_ >= tail_) {
+		// 空き = [head, 容量) と [0, tail)
+		if (offset <= capacity_ && size <= capacity_ - offset) {
+			consumed = offset + size - head_;
+		} else if (size <= tail_) {
+			// 末尾の残りは捨てて 0 から切り出す
+			offset = 0;
+			consumed = capacity_ - head_ + size;
+		} else {
+			return kInvalidOffset;
+		}
+	} else {
+		// 空き = [head, tail)
+		if (offset > tail_ || size > tail_ - offset) {
+			return kInvalidOffset;
+		}
+		consumed = offset + size - head_;
+	}
+
+	head_ = offset + size;
+	used_ += consumed;
+	allocatedTotal_ += consumed;
+	assert(used_ <= capacity_);
+	return offset;
+}
+
+// ===================================
+// フェンスでの締めと解放
+// ===================================
+void RingAllocator::Close(uint64_t fenceValue) {
+	if (!HasOpenAllocations()) {
+		return;
+	}
+	assert(fences_.empty() || fences_.back().fenceValue <= fenceValue);
+	fences_.push_back({ fenceValue, head_, allocatedTotal_ });
+	closedTotal_ = allocatedTotal_;
+}
+
+void RingAllocator::Release(const FencedRange& range) {
+	tail_ = range.end;
+	used_ -= static_cast<size_t>(range.total - releasedTotal_);
+	releasedTotal_ = range.total;
+}
+
+// ===================================
+// テスト（ctest の ring_allocator_test）
+// ===================================
+// GPU のフェンスの代わりに「完了したフェンス値」の変数を進めて、折り返し・容量ちょうどの確保・
+// 一部だけ完了したフェンスでの Retire と、ランダムな確保で区間が重ならないことを確かめる。
+#if defined(TOMO_RING_ALLOCATOR_TEST_MAIN)
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+// GPU のフェンスの代わり（Signal で値を返し、Complete で完了した値を進める）
+struct SimulatedFence {
+	uint64_t nextValue = 1;
+	uint64_t completedValue = 0;
+
+	uint64_t Signal() { return nextValue++; }
+	void Complete(uint64_t value) { completedValue = value; }
+	bool IsComplete(uint64_t value) const { return value <= completedValue; }
+};
+
+int gFailureCount = 0;
+
+void Expect(bool condition, const char* what) {
+	std::printf("%-60s %s\n", what, condition ? "ok" : "NG");
+	gFailureCount += condition ? 0 : 1;
+}
+
+}
+
+int main() {
+	// ================================
+	// 1.容量ちょうどの確保
+	// ================================
+	{
+		SimulatedFence fence;
+		RingAllocator ring(256);
+		auto isComplete = [&](uint64_t value) { return fence.IsComplete(value); };
+		Expect(ring.Allocate(256) == 0, "exact capacity: allocate 256 of 256 at offset 0");
+		Expect(ring.GetUsedSize() == 256 && ring.Allocate(1) == RingAllocator::kInvalidOffset, "exact capacity: full ring rejects 1 byte");
+		Expect(ring.Allocate(257) == RingAllocator::kInvalidOffset, "exact capacity: larger than capacity is rejected");
+		const uint64_t value = fence.Signal();
+		ring.Close(value);
+		ring.Retire(isComplete);
+		Expect(ring.GetUsedSize() == 256, "exact capacity: not released before the fence");
+		fence.Complete(value);
+		ring.Retire(isComplete);
+		Expect(ring.IsEmpty() && ring.Allocate(256) == 0, "exact capacity: released and reusable after the fence");
+	}
+
+	// ================================
+	// 2.折り返し
+	// ================================
+	{
+		SimulatedFence fence;
+		RingAllocator ring(256);
+		auto isComplete = [&](uint64_t value) { return fence.IsComplete(value); };
+		const size_t a = ring.Allocate(100);
+		const uint64_t fenceA = fence.Signal();
+		ring.Close(fenceA);
+		const size_t b = ring.Allocate(100);
+		ring.Close(fence.Signal());
+		Expect(a == 0 && b == 100, "wrap: first two allocations are contiguous");
+
+		fence.Complete(fenceA);
+		ring.Retire(isComplete);
+		Expect(ring.GetUsedSize() == 100, "wrap: first range released");
+
+		// 末尾に 56 バイトしか残っていないので 0 に戻る（残りは詰め物として数える）
+		const size_t c = ring.Allocate(100);
+		Expect(c == 0, "wrap: third allocation wraps to offset 0");
+		Expect(ring.GetUsedSize() == 256, "wrap: skipped tail counts as used");
+		Expect(ring.Allocate(1) == RingAllocator::kInvalidOffset, "wrap: no room between head and tail");
+		const uint64_t fenceC = fence.Signal();
+		ring.Close(fenceC);
+
+		fence.Complete(fenceC - 1);
+		ring.Retire(isComplete);
+		Expect(ring.GetUsedSize() == 156, "wrap: second range released, padding kept with the third");
+		Expect(ring.Allocate(100) == 100, "wrap: freed middle is reused");
+		Expect(ring.Allocate(1) == RingAllocator::kInvalidOffset, "wrap: ring full again");
+	}
+
+	// ================================
+	// 3.一部だけ完了したフェンスでの Retire
+	// ================================
+	{
+		SimulatedFence fence;
+		RingAllocator ring(1024);
+		auto isComplete = [&](uint64_t value) { return fence.IsComplete(value); };
+		std::vector<uint64_t> values;
+		for (int i = 0; i < 5; ++i) {
+			ring.Allocate(100);
+			values.push_back(fence.Signal());
+			ring.Close(values.back());
+		}
+		ring.Allocate(50); // 締めていない確保は解放されない
+		Expect(ring.HasOpenAllocations(), "partial: open allocation tracked");
+
+		fence.Complete(values[2]);
+		ring.Retire(isComplete);
+		Expect(ring.GetUsedSize() == 250 && ring.GetOldestFenceValue() == values[3], "partial: only completed fences released");
+
+		ring.Retire(isComplete);
+		Expect(ring.GetUsedSize() == 250, "partial: retiring again changes nothing");
+
+		fence.Complete(values[4]);
+		ring.Retire(isComplete);
+		Expect(ring.GetUsedSize() == 50 && ring.GetOldestFenceValue() == 0, "partial: open allocation survives all fences");
+		ring.Close(fence.Signal());
+		fence.Complete(fence.nextValue - 1);
+		ring.Retire(isComplete);
+		Expect(ring.IsEmpty(), "partial: empty after the last fence");
+	}
+
+	// ================================
+	// 4.ランダムな確保（生きている区間が重ならず、アライメントが守られる）
+	// ================================
+	{
+		struct Live {
+			size_t offset;
+			size_t size;
+			uint64_t fenceValue;
+		};
+		SimulatedFence fence;
+		RingAllocator ring(64 * 1024);
+		auto isComplete = [&](uint64_t value) { return fence.IsComplete(value); };
+		std::mt19937 random(2024);
+		std::vector<Live> live;
+		std::vector<Live> open;
+		bool overlapFree = true;
+		bool aligned = true;
+		bool bounded = true;
+		size_t wrapCount = 0;
+		size_t previousOffset = 0;
+		std::vector<uint64_t> inFlight;
+
+		for (int frame = 0; frame < 5000; ++frame) {
+			const int allocationCount = static_cast<int>(random() % 6);
+			for (int i = 0; i < allocationCount; ++i) {
+				const size_t size = 1 + random() % 6000;
+				const size_t alignment = size_t{ 1 } << (random() % 9);
+				const size_t offset = ring.Allocate(size, alignment);
+				if (offset == RingAllocator::kInvalidOffset) {
+					continue;
+				}
+				aligned = aligned && offset % alignment == 0;
+				bounded = bounded && offset + size <= ring.GetCapacity();
+				for (const Live& other : live) {
+					overlapFree = overlapFree && (offset + size <= other.offset || other.offset + other.size <= offset);
+				}
+				for (const Live& other : open) {
+					overlapFree = overlapFree && (offset + size <= other.offset || other.offset + other.size <= offset);
+				}
+				wrapCount += offset < previousOffset ? 1 : 0;
+				previousOffset = offset;
+				open.push_back({ offset, size, 0 });
+			}
+
+			// フレームの終わりに締め、GPU は 0～3 フレーム遅れて追いつく
+			const uint64_t value = fence.Signal();
+			ring.Close(value);
+			for (Live& allocation : open) {
+				allocation.fenceValue = value;
+				live.push_back(allocation);
+			}
+			open.clear();
+			inFlight.push_back(value);
+			const size_t lag = random() % 4;
+			while (inFlight.size() > lag) {
+				fence.Complete(inFlight.front());
+				inFlight.erase(inFlight.begin());
+			}
+			ring.Retire(isComplete);
+			std::erase_if(live, [&](const Live& allocation) { return fence.IsComplete(allocation.fenceValue); });
+		}
+		fence.Complete(fence.nextValue - 1);
+		ring.Retire(isComplete);
+
+		std::printf("random: %zu wrap-arounds\n", wrapCount);
+		Expect(overlapFree && bounded, "random: live allocations never overlap");
+		Expect(aligned, "random: alignment respected");
+		Expect(wrapCount > 0, "random: ring wrapped around");
+		Expect(ring.IsEmpty(), "random: empty after all fences complete");
+	}
+
+	std::puts(gFailureCount == 0 ? "PASSED" : "FAILED");
+	return gFailureCount == 0 ? 0 : 1;
+}
+#endif
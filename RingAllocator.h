@@ -0,0 +1,72 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+
+// ==================================
+// フェンスで解放するリングアロケータ
+// ==================================
+// 1 つの大きなバッファの中のオフセットだけを管理する（D3D12 に依存しない）。
+//   Allocate : 先頭（head）から切り出す。末尾に入りきらなければ 0 に戻る
+//   Close    : まだ閉じていない確保をまとめて、それを使うコピーのフェンス値で締める
+//   Retire   : 完了したフェンスまで末尾（tail）を進めて領域を戻す
+// フェンス値は記録時にはまだ分からない（ExecuteCommandList の戻り値）ので、確保と締めを分けている。
+class RingAllocator {
+public:
+	static constexpr size_t kInvalidOffset = std::numeric_limits<size_t>::max();
+
+	RingAllocator() = default;
+	explicit RingAllocator(size_t capacity) { Reset(capacity); }
+
+	// 空にして容量を設定し直す
+	void Reset(size_t capacity);
+
+	// size バイトを alignment（2 のべき乗）境界で確保し、オフセットを返す。空きが無ければ kInvalidOffset
+	size_t Allocate(size_t size, size_t alignment = 1);
+
+	// Close 前の確保をまとめて fenceValue で締める（fenceValue は単調増加であること）
+	void Close(uint64_t fenceValue);
+
+	// 古い順に isFenceComplete(fenceValue) が true の区間を戻す（最初に未完了のものがあればそこで止まる）
+	template <typename IsFenceComplete>
+	void Retire(IsFenceComplete&& isFenceComplete) {
+		while (!fences_.empty() && isFenceComplete(fences_.front().fenceValue)) {
+			Release(fences_.front());
+			fences_.pop_front();
+		}
+	}
+
+	size_t GetCapacity() const { return capacity_; }
+	size_t GetUsedSize() const { return used_; } // 詰め物（アライメント・折り返し）を含む
+	bool IsEmpty() const { return used_ == 0; }
+
+	// Close 前の確保があるか
+	bool HasOpenAllocations() const { return allocatedTotal_ != closedTotal_; }
+
+	// 最も古い締め済み区間のフェンス値（無ければ 0）。空きが足りないときにこれを待つ
+	uint64_t GetOldestFenceValue() const { return fences_.empty() ? 0 : fences_.front().fenceValue; }
+
+private:
+	// フェンス 1 つ分の区間
+	struct FencedRange {
+		uint64_t fenceValue;
+		size_t end;        // 区間の終わり（締めた時点の head）
+		uint64_t total;    // 締めた時点までの累計確保量
+	};
+
+	void Release(const FencedRange& range);
+
+	size_t capacity_ = 0;
+	size_t head_ = 0;              // 次に切り出す位置
+	size_t tail_ = 0;              // 使用中の最も古い位置
+	size_t used_ = 0;
+
+	// 確保・解放の累計（詰め物込み）。差が used_ になる
+	uint64_t allocatedTotal_ = 0;
+	uint64_t closedTotal_ = 0;
+	uint64_t releasedTotal_ = 0;
+
+	std::deque<FencedRange> fences_;
+};
@@ -20,7 +20,7 @@ public:
 private:
 	// ワールドトランスフォーム
 	WorldTransform worldTransform_;
-	// モデル
+	// モデル（所有しない。ModelRegistry のハンドルを持つ側が寿命を管理する）
 	Model* model_ = nullptr;
 	// カメラ
 	Camera* camera_ = nullptr;
@@ -0,0 +1,312 @@
+#include "TextureAtlas.h"
+#include "AtlasPacker.h"
+#include "Fnv1a.h"
+#include "Logger.h"
+#include "TextureCooker.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <system_error>
+
+namespace {
+
+// ページは RGBA8 sRGB で組み立ててからミップを作って圧縮する
+constexpr DXGI_FORMAT kPageFormat = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+constexpr size_t kPixelSize = 4;
+
+constexpr bool IsPowerOfTwo(uint32_t value) {
+	return value != 0 && (value & (value - 1)) == 0;
+}
+
+constexpr uint32_t AlignUp(uint32_t value, uint32_t alignment) {
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+uint64_t GetPageHash(uint64_t key, uint32_t page) {
+	return Fnv1a::HashValue(key, page);
+}
+
+// 元画像を読んでミップ 0 を RGBA8 sRGB にする
+bool DecodeTile(const std::string& filePath, DirectX::ScratchImage& tile) {
+	DirectX::ScratchImage source;
+	if (!TextureCooker::Decode(filePath, source)) {
+		return false;
+	}
+	const DirectX::TexMetadata& metadata = source.GetMetadata();
+	// 配列・キューブ・HDR は対象外
+	if (metadata.dimension != DirectX::TEX_DIMENSION_TEXTURE2D || metadata.arraySize != 1 ||
+		DirectX::FormatDataType(metadata.format) == DirectX::FORMAT_TYPE_FLOAT) {
+		return false;
+	}
+
+	if (DirectX::IsCompressed(metadata.format)) {
+		DirectX::ScratchImage decompressed;
+		if (FAILED(DirectX::Decompress(*source.GetImage(0, 0, 0), DXGI_FORMAT_UNKNOWN, decompressed))) {
+			return false;
+		}
+		source = std::move(decompressed);
+	}
+
+	const DirectX::Image& image = *source.GetImage(0, 0, 0);
+	if (image.format == kPageFormat) {
+		return SUCCEEDED(tile.InitializeFromImage(image));
+	}
+	// LoadTexture / TextureCooker と同じく元画像は sRGB として扱う（色空間の変換はしない）
+	return SUCCEEDED(DirectX::Convert(image, kPageFormat, DirectX::TEX_FILTER_SRGB, DirectX::TEX_THRESHOLD_DEFAULT, tile));
+}
+
+// tile を page の (left, top) から width x height の範囲に置き、中身の周り gutter ピクセルには端の色を引き伸ばす
+void BlitWithGutter(const DirectX::Image& tile, const DirectX::Image& page, uint32_t left, uint32_t top, uint32_t width, uint32_t height, uint32_t gutter) {
+	const int32_t lastX = static_cast<int32_t>(tile.width) - 1;
+	const int32_t lastY = static_cast<int32_t>(tile.height) - 1;
+	for (uint32_t y = 0; y < height; ++y) {
+		const int32_t sourceY = std::clamp(static_cast<int32_t>(y) - static_cast<int32_t>(gutter), 0, lastY);
+		const uint8_t* sourceRow = tile.pixels + tile.rowPitch * sourceY;
+		uint8_t* destinationRow = page.pixels + page.rowPitch * (top + y) + kPixelSize * left;
+		for (uint32_t x = 0; x < width; ++x) {
+			const int32_t sourceX = std::clamp(static_cast<int32_t>(x) - static_cast<int32_t>(gutter), 0, lastX);
+			std::memcpy(destinationRow + kPixelSize * x, sourceRow + kPixelSize * sourceX, kPixelSize);
+		}
+	}
+}
+
+}
+
+// ===================================
+// 設定から決まる値
+// ===================================
+uint32_t TextureAtlas::GetMipLevels(const Settings& settings) {
+	// BC 圧縮は 4x4 ブロック単位なので、余白が 1 ブロック未満になると隣のタイルと同じブロックに入る
+	const uint32_t minGutter = settings.compress ? 4u : 1u;
+	uint32_t levels = 1;
+	while ((settings.gutter >> levels) >= minGutter && (settings.pageSize >> levels) >= 1) {
+		++levels;
+	}
+	return levels;
+}
+
+Matrix4x4 TextureAtlas::MakeUvTransform(const Tile& tile, uint32_t pageSize) {
+	// シェーダーは mul(float4(uv, 0, 1), uvTransform)（行ベクトル）なので、平行移動は 4 行目に置く
+	const float inverseSize = 1.0f / static_cast<float>(pageSize);
+	Matrix4x4 result = Matrix4x4::MakeIdentity4x4();
+	result.m[0][0] = tile.width * inverseSize;
+	result.m[1][1] = tile.height * inverseSize;
+	result.m[3][0] = tile.x * inverseSize;
+	result.m[3][1] = tile.y * inverseSize;
+	return result;
+}
+
+uint64_t TextureAtlas::ComputeKey(std::span<const std::string> filePaths, const Settings& settings) {
+	uint64_t hash = Fnv1a::kOffsetBasis;
+	hash = Fnv1a::HashValue(hash, kAtlasVersion);
+	hash = Fnv1a::HashValue(hash, DIRECTX_TEX_VERSION);
+	hash = Fnv1a::HashValue(hash, (static_cast<uint64_t>(settings.pageSize) << 32) | settings.maxTileSize);
+	hash = Fnv1a::HashValue(hash, (static_cast<uint64_t>(settings.gutter) << 32) | (settings.compress ? 1u : 0u));
+	// タイルはパスで引くのでパスも混ぜる
+	for (const std::string& filePath : filePaths) {
+		hash = Fnv1a::HashString(hash, filePath);
+		hash = Fnv1a::HashValue(hash, TextureCooker::ComputeSourceHash(filePath, TextureCooker::Format::Uncompressed));
+	}
+	return hash != 0 ? hash : 1;
+}
+
+std::string TextureAtlas::GetManifestPath(uint64_t key) {
+	char name[32];
+	std::snprintf(name, sizeof(name), "%016llx.atlas", static_cast<unsigned long long>(key));
+	return TextureCooker::GetCacheDirectory() + "/" + name;
+}
+
+// ===================================
+// 作成
+// ===================================
+bool TextureAtlas::Build(std::span<const std::string> filePaths, const Settings& settings, Atlas& atlas) {
+	assert(IsPowerOfTwo(settings.pageSize) && IsPowerOfTwo(settings.gutter));
+	const auto start = std::chrono::steady_clock::now();
+	const uint32_t gutter = settings.gutter;
+
+	// ================================
+	// 1.デコードして、余白込みの大きさを求める（大きすぎる・読めない画像は大きさ 0 で置かない）
+	// ================================
+	std::vector<DirectX::ScratchImage> tiles(filePaths.size());
+	std::vector<AtlasPacker::Rect> sizes(filePaths.size());
+	for (size_t i = 0; i < filePaths.size(); ++i) {
+		if (!DecodeTile(filePaths[i], tiles[i])) {
+			Log(std::format("TextureAtlas: {} is not packed (unsupported image)\n", filePaths[i]));
+			continue;
+		}
+		const DirectX::TexMetadata& metadata = tiles[i].GetMetadata();
+		if (metadata.width > settings.maxTileSize || metadata.height > settings.maxTileSize) {
+			continue;
+		}
+		// 位置も余白の倍数に揃うよう、大きさを余白の倍数に切り上げる
+		sizes[i].width = AlignUp(static_cast<uint32_t>(metadata.width) + gutter * 2, gutter);
+		sizes[i].height = AlignUp(static_cast<uint32_t>(metadata.height) + gutter * 2, gutter);
+	}
+
+	// ================================
+	// 2.ページに詰める
+	// ================================
+	std::vector<AtlasPacker::Placement> placements;
+	const uint32_t pageCount = AtlasPacker::PackPages(sizes, settings.pageSize, settings.pageSize, placements);
+	if (pageCount == 0) {
+		return false;
+	}
+
+	// ================================
+	// 3.ページを組み立てる（空いているところは不透明の黒にして、不透明な画像だけなら BC1 になるようにする）
+	// ================================
+	std::vector<DirectX::ScratchImage> pageImages(pageCount);
+	for (DirectX::ScratchImage& pageImage : pageImages) {
+		if (FAILED(pageImage.Initialize2D(kPageFormat, settings.pageSize, settings.pageSize, 1, 1))) {
+			return false;
+		}
+		const DirectX::Image& image = *pageImage.GetImage(0, 0, 0);
+		for (size_t y = 0; y < image.height; ++y) {
+			uint8_t* row = image.pixels + image.rowPitch * y;
+			for (size_t x = 0; x < image.width; ++x) {
+				row[x * kPixelSize + 0] = 0;
+				row[x * kPixelSize + 1] = 0;
+				row[x * kPixelSize + 2] = 0;
+				row[x * kPixelSize + 3] = 0xFF;
+			}
+		}
+	}
+
+	atlas.pageSize = settings.pageSize;
+	atlas.tiles.clear();
+	for (size_t i = 0; i < filePaths.size(); ++i) {
+		const AtlasPacker::Placement& placement = placements[i];
+		if (placement.page == AtlasPacker::Placement::kNotPlaced) {
+			continue;
+		}
+		const DirectX::Image& tile = *tiles[i].GetImage(0, 0, 0);
+		BlitWithGutter(tile, *pageImages[placement.page].GetImage(0, 0, 0),
+			placement.rect.x, placement.rect.y, placement.rect.width, placement.rect.height, gutter);
+		atlas.tiles[filePaths[i]] = {
+			placement.page, placement.rect.x + gutter, placement.rect.y + gutter,
+			static_cast<uint32_t>(tile.width), static_cast<uint32_t>(tile.height) };
+	}
+
+	// ================================
+	// 4.ミップ（2x2 の単純平均）と圧縮
+	// ================================
+	const uint32_t mipLevels = GetMipLevels(settings);
+	const TextureCooker::Format format = settings.compress ? TextureCooker::Format::Auto : TextureCooker::Format::Uncompressed;
+	atlas.pages.clear();
+	atlas.pages.resize(pageCount);
+	for (uint32_t page = 0; page < pageCount; ++page) {
+		DirectX::ScratchImage mipImages;
+		HRESULT hr = DirectX::GenerateMipMaps(
+			*pageImages[page].GetImage(0, 0, 0),
+			DirectX::TEX_FILTER_BOX | DirectX::TEX_FILTER_SRGB | DirectX::TEX_FILTER_FORCE_NON_WIC,
+			mipLevels, mipImages);
+		if (FAILED(hr) || !TextureCooker::Compress(std::move(mipImages), format, atlas.pages[page])) {
+			return false;
+		}
+	}
+
+	const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	Log(std::format("TextureAtlas: {} of {} textures -> {} page(s) {}x{} mips {} ({:.1f} ms)\n",
+		atlas.tiles.size(), filePaths.size(), pageCount, settings.pageSize, settings.pageSize, mipLevels, ms));
+	return true;
+}
+
+// ===================================
+// 読み書き
+// ===================================
+// 配置表の書式（テキスト）
+//   tomoatlas <版> <ページの大きさ> <ページ数>
+//   <ページ> <x> <y> <幅> <高さ> <元画像のパス>   … タイルの数だけ
+bool TextureAtlas::TryRead(uint64_t key, Atlas& atlas) {
+	std::ifstream file(std::filesystem::path(GetManifestPath(key)));
+	if (!file) {
+		return false;
+	}
+	std::string magic;
+	uint32_t version = 0;
+	uint32_t pageSize = 0;
+	uint32_t pageCount = 0;
+	file >> magic >> version >> pageSize >> pageCount;
+	if (!file || magic != "tomoatlas" || version != kAtlasVersion || pageCount == 0) {
+		return false;
+	}
+
+	atlas.key = key;
+	atlas.pageSize = pageSize;
+	atlas.pages.clear();
+	atlas.pages.resize(pageCount);
+	for (uint32_t page = 0; page < pageCount; ++page) {
+		if (!TextureCooker::TryRead(TextureCooker::GetCachePath(GetPageHash(key, page)), atlas.pages[page])) {
+			return false;
+		}
+	}
+
+	atlas.tiles.clear();
+	Tile tile;
+	std::string filePath;
+	while (file >> tile.page >> tile.x >> tile.y >> tile.width >> tile.height) {
+		file >> std::ws;
+		std::getline(file, filePath);
+		if (tile.page >= pageCount) {
+			return false;
+		}
+		atlas.tiles[filePath] = tile;
+	}
+	return !atlas.tiles.empty();
+}
+
+bool TextureAtlas::Write(const Atlas& atlas) {
+	// ページを先に書き、配置表は最後に置き換える（配置表があればページも揃っている）
+	for (uint32_t page = 0; page < atlas.pages.size(); ++page) {
+		if (!TextureCooker::Write(TextureCooker::GetCachePath(GetPageHash(atlas.key, page)), atlas.pages[page])) {
+			return false;
+		}
+	}
+
+	std::error_code error;
+	const std::filesystem::path path(GetManifestPath(atlas.key));
+	const std::filesystem::path temporaryPath(path.string() + ".tmp");
+	{
+		std::ofstream file(temporaryPath, std::ios::trunc);
+		file << "tomoatlas " << kAtlasVersion << ' ' << atlas.pageSize << ' ' << atlas.pages.size() << '\n';
+		for (const auto& [filePath, tile] : atlas.tiles) {
+			file << tile.page << ' ' << tile.x << ' ' << tile.y << ' ' << tile.width << ' ' << tile.height << ' ' << filePath << '\n';
+		}
+		if (!file) {
+			file.close();
+			std::filesystem::remove(temporaryPath, error);
+			return false;
+		}
+	}
+	std::filesystem::rename(temporaryPath, path, error);
+	if (error) {
+		std::filesystem::remove(temporaryPath, error);
+		return false;
+	}
+	return true;
+}
+
+// ===================================
+// 読み込み
+// ===================================
+bool TextureAtlas::Load(std::span<const std::string> filePaths, const Settings& settings, Atlas& atlas) {
+	const uint64_t key = ComputeKey(filePaths, settings);
+	if (TryRead(key, atlas)) {
+		return true;
+	}
+
+	atlas = Atlas{};
+	if (!Build(filePaths, settings, atlas)) {
+		return false;
+	}
+	atlas.key = key;
+	// 書けなくても次回また作るだけなので無視する
+	Write(atlas);
+	return true;
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Matrix4x4.h"
+
+namespace DirectX { class ScratchImage; }
+
+// ==================================
+// 小さいテクスチャのアトラス化（事前変換）
+// ==================================
+// 複数の小さい画像を AtlasPacker で数枚のページ（正方形、2 のべき乗）に詰め、ミップを作って BC 圧縮した結果を
+// TextureCooker のキャッシュ置き場に DDS + 配置表（.atlas）として書き出す。2 回目以降はそれを読むだけ。
+// 同じページを使うマテリアルは SRV が同じになるので、描画のたびにテクスチャを設定し直さずに済む。
+//
+// タイルの周りには gutter ピクセルだけ端の色を引き伸ばしておき、位置も gutter の倍数に揃える。
+// ページのミップは 2x2 の単純平均で作るので、ミップ m でもタイルの周りに gutter >> m の余白が残り、隣のタイルの色が混ざらない。
+// そのため作るミップは「最後の段でも余白が 1 テクセル（圧縮するなら 1 ブロック = 4 テクセル）残る」段数までにする。
+//
+// タイル内の UV は MakeUvTransform の行列（Material::uvTransform）でページ上の位置に移す。
+// UV が 0～1 を超えて繰り返す（WRAP に頼る）メッシュには使えない（Model は UV の範囲を見て個別のテクスチャに戻す）。
+class TextureAtlas {
+public:
+	struct Settings {
+		uint32_t pageSize = 2048;    // ページの幅・高さ（2 のべき乗）
+		uint32_t maxTileSize = 1024; // 幅か高さがこれより大きい画像はアトラスに入れない
+		uint32_t gutter = 16;        // タイルの周りの余白（2 のべき乗）
+		bool compress = true;        // 不透明なら BC1、アルファがあれば BC7（TextureCooker::Format::Auto）
+	};
+
+	// ページ上のタイル（位置はミップ 0 のピクセル。余白は含まない）
+	struct Tile {
+		uint32_t page = 0;
+		uint32_t x = 0;
+		uint32_t y = 0;
+		uint32_t width = 0;
+		uint32_t height = 0;
+	};
+
+	struct Atlas {
+		uint64_t key = 0;                             // キャッシュキー（元画像と設定のハッシュ）
+		uint32_t pageSize = 0;
+		std::vector<DirectX::ScratchImage> pages;     // ミップ込み
+		std::unordered_map<std::string, Tile> tiles;  // 元画像のパス → タイル（入らなかった画像は無い）
+	};
+
+	// 配置や変換結果が変わったら上げる
+	static constexpr uint32_t kAtlasVersion = 1;
+
+	// キャッシュがあればそれを、無ければ Build してキャッシュを書き出す。1 枚も入らなければ false
+	static bool Load(std::span<const std::string> filePaths, const Settings& settings, Atlas& atlas);
+
+	// 元画像を読んでページを作る（Load の中身）。1 枚も入らなければ false
+	static bool Build(std::span<const std::string> filePaths, const Settings& settings, Atlas& atlas);
+
+	// 作るミップの段数
+	static uint32_t GetMipLevels(const Settings& settings);
+
+	// タイル内の UV（0～1）をページ上の UV に移す行列（uv * scale + offset）
+	static Matrix4x4 MakeUvTransform(const Tile& tile, uint32_t pageSize);
+
+	// 元画像の内容と設定からキャッシュキーを求める
+	static uint64_t ComputeKey(std::span<const std::string> filePaths, const Settings& settings);
+
+private:
+	static std::string GetManifestPath(uint64_t key);
+	static bool TryRead(uint64_t key, Atlas& atlas);
+	static bool Write(const Atlas& atlas);
+};
@@ -0,0 +1,1116 @@
+#include "TextureCodec.h"
+#include "Logger.h"
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#if defined(TOMO_TEXTURE_CODEC_PNG)
+#include <png.h>
+#endif
+#if defined(TOMO_TEXTURE_CODEC_JPEG)
+#include <csetjmp>
+#include <cstdio>
+#include <jpeglib.h>
+#endif
+
+namespace {
+
+// ================================
+// sRGB と線形の変換
+// ================================
+const std::array<float, 256>& GetSrgbToLinearTable() {
+	static const std::array<float, 256> table = [] {
+		std::array<float, 256> result{};
+		for (size_t i = 0; i < result.size(); ++i) {
+			const float c = static_cast<float>(i) / 255.0f;
+			result[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+		}
+		return result;
+	}();
+	return table;
+}
+
+uint8_t LinearToSrgb(float linear) {
+	const float c = std::clamp(linear, 0.0f, 1.0f);
+	const float srgb = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+	return static_cast<uint8_t>(srgb * 255.0f + 0.5f);
+}
+
+uint8_t ToByte(float value) {
+	return static_cast<uint8_t>(std::clamp(value, 0.0f, 255.0f) + 0.5f);
+}
+
+// ================================
+// 拡大縮小の重み
+// ================================
+struct Tap {
+	uint32_t index;
+	float weight;
+};
+
+// 出力ピクセル x の重みは taps[offsets[x]..offsets[x + 1]]
+void ComputeTaps(uint32_t sourceSize, uint32_t targetSize, std::vector<uint32_t>& offsets, std::vector<Tap>& taps) {
+	const double scale = static_cast<double>(sourceSize) / static_cast<double>(targetSize);
+	offsets.assign(1, 0);
+	taps.clear();
+	for (uint32_t x = 0; x < targetSize; ++x) {
+		if (scale >= 1.0) {
+			// 縮小：出力ピクセルが覆う範囲 [begin, end) との重なりの長さで平均する
+			const double begin = x * scale;
+			const double end = (x + 1) * scale;
+			const uint32_t first = static_cast<uint32_t>(begin);
+			const uint32_t last = std::min(sourceSize, static_cast<uint32_t>(std::ceil(end)));
+			for (uint32_t i = first; i < last; ++i) {
+				const double overlap = std::min(end, i + 1.0) - std::max(begin, static_cast<double>(i));
+				if (overlap > 0.0) {
+					taps.push_back({ i, static_cast<float>(overlap / scale) });
+				}
+			}
+		} else {
+			// 拡大：両隣の 2 ピクセルを線形補間する（端は繰り返す）
+			const double center = (x + 0.5) * scale - 0.5;
+			const double base = std::floor(center);
+			const float t = static_cast<float>(center - base);
+			const int64_t i0 = static_cast<int64_t>(base);
+			auto clampIndex = [&](int64_t i) { return static_cast<uint32_t>(std::clamp<int64_t>(i, 0, sourceSize - 1)); };
+			taps.push_back({ clampIndex(i0), 1.0f - t });
+			taps.push_back({ clampIndex(i0 + 1), t });
+		}
+		offsets.push_back(static_cast<uint32_t>(taps.size()));
+	}
+}
+
+// ================================
+// ブロックの読み書き
+// ================================
+// 4x4 の RGBA（範囲外は端のピクセルを繰り返す）
+void ReadBlock(const TextureCodec::Image& image, uint32_t blockX, uint32_t blockY, uint8_t block[16][4]) {
+	for (uint32_t y = 0; y < 4; ++y) {
+		const uint32_t sy = std::min(blockY * 4 + y, image.height - 1);
+		for (uint32_t x = 0; x < 4; ++x) {
+			const uint32_t sx = std::min(blockX * 4 + x, image.width - 1);
+			std::memcpy(block[y * 4 + x], &image.pixels[(static_cast<size_t>(sy) * image.width + sx) * 4], 4);
+		}
+	}
+}
+
+void WriteBlock(TextureCodec::Image& image, uint32_t blockX, uint32_t blockY, const uint8_t block[16][4]) {
+	for (uint32_t y = 0; y < 4 && blockY * 4 + y < image.height; ++y) {
+		for (uint32_t x = 0; x < 4 && blockX * 4 + x < image.width; ++x) {
+			std::memcpy(&image.pixels[(static_cast<size_t>(blockY * 4 + y) * image.width + blockX * 4 + x) * 4], block[y * 4 + x], 4);
+		}
+	}
+}
+
+// LSB から順にビットを詰める 128 ビットのブロック（BC7 用）
+struct BitWriter {
+	uint8_t* data;
+	uint32_t position = 0;
+
+	void Write(uint32_t value, uint32_t count) {
+		for (uint32_t i = 0; i < count; ++i, ++position) {
+			if ((value >> i) & 1u) {
+				data[position / 8] |= static_cast<uint8_t>(1u << (position % 8));
+			}
+		}
+	}
+};
+
+struct BitReader {
+	const uint8_t* data;
+	uint32_t position = 0;
+
+	uint32_t Read(uint32_t count) {
+		uint32_t value = 0;
+		for (uint32_t i = 0; i < count; ++i, ++position) {
+			value |= static_cast<uint32_t>((data[position / 8] >> (position % 8)) & 1u) << i;
+		}
+		return value;
+	}
+};
+
+// ================================
+// 端点の推定
+// ================================
+// points の主軸（分散が最大の方向）を冪乗法で求める。全点が同じなら false
+template <int N>
+bool ComputePrincipalAxis(const float (*points)[4], int count, float mean[N], float axis[N]) {
+	for (int c = 0; c < N; ++c) {
+		mean[c] = 0.0f;
+		for (int i = 0; i < count; ++i) {
+			mean[c] += points[i][c];
+		}
+		mean[c] /= static_cast<float>(count);
+	}
+	float covariance[N][N] = {};
+	for (int i = 0; i < count; ++i) {
+		for (int a = 0; a < N; ++a) {
+			for (int b = 0; b < N; ++b) {
+				covariance[a][b] += (points[i][a] - mean[a]) * (points[i][b] - mean[b]);
+			}
+		}
+	}
+	// 最も分散の大きい成分から始める
+	int start = 0;
+	for (int c = 1; c < N; ++c) {
+		start = covariance[c][c] > covariance[start][start] ? c : start;
+	}
+	if (covariance[start][start] <= 0.0f) {
+		return false;
+	}
+	for (int c = 0; c < N; ++c) {
+		axis[c] = covariance[start][c];
+	}
+	for (int iteration = 0; iteration < 8; ++iteration) {
+		float next[N] = {};
+		float length = 0.0f;
+		for (int a = 0; a < N; ++a) {
+			for (int b = 0; b < N; ++b) {
+				next[a] += covariance[a][b] * axis[b];
+			}
+			length += next[a] * next[a];
+		}
+		if (length <= 0.0f) {
+			return false;
+		}
+		length = std::sqrt(length);
+		for (int c = 0; c < N; ++c) {
+			axis[c] = next[c] / length;
+		}
+	}
+	return true;
+}
+
+// 主軸に射影した両端を端点にする
+template <int N>
+void ComputeEndpoints(const float (*points)[4], int count, float endpoint0[4], float endpoint1[4]) {
+	float mean[N];
+	float axis[N];
+	if (!ComputePrincipalAxis<N>(points, count, mean, axis)) {
+		for (int c = 0; c < 4; ++c) {
+			endpoint0[c] = endpoint1[c] = points[0][c];
+		}
+		return;
+	}
+	float minT = 0.0f;
+	float maxT = 0.0f;
+	for (int i = 0; i < count; ++i) {
+		float t = 0.0f;
+		for (int c = 0; c < N; ++c) {
+			t += (points[i][c] - mean[c]) * axis[c];
+		}
+		minT = std::min(minT, t);
+		maxT = std::max(maxT, t);
+	}
+	for (int c = 0; c < 4; ++c) {
+		endpoint0[c] = c < N ? std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f) : 255.0f;
+		endpoint1[c] = c < N ? std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f) : 255.0f;
+	}
+}
+
+// 番号ごとの重み（端点 0 の割合）から端点を最小二乗で求め直す。解けなければ false
+template <int N>
+bool RefineEndpoints(const float (*points)[4], const float* weights, int count, float endpoint0[4], float endpoint1[4]) {
+	float aa = 0.0f;
+	float ab = 0.0f;
+	float bb = 0.0f;
+	float ax[N] = {};
+	float bx[N] = {};
+	for (int i = 0; i < count; ++i) {
+		const float a = weights[i];
+		const float b = 1.0f - a;
+		aa += a * a;
+		ab += a * b;
+		bb += b * b;
+		for (int c = 0; c < N; ++c) {
+			ax[c] += a * points[i][c];
+			bx[c] += b * points[i][c];
+		}
+	}
+	const float determinant = aa * bb - ab * ab;
+	if (std::abs(determinant) < 1.0e-6f) {
+		return false;
+	}
+	for (int c = 0; c < N; ++c) {
+		endpoint0[c] = std::clamp((bb * ax[c] - ab * bx[c]) / determinant, 0.0f, 255.0f);
+		endpoint1[c] = std::clamp((aa * bx[c] - ab * ax[c]) / determinant, 0.0f, 255.0f);
+	}
+	return true;
+}
+
+// ================================
+// BC1 / BC3 の色ブロック
+// ================================
+uint16_t PackRgb565(const float color[4]) {
+	const uint32_t r = static_cast<uint32_t>(std::clamp(color[0], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+	const uint32_t g = static_cast<uint32_t>(std::clamp(color[1], 0.0f, 255.0f) * 63.0f / 255.0f + 0.5f);
+	const uint32_t b = static_cast<uint32_t>(std::clamp(color[2], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+	return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+void UnpackRgb565(uint16_t packed, int rgb[3]) {
+	const int r = (packed >> 11) & 31;
+	const int g = (packed >> 5) & 63;
+	const int b = packed & 31;
+	rgb[0] = (r << 3) | (r >> 2);
+	rgb[1] = (g << 2) | (g >> 4);
+	rgb[2] = (b << 3) | (b >> 2);
+}
+
+// 端点 2 つから 4 色の表を作る（fourColors = false なら 3 色 + 透明）
+void MakeColorPalette(uint16_t color0, uint16_t color1, bool fourColors, int palette[4][4]) {
+	UnpackRgb565(color0, palette[0]);
+	UnpackRgb565(color1, palette[1]);
+	for (int c = 0; c < 3; ++c) {
+		if (fourColors) {
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		} else {
+			palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+			palette[3][c] = 0;
+		}
+	}
+	palette[0][3] = palette[1][3] = palette[2][3] = 255;
+	palette[3][3] = fourColors ? 255 : 0;
+}
+
+// 色ブロック（8 バイト）。transparent[i] のピクセルは 3 色モードの透明（番号 3）にする（BC3 では常に false）
+void EncodeColorBlock(const uint8_t block[16][4], const bool transparent[16], uint8_t* output) {
+	float points[16][4];
+	int count = 0;
+	for (int i = 0; i < 16; ++i) {
+		if (!transparent[i]) {
+			for (int c = 0; c < 4; ++c) {
+				points[count][c] = block[i][c];
+			}
+			++count;
+		}
+	}
+	const bool hasTransparent = count < 16;
+
+	uint16_t bestColor0 = 0;
+	uint16_t bestColor1 = 0;
+	uint32_t bestIndices = hasTransparent ? 0xFFFFFFFFu : 0u;
+	if (count > 0) {
+		float endpoint0[4];
+		float endpoint1[4];
+		ComputeEndpoints<3>(points, count, endpoint0, endpoint1);
+
+		int64_t bestError = -1;
+		for (int iteration = 0; iteration < 3; ++iteration) {
+			uint16_t color0 = PackRgb565(endpoint0);
+			uint16_t color1 = PackRgb565(endpoint1);
+			// 4 色モードは color0 > color1、3 色モードは color0 <= color1
+			if (hasTransparent ? color0 > color1 : color0 < color1) {
+				std::swap(color0, color1);
+				std::swap(endpoint0, endpoint1);
+			}
+			const bool fourColors = color0 > color1;
+			int palette[4][4];
+			MakeColorPalette(color0, color1, fourColors, palette);
+
+			// 近い色の番号を選ぶ（3 色モードでは番号 3 は透明なので使わない）
+			uint32_t indices = 0;
+			int64_t error = 0;
+			float weights[16];
+			int point = 0;
+			for (int i = 0; i < 16; ++i) {
+				uint32_t best = 3;
+				if (!transparent[i]) {
+					int64_t bestDistance = INT64_MAX;
+					for (uint32_t k = 0; k < (fourColors ? 4u : 3u); ++k) {
+						int64_t distance = 0;
+						for (int c = 0; c < 3; ++c) {
+							const int64_t d = static_cast<int64_t>(block[i][c]) - palette[k][c];
+							distance += d * d;
+						}
+						if (distance < bestDistance) {
+							bestDistance = distance;
+							best = k;
+						}
+					}
+					error += bestDistance;
+					static constexpr float kFourColorWeights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+					static constexpr float kThreeColorWeights[3] = { 1.0f, 0.0f, 0.5f };
+					weights[point++] = fourColors ? kFourColorWeights[best] : kThreeColorWeights[best];
+				}
+				indices |= best << (i * 2);
+			}
+			if (bestError < 0 || error < bestError) {
+				bestError = error;
+				bestColor0 = color0;
+				bestColor1 = color1;
+				bestIndices = indices;
+			}
+			if (error == 0 || !RefineEndpoints<3>(points, weights, count, endpoint0, endpoint1)) {
+				break;
+			}
+		}
+		// 端点が同じだと 3 色モードになるので、4 色のつもりの番号 3（透明）を 0 に直す
+		if (!hasTransparent && bestColor0 == bestColor1) {
+			bestIndices = 0;
+		}
+	}
+	std::memcpy(output, &bestColor0, 2);
+	std::memcpy(output + 2, &bestColor1, 2);
+	std::memcpy(output + 4, &bestIndices, 4);
+}
+
+void DecodeColorBlock(const uint8_t* input, bool allowThreeColors, uint8_t block[16][4]) {
+	uint16_t color0;
+	uint16_t color1;
+	uint32_t indices;
+	std::memcpy(&color0, input, 2);
+	std::memcpy(&color1, input + 2, 2);
+	std::memcpy(&indices, input + 4, 4);
+	int palette[4][4];
+	MakeColorPalette(color0, color1, !allowThreeColors || color0 > color1, palette);
+	for (int i = 0; i < 16; ++i) {
+		const int* color = palette[(indices >> (i * 2)) & 3];
+		for (int c = 0; c < 4; ++c) {
+			block[i][c] = static_cast<uint8_t>(color[c]);
+		}
+	}
+}
+
+// ================================
+// BC3 のアルファブロック
+// ================================
+void MakeAlphaPalette(uint8_t alpha0, uint8_t alpha1, int palette[8]) {
+	palette[0] = alpha0;
+	palette[1] = alpha1;
+	if (alpha0 > alpha1) {
+		for (int k = 1; k < 7; ++k) {
+			palette[k + 1] = ((7 - k) * alpha0 + k * alpha1) / 7;
+		}
+	} else {
+		for (int k = 1; k < 5; ++k) {
+			palette[k + 1] = ((5 - k) * alpha0 + k * alpha1) / 5;
+		}
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+}
+
+void EncodeAlphaBlock(const uint8_t block[16][4], uint8_t* output) {
+	uint8_t alpha0 = 0;
+	uint8_t alpha1 = 255;
+	for (int i = 0; i < 16; ++i) {
+		alpha0 = std::max(alpha0, block[i][3]);
+		alpha1 = std::min(alpha1, block[i][3]);
+	}
+	int palette[8];
+	MakeAlphaPalette(alpha0, alpha1, palette);
+	uint64_t indices = 0;
+	if (alpha0 > alpha1) {
+		for (int i = 0; i < 16; ++i) {
+			uint64_t best = 0;
+			int bestDistance = 256;
+			for (uint64_t k = 0; k < 8; ++k) {
+				const int distance = std::abs(palette[k] - block[i][3]);
+				if (distance < bestDistance) {
+					bestDistance = distance;
+					best = k;
+				}
+			}
+			indices |= best << (i * 3);
+		}
+	}
+	output[0] = alpha0;
+	output[1] = alpha1;
+	for (int b = 0; b < 6; ++b) {
+		output[2 + b] = static_cast<uint8_t>(indices >> (b * 8));
+	}
+}
+
+void DecodeAlphaBlock(const uint8_t* input, uint8_t block[16][4]) {
+	int palette[8];
+	MakeAlphaPalette(input[0], input[1], palette);
+	uint64_t indices = 0;
+	for (int b = 0; b < 6; ++b) {
+		indices |= static_cast<uint64_t>(input[2 + b]) << (b * 8);
+	}
+	for (int i = 0; i < 16; ++i) {
+		block[i][3] = static_cast<uint8_t>(palette[(indices >> (i * 3)) & 7]);
+	}
+}
+
+// ================================
+// BC7 モード 6
+// ================================
+constexpr int kBc7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+// 7 ビット + p ビットに量子化する（p ビットは誤差の小さい方）
+void QuantizeBc7Endpoint(const float endpoint[4], uint32_t quantized[4], uint32_t& pBit) {
+	float bestError = -1.0f;
+	for (uint32_t p = 0; p < 2; ++p) {
+		uint32_t candidate[4];
+		float error = 0.0f;
+		for (int c = 0; c < 4; ++c) {
+			candidate[c] = static_cast<uint32_t>(std::clamp((endpoint[c] - static_cast<float>(p)) * 0.5f + 0.5f, 0.0f, 127.0f));
+			const float d = endpoint[c] - static_cast<float>((candidate[c] << 1) | p);
+			error += d * d;
+		}
+		if (bestError < 0.0f || error < bestError) {
+			bestError = error;
+			pBit = p;
+			std::copy(candidate, candidate + 4, quantized);
+		}
+	}
+}
+
+void EncodeBc7Block(const uint8_t block[16][4], uint8_t* output) {
+	float points[16][4];
+	for (int i = 0; i < 16; ++i) {
+		for (int c = 0; c < 4; ++c) {
+			points[i][c] = block[i][c];
+		}
+	}
+	float endpoint0[4];
+	float endpoint1[4];
+	ComputeEndpoints<4>(points, 16, endpoint0, endpoint1);
+
+	uint32_t bestQuantized[2][4] = {};
+	uint32_t bestPBits[2] = {};
+	uint32_t bestIndices[16] = {};
+	int64_t bestError = -1;
+	for (int iteration = 0; iteration < 3; ++iteration) {
+		uint32_t quantized[2][4];
+		uint32_t pBits[2];
+		QuantizeBc7Endpoint(endpoint0, quantized[0], pBits[0]);
+		QuantizeBc7Endpoint(endpoint1, quantized[1], pBits[1]);
+		int palette[16][4];
+		for (int c = 0; c < 4; ++c) {
+			const int e0 = static_cast<int>((quantized[0][c] << 1) | pBits[0]);
+			const int e1 = static_cast<int>((quantized[1][c] << 1) | pBits[1]);
+			for (int k = 0; k < 16; ++k) {
+				palette[k][c] = ((64 - kBc7Weights[k]) * e0 + kBc7Weights[k] * e1 + 32) >> 6;
+			}
+		}
+
+		uint32_t indices[16];
+		float weights[16];
+		int64_t error = 0;
+		for (int i = 0; i < 16; ++i) {
+			int64_t bestDistance = INT64_MAX;
+			for (uint32_t k = 0; k < 16; ++k) {
+				int64_t distance = 0;
+				for (int c = 0; c < 4; ++c) {
+					const int64_t d = static_cast<int64_t>(block[i][c]) - palette[k][c];
+					distance += d * d;
+				}
+				if (distance < bestDistance) {
+					bestDistance = distance;
+					indices[i] = k;
+				}
+			}
+			error += bestDistance;
+			weights[i] = 1.0f - static_cast<float>(kBc7Weights[indices[i]]) / 64.0f;
+		}
+		if (bestError < 0 || error < bestError) {
+			bestError = error;
+			std::memcpy(bestQuantized, quantized, sizeof(quantized));
+			std::memcpy(bestPBits, pBits, sizeof(pBits));
+			std::memcpy(bestIndices, indices, sizeof(indices));
+		}
+		if (error == 0 || !RefineEndpoints<4>(points, weights, 16, endpoint0, endpoint1)) {
+			break;
+		}
+	}
+
+	// 先頭のピクセルの番号は最上位ビットが 0（3 ビットで書く）。1 なら端点を入れ替えて番号を反転する
+	if (bestIndices[0] >= 8) {
+		std::swap(bestQuantized[0], bestQuantized[1]);
+		std::swap(bestPBits[0], bestPBits[1]);
+		for (uint32_t& index : bestIndices) {
+			index = 15 - index;
+		}
+	}
+
+	std::memset(output, 0, 16);
+	BitWriter writer{ output };
+	writer.Write(1u << 6, 7); // モード 6
+	for (int c = 0; c < 4; ++c) {
+		writer.Write(bestQuantized[0][c], 7);
+		writer.Write(bestQuantized[1][c], 7);
+	}
+	writer.Write(bestPBits[0], 1);
+	writer.Write(bestPBits[1], 1);
+	writer.Write(bestIndices[0], 3);
+	for (int i = 1; i < 16; ++i) {
+		writer.Write(bestIndices[i], 4);
+	}
+	assert(writer.position == 128);
+}
+
+// モード 6 以外のブロックはマゼンタにする（自前の圧縮器はモード 6 しか書かない）
+void DecodeBc7Block(const uint8_t* input, uint8_t block[16][4]) {
+	BitReader reader{ input };
+	if (reader.Read(7) != (1u << 6)) {
+		for (int i = 0; i < 16; ++i) {
+			block[i][0] = 255;
+			block[i][1] = 0;
+			block[i][2] = 255;
+			block[i][3] = 255;
+		}
+		return;
+	}
+	uint32_t quantized[2][4];
+	for (int c = 0; c < 4; ++c) {
+		quantized[0][c] = reader.Read(7);
+		quantized[1][c] = reader.Read(7);
+	}
+	const uint32_t pBit0 = reader.Read(1);
+	const uint32_t pBit1 = reader.Read(1);
+	for (int i = 0; i < 16; ++i) {
+		const uint32_t index = reader.Read(i == 0 ? 3 : 4);
+		for (int c = 0; c < 4; ++c) {
+			const int e0 = static_cast<int>((quantized[0][c] << 1) | pBit0);
+			const int e1 = static_cast<int>((quantized[1][c] << 1) | pBit1);
+			block[i][c] = static_cast<uint8_t>(((64 - kBc7Weights[index]) * e0 + kBc7Weights[index] * e1 + 32) >> 6);
+		}
+	}
+}
+
+// ================================
+// デコード（PNG / JPEG）
+// ================================
+#if defined(TOMO_TEXTURE_CODEC_PNG)
+bool DecodePng(const std::string& filePath, const MappedFile& file, TextureCodec::Image& image) {
+	png_image png{};
+	png.version = PNG_IMAGE_VERSION;
+	if (!png_image_begin_read_from_memory(&png, file.GetData(), file.GetSize())) {
+		Log("TextureCodec: " + filePath + " " + png.message + "\n");
+		return false;
+	}
+	png.format = PNG_FORMAT_RGBA;
+	image.width = png.width;
+	image.height = png.height;
+	image.pixels.resize(PNG_IMAGE_SIZE(png));
+	if (!png_image_finish_read(&png, nullptr, image.pixels.data(), 0, nullptr)) {
+		Log("TextureCodec: " + filePath + " " + png.message + "\n");
+		png_image_free(&png);
+		return false;
+	}
+	return true;
+}
+#endif
+
+#if defined(TOMO_TEXTURE_CODEC_JPEG)
+// libjpeg は失敗すると error_exit を呼ぶので、exit させずに longjmp で戻る
+struct JpegErrorManager {
+	jpeg_error_mgr base;
+	std::jmp_buf jump;
+	char message[JMSG_LENGTH_MAX];
+};
+
+void OnJpegError(j_common_ptr info) {
+	JpegErrorManager* error = reinterpret_cast<JpegErrorManager*>(info->err);
+	(*info->err->format_message)(info, error->message);
+	std::longjmp(error->jump, 1);
+}
+
+// setjmp と longjmp の間にデストラクタを持つローカル変数を置かないこと
+bool DecodeJpeg(const std::string& filePath, const MappedFile& file, TextureCodec::Image& image) {
+	jpeg_decompress_struct jpeg;
+	JpegErrorManager error;
+	jpeg.err = jpeg_std_error(&error.base);
+	error.base.error_exit = OnJpegError;
+	if (setjmp(error.jump)) {
+		jpeg_destroy_decompress(&jpeg);
+		Log("TextureCodec: " + filePath + " " + error.message + "\n");
+		return false;
+	}
+	jpeg_create_decompress(&jpeg);
+	jpeg_mem_src(&jpeg, reinterpret_cast<unsigned char*>(const_cast<char*>(file.GetData())), static_cast<unsigned long>(file.GetSize()));
+	jpeg_read_header(&jpeg, TRUE);
+	jpeg.out_color_space = JCS_RGB;
+	jpeg_start_decompress(&jpeg);
+
+	image.width = jpeg.output_width;
+	image.height = jpeg.output_height;
+	image.pixels.resize(static_cast<size_t>(image.width) * image.height * 4);
+	while (jpeg.output_scanline < jpeg.output_height) {
+		// 行の後ろ 3/4 に RGB で読み、前から RGBA に広げる（書く位置が読む位置を追い越さない）
+		uint8_t* row = &image.pixels[static_cast<size_t>(jpeg.output_scanline) * image.width * 4];
+		JSAMPROW rgb = row + image.width;
+		jpeg_read_scanlines(&jpeg, &rgb, 1);
+		for (uint32_t x = 0; x < image.width; ++x) {
+			const uint8_t r = rgb[x * 3];
+			const uint8_t g = rgb[x * 3 + 1];
+			const uint8_t b = rgb[x * 3 + 2];
+			row[x * 4] = r;
+			row[x * 4 + 1] = g;
+			row[x * 4 + 2] = b;
+			row[x * 4 + 3] = 255;
+		}
+	}
+	jpeg_finish_decompress(&jpeg);
+	jpeg_destroy_decompress(&jpeg);
+	return true;
+}
+#endif
+
+// ================================
+// DDS
+// ================================
+// DXGI_FORMAT の値（dxgiformat.h と同じ）
+uint32_t ToDxgiFormat(TextureCodec::Format format) {
+	switch (format) {
+	case TextureCodec::Format::BC1:
+		return 72; // DXGI_FORMAT_BC1_UNORM_SRGB
+	case TextureCodec::Format::BC3:
+		return 78; // DXGI_FORMAT_BC3_UNORM_SRGB
+	case TextureCodec::Format::BC7:
+		return 99; // DXGI_FORMAT_BC7_UNORM_SRGB
+	default:
+		return 29; // DXGI_FORMAT_R8G8B8A8_UNORM_SRGB
+	}
+}
+
+}
+
+bool TextureCodec::Image::IsAlphaAllOpaque() const {
+	for (size_t i = 3; i < pixels.size(); i += 4) {
+		if (pixels[i] != 255) {
+			return false;
+		}
+	}
+	return true;
+}
+
+size_t TextureCodec::GetBlockBytes(Format format) {
+	switch (format) {
+	case Format::BC1:
+		return 8;
+	case Format::BC3:
+	case Format::BC7:
+		return 16;
+	default:
+		return 0;
+	}
+}
+
+// ===================================
+// デコード
+// ===================================
+bool TextureCodec::Decode(const std::string& filePath, Image& image) {
+	MappedFile file;
+	if (!file.Open(filePath)) {
+		return false;
+	}
+	const std::string_view data = file.GetView();
+	if (data.starts_with("\x89PNG\r\n\x1a\n")) {
+#if defined(TOMO_TEXTURE_CODEC_PNG)
+		return DecodePng(filePath, file, image);
+#endif
+	} else if (data.starts_with("\xff\xd8\xff")) {
+#if defined(TOMO_TEXTURE_CODEC_JPEG)
+		return DecodeJpeg(filePath, file, image);
+#endif
+	}
+	// 拡張子が .png でも中身が WebP などのことがある
+	const std::string_view magic = data.substr(0, std::min<size_t>(data.size(), 12));
+	const bool webp = magic.size() == 12 && magic.starts_with("RIFF") && magic.substr(8) == "WEBP";
+	Log("TextureCodec: " + filePath + (webp ? " is WebP (unsupported)\n" : " has an unsupported format\n"));
+	return false;
+}
+
+// ===================================
+// 拡大縮小とミップ
+// ===================================
+TextureCodec::Image TextureCodec::Resize(const Image& source, uint32_t width, uint32_t height) {
+	assert(source.width > 0 && source.height > 0 && width > 0 && height > 0);
+	if (source.width == width && source.height == height) {
+		return source;
+	}
+
+	std::vector<uint32_t> offsetsX;
+	std::vector<uint32_t> offsetsY;
+	std::vector<Tap> tapsX;
+	std::vector<Tap> tapsY;
+	ComputeTaps(source.width, width, offsetsX, tapsX);
+	ComputeTaps(source.height, height, offsetsY, tapsY);
+	const std::array<float, 256>& toLinear = GetSrgbToLinearTable();
+
+	// 横方向（線形の色のまま float で持つ）
+	std::vector<float> horizontal(static_cast<size_t>(width) * source.height * 4);
+	for (uint32_t y = 0; y < source.height; ++y) {
+		const uint8_t* row = &source.pixels[static_cast<size_t>(y) * source.width * 4];
+		float* output = &horizontal[static_cast<size_t>(y) * width * 4];
+		for (uint32_t x = 0; x < width; ++x) {
+			float sum[4] = {};
+			for (uint32_t t = offsetsX[x]; t < offsetsX[x + 1]; ++t) {
+				const uint8_t* pixel = row + tapsX[t].index * 4;
+				sum[0] += toLinear[pixel[0]] * tapsX[t].weight;
+				sum[1] += toLinear[pixel[1]] * tapsX[t].weight;
+				sum[2] += toLinear[pixel[2]] * tapsX[t].weight;
+				sum[3] += pixel[3] * tapsX[t].weight;
+			}
+			std::copy(sum, sum + 4, output + x * 4);
+		}
+	}
+
+	// 縦方向
+	Image result;
+	result.width = width;
+	result.height = height;
+	result.pixels.resize(static_cast<size_t>(width) * height * 4);
+	for (uint32_t y = 0; y < height; ++y) {
+		uint8_t* output = &result.pixels[static_cast<size_t>(y) * width * 4];
+		for (uint32_t x = 0; x < width; ++x) {
+			float sum[4] = {};
+			for (uint32_t t = offsetsY[y]; t < offsetsY[y + 1]; ++t) {
+				const float* pixel = &horizontal[(static_cast<size_t>(tapsY[t].index) * width + x) * 4];
+				for (int c = 0; c < 4; ++c) {
+					sum[c] += pixel[c] * tapsY[t].weight;
+				}
+			}
+			output[x * 4] = LinearToSrgb(sum[0]);
+			output[x * 4 + 1] = LinearToSrgb(sum[1]);
+			output[x * 4 + 2] = LinearToSrgb(sum[2]);
+			output[x * 4 + 3] = ToByte(sum[3]);
+		}
+	}
+	return result;
+}
+
+void TextureCodec::GenerateMips(Image&& top, std::vector<Image>& mips) {
+	mips.clear();
+	mips.push_back(std::move(top));
+	while (mips.back().width > 1 || mips.back().height > 1) {
+		Image next = Resize(mips.back(), std::max(1u, mips.back().width / 2), std::max(1u, mips.back().height / 2));
+		mips.push_back(std::move(next));
+	}
+}
+
+// ===================================
+// 圧縮
+// ===================================
+bool TextureCodec::Compress(const std::vector<Image>& mips, Format format, Texture& texture) {
+	if (mips.empty()) {
+		return false;
+	}
+	texture.format = format;
+	texture.width = mips[0].width;
+	texture.height = mips[0].height;
+	texture.mips.clear();
+	if (format == Format::RGBA8) {
+		for (const Image& mip : mips) {
+			texture.mips.push_back(mip.pixels);
+		}
+		return true;
+	}
+	// D3D12 では BC テクスチャの先頭のミップは 4 の倍数でなければならない（2 段目以降は端のブロックが余ってよい）
+	if (texture.width % 4 != 0 || texture.height % 4 != 0) {
+		return false;
+	}
+
+	const size_t blockBytes = GetBlockBytes(format);
+	for (const Image& mip : mips) {
+		const uint32_t blocksX = (mip.width + 3) / 4;
+		const uint32_t blocksY = (mip.height + 3) / 4;
+		std::vector<uint8_t>& output = texture.mips.emplace_back(static_cast<size_t>(blocksX) * blocksY * blockBytes);
+		for (uint32_t by = 0; by < blocksY; ++by) {
+			for (uint32_t bx = 0; bx < blocksX; ++bx) {
+				uint8_t block[16][4];
+				ReadBlock(mip, bx, by, block);
+				uint8_t* encoded = &output[(static_cast<size_t>(by) * blocksX + bx) * blockBytes];
+				switch (format) {
+				case Format::BC1: {
+					// アルファは 1 ビット（半分未満は透明）
+					bool transparent[16];
+					for (int i = 0; i < 16; ++i) {
+						transparent[i] = block[i][3] < 128;
+					}
+					EncodeColorBlock(block, transparent, encoded);
+					break;
+				}
+				case Format::BC3: {
+					const bool opaque[16] = {};
+					EncodeAlphaBlock(block, encoded);
+					EncodeColorBlock(block, opaque, encoded + 8);
+					break;
+				}
+				default:
+					EncodeBc7Block(block, encoded);
+					break;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+TextureCodec::Image TextureCodec::Decompress(const Texture& texture, uint32_t mip) {
+	assert(mip < texture.mips.size());
+	Image image;
+	image.width = std::max(1u, texture.width >> mip);
+	image.height = std::max(1u, texture.height >> mip);
+	if (texture.format == Format::RGBA8) {
+		image.pixels = texture.mips[mip];
+		return image;
+	}
+
+	image.pixels.resize(static_cast<size_t>(image.width) * image.height * 4);
+	const size_t blockBytes = GetBlockBytes(texture.format);
+	const uint32_t blocksX = (image.width + 3) / 4;
+	const uint32_t blocksY = (image.height + 3) / 4;
+	for (uint32_t by = 0; by < blocksY; ++by) {
+		for (uint32_t bx = 0; bx < blocksX; ++bx) {
+			const uint8_t* encoded = &texture.mips[mip][(static_cast<size_t>(by) * blocksX + bx) * blockBytes];
+			uint8_t block[16][4];
+			switch (texture.format) {
+			case Format::BC1:
+				DecodeColorBlock(encoded, true, block);
+				break;
+			case Format::BC3:
+				DecodeColorBlock(encoded + 8, false, block);
+				DecodeAlphaBlock(encoded, block);
+				break;
+			default:
+				DecodeBc7Block(encoded, block);
+				break;
+			}
+			WriteBlock(image, bx, by, block);
+		}
+	}
+	return image;
+}
+
+// ===================================
+// 書き出し
+// ===================================
+bool TextureCodec::WriteDds(const std::string& path, const Texture& texture) {
+	if (texture.mips.empty()) {
+		return false;
+	}
+	const bool compressed = texture.format != Format::RGBA8;
+
+	// DDS_HEADER（124 バイト）+ DDS_HEADER_DXT10（20 バイト）。DDS.h の定義と同じ並び
+	uint32_t header[31] = {};
+	header[0] = 124;                                                         // size
+	header[1] = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | (compressed ? 0x80000 : 0x8); // CAPS | HEIGHT | WIDTH | PIXELFORMAT | MIPMAPCOUNT | LINEARSIZE or PITCH
+	header[2] = texture.height;
+	header[3] = texture.width;
+	header[4] = compressed ? static_cast<uint32_t>(texture.mips[0].size()) : texture.width * 4;
+	header[6] = static_cast<uint32_t>(texture.mips.size());
+	header[18] = 32;                                                         // ddspf.size
+	header[19] = 0x4;                                                        // DDPF_FOURCC
+	header[20] = 0x30315844;                                                 // 'DX10'
+	header[26] = 0x1000 | (texture.mips.size() > 1 ? 0x400008 : 0);          // TEXTURE | MIPMAP | COMPLEX
+	const uint32_t extension[5] = {
+		ToDxgiFormat(texture.format),
+		3,   // D3D12_RESOURCE_DIMENSION_TEXTURE2D
+		0,   // miscFlag
+		1,   // arraySize
+		0,   // miscFlags2
+	};
+
+	std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+	if (!stream) {
+		return false;
+	}
+	stream.write("DDS ", 4);
+	stream.write(reinterpret_cast<const char*>(header), sizeof(header));
+	stream.write(reinterpret_cast<const char*>(extension), sizeof(extension));
+	for (const std::vector<uint8_t>& mip : texture.mips) {
+		stream.write(reinterpret_cast<const char*>(mip.data()), static_cast<std::streamsize>(mip.size()));
+	}
+	return static_cast<bool>(stream);
+}
+
+// ===================================
+// テスト（ctest の texture_codec_test）
+// ===================================
+// 4 の倍数への丸め、sRGB を考えたミップ、BC1 / BC3 / BC7 の画質（PSNR）、BC1 の透明、DDS のヘッダーを確かめる。
+#if defined(TOMO_TEXTURE_CODEC_TEST_MAIN)
+#include <cstdio>
+#include <filesystem>
+#include <random>
+
+namespace {
+
+static_assert(TextureCodec::RoundToBlockSize(414) == 416 && TextureCodec::RoundToBlockSize(410) == 412);
+static_assert(TextureCodec::RoundToBlockSize(990) == 992 && TextureCodec::RoundToBlockSize(469) == 468);
+static_assert(TextureCodec::RoundToBlockSize(1) == 4 && TextureCodec::RoundToBlockSize(512) == 512);
+
+int gFailureCount = 0;
+
+void Expect(bool condition, const char* what) {
+	std::printf("%-60s %s\n", what, condition ? "ok" : "NG");
+	gFailureCount += condition ? 0 : 1;
+}
+
+// なめらかなグラデーション + 細かい模様 + 鋭い境界（写真とテクスチャの中間くらい）
+TextureCodec::Image MakeTestImage(uint32_t width, uint32_t height, bool withAlpha) {
+	std::mt19937 random(7);
+	std::uniform_int_distribution<int> noise(-6, 6);
+	TextureCodec::Image image;
+	image.width = width;
+	image.height = height;
+	image.pixels.resize(static_cast<size_t>(width) * height * 4);
+	for (uint32_t y = 0; y < height; ++y) {
+		for (uint32_t x = 0; x < width; ++x) {
+			uint8_t* pixel = &image.pixels[(static_cast<size_t>(y) * width + x) * 4];
+			const float u = static_cast<float>(x) / static_cast<float>(width);
+			const float v = static_cast<float>(y) / static_cast<float>(height);
+			const bool edge = (x / 16 + y / 16) % 2 == 0;
+			pixel[0] = static_cast<uint8_t>(std::clamp(static_cast<int>(200.0f * u + 30.0f) + noise(random), 0, 255));
+			pixel[1] = static_cast<uint8_t>(std::clamp(static_cast<int>(120.0f + 100.0f * std::sin(6.0f * v)) + noise(random), 0, 255));
+			pixel[2] = static_cast<uint8_t>(edge ? 40 : 180);
+			pixel[3] = withAlpha ? static_cast<uint8_t>(255.0f * u * v) : 255;
+		}
+	}
+	return image;
+}
+
+// channels 成分（RGB なら 3、RGBA なら 4）の PSNR（dB）
+double ComputePsnr(const TextureCodec::Image& a, const TextureCodec::Image& b, int channels) {
+	double squaredError = 0.0;
+	size_t count = 0;
+	for (size_t i = 0; i < a.pixels.size(); i += 4) {
+		for (int c = 0; c < channels; ++c) {
+			const double d = static_cast<double>(a.pixels[i + c]) - b.pixels[i + c];
+			squaredError += d * d;
+			++count;
+		}
+	}
+	const double mse = squaredError / static_cast<double>(count);
+	return mse > 0.0 ? 10.0 * std::log10(255.0 * 255.0 / mse) : 99.0;
+}
+
+}
+
+int main() {
+	// ================================
+	// 1.拡大縮小とミップ
+	// ================================
+	{
+		TextureCodec::Image flat;
+		flat.width = 414;
+		flat.height = 410;
+		flat.pixels.assign(static_cast<size_t>(flat.width) * flat.height * 4, 0);
+		for (size_t i = 0; i < flat.pixels.size(); i += 4) {
+			flat.pixels[i] = 90;
+			flat.pixels[i + 1] = 160;
+			flat.pixels[i + 2] = 220;
+			flat.pixels[i + 3] = 255;
+		}
+		const TextureCodec::Image resized = TextureCodec::Resize(flat, TextureCodec::RoundToBlockSize(flat.width), TextureCodec::RoundToBlockSize(flat.height));
+		Expect(resized.width == 416 && resized.height == 412 && resized.pixels.size() == 416u * 412u * 4u, "resize: 414x410 -> 416x412");
+		bool flatKept = true;
+		for (size_t i = 0; i < resized.pixels.size(); ++i) {
+			flatKept = flatKept && std::abs(resized.pixels[i] - flat.pixels[i % 4]) <= 1;
+		}
+		Expect(flatKept, "resize: every pixel keeps the flat color");
+
+		std::vector<TextureCodec::Image> mips;
+		TextureCodec::GenerateMips(TextureCodec::Image(resized), mips);
+		Expect(mips.size() == 9 && mips.back().width == 1 && mips.back().height == 1 && mips[1].width == 208 && mips[1].height == 206,
+			"mips: 416x412 has 9 levels down to 1x1");
+
+		// 黒と白の平均は線形で 0.5（sRGB で 188）。sRGB のまま平均すると 128 になって暗くなる
+		TextureCodec::Image checker;
+		checker.width = 2;
+		checker.height = 2;
+		checker.pixels = { 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 255 };
+		const TextureCodec::Image average = TextureCodec::Resize(checker, 1, 1);
+		Expect(average.pixels[0] == 188 && average.pixels[3] == 255, "mips: 2x2 black/white averages to sRGB 188");
+	}
+
+	// ================================
+	// 2.ブロック圧縮の画質
+	// ================================
+	struct Case {
+		TextureCodec::Format format;
+		bool withAlpha;
+		int channels;
+		double minimumPsnr;
+		const char* name;
+	};
+	const Case cases[] = {
+		{ TextureCodec::Format::BC1, false, 3, 36.0, "BC1 opaque" },
+		{ TextureCodec::Format::BC3, true, 4, 36.0, "BC3 alpha" },
+		{ TextureCodec::Format::BC7, false, 3, 38.0, "BC7 opaque" },
+		{ TextureCodec::Format::BC7, true, 4, 38.0, "BC7 alpha" },
+	};
+	for (const Case& testCase : cases) {
+		std::vector<TextureCodec::Image> mips;
+		TextureCodec::GenerateMips(MakeTestImage(128, 96, testCase.withAlpha), mips);
+		TextureCodec::Texture texture;
+		const bool compressed = TextureCodec::Compress(mips, testCase.format, texture);
+		bool sizesMatch = compressed && texture.mips.size() == mips.size();
+		for (uint32_t mip = 0; sizesMatch && mip < texture.mips.size(); ++mip) {
+			const size_t blocks = static_cast<size_t>((mips[mip].width + 3) / 4) * ((mips[mip].height + 3) / 4);
+			sizesMatch = texture.mips[mip].size() == blocks * TextureCodec::GetBlockBytes(testCase.format);
+		}
+		// 画質はミップ 0 だけを見る。縮小した段では 1 ブロックに R / G / B の独立した模様が入り、
+		// 1 区間の形式（BC1 / BC7 モード 6）では原理的に表せないので、圧縮器の良し悪しの目安にならない
+		const double psnr = sizesMatch ? ComputePsnr(mips[0], TextureCodec::Decompress(texture, 0), testCase.channels) : 0.0;
+		char what[96];
+		std::snprintf(what, sizeof(what), "%s: PSNR %.1f dB >= %.0f", testCase.name, psnr, testCase.minimumPsnr);
+		Expect(sizesMatch && psnr >= testCase.minimumPsnr, what);
+	}
+
+	// 4 の倍数でない先頭は圧縮しない
+	{
+		std::vector<TextureCodec::Image> mips;
+		TextureCodec::GenerateMips(MakeTestImage(30, 20, false), mips);
+		TextureCodec::Texture texture;
+		Expect(!TextureCodec::Compress(mips, TextureCodec::Format::BC1, texture), "compress: rejects a 30x20 top mip");
+	}
+
+	// BC1 の 1 ビットアルファ（半分未満は透明、それ以外は不透明）
+	{
+		std::vector<TextureCodec::Image> mips(1, MakeTestImage(64, 64, true));
+		TextureCodec::Texture texture;
+		TextureCodec::Compress(mips, TextureCodec::Format::BC1, texture);
+		const TextureCodec::Image decoded = TextureCodec::Decompress(texture, 0);
+		bool alphaMatches = true;
+		for (size_t i = 3; i < decoded.pixels.size(); i += 4) {
+			alphaMatches = alphaMatches && decoded.pixels[i] == (mips[0].pixels[i] < 128 ? 0 : 255);
+		}
+		Expect(alphaMatches, "BC1: punch-through alpha follows the 128 threshold");
+	}
+
+	// ================================
+	// 3.DDS のヘッダー
+	// ================================
+	{
+		std::vector<TextureCodec::Image> mips;
+		TextureCodec::GenerateMips(MakeTestImage(64, 32, false), mips);
+		TextureCodec::Texture texture;
+		TextureCodec::Compress(mips, TextureCodec::Format::BC7, texture);
+		const std::string path = (std::filesystem::temp_directory_path() / "tomo_texture_codec_test.dds").string();
+		const bool written = TextureCodec::WriteDds(path, texture);
+
+		MappedFile file;
+		const bool opened = written && file.Open(path);
+		uint32_t header[36] = {};
+		size_t expectedSize = 4 + 124 + 20;
+		for (const std::vector<uint8_t>& mip : texture.mips) {
+			expectedSize += mip.size();
+		}
+		if (opened && file.GetSize() >= sizeof(header)) {
+			std::memcpy(header, file.GetData(), sizeof(header));
+		}
+		// [0] "DDS " / [1..31] DDS_HEADER / [32..36] DDS_HEADER_DXT10
+		Expect(opened && file.GetSize() == expectedSize && std::memcmp(file.GetData(), "DDS ", 4) == 0, "dds: magic and size");
+		Expect(header[1] == 124 && header[3] == 32 && header[4] == 64 && header[7] == 7 && header[21] == 0x30315844,
+			"dds: 64x32, 7 mips, DX10 extension");
+		Expect(header[32] == 99 && header[33] == 3 && header[35] == 1, "dds: BC7_UNORM_SRGB 2D texture");
+		file.Close();
+		std::error_code error;
+		std::filesystem::remove(path, error);
+	}
+
+	std::puts(gFailureCount == 0 ? "PASSED" : "FAILED");
+	return gFailureCount == 0 ? 0 : 1;
+}
+#endif
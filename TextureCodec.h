@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ==================================
+// DirectXTex を使わない画像の変換（デコード・拡大縮小・ミップ・BC 圧縮・DDS 書き出し）
+// ==================================
+// TextureCooker が DirectXTex を使えない環境（Linux / CI での事前変換）で使う。D3D12 にも DirectXTex にも依存しない。
+//   Decode       : PNG（libpng）/ JPEG（libjpeg）を拡張子ではなく中身で判別して RGBA8 にする
+//                  （CMake が TOMO_TEXTURE_CODEC_PNG / TOMO_TEXTURE_CODEC_JPEG を定義したときだけ。無ければ false）
+//   Resize       : sRGB を線形に戻してから縮小は面積平均、拡大は双線形で補間する
+//   GenerateMips : 最後の 1x1 までの全段（DirectX::GenerateMipMaps の levels = 0 と同じ段数）
+//   Compress     : BC1 / BC3 / BC7。先頭のミップの幅・高さは 4 の倍数であること（D3D12 の制約。RoundToBlockSize で揃える）
+//   WriteDds     : DX10 拡張ヘッダー付きの DDS（DirectX::LoadFromDDSFile でそのまま読める）
+// 色は sRGB として扱い、DDS には *_SRGB の形式で書く（TextureCooker が WIC_FLAGS_FORCE_SRGB で読むのと同じ）。
+//
+// BC7 はモード 6（1 区間、RGBA 各 7 ビット + p ビット、4 ビットの番号）だけを使う。DirectXTex の BC7 より画質は落ちるが速い。
+class TextureCodec {
+public:
+	// RGBA8（sRGB）の画像
+	struct Image {
+		uint32_t width = 0;
+		uint32_t height = 0;
+		std::vector<uint8_t> pixels; // width * height * 4
+
+		bool IsAlphaAllOpaque() const;
+	};
+
+	enum class Format : uint32_t {
+		RGBA8,
+		BC1,
+		BC3,
+		BC7,
+	};
+
+	// ミップ込みの変換結果
+	struct Texture {
+		Format format = Format::RGBA8;
+		uint32_t width = 0;                      // ミップ 0 の大きさ
+		uint32_t height = 0;
+		std::vector<std::vector<uint8_t>> mips;  // 細かい順
+	};
+
+	// 圧縮器の出力が変わったら上げる（TextureCooker のキャッシュキーに入る）
+	static constexpr uint32_t kEncoderVersion = 1;
+
+	// ブロック圧縮できる大きさ（最も近い 4 の倍数。ちょうど中間なら大きい方、最小 4）
+	static constexpr uint32_t RoundToBlockSize(uint32_t size) {
+		return size <= 2 ? 4 : (size + 2) / 4 * 4;
+	}
+
+	// ファイルを読んで RGBA8 にする。対応していない形式（WebP など）は false
+	static bool Decode(const std::string& filePath, Image& image);
+
+	// width x height に拡大縮小する
+	static Image Resize(const Image& source, uint32_t width, uint32_t height);
+
+	// top を先頭にして 1x1 までの全段を作る
+	static void GenerateMips(Image&& top, std::vector<Image>& mips);
+
+	// mips を format にする（RGBA8 ならそのまま移す）。先頭が 4 の倍数でなければ false
+	static bool Compress(const std::vector<Image>& mips, Format format, Texture& texture);
+
+	// ミップ 1 段を RGBA8 に戻す（テスト・確認用。BC7 はモード 6 のブロックだけ読める）
+	static Image Decompress(const Texture& texture, uint32_t mip);
+
+	// 1 ブロック（4x4）のバイト数。RGBA8 は 0
+	static size_t GetBlockBytes(Format format);
+
+	// DDS として書き出す（失敗したら false）
+	static bool WriteDds(const std::string& path, const Texture& texture);
+};
@@ -0,0 +1,506 @@
+#include "TextureCooker.h"
+#include "Fnv1a.h"
+#include "Logger.h"
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+
+#if defined(TOMO_TEXTURE_COOKER_TOOL_MAIN) && defined(_WIN32)
+#include <objbase.h>
+#endif
+
+std::string TextureCooker::cacheDirectory_ = "resources/.texcache";
+
+namespace {
+
+// 圧縮器の出力は圧縮器（DirectXTex の版 / TextureCodec の版）で変わりうる
+#if defined(TOMO_TEXTURE_COOKER_DIRECTXTEX)
+constexpr uint64_t kEncoderId = DIRECTX_TEX_VERSION;
+#else
+constexpr uint64_t kEncoderId = (uint64_t{ 1 } << 32) | TextureCodec::kEncoderVersion;
+#endif
+
+std::string ToLower(std::string text) {
+	std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+	return text;
+}
+
+// 変換結果のログ（"-> BC1 416x412 mips 9 (215.3 KB, 12.5 ms)"）
+void LogCooked(const std::string& filePath, const char* formatName, size_t width, size_t height, size_t mipLevels, size_t bytes, double ms) {
+	char text[128];
+	std::snprintf(text, sizeof(text), " -> %s %zux%zu mips %zu (%.1f KB, %.1f ms)\n",
+		formatName, width, height, mipLevels, static_cast<double>(bytes) / 1024.0, ms);
+	Log("TextureCooker: " + filePath + text);
+}
+
+#if defined(TOMO_TEXTURE_COOKER_DIRECTXTEX)
+// DirectXTex のファイル関数は wchar_t のパスを受け取る。std::string は UTF-8 として扱う
+std::wstring ToWidePath(const std::string& path) {
+	return std::filesystem::path(std::u8string(path.begin(), path.end())).wstring();
+}
+
+const char* FormatName(DXGI_FORMAT format) {
+	switch (format) {
+	case DXGI_FORMAT_BC1_UNORM:
+	case DXGI_FORMAT_BC1_UNORM_SRGB:
+		return "BC1";
+	case DXGI_FORMAT_BC3_UNORM:
+	case DXGI_FORMAT_BC3_UNORM_SRGB:
+		return "BC3";
+	case DXGI_FORMAT_BC7_UNORM:
+	case DXGI_FORMAT_BC7_UNORM_SRGB:
+		return "BC7";
+	default:
+		return "uncompressed";
+	}
+}
+#else
+const char* FormatName(TextureCodec::Format format) {
+	switch (format) {
+	case TextureCodec::Format::BC1:
+		return "BC1";
+	case TextureCodec::Format::BC3:
+		return "BC3";
+	case TextureCodec::Format::BC7:
+		return "BC7";
+	default:
+		return "uncompressed";
+	}
+}
+#endif
+
+}
+
+// ===================================
+// キャッシュ置き場
+// ===================================
+void TextureCooker::SetCacheDirectory(const std::string& cacheDirectory) {
+	cacheDirectory_ = cacheDirectory;
+}
+
+const std::string& TextureCooker::GetCacheDirectory() {
+	return cacheDirectory_;
+}
+
+std::string TextureCooker::GetCachePath(uint64_t sourceHash) {
+	char name[32];
+	std::snprintf(name, sizeof(name), "%016llx.dds", static_cast<unsigned long long>(sourceHash));
+	return cacheDirectory_ + "/" + name;
+}
+
+bool TextureCooker::IsSourceExtension(const std::string& extension) {
+	const std::string lower = ToLower(extension);
+	return lower == ".png" || lower == ".jpg" || lower == ".jpeg" || lower == ".bmp" ||
+		lower == ".tga" || lower == ".hdr" || lower == ".dds";
+}
+
+// ===================================
+// キャッシュキー
+// ===================================
+uint64_t TextureCooker::ComputeSourceHash(const std::string& filePath, Format format) {
+	MappedFile file;
+	if (!file.Open(filePath)) {
+		return 0;
+	}
+
+	uint64_t hash = Fnv1a::kOffsetBasis;
+	hash = Fnv1a::HashValue(hash, (static_cast<uint64_t>(kCookerVersion) << 32) | static_cast<uint32_t>(format));
+	hash = Fnv1a::HashValue(hash, kEncoderId);
+	// 拡張子でデコード方法が変わるので混ぜる（内容が同じなら置き場所は問わない）
+	hash = Fnv1a::HashString(hash, ToLower(std::filesystem::path(filePath).extension().string()));
+	hash = Fnv1a::HashString(hash, file.GetView());
+
+	// 0 は「読めなかった」に使うので避ける
+	return hash != 0 ? hash : 1;
+}
+
+// ===================================
+// 変換（DirectXTex）
+// ===================================
+#if defined(TOMO_TEXTURE_COOKER_DIRECTXTEX)
+bool TextureCooker::Decode(const std::string& filePath, DirectX::ScratchImage& image) {
+	const std::string extension = ToLower(std::filesystem::path(filePath).extension().string());
+	const std::wstring path = ToWidePath(filePath);
+
+	HRESULT hr = E_FAIL;
+	if (extension == ".dds") {
+		hr = DirectX::LoadFromDDSFile(path.c_str(), DirectX::DDS_FLAGS_NONE, nullptr, image);
+	} else if (extension == ".tga") {
+		hr = DirectX::LoadFromTGAFile(path.c_str(), DirectX::TGA_FLAGS_FORCE_SRGB, nullptr, image);
+	} else if (extension == ".hdr") {
+		hr = DirectX::LoadFromHDRFile(path.c_str(), nullptr, image);
+	} else {
+		// LoadTexture と同じく sRGB として読む
+		hr = DirectX::LoadFromWICFile(path.c_str(), DirectX::WIC_FLAGS_FORCE_SRGB, nullptr, image);
+	}
+	return SUCCEEDED(hr);
+}
+
+DXGI_FORMAT TextureCooker::ResolveFormat(const DirectX::ScratchImage& image, Format format) {
+	const DirectX::TexMetadata& metadata = image.GetMetadata();
+	if (format == Format::Uncompressed ||
+		DirectX::IsCompressed(metadata.format) ||
+		metadata.dimension != DirectX::TEX_DIMENSION_TEXTURE2D) {
+		return DXGI_FORMAT_UNKNOWN;
+	}
+	// D3D12 では BC テクスチャの先頭のミップは 4 の倍数でなければならない
+	if (metadata.width % 4 != 0 || metadata.height % 4 != 0) {
+		return DXGI_FORMAT_UNKNOWN;
+	}
+	// 浮動小数（HDR）は BC6H の対象なので、ここでは圧縮しない
+	if (DirectX::FormatDataType(metadata.format) == DirectX::FORMAT_TYPE_FLOAT) {
+		return DXGI_FORMAT_UNKNOWN;
+	}
+
+	if (format == Format::Auto) {
+		format = image.IsAlphaAllOpaque() ? Format::BC1 : Format::BC7;
+	}
+	DXGI_FORMAT target = DXGI_FORMAT_BC7_UNORM;
+	switch (format) {
+	case Format::BC1:
+		target = DXGI_FORMAT_BC1_UNORM;
+		break;
+	case Format::BC3:
+		target = DXGI_FORMAT_BC3_UNORM;
+		break;
+	default:
+		break;
+	}
+	// 元が sRGB なら圧縮後も sRGB として読む
+	return DirectX::IsSRGB(metadata.format) ? DirectX::MakeSRGB(target) : target;
+}
+
+bool TextureCooker::Cook(const std::string& filePath, Format format, DirectX::ScratchImage& cooked) {
+	const auto start = std::chrono::steady_clock::now();
+
+	// ================================
+	// 1.デコード
+	// ================================
+	DirectX::ScratchImage source;
+	if (!Decode(filePath, source)) {
+		return false;
+	}
+
+	// ================================
+	// 2.全段のミップ（元画像が既にミップを持っていればそのまま）
+	// ================================
+	DirectX::ScratchImage mipImages;
+	const DirectX::TexMetadata& sourceMetadata = source.GetMetadata();
+	if (sourceMetadata.mipLevels <= 1 &&
+		sourceMetadata.dimension == DirectX::TEX_DIMENSION_TEXTURE2D &&
+		!DirectX::IsCompressed(sourceMetadata.format) &&
+		(sourceMetadata.width > 1 || sourceMetadata.height > 1)) {
+		// ブロック圧縮するなら先に 4 の倍数にしておく（そのままだと ResolveFormat が圧縮しない）
+		const size_t blockWidth = TextureCodec::RoundToBlockSize(static_cast<uint32_t>(sourceMetadata.width));
+		const size_t blockHeight = TextureCodec::RoundToBlockSize(static_cast<uint32_t>(sourceMetadata.height));
+		if (format != Format::Uncompressed &&
+			DirectX::FormatDataType(sourceMetadata.format) != DirectX::FORMAT_TYPE_FLOAT &&
+			(blockWidth != sourceMetadata.width || blockHeight != sourceMetadata.height)) {
+			DirectX::ScratchImage resized;
+			HRESULT hr = DirectX::Resize(
+				source.GetImages(), source.GetImageCount(), sourceMetadata, blockWidth, blockHeight,
+				DirectX::TEX_FILTER_TRIANGLE | DirectX::TEX_FILTER_SRGB | DirectX::TEX_FILTER_FORCE_NON_WIC, resized);
+			if (FAILED(hr)) {
+				return false;
+			}
+			source = std::move(resized);
+		}
+
+		HRESULT hr = DirectX::GenerateMipMaps(
+			source.GetImages(), source.GetImageCount(), sourceMetadata,
+			DirectX::TEX_FILTER_SRGB, 0, mipImages);
+		if (FAILED(hr)) {
+			return false;
+		}
+	} else {
+		mipImages = std::move(source);
+	}
+
+	// ================================
+	// 3.ブロック圧縮
+	// ================================
+	if (!Compress(std::move(mipImages), format, cooked)) {
+		return false;
+	}
+
+	const DirectX::TexMetadata& metadata = cooked.GetMetadata();
+	const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	LogCooked(filePath, FormatName(metadata.format), metadata.width, metadata.height, metadata.mipLevels, cooked.GetPixelsSize(), ms);
+	return true;
+}
+
+bool TextureCooker::Compress(DirectX::ScratchImage&& mipImages, Format format, DirectX::ScratchImage& cooked) {
+	const DXGI_FORMAT target = ResolveFormat(mipImages, format);
+	if (target == DXGI_FORMAT_UNKNOWN) {
+		cooked = std::move(mipImages);
+		return true;
+	}
+	HRESULT hr = DirectX::Compress(
+		mipImages.GetImages(), mipImages.GetImageCount(), mipImages.GetMetadata(),
+		target, DirectX::TEX_COMPRESS_PARALLEL, DirectX::TEX_THRESHOLD_DEFAULT, cooked);
+	return SUCCEEDED(hr);
+}
+
+bool TextureCooker::TryRead(const std::string& cachePath, DirectX::ScratchImage& image) {
+	std::error_code error;
+	if (!std::filesystem::exists(cachePath, error)) {
+		return false;
+	}
+	return SUCCEEDED(DirectX::LoadFromDDSFile(ToWidePath(cachePath).c_str(), DirectX::DDS_FLAGS_NONE, nullptr, image));
+}
+
+#else
+// ===================================
+// 変換（TextureCodec）
+// ===================================
+TextureCodec::Format TextureCooker::ResolveFormat(const TextureCodec::Image& image, Format format) {
+	switch (format) {
+	case Format::Uncompressed:
+		return TextureCodec::Format::RGBA8;
+	case Format::BC1:
+		return TextureCodec::Format::BC1;
+	case Format::BC3:
+		return TextureCodec::Format::BC3;
+	case Format::BC7:
+		return TextureCodec::Format::BC7;
+	default:
+		return image.IsAlphaAllOpaque() ? TextureCodec::Format::BC1 : TextureCodec::Format::BC7;
+	}
+}
+
+bool TextureCooker::Cook(const std::string& filePath, Format format, CookedImage& cooked) {
+	const auto start = std::chrono::steady_clock::now();
+
+	// 1.デコード
+	TextureCodec::Image source;
+	if (!TextureCodec::Decode(filePath, source)) {
+		return false;
+	}
+
+	// 2.ブロック圧縮するなら 4 の倍数にしてから全段のミップを作る
+	const TextureCodec::Format target = ResolveFormat(source, format);
+	if (target != TextureCodec::Format::RGBA8) {
+		const uint32_t blockWidth = TextureCodec::RoundToBlockSize(source.width);
+		const uint32_t blockHeight = TextureCodec::RoundToBlockSize(source.height);
+		if (blockWidth != source.width || blockHeight != source.height) {
+			source = TextureCodec::Resize(source, blockWidth, blockHeight);
+		}
+	}
+	std::vector<TextureCodec::Image> mipImages;
+	TextureCodec::GenerateMips(std::move(source), mipImages);
+
+	// 3.ブロック圧縮
+	if (!TextureCodec::Compress(mipImages, target, cooked)) {
+		return false;
+	}
+
+	size_t bytes = 0;
+	for (const std::vector<uint8_t>& mip : cooked.mips) {
+		bytes += mip.size();
+	}
+	const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	LogCooked(filePath, FormatName(cooked.format), cooked.width, cooked.height, cooked.mips.size(), bytes, ms);
+	return true;
+}
+#endif
+
+// ===================================
+// 書き出し
+// ===================================
+bool TextureCooker::Write(const std::string& cachePath, const CookedImage& image) {
+	std::error_code error;
+	const std::filesystem::path path(cachePath);
+	std::filesystem::create_directories(path.parent_path(), error);
+
+	// 途中で落ちても壊れたキャッシュを読まないよう、一時ファイルに書いてから置き換える
+	const std::string temporaryPath = cachePath + ".tmp";
+#if defined(TOMO_TEXTURE_COOKER_DIRECTXTEX)
+	const bool saved = SUCCEEDED(DirectX::SaveToDDSFile(
+		image.GetImages(), image.GetImageCount(), image.GetMetadata(),
+		DirectX::DDS_FLAGS_NONE, ToWidePath(temporaryPath).c_str()));
+#else
+	const bool saved = TextureCodec::WriteDds(temporaryPath, image);
+#endif
+	if (!saved) {
+		std::filesystem::remove(temporaryPath, error);
+		return false;
+	}
+	std::filesystem::rename(temporaryPath, path, error);
+	if (error) {
+		std::filesystem::remove(temporaryPath, error);
+		return false;
+	}
+	return true;
+}
+
+// ===================================
+// 読み込み
+// ===================================
+#if defined(TOMO_TEXTURE_COOKER_DIRECTXTEX)
+DirectX::ScratchImage TextureCooker::Load(const std::string& filePath, Format format) {
+	DirectX::ScratchImage image;
+	const uint64_t sourceHash = ComputeSourceHash(filePath, format);
+	assert(sourceHash != 0 && "テクスチャが見つからない");
+
+	const std::string cachePath = GetCachePath(sourceHash);
+	if (TryRead(cachePath, image)) {
+		return image;
+	}
+
+	const bool cooked = Cook(filePath, format, image);
+	assert(cooked && "テクスチャを読み込めない");
+	if (cooked) {
+		// 書けなくても（読み取り専用の場所など）次回また変換するだけなので無視する
+		Write(cachePath, image);
+	}
+	return image;
+}
+#endif
+
+// ===================================
+// 事前変換
+// ===================================
+size_t TextureCooker::Prebuild(const std::string& rootDirectory, Format format) {
+	size_t builtCount = 0;
+	std::error_code error;
+	for (std::filesystem::recursive_directory_iterator it(rootDirectory, error), last; !error && it != last; it.increment(error)) {
+		const std::filesystem::path& path = it->path();
+		// キャッシュ置き場（.texcache / .meshcache）などの隠しディレクトリには入らない
+		if (it->is_directory(error)) {
+			if (path.filename().string().starts_with(".")) {
+				it.disable_recursion_pending();
+			}
+			continue;
+		}
+		if (!it->is_regular_file(error) || !IsSourceExtension(path.extension().string())) {
+			continue;
+		}
+
+		const std::string filePath = path.generic_string();
+		const uint64_t sourceHash = ComputeSourceHash(filePath, format);
+		if (sourceHash == 0) {
+			continue;
+		}
+		// 名前がキーなので、あれば作り直さない（壊れていれば Load 時に書き直される）
+		const std::string cachePath = GetCachePath(sourceHash);
+		if (std::filesystem::exists(cachePath, error)) {
+			continue;
+		}
+		CookedImage image;
+		if (Cook(filePath, format, image) && Write(cachePath, image)) {
+			++builtCount;
+		}
+	}
+	return builtCount;
+}
+
+#if defined(TOMO_TEXTURE_COOKER_TOOL_MAIN)
+// 使い方: texcook [リソースのルート] [キャッシュ置き場] [auto|bc1|bc3|bc7|none]
+int main(int argc, char** argv) {
+#ifdef _WIN32
+	// WIC を使うので COM を初期化する
+	CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+#endif
+	const std::string root = argc > 1 ? argv[1] : "resources";
+	if (argc > 2) {
+		TextureCooker::SetCacheDirectory(argv[2]);
+	}
+	TextureCooker::Format format = TextureCooker::Format::Auto;
+	if (argc > 3) {
+		const std::string name = argv[3];
+		format = name == "bc1" ? TextureCooker::Format::BC1
+			: name == "bc3" ? TextureCooker::Format::BC3
+			: name == "bc7" ? TextureCooker::Format::BC7
+			: name == "none" ? TextureCooker::Format::Uncompressed
+			: TextureCooker::Format::Auto;
+	}
+	const size_t builtCount = TextureCooker::Prebuild(root, format);
+	std::printf("%zu texture cache file(s) written to %s\n", builtCount, TextureCooker::GetCacheDirectory().c_str());
+	return 0;
+}
+#endif
+
+// ===================================
+// テスト（ctest の texture_cooker_test）
+// ===================================
+// 大きさが 4 の倍数でない resources の画像（cube.jpg 414x410 / fence.png 990x360 / sky_night.png 692x469）が
+// 4 の倍数に揃えてから BC 圧縮されること、事前変換の 2 回目は何も書き出さないことを確かめる。
+#if defined(TOMO_TEXTURE_COOKER_TEST_MAIN) && !defined(TOMO_TEXTURE_COOKER_DIRECTXTEX)
+#include <cmath>
+
+namespace {
+
+int gFailureCount = 0;
+
+void Expect(bool condition, const char* what) {
+	std::printf("%-60s %s\n", what, condition ? "ok" : "NG");
+	gFailureCount += condition ? 0 : 1;
+}
+
+}
+
+int main() {
+	struct Case {
+		const char* filePath;
+		uint32_t width;
+		uint32_t height;
+		TextureCodec::Format format;
+	};
+	const Case cases[] = {
+		{ "resources/cube/cube.jpg", 416, 412, TextureCodec::Format::BC1 },
+		{ "resources/fence/fence.png", 992, 360, TextureCodec::Format::BC7 },
+		{ "resources/skydome/sky_night.png", 692, 468, TextureCodec::Format::BC1 },
+	};
+	for (const Case& testCase : cases) {
+		TextureCooker::CookedImage cooked;
+		const bool ok = TextureCooker::Cook(testCase.filePath, TextureCooker::Format::Auto, cooked);
+
+		// 4 の倍数に揃えた元画像と比べる（圧縮の誤差だけを見る）
+		double psnr = 0.0;
+		TextureCodec::Image source;
+		if (ok && TextureCodec::Decode(testCase.filePath, source)) {
+			const TextureCodec::Image expected = TextureCodec::Resize(source, cooked.width, cooked.height);
+			const TextureCodec::Image decoded = TextureCodec::Decompress(cooked, 0);
+			double squaredError = 0.0;
+			for (size_t i = 0; i < expected.pixels.size(); ++i) {
+				// アルファで隠れる色の誤差は見えないので、RGB はアルファで重み付けする
+				const size_t alpha = i / 4 * 4 + 3;
+				const double weight = i == alpha ? 1.0 : expected.pixels[alpha] / 255.0;
+				const double d = (static_cast<double>(expected.pixels[i]) - decoded.pixels[i]) * weight;
+				squaredError += d * d;
+			}
+			const double mse = squaredError / static_cast<double>(expected.pixels.size());
+			psnr = mse > 0.0 ? 10.0 * std::log10(255.0 * 255.0 / mse) : 99.0;
+		}
+
+		char what[128];
+		std::snprintf(what, sizeof(what), "%s: %ux%u %s", testCase.filePath, cooked.width, cooked.height, FormatName(cooked.format));
+		Expect(ok && cooked.width == testCase.width && cooked.height == testCase.height && cooked.format == testCase.format, what);
+		std::snprintf(what, sizeof(what), "%s: mips %zu, PSNR %.1f dB", testCase.filePath, cooked.mips.size(), psnr);
+		Expect(ok && cooked.mips.size() > 1 && psnr >= 30.0, what);
+	}
+
+	// 事前変換：1 回目は全部書き出し、2 回目はキャッシュがあるので 0
+	{
+		std::error_code error;
+		const std::filesystem::path cacheDirectory = std::filesystem::temp_directory_path() / "tomo_texture_cooker_test";
+		std::filesystem::remove_all(cacheDirectory, error);
+		TextureCooker::SetCacheDirectory(cacheDirectory.generic_string());
+		const size_t firstCount = TextureCooker::Prebuild("resources");
+		const size_t secondCount = TextureCooker::Prebuild("resources");
+		char what[96];
+		std::snprintf(what, sizeof(what), "prebuild: %zu written, then %zu", firstCount, secondCount);
+		Expect(firstCount >= 3 && secondCount == 0, what);
+		std::filesystem::remove_all(cacheDirectory, error);
+	}
+
+	std::puts(gFailureCount == 0 ? "PASSED" : "FAILED");
+	return gFailureCount == 0 ? 0 : 1;
+}
+#endif
@@ -0,0 +1,102 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// DirectXTex で変換するか（Windows の既定）。それ以外は TextureCodec（libpng / libjpeg と自前の BC 圧縮器）で変換する
+#if !defined(TOMO_TEXTURE_COOKER_DIRECTXTEX) && defined(_WIN32)
+#define TOMO_TEXTURE_COOKER_DIRECTXTEX
+#endif
+
+#include "TextureCodec.h"
+#if defined(TOMO_TEXTURE_COOKER_DIRECTXTEX)
+// DirectXTexのインクルード
+#include "externals/DirectXTex/DirectXTex.h"
+#endif
+
+// ==================================
+// テクスチャの事前変換（ブロック圧縮 + ミップ）と DDS キャッシュ
+// ==================================
+// 初回読み込み時に元画像をデコードし、全段のミップを作って BC1 / BC3 / BC7 に圧縮（DirectXTex の CPU 圧縮）した結果を
+// .dds として書き出す。2 回目以降はその DDS を読むだけなので、デコードもミップ生成も圧縮もしない。
+// RGBA8 に比べて VRAM は BC1 で 1/8、BC3 / BC7 で 1/4 になる。
+//
+// キャッシュのキーは「元画像の内容ハッシュ + 変換の版 + 圧縮形式の指定 + 圧縮器の版」（MeshCache と同じく名前がキー）。
+// 変換結果が変わる修正を入れたら kCookerVersion を上げること。
+//
+// ブロック圧縮する画像は、先頭のミップの幅・高さを最も近い 4 の倍数に拡大縮小してからミップを作る（D3D12 の制約。
+// UV は 0～1 のままなので見た目は変わらない）。
+//
+// DirectXTex が無い環境（Linux / CI）では TextureCodec で変換する。読めるのは PNG / JPEG だけで（WebP などは変換しない）、
+// BC7 はモード 6 だけを使う。書き出した DDS は Windows の TryRead でもそのまま読めるが、圧縮器が違うのでキャッシュキーは別になる。
+// この場合は事前変換（Prebuild / Cook / Write）だけを持ち、Load / TryRead は無い。
+//
+// 事前変換用の実行ファイルは CMake の texture_cooker（TOMO_TEXTURE_COOKER_TOOL_MAIN）。
+//   cmake --build build --target texture_cooker && ./build/texture_cooker resources
+class TextureCooker {
+public:
+	// 変換後の形式
+	enum class Format : uint32_t {
+		Auto,          // 不透明なら BC1、アルファがあれば BC7
+		BC1,           // RGB + 1bit アルファ（8:1）
+		BC3,           // RGBA（4:1。BC7 より圧縮が速い）
+		BC7,           // RGBA 高品質（4:1）
+		Uncompressed,  // 圧縮せずミップだけ付ける
+	};
+
+	// 変換結果の版（出力が変わったら上げる）
+	static constexpr uint32_t kCookerVersion = 2;
+
+	// 変換結果（ミップ込み）
+#if defined(TOMO_TEXTURE_COOKER_DIRECTXTEX)
+	using CookedImage = DirectX::ScratchImage;
+#else
+	using CookedImage = TextureCodec::Texture;
+#endif
+
+#if defined(TOMO_TEXTURE_COOKER_DIRECTXTEX)
+	// キャッシュがあればそれを、無ければ元画像を変換してキャッシュを書き出して返す（ミップ込み）
+	static DirectX::ScratchImage Load(const std::string& filePath, Format format = Format::Auto);
+#endif
+
+	// rootDirectory 以下の全画像のキャッシュを作る（"." で始まるディレクトリは除く）。新しく書き出した数を返す
+	static size_t Prebuild(const std::string& rootDirectory, Format format = Format::Auto);
+
+	// キャッシュの置き場所（既定は "resources/.texcache"）
+	static void SetCacheDirectory(const std::string& cacheDirectory);
+	static const std::string& GetCacheDirectory();
+
+	// 元画像の内容と変換設定からキャッシュキーを求める（読めなければ 0）
+	static uint64_t ComputeSourceHash(const std::string& filePath, Format format);
+
+	// 元画像を読んでミップを作り、圧縮する（Load の中身。失敗したら false）
+	static bool Cook(const std::string& filePath, Format format, CookedImage& cooked);
+
+	// 書き出し（失敗したら false）
+	static bool Write(const std::string& cachePath, const CookedImage& image);
+
+	static std::string GetCachePath(uint64_t sourceHash);
+
+	// 変換する拡張子か（".png" など。大文字小文字は区別しない）
+	static bool IsSourceExtension(const std::string& extension);
+
+#if defined(TOMO_TEXTURE_COOKER_DIRECTXTEX)
+	// キャッシュの読み込み（失敗したら false）
+	static bool TryRead(const std::string& cachePath, DirectX::ScratchImage& image);
+
+	// 元画像のデコード（拡張子で読み方を選ぶ。TextureAtlas も使う）
+	static bool Decode(const std::string& filePath, DirectX::ScratchImage& image);
+
+	// ミップを作り終えた画像を format で圧縮する（圧縮できない・しない画像はそのまま移す）
+	static bool Compress(DirectX::ScratchImage&& mipImages, Format format, DirectX::ScratchImage& cooked);
+#endif
+
+private:
+#if defined(TOMO_TEXTURE_COOKER_DIRECTXTEX)
+	// 指定と画像の中身から圧縮形式を決める（圧縮しないなら DXGI_FORMAT_UNKNOWN）
+	static DXGI_FORMAT ResolveFormat(const DirectX::ScratchImage& image, Format format);
+#else
+	static TextureCodec::Format ResolveFormat(const TextureCodec::Image& image, Format format);
+#endif
+
+	static std::string cacheDirectory_;
+};
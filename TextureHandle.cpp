@@ -0,0 +1,203 @@
+#include "TextureHandle.h"
+
+// TextureTable はテンプレートなので本体はヘッダーにある。ここにはテストだけを置く
+// （ゲーム本体のプロジェクトには入れず、CMake の texture_handle_test だけがビルドする）
+
+// ===================================
+// テスト（ctest の texture_handle_test）
+// ===================================
+// 定常状態のフレームの描画（テクスチャのバインドまで）が operator new を 1 回も呼ばないことを、
+// グローバルの operator new を置き換えて数えて確かめる。1 フレームは Model::Draw と同じ順に次を行う。
+//   RequestMip  : ComputeDesiredMip → TextureResidency::Request（TextureManager::RequestMip の中身）
+//   CullMeshlets: visibleRanges を clear して、見えている範囲を同じマテリアルで連続するものにまとめて詰める
+//   DrawRanges  : マテリアルが変わるときだけ BindMaterial（TextureTable::Find = TextureManager::GetGpuHandle）
+//   Update      : TextureResidency::Update（TextureManager::UpdateStreaming の中身。changes は使い回す）
+// D3D12 の呼び出し（SetGraphicsRoot* / DrawIndexedInstanced）は数えるだけにしている。
+#if defined(TOMO_TEXTURE_HANDLE_TEST_MAIN)
+#include "TextureResidency.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+std::atomic<uint64_t> gAllocationCount{ 0 };
+
+// D3D12 の Texture の代わり（GPU ハンドルの ptr と、ストリーミングの番号だけ）
+struct FakeTexture {
+	uint64_t gpuHandle = 0;
+	uint32_t residencyId = 0;
+	std::string name;
+};
+
+// Model::DrawRange と同じ形
+struct DrawRange {
+	uint32_t indexOffset = 0;
+	uint32_t indexCount = 0;
+	uint32_t materialIndex = 0;
+};
+
+// Model のうち描画に使う部分だけ
+struct FakeModel {
+	std::vector<TextureHandle> textureHandles;  // マテリアルごと
+	std::vector<DrawRange> meshletRanges;
+	std::vector<DrawRange> visibleRanges;       // Initialize で meshletRanges の数だけ reserve しておく
+};
+
+constexpr uint32_t kTextureSize = 1024;
+constexpr uint32_t kMipCount = 11;
+
+// 1 フレーム分の描画。バインドした回数を返す
+uint32_t DrawFrame(std::vector<FakeModel>& models, const TextureTable<FakeTexture>& table, TextureResidency& residency,
+	std::vector<TextureResidency::Change>& changes, uint32_t frame) {
+	uint32_t bindCount = 0;
+	for (size_t m = 0; m < models.size(); ++m) {
+		FakeModel& model = models[m];
+
+		// RequestMip（カメラが動くので画面上の大きさは毎フレーム変わる。60 フレームで一巡）
+		const float screenSize = 16.0f + 32.0f * static_cast<float>((frame + m * 7) % 60);
+		for (TextureHandle handle : model.textureHandles) {
+			if (const FakeTexture* texture = table.Find(handle)) {
+				residency.Request(texture->residencyId,
+					TextureResidency::ComputeDesiredMip(kTextureSize, kTextureSize, kMipCount, screenSize), screenSize);
+			}
+		}
+
+		// CullMeshlets（見える meshlet もフレームごとに変わる）
+		model.visibleRanges.clear();
+		for (size_t i = 0; i < model.meshletRanges.size(); ++i) {
+			if ((i + frame) % 5 == 0) {
+				continue;
+			}
+			const DrawRange& range = model.meshletRanges[i];
+			if (!model.visibleRanges.empty() &&
+				model.visibleRanges.back().materialIndex == range.materialIndex &&
+				model.visibleRanges.back().indexOffset + model.visibleRanges.back().indexCount == range.indexOffset) {
+				model.visibleRanges.back().indexCount += range.indexCount;
+			} else {
+				model.visibleRanges.push_back(range);
+			}
+		}
+
+		// DrawRanges → BindMaterial
+		uint64_t boundTexture = 0;
+		uint32_t boundMaterial = static_cast<uint32_t>(model.textureHandles.size());
+		for (const DrawRange& range : model.visibleRanges) {
+			if (range.materialIndex != boundMaterial) {
+				const FakeTexture* texture = table.Find(model.textureHandles[range.materialIndex]);
+				const uint64_t gpuHandle = texture ? texture->gpuHandle : 0;
+				if (gpuHandle != boundTexture) {
+					boundTexture = gpuHandle;
+					++bindCount;
+				}
+				boundMaterial = range.materialIndex;
+			}
+		}
+	}
+
+	// UpdateStreaming
+	changes.clear();
+	residency.Update(changes);
+	return bindCount;
+}
+
+}
+
+void* operator new(std::size_t size) {
+	gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+	if (void* pointer = std::malloc(size > 0 ? size : 1)) {
+		return pointer;
+	}
+	throw std::bad_alloc();
+}
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+
+int main() {
+	// ================================
+	// 読み込み時（確保してよい）
+	// ================================
+	// パス → ハンドルの表と本体を作り、ストリーミングに登録する
+	TextureTable<FakeTexture> table;
+	std::unordered_map<std::string, TextureHandle> handles;
+	TextureResidency residency;
+	std::vector<uint64_t> mipSizes;
+	for (uint32_t mip = 0; mip < kMipCount; ++mip) {
+		const uint64_t size = std::max(1u, kTextureSize >> mip);
+		mipSizes.push_back(size * size);
+	}
+	constexpr uint32_t kTextureCount = 512;
+	for (uint32_t i = 0; i < kTextureCount; ++i) {
+		std::string name = "resources/texture_" + std::to_string(i) + ".png";
+		const uint32_t residencyId = residency.Register(mipSizes, kMipCount - 4);
+		const TextureHandle handle = table.Add({ 0x1000ull + i * 32ull, residencyId, name });
+		handles.emplace(std::move(name), handle);
+	}
+	// 全部は常駐できない予算にして、毎フレーム捨てる・読み込むが起きるようにする
+	residency.SetBudget(kTextureCount * mipSizes[2]);
+
+	// 64 体のモデル（4 マテリアル・96 meshlet）。ハンドルは読み込み時にパスから引いておく
+	std::vector<FakeModel> models(64);
+	for (size_t m = 0; m < models.size(); ++m) {
+		FakeModel& model = models[m];
+		for (uint32_t material = 0; material < 4; ++material) {
+			const uint32_t texture = static_cast<uint32_t>((m * 4 + material) * 7) % kTextureCount;
+			model.textureHandles.push_back(handles.at("resources/texture_" + std::to_string(texture) + ".png"));
+		}
+		for (uint32_t i = 0; i < 96; ++i) {
+			model.meshletRanges.push_back({ i * 372, 372, i / 24 });
+		}
+		model.visibleRanges.reserve(model.meshletRanges.size());
+	}
+	std::vector<TextureResidency::Change> changes;
+
+	// ウォームアップ（使い回す配列が最大の大きさになるまで。画面上の大きさは 60 フレームで一巡する）
+	uint32_t frame = 0;
+	for (; frame < 120; ++frame) {
+		DrawFrame(models, table, residency, changes, frame);
+	}
+
+	// ================================
+	// 定常状態のフレーム（確保してはいけない）
+	// ================================
+	const uint64_t before = gAllocationCount.load();
+	uint64_t bindCount = 0;
+	uint64_t changeCount = 0;
+	constexpr uint32_t kFrameCount = 1000;
+	for (uint32_t i = 0; i < kFrameCount; ++i, ++frame) {
+		bindCount += DrawFrame(models, table, residency, changes, frame);
+		changeCount += changes.size();
+	}
+	const uint64_t allocations = gAllocationCount.load() - before;
+
+	std::printf("%u frames x %zu models: %llu binds, %llu residency changes, %llu allocations  %s\n",
+		kFrameCount, models.size(), static_cast<unsigned long long>(bindCount), static_cast<unsigned long long>(changeCount),
+		static_cast<unsigned long long>(allocations), allocations == 0 ? "ok" : "NG");
+
+	// フレームの中身が空回りしていないこと（バインドとミップの入れ替えが実際に起きている）
+	const bool exercised = bindCount >= kFrameCount * models.size() * 4 && changeCount > 0;
+	std::printf("binds and residency changes happen %s\n", exercised ? "ok" : "NG");
+
+	// 引いた中身が正しいこと（無効なハンドル・範囲外は nullptr）
+	bool correct = !table.Find(TextureHandle{}) && !table.Find(TextureHandle{ kTextureCount });
+	for (uint32_t i = 0; i < kTextureCount; ++i) {
+		const FakeTexture* texture = table.Find(TextureHandle{ i });
+		correct = correct && texture && texture->gpuHandle == 0x1000ull + i * 32ull;
+	}
+	std::printf("lookup results %s\n", correct ? "ok" : "NG");
+
+	// 読み込み時の確保が数えられていなければ operator new の置き換えが効いていない
+	const bool hooked = before > 0;
+	std::printf("allocations while loading: %llu %s\n", static_cast<unsigned long long>(before), hooked ? "ok" : "NG");
+
+	const bool passed = allocations == 0 && exercised && correct && hooked;
+	std::puts(passed ? "PASSED" : "FAILED");
+	return passed ? 0 : 1;
+}
+#endif
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <utility>
+
+// テクスチャのハンドル（読み込み順の通し番号）
+// パスは読み込み時に 1 度だけ番号に変換し、描画中は番号で引く（文字列の生成・ハッシュをしない）
+struct TextureHandle {
+	static constexpr uint32_t kInvalid = std::numeric_limits<uint32_t>::max();
+
+	uint32_t id = kInvalid;
+
+	bool IsValid() const { return id != kInvalid; }
+	bool operator==(const TextureHandle&) const = default;
+};
+
+// ==================================
+// ハンドルの番号で並ぶ表
+// ==================================
+// TextureManager の本体（D3D12 に依存しないので、ハンドルで引くときに確保しないことをテストで確かめられる）。
+// deque なので追加しても既存の要素のアドレスは変わらない。
+template <class T>
+class TextureTable {
+public:
+	// 末尾に追加して番号を振る
+	TextureHandle Add(T&& value) {
+		const TextureHandle handle{ static_cast<uint32_t>(items_.size()) };
+		items_.push_back(std::move(value));
+		return handle;
+	}
+
+	// ハンドルから引く（配列を引くだけで、確保もハッシュもしない）。無効なハンドルは nullptr
+	const T* Find(TextureHandle handle) const {
+		return handle.id < items_.size() ? &items_[handle.id] : nullptr;
+	}
+
+	T& operator[](uint32_t index) { return items_[index]; }
+	uint32_t GetCount() const { return static_cast<uint32_t>(items_.size()); }
+
+private:
+	std::deque<T> items_;
+};
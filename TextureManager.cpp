@@ -1,7 +1,48 @@
 #include "TextureManager.h"
 #include "GraphicsCore.h"
+#include "CommandListManager.h"
 #include "ResourcesUtility.h"
+#include "TextureCooker.h"
+#include "UploadHeap.h"
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <format>
+
+namespace {
+
+void CreateTextureSrv(ID3D12Device* device, ID3D12Resource* resource, const DirectX::TexMetadata& metadata, D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle) {
+    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = metadata.format;
+    srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+    srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+    srvDesc.Texture2D.MipLevels = static_cast<UINT>(metadata.mipLevels);
+
+    device->CreateShaderResourceView(resource, &srvDesc, cpuHandle);
+}
+
+// ストリーミングで最初に常駐させるミップ（tailSize ピクセル以下になる最初のミップ）
+// BC 形式はリソースの先頭のミップが 4 の倍数でなければならないので、それを満たす範囲に収める
+uint32_t ComputeTailMip(const DirectX::TexMetadata& metadata, uint32_t tailSize) {
+    const bool compressed = DirectX::IsCompressed(metadata.format);
+    uint32_t tailMip = 0;
+    for (uint32_t mip = 1; mip < metadata.mipLevels; ++mip) {
+        const size_t width = (std::max)(metadata.width >> mip, size_t(1));
+        const size_t height = (std::max)(metadata.height >> mip, size_t(1));
+        if (compressed && (width % 4 != 0 || height % 4 != 0)) {
+            break;
+        }
+        tailMip = mip;
+        if ((std::max)(width, height) <= tailSize) {
+            break;
+        }
+    }
+    return tailMip;
+}
+
+}
+
+TextureManager::~TextureManager() = default;
 
 TextureManager* TextureManager::GetInstance() {
     static TextureManager instance;
@@ -13,48 +54,203 @@ void TextureManager::Initialize(DescriptorHeap* srvHeap) {
     m_srvHeap = srvHeap;
 }
 
-const Texture* TextureManager::Load(const std::string& filePath, ID3D12GraphicsCommandList* commandList) {
+TextureHandle TextureManager::LoadHandle(const std::string& filePath, ID3D12GraphicsCommandList* commandList) {
     // 既に読み込み済みならそれを返す
-    auto it = m_textures.find(filePath);
-    if (it != m_textures.end()) {
-        return &it->second;
+    auto it = m_handles.find(filePath);
+    if (it != m_handles.end()) {
+        return it->second;
     }
 
-    // 新規読み込み
+    // テクスチャファイルの読み込み（変換済みの DDS キャッシュがあればそれを読む。無ければ BC 圧縮してキャッシュする）
+    return AddTexture(filePath, TextureCooker::Load(filePath), commandList);
+}
+
+TextureHandle TextureManager::LoadWhiteHandle(ID3D12GraphicsCommandList* commandList) {
+    auto it = m_handles.find(kWhiteTextureName);
+    if (it != m_handles.end()) {
+        return it->second;
+    }
+
+    DirectX::ScratchImage image;
+    const HRESULT hr = image.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM, 1, 1, 1, 1);
+    assert(SUCCEEDED(hr));
+    (void)hr;
+    std::memset(image.GetPixels(), 0xFF, image.GetPixelsSize());
+    return AddTexture(kWhiteTextureName, std::move(image), commandList);
+}
+
+TextureHandle TextureManager::AddTexture(const std::string& name, DirectX::ScratchImage&& mipImages, ID3D12GraphicsCommandList* commandList) {
     Texture newTexture;
+    StreamState stream;
+    const DirectX::TexMetadata metadata = mipImages.GetMetadata();
+    ID3D12Device* device = GraphicsCore::GetInstance()->GetDevice();
 
-    // テクスチャファイルの読み込み
-    DirectX::ScratchImage mipImages = LoadTexture(filePath);
-    const DirectX::TexMetadata& metadata = mipImages.GetMetadata();
+    // 粗いミップだけを常駐させ、全ミップは CPU 側に持っておく（最初から tailSize 以下の小さいテクスチャはそのまま全部置く）
+    const bool streamable = IsStreamingEnabled() &&
+        metadata.dimension == DirectX::TEX_DIMENSION_TEXTURE2D && metadata.arraySize == 1 && metadata.mipLevels > 1;
+    const uint32_t tailMip = streamable ? ComputeTailMip(metadata, m_streamingTailSize) : 0;
+    if (tailMip > 0) {
+        std::vector<uint64_t> mipSizes(metadata.mipLevels);
+        for (size_t mip = 0; mip < metadata.mipLevels; ++mip) {
+            mipSizes[mip] = mipImages.GetImage(mip, 0, 0)->slicePitch;
+        }
+        stream.residencyId = m_residency.Register(mipSizes, tailMip);
+        m_residencyToTexture.push_back(m_textures.GetCount());
+        for (DescriptorHandle& slot : stream.slots) {
+            auto [cpuHandle, gpuHandle] = m_srvHeap->Allocate();
+            slot = DescriptorHandle(cpuHandle, gpuHandle);
+        }
+        stream.source = std::make_unique<DirectX::ScratchImage>(std::move(mipImages));
+        CreateStreamedResource(newTexture, stream, m_residency.GetResidentMip(stream.residencyId), 0, commandList);
+
+        assert(m_textures.GetCount() < TextureHandle::kInvalid);
+        const TextureHandle handle = m_textures.Add(std::move(newTexture));
+        m_streams.push_back(std::move(stream));
+        m_handles.emplace(name, handle);
+        return handle;
+    }
 
     // テクスチャリソースの作成
-    ID3D12Device* device = GraphicsCore::GetInstance()->GetDevice();
     newTexture.resource = CreateTextureResource(device, metadata);
 
-    // データ転送の戻り値（中間リソース）を受け取って保持
-    ResourceObject intermediateResource = UploadTextureData(newTexture.resource, mipImages, device, commandList);
-    m_intermediateResources.push_back(intermediateResource);
+    // 中間バッファは UploadHeap から切り出す（コピーが終われば次の転送に使い回される）
+    const UploadAllocation upload = UploadHeap::GetInstance()->Allocate(
+        static_cast<size_t>(GetTextureUploadSize(newTexture.resource, mipImages)), D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+    UploadTextureData(newTexture.resource, mipImages, device, commandList, upload);
 
     // SRVの作成（DescriptorHeapから確保）
     auto [cpuHandle, gpuHandle] = m_srvHeap->Allocate();
     newTexture.cpuHandle = cpuHandle;
     newTexture.gpuHandle = gpuHandle;
 
-    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-    srvDesc.Format = metadata.format;
-    srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-    srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-    srvDesc.Texture2D.MipLevels = static_cast<UINT>(metadata.mipLevels);
+    CreateTextureSrv(device, newTexture.resource.Get(), metadata, cpuHandle);
 
-    device->CreateShaderResourceView(newTexture.resource.Get(), &srvDesc, cpuHandle);
+    // 末尾に追加して番号を振る
+    assert(m_textures.GetCount() < TextureHandle::kInvalid);
+    const TextureHandle handle = m_textures.Add(std::move(newTexture));
+    m_streams.push_back(std::move(stream));
+    m_handles.emplace(name, handle);
+
+    return handle;
+}
 
-    // マップに登録
-    m_textures[filePath] = newTexture;
+const Texture* TextureManager::Load(const std::string& filePath, ID3D12GraphicsCommandList* commandList) {
+    return Get(LoadHandle(filePath, commandList));
+}
 
-    return &m_textures[filePath];
+TextureHandle TextureManager::FindHandle(const std::string& filePath) const {
+    auto it = m_handles.find(filePath);
+    return (it != m_handles.end()) ? it->second : TextureHandle{};
 }
 
 const Texture* TextureManager::GetTexture(const std::string& filePath) const {
-    auto it = m_textures.find(filePath);
-    return (it != m_textures.end()) ? &it->second : nullptr;
-}
\ No newline at end of file
+    return Get(FindHandle(filePath));
+}
+
+// ===================================
+// テクスチャアトラス
+// ===================================
+void TextureManager::LoadAtlas(std::span<const std::string> filePaths, ID3D12GraphicsCommandList* commandList, const TextureAtlas::Settings& settings) {
+    TextureAtlas::Atlas atlas;
+    if (!TextureAtlas::Load(filePaths, settings, atlas)) {
+        return;
+    }
+
+    // ページは普通のテクスチャとして登録する（名前はパスと重ならないようにキャッシュキーから作る）
+    std::vector<TextureHandle> pages;
+    pages.reserve(atlas.pages.size());
+    for (size_t page = 0; page < atlas.pages.size(); ++page) {
+        pages.push_back(AddTexture(std::format("atlas:{:016x}/{}", atlas.key, page), std::move(atlas.pages[page]), commandList));
+    }
+    for (const auto& [filePath, tile] : atlas.tiles) {
+        m_atlasTiles[filePath] = { pages[tile.page], TextureAtlas::MakeUvTransform(tile, atlas.pageSize) };
+    }
+}
+
+const AtlasTile* TextureManager::FindAtlasTile(const std::string& filePath) const {
+    auto it = m_atlasTiles.find(filePath);
+    return (it != m_atlasTiles.end()) ? &it->second : nullptr;
+}
+
+// ===================================
+// ミップストリーミング
+// ===================================
+void TextureManager::EnableStreaming(CommandQueue* queue, uint64_t budgetBytes, uint32_t tailSize) {
+    assert(queue != nullptr);
+    m_streamingQueue = queue;
+    m_streamingTailSize = tailSize;
+    m_residency.SetBudget(budgetBytes);
+}
+
+void TextureManager::RequestMip(TextureHandle handle, float screenPixels) {
+    if (handle.id >= m_streams.size() || !m_streams[handle.id].source) {
+        return;
+    }
+    const StreamState& stream = m_streams[handle.id];
+    const DirectX::TexMetadata& metadata = stream.source->GetMetadata();
+    const uint32_t desiredMip = TextureResidency::ComputeDesiredMip(
+        static_cast<uint32_t>(metadata.width), static_cast<uint32_t>(metadata.height), static_cast<uint32_t>(metadata.mipLevels), screenPixels);
+    m_residency.Request(stream.residencyId, desiredMip, screenPixels);
+}
+
+void TextureManager::UpdateStreaming(ID3D12GraphicsCommandList* commandList) {
+    if (!IsStreamingEnabled()) {
+        return;
+    }
+
+    // 1.前の差し替えが GPU で終わったものを解放・解除する
+    auto isComplete = [this](uint64_t fenceValue) {
+        return fenceValue != kUnsubmitted && m_streamingQueue->IsFenceComplete(fenceValue);
+    };
+    std::erase_if(m_retiredResources, [&](const RetiredResource& retired) { return isComplete(retired.fenceValue); });
+    for (StreamState& stream : m_streams) {
+        if (stream.pendingFenceValue != 0 && isComplete(stream.pendingFenceValue)) {
+            stream.pendingFenceValue = 0;
+            m_residency.SetLocked(stream.residencyId, false);
+        }
+    }
+
+    // 2.常駐ミップを決め、変わったテクスチャを作り直す
+    m_residencyChanges.clear();
+    m_residency.Update(m_residencyChanges);
+    for (const TextureResidency::Change& change : m_residencyChanges) {
+        const uint32_t textureIndex = m_residencyToTexture[change.texture];
+        Texture& texture = m_textures[textureIndex];
+        StreamState& stream = m_streams[textureIndex];
+
+        // 今の SRV とリソースは前のフレームの描画が読んでいるので、もう一方の SRV に作ってフェンスの後で古い方を捨てる
+        m_retiredResources.push_back({ texture.resource, kUnsubmitted });
+        const uint32_t slot = 1 - stream.currentSlot;
+        CreateStreamedResource(texture, stream, change.toMip, slot, commandList);
+        stream.currentSlot = slot;
+        stream.pendingFenceValue = kUnsubmitted;
+        m_residency.SetLocked(stream.residencyId, true);
+    }
+}
+
+void TextureManager::SubmitStreaming(uint64_t fenceValue) {
+    for (RetiredResource& retired : m_retiredResources) {
+        if (retired.fenceValue == kUnsubmitted) {
+            retired.fenceValue = fenceValue;
+        }
+    }
+    for (StreamState& stream : m_streams) {
+        if (stream.pendingFenceValue == kUnsubmitted) {
+            stream.pendingFenceValue = fenceValue;
+        }
+    }
+}
+
+void TextureManager::CreateStreamedResource(Texture& texture, StreamState& stream, uint32_t firstMip, uint32_t slot, ID3D12GraphicsCommandList* commandList) {
+    ID3D12Device* device = GraphicsCore::GetInstance()->GetDevice();
+    const DirectX::TexMetadata range = GetMipRangeMetadata(stream.source->GetMetadata(), firstMip);
+
+    texture.resource = CreateTextureResource(device, range);
+    const UploadAllocation upload = UploadHeap::GetInstance()->Allocate(
+        static_cast<size_t>(GetTextureUploadSize(texture.resource, *stream.source, firstMip)), D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+    UploadTextureData(texture.resource, *stream.source, device, commandList, upload, firstMip);
+
+    texture.cpuHandle = stream.slots[slot].CpuHandle;
+    texture.gpuHandle = stream.slots[slot].GpuHandle;
+    CreateTextureSrv(device, texture.resource.Get(), range, texture.cpuHandle);
+}
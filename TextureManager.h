@@ -1,9 +1,20 @@
 #pragma once
 #include <d3d12.h>
+#include <cstdint>
+#include <limits>
 #include <string>
+#include <memory>
+#include <span>
 #include <unordered_map>
+#include <vector>
 #include "DescriptorHeap.h"
 #include "ResourceObject.h"
+#include "TextureAtlas.h"
+#include "TextureHandle.h"
+#include "TextureResidency.h"
+
+class CommandQueue;
+namespace DirectX { class ScratchImage; }
 
 // テクスチャ情報を保持する構造体
 struct Texture {
@@ -12,6 +23,12 @@ struct Texture {
     D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle;
 };
 
+// アトラスに入ったテクスチャ（ページのテクスチャと、タイル内の UV をページ上に移す行列）
+struct AtlasTile {
+    TextureHandle page;
+    Matrix4x4 uvTransform;
+};
+
 class TextureManager {
 public:
     static TextureManager* GetInstance();
@@ -19,21 +36,109 @@ public:
     // DescriptorHeapを使って初期化
     void Initialize(DescriptorHeap* srvHeap);
 
+    // ===================================
+    // ミップストリーミング
+    // ===================================
+    // 有効にした後に読み込んだテクスチャは、tailSize ピクセル以下の粗いミップだけを最初に常駐させ、
+    // 描画からの要求（RequestMip）に応じて budgetBytes の範囲で細かいミップを読み込む（足りなければ LRU で捨てる）。
+    // 元のミップは CPU 側に保持しておき、常駐ミップが変わるたびにその段数のリソースを作り直して SRV を差し替える。
+    // queue : 描画を実行するキュー（差し替え前のリソースと SRV の解放をフェンスで待つ）
+    void EnableStreaming(CommandQueue* queue, uint64_t budgetBytes, uint32_t tailSize = kDefaultStreamingTailSize);
+    bool IsStreamingEnabled() const { return m_streamingQueue != nullptr; }
+
+    // 画面上で screenPixels ピクセルの大きさに描かれることを伝える（確保しない。ストリーミングしないテクスチャは無視）
+    void RequestMip(TextureHandle handle, float screenPixels);
+
+    // 前のフレームまでの要求で常駐ミップを決め、変わったテクスチャの転送を commandList に積む（フレームの最初に呼ぶ）
+    void UpdateStreaming(ID3D12GraphicsCommandList* commandList);
+
+    // UpdateStreaming を積んだコマンドリストのフェンス値で締める（UploadHeap::Submit と同じ値）
+    void SubmitStreaming(uint64_t fenceValue);
+
+    const TextureResidency& GetResidency() const { return m_residency; }
+
+    static constexpr uint32_t kDefaultStreamingTailSize = 64;
+
+    // テクスチャの読み込み。読み込み済みなら同じハンドルを返す
+    // 初期化時に呼んでハンドルを保持しておくこと（毎フレーム呼ぶとパスのハッシュが走る）
+    // 転送は UploadHeap を使うので、commandList を実行したフェンス値で UploadHeap::Submit すること
+    [[nodiscard]] TextureHandle LoadHandle(const std::string& filePath, ID3D12GraphicsCommandList* commandList);
+
+    // 1x1 の白いテクスチャ（テクスチャの無いマテリアル用。最初に呼んだときに作り、以降は同じハンドルを返す）
+    [[nodiscard]] TextureHandle LoadWhiteHandle(ID3D12GraphicsCommandList* commandList);
+
     // テクスチャの読み込み（戻り値を[[nodiscard]]にする）
     [[nodiscard]] const Texture* Load(const std::string& filePath, ID3D12GraphicsCommandList* commandList);
 
+    // ハンドルからの取得（配列を引くだけで、確保もハッシュもしない）。無効なハンドルは nullptr
+    const Texture* Get(TextureHandle handle) const {
+        return m_textures.Find(handle);
+    }
+    // 無効なハンドルは空のハンドル（ptr = 0）
+    D3D12_GPU_DESCRIPTOR_HANDLE GetGpuHandle(TextureHandle handle) const {
+        const Texture* texture = m_textures.Find(handle);
+        return texture ? texture->gpuHandle : D3D12_GPU_DESCRIPTOR_HANDLE{};
+    }
+
+    // パスからハンドルを探す（読み込みはしない）。見つからなければ無効なハンドル
+    TextureHandle FindHandle(const std::string& filePath) const;
+
     // テクスチャの取得
     const Texture* GetTexture(const std::string& filePath) const;
 
+    // ===================================
+    // テクスチャアトラス
+    // ===================================
+    // filePaths の小さいテクスチャをページにまとめて読み込む（TextureAtlas のキャッシュがあればそれを読む）。
+    // 大きすぎて入らなかったものは登録されないので、FindAtlasTile が nullptr なら LoadHandle で個別に読むこと
+    void LoadAtlas(std::span<const std::string> filePaths, ID3D12GraphicsCommandList* commandList, const TextureAtlas::Settings& settings = {});
+
+    // アトラスに入ったテクスチャのページと UV 変換を探す。入っていなければ nullptr
+    const AtlasTile* FindAtlasTile(const std::string& filePath) const;
+
 private:
     TextureManager() = default;
-    ~TextureManager() = default;
+    ~TextureManager(); // ScratchImage を前方宣言で持つので .cpp で定義する
     TextureManager(const TextureManager&) = delete;
     TextureManager& operator=(const TextureManager&) = delete;
 
     DescriptorHeap* m_srvHeap = nullptr;
-    std::unordered_map<std::string, Texture> m_textures;
 
-    // テクスチャ転送用の中間リソースを保持
-    std::vector<ResourceObject> m_intermediateResources;
-};
\ No newline at end of file
+    // ハンドルの番号で並ぶ本体（追加しても既存の要素のアドレスは変わらない）
+    TextureTable<Texture> m_textures;
+    // パス → ハンドル（読み込み時だけ引く）
+    std::unordered_map<std::string, TextureHandle> m_handles;
+    // 元画像のパス → アトラス上のタイル
+    std::unordered_map<std::string, AtlasTile> m_atlasTiles;
+
+    // ストリーミング中のテクスチャ（m_textures と同じ番号。ストリーミングしないものは source が空）
+    struct StreamState {
+        std::unique_ptr<DirectX::ScratchImage> source; // 全ミップ
+        uint32_t residencyId = 0;
+        DescriptorHandle slots[2];                     // SRV を交互に書き換える（GPU が読んでいる方は触らない）
+        uint32_t currentSlot = 0;
+        uint64_t pendingFenceValue = 0;                // 差し替え中（0 = 差し替え中でない / 締める前は kUnsubmitted）
+    };
+    // 差し替えで外したリソース（フェンスが終わったら解放）
+    struct RetiredResource {
+        Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+        uint64_t fenceValue;
+    };
+    static constexpr uint64_t kUnsubmitted = ~0ull;
+    // 白いテクスチャの登録名（ファイルパスと重ならない名前）
+    static constexpr const char* kWhiteTextureName = "<white>";
+
+    // 読み込んだ画像を name で登録する（ストリーミング中なら粗いミップだけ置く）
+    TextureHandle AddTexture(const std::string& name, DirectX::ScratchImage&& mipImages, ID3D12GraphicsCommandList* commandList);
+
+    // 常駐ミップ firstMip 以降のリソースを作って転送を積み、SRV を slot に作る
+    void CreateStreamedResource(Texture& texture, StreamState& stream, uint32_t firstMip, uint32_t slot, ID3D12GraphicsCommandList* commandList);
+
+    CommandQueue* m_streamingQueue = nullptr;
+    uint32_t m_streamingTailSize = kDefaultStreamingTailSize;
+    std::vector<StreamState> m_streams;
+    std::vector<uint32_t> m_residencyToTexture; // TextureResidency の番号 → m_textures の番号
+    std::vector<RetiredResource> m_retiredResources;
+    std::vector<TextureResidency::Change> m_residencyChanges;
+    TextureResidency m_residency;
+};
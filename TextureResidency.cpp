@@ -0,0 +1,313 @@
+#include "TextureResidency.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+uint32_t TextureResidency::Register(std::span<const uint64_t> mipSizes, uint32_t tailMip) {
+	assert(!mipSizes.empty());
+	Entry entry;
+	entry.mipSizes.assign(mipSizes.begin(), mipSizes.end());
+	entry.tailBytes.resize(mipSizes.size() + 1, 0);
+	for (size_t m = mipSizes.size(); m-- > 0;) {
+		entry.tailBytes[m] = entry.tailBytes[m + 1] + mipSizes[m];
+	}
+	entry.tailMip = std::min(tailMip, static_cast<uint32_t>(mipSizes.size() - 1));
+	entry.residentMip = entry.tailMip;
+	entry.requestedMip = entry.tailMip;
+	entry.lastUsedFrame = frame_;
+
+	residentBytes_ += entry.tailBytes[entry.residentMip];
+	textures_.push_back(std::move(entry));
+	return static_cast<uint32_t>(textures_.size() - 1);
+}
+
+void TextureResidency::SetLocked(uint32_t texture, bool locked) {
+	assert(texture < textures_.size());
+	textures_[texture].locked = locked;
+}
+
+void TextureResidency::Request(uint32_t texture, uint32_t desiredMip, float priority) {
+	assert(texture < textures_.size());
+	Entry& entry = textures_[texture];
+	if (!entry.requested) {
+		entry.requested = true;
+		entry.requestedMip = desiredMip;
+		entry.priority = priority;
+	} else {
+		entry.requestedMip = std::min(entry.requestedMip, desiredMip);
+		entry.priority = std::max(entry.priority, priority);
+	}
+	entry.lastUsedFrame = frame_;
+}
+
+uint32_t TextureResidency::ComputeDesiredMip(uint32_t width, uint32_t height, uint32_t mipCount, float screenPixels) {
+	if (mipCount == 0) {
+		return 0;
+	}
+	// 大きさが無い（画面外など）なら最も粗いミップ、テクスチャより大きく映るなら最も細かいミップ
+	if (!(screenPixels > 0.0f)) {
+		return mipCount - 1;
+	}
+	const float texels = static_cast<float>(std::max(width, height));
+	if (texels <= screenPixels) {
+		return 0;
+	}
+	const uint32_t mip = static_cast<uint32_t>(std::floor(std::log2(texels / screenPixels)));
+	return std::min(mip, mipCount - 1);
+}
+
+// ===================================
+// 常駐ミップの決定
+// ===================================
+void TextureResidency::Update(std::vector<Change>& changes) {
+	const size_t count = textures_.size();
+	targets_.resize(count);
+
+	// ================================
+	// 1.要求どおりにした場合
+	// ================================
+	// 要求より細かいミップが既にあれば、予算が許す限り残しておく（すぐ近づいたときに読み直さない）
+	uint64_t total = 0;
+	for (size_t i = 0; i < count; ++i) {
+		const Entry& entry = textures_[i];
+		uint32_t target = entry.residentMip;
+		if (!entry.locked && entry.requested) {
+			target = std::min(entry.requestedMip, entry.residentMip);
+		}
+		targets_[i] = std::min(target, entry.tailMip);
+		total += entry.tailBytes[targets_[i]];
+	}
+
+	// ================================
+	// 2.予算を超えたら LRU で捨てる
+	// ================================
+	if (budgetBytes_ != 0 && total > budgetBytes_) {
+		evictionOrder_.clear();
+		for (uint32_t i = 0; i < count; ++i) {
+			if (!textures_[i].locked) {
+				evictionOrder_.push_back(i);
+			}
+		}
+		std::sort(evictionOrder_.begin(), evictionOrder_.end(), [this](uint32_t a, uint32_t b) {
+			const Entry& ea = textures_[a];
+			const Entry& eb = textures_[b];
+			if (ea.lastUsedFrame != eb.lastUsedFrame) {
+				return ea.lastUsedFrame < eb.lastUsedFrame;
+			}
+			return ea.priority < eb.priority;
+		});
+
+		auto dropUntil = [&](uint32_t texture, uint32_t floorMip) {
+			const Entry& entry = textures_[texture];
+			while (total > budgetBytes_ && targets_[texture] < floorMip) {
+				total -= entry.mipSizes[targets_[texture]];
+				++targets_[texture];
+			}
+		};
+
+		// 今は要らないミップ（使われていないテクスチャは tail より細かい全部）を古い順に捨てる
+		for (uint32_t texture : evictionOrder_) {
+			const Entry& entry = textures_[texture];
+			dropUntil(texture, entry.requested ? std::min(entry.requestedMip, entry.tailMip) : entry.tailMip);
+		}
+		// まだ超えていれば、このフレームに要求されたミップも要求の小さい順に削る
+		for (uint32_t texture : evictionOrder_) {
+			dropUntil(texture, textures_[texture].tailMip);
+		}
+	}
+
+	// ================================
+	// 3.変わったものを返す
+	// ================================
+	for (uint32_t i = 0; i < count; ++i) {
+		Entry& entry = textures_[i];
+		if (targets_[i] != entry.residentMip) {
+			changes.push_back({ i, entry.residentMip, targets_[i] });
+			entry.residentMip = targets_[i];
+		}
+		entry.requested = false;
+	}
+	residentBytes_ = total;
+	++frame_;
+}
+
+// ===================================
+// テスト（ctest の texture_residency_test）
+// ===================================
+// 使われていない順（LRU）に捨てること、予算を守ること、ロック中のテクスチャを変えないことを確かめる。
+#if defined(TOMO_TEXTURE_RESIDENCY_TEST_MAIN)
+#include <cstdio>
+#include <random>
+
+namespace {
+
+// size x size の RGBA8 の各ミップのバイト数
+std::vector<uint64_t> MakeMipSizes(uint32_t size) {
+	std::vector<uint64_t> mipSizes;
+	for (uint32_t s = size; s > 0; s /= 2) {
+		mipSizes.push_back(static_cast<uint64_t>(s) * s * 4);
+	}
+	return mipSizes;
+}
+
+uint64_t Sum(const std::vector<uint64_t>& sizes, size_t begin, size_t end) {
+	uint64_t sum = 0;
+	for (size_t i = begin; i < end; ++i) {
+		sum += sizes[i];
+	}
+	return sum;
+}
+
+bool Changed(const std::vector<TextureResidency::Change>& changes, uint32_t texture) {
+	return std::any_of(changes.begin(), changes.end(), [&](const TextureResidency::Change& change) { return change.texture == texture; });
+}
+
+int gFailureCount = 0;
+
+void Expect(bool condition, const char* what) {
+	std::printf("%-60s %s\n", what, condition ? "ok" : "NG");
+	gFailureCount += condition ? 0 : 1;
+}
+
+}
+
+int main() {
+	// 256 x 256（9 段）、ミップ 4（16 x 16）以降を常に常駐させる
+	constexpr uint32_t kTailMip = 4;
+	const std::vector<uint64_t> mipSizes = MakeMipSizes(256);
+	const uint64_t tailBytes = Sum(mipSizes, kTailMip, mipSizes.size());
+	const uint64_t fineBytes = Sum(mipSizes, 0, kTailMip); // 全部置いたときに tail より増える分
+	std::vector<TextureResidency::Change> changes;
+
+	Expect(TextureResidency::ComputeDesiredMip(256, 256, 9, 300.0f) == 0 &&
+		TextureResidency::ComputeDesiredMip(256, 256, 9, 64.0f) == 2 &&
+		TextureResidency::ComputeDesiredMip(256, 256, 9, 0.0f) == 8, "desired mip follows the screen size");
+
+	// ================================
+	// 1.LRU：2 枚分しか入らない予算で 3 枚を順に使うと、最も古いものが捨てられる
+	// ================================
+	{
+		TextureResidency residency;
+		for (int i = 0; i < 3; ++i) {
+			residency.Register(mipSizes, kTailMip);
+		}
+		Expect(residency.GetResidentBytes() == tailBytes * 3 && residency.GetResidentMip(0) == kTailMip, "lru: only the tail is resident at first");
+		residency.SetBudget(tailBytes * 3 + fineBytes * 2);
+
+		for (uint32_t texture = 0; texture < 3; ++texture) {
+			changes.clear();
+			residency.Request(texture, 0, 256.0f);
+			residency.Update(changes);
+		}
+		Expect(residency.GetResidentMip(0) == kTailMip, "lru: least recently used texture evicted to its tail");
+		Expect(residency.GetResidentMip(1) == 0 && residency.GetResidentMip(2) == 0, "lru: recently used textures kept");
+		Expect(Changed(changes, 0) && !Changed(changes, 1), "lru: only the evicted and the loaded texture change");
+		Expect(residency.GetResidentBytes() <= residency.GetBudget(), "lru: within budget");
+
+		// 予算に余裕があれば要求が無くても細かいミップを残す
+		changes.clear();
+		residency.Update(changes);
+		Expect(changes.empty(), "lru: idle frame changes nothing");
+	}
+
+	// ================================
+	// 2.同じフレームで足りなければ、要求の小さい（優先度の低い）方から削る
+	// ================================
+	{
+		TextureResidency residency;
+		residency.Register(mipSizes, kTailMip);
+		residency.Register(mipSizes, kTailMip);
+		residency.SetBudget(tailBytes * 2 + fineBytes);
+		residency.Request(0, 0, 100.0f);
+		residency.Request(1, 0, 900.0f);
+		residency.Update(changes);
+		Expect(residency.GetResidentMip(1) == 0 && residency.GetResidentMip(0) == kTailMip, "priority: smaller request yields");
+		Expect(residency.GetResidentBytes() <= residency.GetBudget(), "priority: within budget");
+	}
+
+	// ================================
+	// 3.ロック中（GPU へ反映中）のテクスチャは捨ても読み込みもしない
+	// ================================
+	{
+		TextureResidency residency;
+		for (int i = 0; i < 3; ++i) {
+			residency.Register(mipSizes, kTailMip);
+		}
+		residency.SetBudget(tailBytes * 3 + fineBytes * 2);
+		residency.Request(0, 0, 256.0f);
+		residency.Update(changes);
+
+		// 0 は最も古いが、ロック中なので 1 と 2 のどちらかが予算に合わせて削られる
+		residency.SetLocked(0, true);
+		residency.Request(1, 0, 256.0f);
+		residency.Update(changes);
+		changes.clear();
+		residency.Request(2, 0, 256.0f);
+		residency.Update(changes);
+		Expect(residency.GetResidentMip(0) == 0 && !Changed(changes, 0), "locked: resident mips kept even when least recently used");
+		Expect(residency.GetResidentMip(1) > 0, "locked: next oldest texture evicted instead");
+		Expect(residency.GetResidentBytes() <= residency.GetBudget(), "locked: within budget");
+
+		// ロック中の要求は反映されず、解除後の Update で反映される
+		residency.SetLocked(1, true);
+		const uint32_t lockedMip = residency.GetResidentMip(1);
+		changes.clear();
+		residency.Request(1, 0, 1000.0f);
+		residency.Update(changes);
+		Expect(residency.GetResidentMip(1) == lockedMip && !Changed(changes, 1), "locked: request ignored while locked");
+		residency.SetLocked(0, false);
+		residency.SetLocked(1, false);
+		changes.clear();
+		residency.Request(1, 0, 1000.0f);
+		residency.Update(changes);
+		Expect(residency.GetResidentMip(1) == 0 && residency.GetResidentMip(0) == kTailMip, "locked: applied after unlock, old texture evicted");
+	}
+
+	// ================================
+	// 4.ランダムな要求とロック（ロック中は変わらず、tail 以外は予算を超えない）
+	// ================================
+	{
+		std::mt19937 random(3);
+		TextureResidency residency;
+		residency.SetBudget(3'000'000);
+		constexpr uint32_t kTextureCount = 50;
+		for (uint32_t i = 0; i < kTextureCount; ++i) {
+			const std::vector<uint64_t> sizes = MakeMipSizes(64u << (random() % 5));
+			residency.Register(sizes, static_cast<uint32_t>(sizes.size()) - 5);
+		}
+		std::vector<bool> locked(kTextureCount, false);
+		size_t lockedChangeCount = 0;
+		size_t overBudgetCount = 0;
+		size_t changeCount = 0;
+		for (int frame = 0; frame < 2000; ++frame) {
+			for (int k = 0; k < 10; ++k) {
+				const uint32_t texture = random() % kTextureCount;
+				residency.Request(texture, random() % residency.GetMipCount(texture), static_cast<float>(random() % 1000));
+			}
+			if (frame % 7 == 0) {
+				const uint32_t texture = random() % kTextureCount;
+				locked[texture] = random() % 2 != 0;
+				residency.SetLocked(texture, locked[texture]);
+			}
+			changes.clear();
+			residency.Update(changes);
+			changeCount += changes.size();
+			for (const TextureResidency::Change& change : changes) {
+				lockedChangeCount += locked[change.texture] ? 1 : 0;
+			}
+			// 予算を超えてよいのは、ロック中のものと tail だけで超えるとき
+			if (residency.GetResidentBytes() > residency.GetBudget()) {
+				for (uint32_t texture = 0; texture < kTextureCount; ++texture) {
+					overBudgetCount += !locked[texture] && residency.GetResidentMip(texture) < residency.GetMipCount(texture) - 5 ? 1 : 0;
+				}
+			}
+		}
+		std::printf("random: %zu changes over 2000 frames\n", changeCount);
+		Expect(lockedChangeCount == 0, "random: locked textures never change");
+		Expect(overBudgetCount == 0, "random: over budget only because of locked textures or tails");
+	}
+
+	std::puts(gFailureCount == 0 ? "PASSED" : "FAILED");
+	return gFailureCount == 0 ? 0 : 1;
+}
+#endif
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// ==================================
+// テクスチャのミップの常駐管理（予算と LRU）
+// ==================================
+// どのテクスチャのどのミップまでを VRAM に置くかだけを決める（D3D12 に依存しない）。
+//   Request : 描画時に「このフレームはミップ n まで欲しい」を伝える（画面上の大きさから ComputeDesiredMip で求める）
+//   Update  : 要求と予算から各テクスチャの常駐ミップを決め、変わったものを返す
+// 予算を超える分は、最後に使われたフレームが古い順（同じフレームなら要求の小さい順）に細かいミップから捨てる。
+// 各テクスチャの最も粗い数段（tailMip 以降）は常に常駐させ、捨てない。
+//
+// ミップ番号は 0 が最も細かい。「常駐ミップ m」は m 以降（m, m+1, ... 最後）が VRAM にあることを表す。
+class TextureResidency {
+public:
+	// 常駐ミップが変わったテクスチャ
+	struct Change {
+		uint32_t texture;
+		uint32_t fromMip;
+		uint32_t toMip;   // fromMip より小さければ細かいミップを読み込む、大きければ捨てる
+	};
+
+	// 予算（バイト）。0 なら無制限
+	void SetBudget(uint64_t budgetBytes) { budgetBytes_ = budgetBytes; }
+	uint64_t GetBudget() const { return budgetBytes_; }
+
+	// テクスチャを登録して番号を返す（0 から順に振る）
+	// mipSizes : 各ミップのバイト数（細かい順）/ tailMip : 常に常駐させる最も細かいミップ（最初はここまで常駐）
+	uint32_t Register(std::span<const uint64_t> mipSizes, uint32_t tailMip);
+
+	// GPU への反映中（前の変更が終わっていない）テクスチャは Update で変えない
+	void SetLocked(uint32_t texture, bool locked);
+
+	// このフレームの要求を記録する（同じフレームに複数回呼ばれたら最も細かいものを採る）
+	void Request(uint32_t texture, uint32_t desiredMip, float priority = 0.0f);
+
+	// 要求と予算から常駐ミップを決め、変わったものを changes に追加する。フレームを 1 つ進める
+	void Update(std::vector<Change>& changes);
+
+	uint32_t GetResidentMip(uint32_t texture) const { return textures_[texture].residentMip; }
+	uint32_t GetMipCount(uint32_t texture) const { return static_cast<uint32_t>(textures_[texture].mipSizes.size()); }
+	uint64_t GetResidentBytes() const { return residentBytes_; }
+	uint64_t GetFrame() const { return frame_; }
+	size_t GetTextureCount() const { return textures_.size(); }
+
+	// width x height のテクスチャを画面上で screenPixels ピクセルの大きさに描くときに要るミップ
+	// （1 テクセルが 1 ピクセル以上になる最も粗いミップ。UV がテクスチャ全体を 1 回覆う前提）
+	static uint32_t ComputeDesiredMip(uint32_t width, uint32_t height, uint32_t mipCount, float screenPixels);
+
+private:
+	struct Entry {
+		std::vector<uint64_t> mipSizes;
+		std::vector<uint64_t> tailBytes; // tailBytes[m] = ミップ m 以降の合計
+		uint32_t tailMip = 0;
+		uint32_t residentMip = 0;
+		uint32_t requestedMip = 0;
+		float priority = 0.0f;           // このフレームの要求の大きさ（大きいほど捨てにくい）
+		uint64_t lastUsedFrame = 0;
+		bool requested = false;          // このフレームに要求があったか
+		bool locked = false;
+	};
+
+	std::vector<Entry> textures_;
+	uint64_t budgetBytes_ = 0;
+	uint64_t residentBytes_ = 0;
+	uint64_t frame_ = 1;
+
+	// 捨てる順の作業用（毎フレーム確保しない）
+	std::vector<uint32_t> evictionOrder_;
+	std::vector<uint32_t> targets_;
+};
@@ -24,6 +24,7 @@
 
 // -------- Lorder ------------
 #include "LoadObjFile.h"
+#include "MeshCache.h"
 
 // =============================
 // Math
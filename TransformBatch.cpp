@@ -0,0 +1,386 @@
+#include "TransformBatch.h"
+#include "MathSimd.h"
+#include <cassert>
+#include <cstddef>
+
+static_assert(sizeof(Vector3) == sizeof(float) * 3, "Vector3 は float3 個で隙間なく並んでいる必要がある");
+
+namespace {
+
+// 行ベクトル規約の係数
+//   out.x = x * m[0][0] + y * m[1][0] + z * m[2][0] (+ m[3][0])
+//   w     = x * m[0][3] + y * m[1][3] + z * m[2][3] + m[3][3]
+struct Coefficients {
+	float m[4][4];
+};
+
+Coefficients FromMatrix(const Matrix4x4& matrix) {
+	Coefficients result;
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			result.m[i][j] = matrix.m[i][j];
+		}
+	}
+	return result;
+}
+
+Coefficients FromAffine(const Affine3x4& affine) {
+	// Affine3x4 は転置して格納しているので戻す（w は使わない）
+	Coefficients result;
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 3; ++j) {
+			result.m[i][j] = affine.m[j][i];
+		}
+		result.m[i][3] = (i == 3) ? 1.0f : 0.0f;
+	}
+	return result;
+}
+
+// 1要素分（端数処理とSIMD無効時に使用）
+// 加算の順序は Vector3::Transform と揃えてあるので結果はビット単位で一致する
+template <bool kTranslate, bool kDivideW>
+inline void TransformOne(float x, float y, float z, const Coefficients& c, float& outX, float& outY, float& outZ) {
+	float rx = x * c.m[0][0] + y * c.m[1][0] + z * c.m[2][0];
+	float ry = x * c.m[0][1] + y * c.m[1][1] + z * c.m[2][1];
+	float rz = x * c.m[0][2] + y * c.m[1][2] + z * c.m[2][2];
+	if constexpr (kTranslate) {
+		rx += c.m[3][0];
+		ry += c.m[3][1];
+		rz += c.m[3][2];
+	}
+	if constexpr (kDivideW) {
+		float w = x * c.m[0][3] + y * c.m[1][3] + z * c.m[2][3] + c.m[3][3];
+		if (w != 0.0f) {
+			rx /= w;
+			ry /= w;
+			rz /= w;
+		}
+	}
+	outX = rx;
+	outY = ry;
+	outZ = rz;
+}
+
+// ==================================
+// SIMD レーン操作（型ごとにオーバーロード）
+// ==================================
+#if defined(TOMO_MATH_SSE)
+inline void Splat(__m128& out, float value) { out = _mm_set1_ps(value); }
+inline __m128 Add(__m128 a, __m128 b) { return _mm_add_ps(a, b); }
+inline __m128 Mul(__m128 a, __m128 b) { return _mm_mul_ps(a, b); }
+// w != 0 のレーンだけ value / w にする
+inline __m128 DivideByW(__m128 value, __m128 w) {
+	__m128 mask = _mm_cmpneq_ps(w, _mm_setzero_ps());
+	return _mm_or_ps(_mm_and_ps(mask, _mm_div_ps(value, w)), _mm_andnot_ps(mask, value));
+}
+#endif
+
+#if defined(TOMO_MATH_AVX)
+inline void Splat(__m256& out, float value) { out = _mm256_set1_ps(value); }
+inline __m256 Add(__m256 a, __m256 b) { return _mm256_add_ps(a, b); }
+inline __m256 Mul(__m256 a, __m256 b) { return _mm256_mul_ps(a, b); }
+inline __m256 DivideByW(__m256 value, __m256 w) {
+	__m256 mask = _mm256_cmp_ps(w, _mm256_setzero_ps(), _CMP_NEQ_UQ);
+	return _mm256_blendv_ps(value, _mm256_div_ps(value, w), mask);
+}
+#endif
+
+#if defined(TOMO_MATH_NEON)
+inline void Splat(float32x4_t& out, float value) { out = vdupq_n_f32(value); }
+inline float32x4_t Add(float32x4_t a, float32x4_t b) { return vaddq_f32(a, b); }
+inline float32x4_t Mul(float32x4_t a, float32x4_t b) { return vmulq_f32(a, b); }
+inline float32x4_t DivideByW(float32x4_t value, float32x4_t w) {
+	uint32x4_t mask = vmvnq_u32(vceqq_f32(w, vdupq_n_f32(0.0f)));
+	return vbslq_f32(mask, vdivq_f32(value, w), value);
+}
+#endif
+
+#if defined(TOMO_MATH_SSE) || defined(TOMO_MATH_NEON)
+// 係数をレーン幅に展開したもの（ループの外で一度だけ作る）。
+// __m128 などをテンプレート引数にすると GCC が属性を捨てる警告（-Wignored-attributes）を出すので、幅ごとに型を分ける
+template <class V>
+inline void SplatAll(V (&m)[4][4], const Coefficients& c) {
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			Splat(m[i][j], c.m[i][j]);
+		}
+	}
+}
+
+struct SplatCoefficients4 {
+#if defined(TOMO_MATH_SSE)
+	__m128 m[4][4];
+#else
+	float32x4_t m[4][4];
+#endif
+
+	explicit SplatCoefficients4(const Coefficients& c) { SplatAll(m, c); }
+};
+
+#if defined(TOMO_MATH_AVX)
+struct SplatCoefficients8 {
+	__m256 m[4][4];
+
+	explicit SplatCoefficients8(const Coefficients& c) { SplatAll(m, c); }
+};
+#endif
+
+// SoA のレーン単位で変換（演算順序は TransformOne と同じ）
+template <bool kTranslate, bool kDivideW, class V, class C>
+inline void TransformLanes(V& x, V& y, V& z, const C& c) {
+	V rx = Add(Add(Mul(x, c.m[0][0]), Mul(y, c.m[1][0])), Mul(z, c.m[2][0]));
+	V ry = Add(Add(Mul(x, c.m[0][1]), Mul(y, c.m[1][1])), Mul(z, c.m[2][1]));
+	V rz = Add(Add(Mul(x, c.m[0][2]), Mul(y, c.m[1][2])), Mul(z, c.m[2][2]));
+	if constexpr (kTranslate) {
+		rx = Add(rx, c.m[3][0]);
+		ry = Add(ry, c.m[3][1]);
+		rz = Add(rz, c.m[3][2]);
+	}
+	if constexpr (kDivideW) {
+		V w = Add(Add(Add(Mul(x, c.m[0][3]), Mul(y, c.m[1][3])), Mul(z, c.m[2][3])), c.m[3][3]);
+		rx = DivideByW(rx, w);
+		ry = DivideByW(ry, w);
+		rz = DivideByW(rz, w);
+	}
+	x = rx;
+	y = ry;
+	z = rz;
+}
+#endif
+
+// ==================================
+// AoS
+// ==================================
+template <bool kTranslate, bool kDivideW>
+void TransformAoS(std::span<const Vector3> input, std::span<Vector3> output, const Coefficients& c) {
+	assert(input.size() == output.size());
+	const size_t count = input.size();
+	size_t i = 0;
+
+#if defined(TOMO_MATH_SSE) || defined(TOMO_MATH_NEON)
+	const float* src = reinterpret_cast<const float*>(input.data());
+	float* dst = reinterpret_cast<float*>(output.data());
+#endif
+
+#if defined(TOMO_MATH_SSE)
+	// 4点 = float 12個 = __m128 3本を読み、SoA に並べ替えてから変換する
+	//   a = x0 y0 z0 x1 / b = y1 z1 x2 y2 / c = z2 x3 y3 z3
+	const SplatCoefficients4 sc(c);
+	for (; i + 4 <= count; i += 4) {
+		const float* p = src + i * 3;
+		__m128 a = _mm_loadu_ps(p + 0);
+		__m128 b = _mm_loadu_ps(p + 4);
+		__m128 d = _mm_loadu_ps(p + 8);
+
+		__m128 x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, d, TOMO_SHUFFLE_MASK(2, 2, 1, 1)), TOMO_SHUFFLE_MASK(0, 3, 0, 2));
+		__m128 y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, TOMO_SHUFFLE_MASK(1, 1, 0, 0)), _mm_shuffle_ps(b, d, TOMO_SHUFFLE_MASK(3, 3, 2, 2)), TOMO_SHUFFLE_MASK(0, 2, 0, 2));
+		__m128 z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, TOMO_SHUFFLE_MASK(2, 2, 1, 1)), d, TOMO_SHUFFLE_MASK(0, 2, 0, 3));
+
+		TransformLanes<kTranslate, kDivideW>(x, y, z, sc);
+
+		// AoS に戻す
+		a = _mm_shuffle_ps(_mm_shuffle_ps(x, y, TOMO_SHUFFLE_MASK(0, 1, 0, 1)), _mm_shuffle_ps(z, x, TOMO_SHUFFLE_MASK(0, 0, 1, 1)), TOMO_SHUFFLE_MASK(0, 2, 0, 2));
+		b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, TOMO_SHUFFLE_MASK(1, 1, 1, 1)), _mm_shuffle_ps(x, y, TOMO_SHUFFLE_MASK(2, 2, 2, 2)), TOMO_SHUFFLE_MASK(0, 2, 0, 2));
+		d = _mm_shuffle_ps(_mm_shuffle_ps(z, x, TOMO_SHUFFLE_MASK(2, 2, 3, 3)), _mm_shuffle_ps(y, z, TOMO_SHUFFLE_MASK(3, 3, 3, 3)), TOMO_SHUFFLE_MASK(0, 2, 0, 2));
+
+		float* q = dst + i * 3;
+		_mm_storeu_ps(q + 0, a);
+		_mm_storeu_ps(q + 4, b);
+		_mm_storeu_ps(q + 8, d);
+	}
+#elif defined(TOMO_MATH_NEON)
+	// vld3q / vst3q がそのまま AoS ⇔ SoA の並べ替えになる
+	const SplatCoefficients4 sc(c);
+	for (; i + 4 <= count; i += 4) {
+		float32x4x3_t v = vld3q_f32(src + i * 3);
+		TransformLanes<kTranslate, kDivideW>(v.val[0], v.val[1], v.val[2], sc);
+		vst3q_f32(dst + i * 3, v);
+	}
+#endif
+
+	// 端数
+	for (; i < count; ++i) {
+		const Vector3 v = input[i];
+		TransformOne<kTranslate, kDivideW>(v.x, v.y, v.z, c, output[i].x, output[i].y, output[i].z);
+	}
+}
+
+// ==================================
+// SoA
+// ==================================
+template <bool kTranslate, bool kDivideW>
+void TransformSoA(const ConstVector3SoA& input, const Vector3SoA& output, const Coefficients& c) {
+	const size_t count = input.x.size();
+	assert(input.y.size() == count && input.z.size() == count);
+	assert(output.x.size() == count && output.y.size() == count && output.z.size() == count);
+	const float* inX = input.x.data();
+	const float* inY = input.y.data();
+	const float* inZ = input.z.data();
+	float* outX = output.x.data();
+	float* outY = output.y.data();
+	float* outZ = output.z.data();
+	size_t i = 0;
+
+#if defined(TOMO_MATH_AVX)
+	const SplatCoefficients8 sc8(c);
+	for (; i + 8 <= count; i += 8) {
+		__m256 x = _mm256_loadu_ps(inX + i);
+		__m256 y = _mm256_loadu_ps(inY + i);
+		__m256 z = _mm256_loadu_ps(inZ + i);
+		TransformLanes<kTranslate, kDivideW>(x, y, z, sc8);
+		_mm256_storeu_ps(outX + i, x);
+		_mm256_storeu_ps(outY + i, y);
+		_mm256_storeu_ps(outZ + i, z);
+	}
+#endif
+#if defined(TOMO_MATH_SSE)
+	const SplatCoefficients4 sc(c);
+	for (; i + 4 <= count; i += 4) {
+		__m128 x = _mm_loadu_ps(inX + i);
+		__m128 y = _mm_loadu_ps(inY + i);
+		__m128 z = _mm_loadu_ps(inZ + i);
+		TransformLanes<kTranslate, kDivideW>(x, y, z, sc);
+		_mm_storeu_ps(outX + i, x);
+		_mm_storeu_ps(outY + i, y);
+		_mm_storeu_ps(outZ + i, z);
+	}
+#elif defined(TOMO_MATH_NEON)
+	const SplatCoefficients4 sc(c);
+	for (; i + 4 <= count; i += 4) {
+		float32x4_t x = vld1q_f32(inX + i);
+		float32x4_t y = vld1q_f32(inY + i);
+		float32x4_t z = vld1q_f32(inZ + i);
+		TransformLanes<kTranslate, kDivideW>(x, y, z, sc);
+		vst1q_f32(outX + i, x);
+		vst1q_f32(outY + i, y);
+		vst1q_f32(outZ + i, z);
+	}
+#endif
+
+	// 端数
+	for (; i < count; ++i) {
+		TransformOne<kTranslate, kDivideW>(inX[i], inY[i], inZ[i], c, outX[i], outY[i], outZ[i]);
+	}
+}
+
+} // namespace
+
+void TransformPoints(std::span<const Vector3> input, std::span<Vector3> output, const Matrix4x4& matrix) {
+	TransformAoS<true, true>(input, output, FromMatrix(matrix));
+}
+
+void TransformPoints(std::span<const Vector3> input, std::span<Vector3> output, const Affine3x4& affine) {
+	TransformAoS<true, false>(input, output, FromAffine(affine));
+}
+
+void TransformDirections(std::span<const Vector3> input, std::span<Vector3> output, const Matrix4x4& matrix) {
+	TransformAoS<false, false>(input, output, FromMatrix(matrix));
+}
+
+void TransformDirections(std::span<const Vector3> input, std::span<Vector3> output, const Affine3x4& affine) {
+	TransformAoS<false, false>(input, output, FromAffine(affine));
+}
+
+void TransformPoints(const ConstVector3SoA& input, const Vector3SoA& output, const Matrix4x4& matrix) {
+	TransformSoA<true, true>(input, output, FromMatrix(matrix));
+}
+
+void TransformPoints(const ConstVector3SoA& input, const Vector3SoA& output, const Affine3x4& affine) {
+	TransformSoA<true, false>(input, output, FromAffine(affine));
+}
+
+void TransformDirections(const ConstVector3SoA& input, const Vector3SoA& output, const Matrix4x4& matrix) {
+	TransformSoA<false, false>(input, output, FromMatrix(matrix));
+}
+
+void TransformDirections(const ConstVector3SoA& input, const Vector3SoA& output, const Affine3x4& affine) {
+	TransformSoA<false, false>(input, output, FromAffine(affine));
+}
+
+#if defined(TOMO_TRANSFORM_BATCH_TEST_MAIN)
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// 一括変換の結果が 1 要素ずつの変換（Vector3::Transform / Affine3x4::TransformPoint など）とビット単位で一致することを確かめる。
+// 要素数は SIMD の幅（4 / 8）の端数がすべて出るように選ぶ
+int main() {
+	std::mt19937 random(3);
+	std::uniform_real_distribution<float> distribution(-5.0f, 5.0f);
+
+	const Matrix4x4 projection = Matrix4x4::MakeParspectiveFovMatrix(0.8f, 1.7f, 0.1f, 100.0f);
+	const Affine3x4 affine = Affine3x4::MakeAffine({ 1.0f, 2.0f, 3.0f }, Vector3{ 0.3f, 1.0f, -2.0f }, { 1.0f, 2.0f, 3.0f });
+	const Matrix4x4 world = Affine3x4::ToMatrix4x4(affine);
+	const Matrix4x4 worldProjection = world * projection;
+	// 方向の変換（平行移動の 0 を足さないので、-0 がそのまま残る）
+	auto transformDirection = [&](const Vector3& v) {
+		return Vector3{
+			v.x * world.m[0][0] + v.y * world.m[1][0] + v.z * world.m[2][0],
+			v.x * world.m[0][1] + v.y * world.m[1][1] + v.z * world.m[2][1],
+			v.x * world.m[0][2] + v.y * world.m[1][2] + v.z * world.m[2][2],
+		};
+	};
+
+	int mismatchCount = 0;
+	for (size_t count : { 0, 1, 3, 4, 5, 7, 8, 9, 17, 1003 }) {
+		std::vector<Vector3> input(count);
+		for (Vector3& v : input) {
+			v = { distribution(random), distribution(random), distribution(random) };
+		}
+		if (count > 2) {
+			input[1] = { 0.0f, 0.0f, 0.0f }; // w = 0 になる点（w 除算をしない）
+		}
+		std::vector<float> x(count), y(count), z(count);
+		for (size_t i = 0; i < count; ++i) {
+			x[i] = input[i].x;
+			y[i] = input[i].y;
+			z[i] = input[i].z;
+		}
+		std::vector<Vector3> output(count);
+		std::vector<float> outX(count), outY(count), outZ(count);
+
+		auto check = [&](const char* name, auto reference) {
+			for (size_t i = 0; i < count; ++i) {
+				const Vector3 expected = reference(input[i]);
+				const Vector3 soa = { outX[i], outY[i], outZ[i] };
+				if (std::memcmp(&expected, &output[i], sizeof(Vector3)) != 0 || std::memcmp(&expected, &soa, sizeof(Vector3)) != 0) {
+					if (mismatchCount++ < 8) {
+						std::printf("%s count=%zu index=%zu expected (%g %g %g) aos (%g %g %g) soa (%g %g %g)\n", name, count, i,
+							expected.x, expected.y, expected.z, output[i].x, output[i].y, output[i].z, soa.x, soa.y, soa.z);
+					}
+				}
+			}
+		};
+
+		TransformPoints(input, output, worldProjection);
+		TransformPoints({ x, y, z }, { outX, outY, outZ }, worldProjection);
+		check("points/matrix", [&](const Vector3& v) { return Vector3::Transform(v, worldProjection); });
+
+		TransformPoints(input, output, affine);
+		TransformPoints({ x, y, z }, { outX, outY, outZ }, affine);
+		check("points/affine", [&](const Vector3& v) { return Affine3x4::TransformPoint(v, affine); });
+
+		TransformDirections(input, output, world);
+		TransformDirections({ x, y, z }, { outX, outY, outZ }, world);
+		check("directions/matrix", transformDirection);
+
+		TransformDirections(input, output, affine);
+		TransformDirections({ x, y, z }, { outX, outY, outZ }, affine);
+		check("directions/affine", [&](const Vector3& v) { return Affine3x4::TransformDirection(v, affine); });
+
+		// インプレース
+		output = input;
+		TransformPoints(output, output, worldProjection);
+		outX = x;
+		outY = y;
+		outZ = z;
+		TransformPoints({ outX, outY, outZ }, { outX, outY, outZ }, worldProjection);
+		check("points/in-place", [&](const Vector3& v) { return Vector3::Transform(v, worldProjection); });
+	}
+
+	std::printf("%d mismatch(es)\n", mismatchCount);
+	std::puts(mismatchCount == 0 ? "PASSED" : "FAILED");
+	return mismatchCount == 0 ? 0 : 1;
+}
+#endif
@@ -0,0 +1,41 @@
+#pragma once
+#include <span>
+#include "Vector3.h"
+#include "Matrix4x4.h"
+#include "Affine3x4.h"
+
+// ==================================
+// 座標の一括変換
+// ==================================
+// Vector3::Transform を頂点ごとに呼ぶ代わりに、連続した配列をまとめて変換する。
+// SIMD が使える環境では 4 要素（AVX の SoA は 8 要素）ずつ処理し、端数はスカラーで処理する。
+//
+//   TransformPoints     : 平行移動あり。Matrix4x4 版は Vector3::Transform と同じく w 除算を行う
+//   TransformDirections : 平行移動なし・w 除算なし（法線やベクトル用）
+//
+// input と output は同じ要素数であること。input と output が同一配列（インプレース）でもよい。
+
+// SoA 形式の座標列（x, y, z を別々の配列で持つ）
+struct Vector3SoA {
+	std::span<float> x;
+	std::span<float> y;
+	std::span<float> z;
+};
+
+struct ConstVector3SoA {
+	std::span<const float> x;
+	std::span<const float> y;
+	std::span<const float> z;
+};
+
+// AoS (Vector3 の配列)
+void TransformPoints(std::span<const Vector3> input, std::span<Vector3> output, const Matrix4x4& matrix);
+void TransformPoints(std::span<const Vector3> input, std::span<Vector3> output, const Affine3x4& affine);
+void TransformDirections(std::span<const Vector3> input, std::span<Vector3> output, const Matrix4x4& matrix);
+void TransformDirections(std::span<const Vector3> input, std::span<Vector3> output, const Affine3x4& affine);
+
+// SoA
+void TransformPoints(const ConstVector3SoA& input, const Vector3SoA& output, const Matrix4x4& matrix);
+void TransformPoints(const ConstVector3SoA& input, const Vector3SoA& output, const Affine3x4& affine);
+void TransformDirections(const ConstVector3SoA& input, const Vector3SoA& output, const Matrix4x4& matrix);
+void TransformDirections(const ConstVector3SoA& input, const Vector3SoA& output, const Affine3x4& affine);
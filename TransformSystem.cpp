@@ -0,0 +1,263 @@
+#include "TransformSystem.h"
+#include "TransformationMatrix.h"
+#include "ResourcesUtility.h"
+#include "Camera.h"
+#include <cassert>
+#include <cstring>
+
+static_assert(sizeof(TransformationMatrix) <= 256, "TransformationMatrix が CBV スロットに収まらない");
+
+TransformSystem* TransformSystem::GetInstance() {
+	static TransformSystem instance;
+	return &instance;
+}
+
+void TransformSystem::Initialize(ID3D12Device* device, uint32_t capacity) {
+	assert(device != nullptr);
+	assert(capacity > 0);
+	capacity_ = capacity;
+
+	// 全オブジェクト分の定数バッファを 1 本で確保し、ずっとマップしたままにする
+	uploadResource_ = CreateBufferResource(device, kSlotStride * capacity_);
+	uploadResource_.Get()->Map(0, nullptr, reinterpret_cast<void**>(&mappedData_));
+	gpuBaseAddress_ = uploadResource_.Get()->GetGPUVirtualAddress();
+
+	scales_.reserve(capacity_);
+	orientations_.reserve(capacity_);
+	eulerRotations_.reserve(capacity_);
+	eulerValid_.reserve(capacity_);
+	translations_.reserve(capacity_);
+	worlds_.reserve(capacity_);
+	localBounds_.reserve(capacity_);
+	localSpheres_.reserve(capacity_);
+	worldBounds_.reserve(capacity_);
+	worldSpheres_.reserve(capacity_);
+	dirty_.reserve(capacity_);
+	denseToSlot_.reserve(capacity_);
+	generations_.reserve(capacity_);
+	slotToDense_.reserve(capacity_);
+}
+
+void TransformSystem::Shutdown() {
+	if (uploadResource_.Get()) {
+		uploadResource_.Get()->Unmap(0, nullptr);
+	}
+	uploadResource_ = ResourceObject();
+	mappedData_ = nullptr;
+	gpuBaseAddress_ = 0;
+
+	// 以降に破棄されるハンドルは IsAlive が false になり、何もしない
+	generations_.clear();
+	slotToDense_.clear();
+	freeSlots_.clear();
+	scales_.clear();
+	orientations_.clear();
+	eulerRotations_.clear();
+	eulerValid_.clear();
+	translations_.clear();
+	worlds_.clear();
+	localBounds_.clear();
+	localSpheres_.clear();
+	worldBounds_.clear();
+	worldSpheres_.clear();
+	dirty_.clear();
+	denseToSlot_.clear();
+	hasDirty_ = false;
+	hasViewProjection_ = false;
+	capacity_ = 0;
+}
+
+TransformHandle TransformSystem::Create() {
+	assert(mappedData_ != nullptr && "TransformSystem が初期化されていない");
+	assert(GetCount() < capacity_ && "TransformSystem の容量不足");
+
+	// スロットを確保（空きがあれば再利用）
+	uint32_t slot;
+	if (!freeSlots_.empty()) {
+		slot = freeSlots_.back();
+		freeSlots_.pop_back();
+	} else {
+		slot = static_cast<uint32_t>(generations_.size());
+		generations_.push_back(0);
+		slotToDense_.push_back(TransformHandle::kInvalidIndex);
+	}
+
+	// 末尾に追加
+	const uint32_t dense = GetCount();
+	scales_.push_back({ 1.0f, 1.0f, 1.0f });
+	orientations_.push_back(Quaternion::MakeIdentity());
+	eulerRotations_.push_back({ 0.0f, 0.0f, 0.0f });
+	eulerValid_.push_back(1);
+	translations_.push_back({ 0.0f, 0.0f, 0.0f });
+	worlds_.push_back(Affine3x4::MakeIdentity());
+	localBounds_.push_back(AABB::MakeEmpty());
+	localSpheres_.push_back({});
+	worldBounds_.push_back(AABB::MakeEmpty());
+	worldSpheres_.push_back({});
+	dirty_.push_back(1);
+	denseToSlot_.push_back(slot);
+	slotToDense_[slot] = dense;
+	hasDirty_ = true;
+
+	return { slot, generations_[slot] };
+}
+
+void TransformSystem::Destroy(TransformHandle handle) {
+	if (!IsAlive(handle)) {
+		return;
+	}
+
+	const uint32_t dense = slotToDense_[handle.index];
+	const uint32_t last = GetCount() - 1;
+
+	// 末尾の要素を空いた位置へ移動して前詰めを保つ
+	if (dense != last) {
+		scales_[dense] = scales_[last];
+		orientations_[dense] = orientations_[last];
+		eulerRotations_[dense] = eulerRotations_[last];
+		eulerValid_[dense] = eulerValid_[last];
+		translations_[dense] = translations_[last];
+		worlds_[dense] = worlds_[last];
+		localBounds_[dense] = localBounds_[last];
+		localSpheres_[dense] = localSpheres_[last];
+		worldBounds_[dense] = worldBounds_[last];
+		worldSpheres_[dense] = worldSpheres_[last];
+		dirty_[dense] = dirty_[last];
+		denseToSlot_[dense] = denseToSlot_[last];
+		slotToDense_[denseToSlot_[dense]] = dense;
+		// CBV の位置が変わるので、移動したものの定数をすぐ新しいスロットへ書き直す
+		// （次の Update を待つと、それまでに記録した描画が破棄したオブジェクトの行列を使ってしまう）。
+		// 値が変わって再計算待ちのものは Update で改めて書き込まれる
+		if (hasViewProjection_) {
+			WriteConstants(dense, lastViewProjection_);
+		}
+	}
+
+	scales_.pop_back();
+	orientations_.pop_back();
+	eulerRotations_.pop_back();
+	eulerValid_.pop_back();
+	translations_.pop_back();
+	worlds_.pop_back();
+	localBounds_.pop_back();
+	localSpheres_.pop_back();
+	worldBounds_.pop_back();
+	worldSpheres_.pop_back();
+	dirty_.pop_back();
+	denseToSlot_.pop_back();
+
+	// スロットを解放し、世代を進めて古いハンドルを無効にする
+	slotToDense_[handle.index] = TransformHandle::kInvalidIndex;
+	++generations_[handle.index];
+	freeSlots_.push_back(handle.index);
+}
+
+bool TransformSystem::IsAlive(TransformHandle handle) const {
+	return handle.index < generations_.size() &&
+		generations_[handle.index] == handle.generation &&
+		slotToDense_[handle.index] != TransformHandle::kInvalidIndex;
+}
+
+void TransformSystem::Update(const Camera& camera) {
+	const Matrix4x4 viewProjection = camera.GetViewProjectionMatrix();
+	const bool viewProjectionChanged =
+		!hasViewProjection_ || std::memcmp(&viewProjection, &lastViewProjection_, sizeof(Matrix4x4)) != 0;
+
+	// カメラも動かず、値の変わったものも無ければ書き込みは不要
+	if (!viewProjectionChanged && !hasDirty_) {
+		return;
+	}
+
+	const uint32_t count = GetCount();
+
+	// 1. 変更のあったものだけワールド行列と境界を再計算
+	if (hasDirty_) {
+		for (uint32_t i = 0; i < count; ++i) {
+			if (dirty_[i]) {
+				worlds_[i] = Affine3x4::MakeAffine(scales_[i], orientations_[i], translations_[i]);
+				worldBounds_[i] = AABB::Transform(localBounds_[i], worlds_[i]);
+				worldSpheres_[i] = BoundingSphere::Transform(localSpheres_[i], worlds_[i]);
+			}
+		}
+	}
+
+	// 2. WVP を計算してアップロードバッファへ順番に書き込む
+	//    （書き込み結合メモリなので読み戻さず、スロット単位でまとめて書く）
+	for (uint32_t i = 0; i < count; ++i) {
+		if (!viewProjectionChanged && !dirty_[i]) {
+			continue;
+		}
+		WriteConstants(i, viewProjection);
+	}
+
+	if (hasDirty_) {
+		std::memset(dirty_.data(), 0, dirty_.size());
+		hasDirty_ = false;
+	}
+	lastViewProjection_ = viewProjection;
+	hasViewProjection_ = true;
+}
+
+void TransformSystem::SetScale(TransformHandle handle, const Vector3& scale) {
+	const uint32_t dense = DenseIndex(handle);
+	scales_[dense] = scale;
+	MarkDirty(dense);
+}
+
+Vector3 TransformSystem::GetRotation(TransformHandle handle) const {
+	const uint32_t dense = DenseIndex(handle);
+	if (eulerValid_[dense]) {
+		return eulerRotations_[dense];
+	}
+	return Quaternion::ToEuler(orientations_[dense]);
+}
+
+void TransformSystem::SetRotation(TransformHandle handle, const Vector3& rotation) {
+	const uint32_t dense = DenseIndex(handle);
+	// 三角関数はここで一度だけ。行列の再計算はクォータニオンから行う
+	orientations_[dense] = Quaternion::MakeFromEuler(rotation);
+	eulerRotations_[dense] = rotation;
+	eulerValid_[dense] = 1;
+	MarkDirty(dense);
+}
+
+void TransformSystem::SetRotationQuaternion(TransformHandle handle, const Quaternion& rotation) {
+	const uint32_t dense = DenseIndex(handle);
+	orientations_[dense] = rotation;
+	eulerValid_[dense] = 0;
+	MarkDirty(dense);
+}
+
+void TransformSystem::SetTranslation(TransformHandle handle, const Vector3& translation) {
+	const uint32_t dense = DenseIndex(handle);
+	translations_[dense] = translation;
+	MarkDirty(dense);
+}
+
+void TransformSystem::SetLocalBounds(TransformHandle handle, const AABB& bounds, const BoundingSphere& sphere) {
+	const uint32_t dense = DenseIndex(handle);
+	localBounds_[dense] = bounds;
+	localSpheres_[dense] = sphere;
+	MarkDirty(dense);
+}
+
+D3D12_GPU_VIRTUAL_ADDRESS TransformSystem::GetGPUVirtualAddress(TransformHandle handle) const {
+	return gpuBaseAddress_ + kSlotStride * DenseIndex(handle);
+}
+
+uint32_t TransformSystem::DenseIndex(TransformHandle handle) const {
+	assert(IsAlive(handle) && "無効なTransformHandle");
+	return slotToDense_[handle.index];
+}
+
+void TransformSystem::WriteConstants(uint32_t denseIndex, const Matrix4x4& viewProjection) {
+	TransformationMatrix data;
+	data.WVP = Affine3x4::Multiply(worlds_[denseIndex], viewProjection);
+	data.World = worlds_[denseIndex];
+	std::memcpy(mappedData_ + kSlotStride * denseIndex, &data, sizeof(TransformationMatrix));
+}
+
+void TransformSystem::MarkDirty(uint32_t denseIndex) {
+	dirty_[denseIndex] = 1;
+	hasDirty_ = true;
+}
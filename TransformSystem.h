@@ -0,0 +1,128 @@
+#pragma once
+#include <d3d12.h>
+#include <cstdint>
+#include <vector>
+#include "Vector3.h"
+#include "Matrix4x4.h"
+#include "Affine3x4.h"
+#include "Quaternion.h"
+#include "BoundingVolume.h"
+#include "ResourceObject.h"
+
+class Camera;
+
+// トランスフォームのハンドル
+// index はスロット番号、generation は解放・再利用を見分けるための世代番号
+struct TransformHandle {
+	static constexpr uint32_t kInvalidIndex = 0xFFFFFFFFu;
+
+	uint32_t index = kInvalidIndex;
+	uint32_t generation = 0;
+
+	bool IsValid() const { return index != kInvalidIndex; }
+};
+
+// ==================================
+// トランスフォームの一括管理
+// ==================================
+// 全オブジェクトの scale / rotation / translation を連続した配列（SoA）で持ち、
+// Update でワールド行列と WVP 行列をまとめて計算して 1 本のアップロードバッファに書き込む。
+//
+//   - 配列は生存しているものだけを前詰めで保持する（削除時は末尾と入れ替え、移動したものの CBV はその場で書き直す）
+//   - ハンドル → 配列位置は間接テーブルで引くので、入れ替えが起きてもハンドルは有効なまま
+//   - ワールド行列は値が変わったものだけ再計算する（ブロックのような静的オブジェクト向け）
+//   - 回転は内部ではクォータニオンで持ち、行列化に三角関数を使わない。
+//     オイラー角でもクォータニオンでも設定できる
+//   - 定数バッファは 256 バイト境界のスロットを配列位置の順に並べる
+//   - ローカルの境界を設定したものは、ワールド行列と一緒にワールド空間の境界も更新する
+class TransformSystem {
+public:
+	static TransformSystem* GetInstance();
+
+	// capacity はアップロードバッファのスロット数（上限）
+	void Initialize(ID3D12Device* device, uint32_t capacity = kDefaultCapacity);
+	void Shutdown();
+
+	// 生成・破棄
+	TransformHandle Create();
+	void Destroy(TransformHandle handle);
+	bool IsAlive(TransformHandle handle) const;
+
+	// 全トランスフォームの行列を計算してアップロードバッファへ書き込む（1フレーム1回）
+	void Update(const Camera& camera);
+
+	// アクセサ（Set はワールド行列を再計算対象にする）
+	const Vector3& GetScale(TransformHandle handle) const { return scales_[DenseIndex(handle)]; }
+	const Vector3& GetTranslation(TransformHandle handle) const { return translations_[DenseIndex(handle)]; }
+	void SetScale(TransformHandle handle, const Vector3& scale);
+	void SetTranslation(TransformHandle handle, const Vector3& translation);
+
+	// 回転（オイラー角）。クォータニオンで設定された場合は分解した値を返す
+	Vector3 GetRotation(TransformHandle handle) const;
+	void SetRotation(TransformHandle handle, const Vector3& rotation);
+
+	// 回転（クォータニオン）。正規化済みであること
+	const Quaternion& GetRotationQuaternion(TransformHandle handle) const { return orientations_[DenseIndex(handle)]; }
+	void SetRotationQuaternion(TransformHandle handle, const Quaternion& rotation);
+
+	// 直近の Update で計算したワールド行列
+	const Affine3x4& GetWorldMatrix(TransformHandle handle) const { return worlds_[DenseIndex(handle)]; }
+
+	// 境界（モデル空間）。設定しなければ空の AABB / 半径 0 の球のまま
+	void SetLocalBounds(TransformHandle handle, const AABB& bounds, const BoundingSphere& sphere);
+
+	// 直近の Update で計算したワールド空間の境界（カリング・ピッキング用）
+	const AABB& GetWorldBounds(TransformHandle handle) const { return worldBounds_[DenseIndex(handle)]; }
+	const BoundingSphere& GetWorldBoundingSphere(TransformHandle handle) const { return worldSpheres_[DenseIndex(handle)]; }
+
+	// 描画時に WVP 用 CBV として渡すアドレス
+	D3D12_GPU_VIRTUAL_ADDRESS GetGPUVirtualAddress(TransformHandle handle) const;
+
+	uint32_t GetCount() const { return static_cast<uint32_t>(scales_.size()); }
+	uint32_t GetCapacity() const { return capacity_; }
+
+	static constexpr uint32_t kDefaultCapacity = 1u << 16;
+
+private:
+	TransformSystem() = default;
+	~TransformSystem() = default;
+	TransformSystem(const TransformSystem&) = delete;
+	TransformSystem& operator=(const TransformSystem&) = delete;
+
+	uint32_t DenseIndex(TransformHandle handle) const;
+	void MarkDirty(uint32_t denseIndex);
+	// worlds_[denseIndex] から WVP を計算して CBV スロットへ書き込む
+	void WriteConstants(uint32_t denseIndex, const Matrix4x4& viewProjection);
+
+	uint32_t capacity_ = 0;
+
+	// ハンドル側（スロット番号で引く）
+	std::vector<uint32_t> generations_;
+	std::vector<uint32_t> slotToDense_;
+	std::vector<uint32_t> freeSlots_;
+
+	// データ側（前詰め、添字 = 配列位置）
+	std::vector<Vector3> scales_;
+	std::vector<Quaternion> orientations_;
+	std::vector<Vector3> translations_;
+	std::vector<Vector3> eulerRotations_; // SetRotation で渡されたオイラー角（GetRotation 用）
+	std::vector<uint8_t> eulerValid_;
+	std::vector<Affine3x4> worlds_;
+	std::vector<AABB> localBounds_;
+	std::vector<BoundingSphere> localSpheres_;
+	std::vector<AABB> worldBounds_;
+	std::vector<BoundingSphere> worldSpheres_;
+	std::vector<uint8_t> dirty_;
+	std::vector<uint32_t> denseToSlot_;
+
+	// 変更のあったものだけ再計算するための情報
+	bool hasDirty_ = false;
+	Matrix4x4 lastViewProjection_ = {};
+	bool hasViewProjection_ = false;
+
+	// アップロードバッファ（capacity_ * kSlotStride バイト、マップしたまま）
+	static constexpr size_t kSlotStride = 256;
+	ResourceObject uploadResource_;
+	uint8_t* mappedData_ = nullptr;
+	D3D12_GPU_VIRTUAL_ADDRESS gpuBaseAddress_ = 0;
+};
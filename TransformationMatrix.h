@@ -1,7 +1,9 @@
 #pragma once
 #include "Matrix4x4.h"
+#include "Affine3x4.h"
 
+// シェーダー側の TransformationMatrix と同じレイアウト（112バイト）
 struct TransformationMatrix {
 	Matrix4x4 WVP; // ワールド×ビュー×プロジェクション行列
-	Matrix4x4 World; // ワールド行列
+	Affine3x4 World; // ワールド行列（3x4）
 };
\ No newline at end of file
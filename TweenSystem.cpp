@@ -0,0 +1,189 @@
+#include "TweenSystem.h"
+#include <algorithm>
+#include <cassert>
+
+namespace {
+constexpr uint32_t kInvalidBucket = 0xFFFFFFFFu;
+}
+
+TweenSystem* TweenSystem::GetInstance() {
+	static TweenSystem instance;
+	return &instance;
+}
+
+TweenHandle TweenSystem::Start(float from, float to, float duration, EaseType ease) {
+	assert(duration > 0.0f && "トゥイーンの時間は 0 より大きいこと");
+	assert(ease < EaseType::kCount);
+
+	// スロットを確保（空きがあれば再利用）
+	uint32_t slot;
+	if (!freeSlots_.empty()) {
+		slot = freeSlots_.back();
+		freeSlots_.pop_back();
+	} else {
+		slot = static_cast<uint32_t>(generations_.size());
+		generations_.push_back(0);
+		locations_.push_back({ kInvalidBucket, 0 });
+	}
+
+	// イージングごとの配列の末尾に追加
+	const uint32_t bucketIndex = static_cast<uint32_t>(ease);
+	Bucket& bucket = buckets_[bucketIndex];
+	const uint32_t dense = static_cast<uint32_t>(bucket.slots.size());
+	bucket.elapsed.push_back(0.0f);
+	bucket.inverseDuration.push_back(1.0f / duration);
+	bucket.from.push_back(from);
+	bucket.to.push_back(to);
+	bucket.values.push_back(from);
+	bucket.slots.push_back(slot);
+	locations_[slot] = { bucketIndex, dense };
+
+	return { slot, generations_[slot] };
+}
+
+void TweenSystem::Stop(TweenHandle handle) {
+	if (!IsAlive(handle)) {
+		return;
+	}
+	Remove(handle.index);
+}
+
+bool TweenSystem::IsAlive(TweenHandle handle) const {
+	return handle.index < generations_.size() &&
+		generations_[handle.index] == handle.generation &&
+		locations_[handle.index].bucket != kInvalidBucket;
+}
+
+template <typename EaseFunction>
+void TweenSystem::AdvanceBucket(Bucket& bucket, float dt, EaseFunction ease) {
+	const size_t count = bucket.slots.size();
+	float* elapsed = bucket.elapsed.data();
+	const float* inverseDuration = bucket.inverseDuration.data();
+	const float* from = bucket.from.data();
+	const float* to = bucket.to.data();
+	float* values = bucket.values.data();
+
+	// 分岐のない同じ計算の繰り返しなので、コンパイラがベクトル化できる
+	for (size_t i = 0; i < count; ++i) {
+		elapsed[i] += dt;
+		const float t = std::min(elapsed[i] * inverseDuration[i], 1.0f);
+		const float eased = ease(t);
+		values[i] = t >= 1.0f ? to[i] : from[i] + (to[i] - from[i]) * eased;
+	}
+
+	// 終了判定は別ループでまとめて行う
+	for (size_t i = 0; i < count; ++i) {
+		if (elapsed[i] * inverseDuration[i] >= 1.0f) {
+			const uint32_t slot = bucket.slots[i];
+			completed_.push_back({ slot, generations_[slot] });
+		}
+	}
+}
+
+void TweenSystem::Update(float dt) {
+	// 前のフレームで終了したものを解放
+	// （Stop 済みや、解放後に再利用されたスロットは IsAlive で弾かれる）
+	for (const TweenHandle& handle : completed_) {
+		if (IsAlive(handle)) {
+			Remove(handle.index);
+		}
+	}
+	completed_.clear();
+
+	for (uint32_t i = 0; i < buckets_.size(); ++i) {
+		Bucket& bucket = buckets_[i];
+		if (bucket.slots.empty()) {
+			continue;
+		}
+
+		switch (static_cast<EaseType>(i)) {
+		case EaseType::Linear:     AdvanceBucket(bucket, dt, [](float t) { return Easing::Linear(t); }); break;
+		case EaseType::InQuad:     AdvanceBucket(bucket, dt, [](float t) { return Easing::EaseInQuad(t); }); break;
+		case EaseType::OutQuad:    AdvanceBucket(bucket, dt, [](float t) { return Easing::EaseOutQuad(t); }); break;
+		case EaseType::InOutQuad:  AdvanceBucket(bucket, dt, [](float t) { return Easing::EaseInOutQuad(t); }); break;
+		case EaseType::InOutSine:  AdvanceBucket(bucket, dt, [](float t) { return Easing::EaseInOutSine(t); }); break;
+		case EaseType::InCubic:    AdvanceBucket(bucket, dt, [](float t) { return Easing::EaseInCubic(t); }); break;
+		case EaseType::OutCubic:   AdvanceBucket(bucket, dt, [](float t) { return Easing::EaseOutCubic(t); }); break;
+		case EaseType::InOutCubic: AdvanceBucket(bucket, dt, [](float t) { return Easing::EaseInOutCubic(t); }); break;
+		case EaseType::InOut:      AdvanceBucket(bucket, dt, [](float t) { return Easing::EaseInOut(t); }); break;
+		case EaseType::OutBounce:  AdvanceBucket(bucket, dt, [](float t) { return Easing::EaseOutBounce(t); }); break;
+		case EaseType::OutBack:    AdvanceBucket(bucket, dt, [](float t) { return Easing::EaseOutBack(t); }); break;
+		case EaseType::OutElastic: AdvanceBucket(bucket, dt, [](float t) { return Easing::EaseOutElastic(t); }); break;
+		default: break;
+		}
+	}
+}
+
+float TweenSystem::GetValue(TweenHandle handle) const {
+	const Location& location = GetLocation(handle);
+	return buckets_[location.bucket].values[location.dense];
+}
+
+bool TweenSystem::IsFinished(TweenHandle handle) const {
+	if (!IsAlive(handle)) {
+		return false;
+	}
+	const Location& location = GetLocation(handle);
+	const Bucket& bucket = buckets_[location.bucket];
+	return bucket.elapsed[location.dense] * bucket.inverseDuration[location.dense] >= 1.0f;
+}
+
+void TweenSystem::Clear() {
+	for (Bucket& bucket : buckets_) {
+		for (uint32_t slot : bucket.slots) {
+			locations_[slot].bucket = kInvalidBucket;
+			++generations_[slot];
+			freeSlots_.push_back(slot);
+		}
+		bucket.elapsed.clear();
+		bucket.inverseDuration.clear();
+		bucket.from.clear();
+		bucket.to.clear();
+		bucket.values.clear();
+		bucket.slots.clear();
+	}
+	completed_.clear();
+}
+
+uint32_t TweenSystem::GetCount() const {
+	size_t count = 0;
+	for (const Bucket& bucket : buckets_) {
+		count += bucket.slots.size();
+	}
+	return static_cast<uint32_t>(count);
+}
+
+void TweenSystem::Remove(uint32_t slot) {
+	const Location location = locations_[slot];
+	Bucket& bucket = buckets_[location.bucket];
+	const uint32_t dense = location.dense;
+	const uint32_t last = static_cast<uint32_t>(bucket.slots.size()) - 1;
+
+	// 末尾の要素を空いた位置へ移動して前詰めを保つ
+	if (dense != last) {
+		bucket.elapsed[dense] = bucket.elapsed[last];
+		bucket.inverseDuration[dense] = bucket.inverseDuration[last];
+		bucket.from[dense] = bucket.from[last];
+		bucket.to[dense] = bucket.to[last];
+		bucket.values[dense] = bucket.values[last];
+		bucket.slots[dense] = bucket.slots[last];
+		locations_[bucket.slots[dense]].dense = dense;
+	}
+
+	bucket.elapsed.pop_back();
+	bucket.inverseDuration.pop_back();
+	bucket.from.pop_back();
+	bucket.to.pop_back();
+	bucket.values.pop_back();
+	bucket.slots.pop_back();
+
+	// スロットを解放し、世代を進めて古いハンドルを無効にする
+	locations_[slot].bucket = kInvalidBucket;
+	++generations_[slot];
+	freeSlots_.push_back(slot);
+}
+
+const TweenSystem::Location& TweenSystem::GetLocation(TweenHandle handle) const {
+	assert(IsAlive(handle) && "無効なTweenHandle");
+	return locations_[handle.index];
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Easing.h"
+
+// トゥイーンのハンドル
+// index はスロット番号、generation は解放・再利用を見分けるための世代番号
+struct TweenHandle {
+	static constexpr uint32_t kInvalidIndex = 0xFFFFFFFFu;
+
+	uint32_t index = kInvalidIndex;
+	uint32_t generation = 0;
+
+	bool IsValid() const { return index != kInvalidIndex; }
+};
+
+// ==================================
+// トゥイーンの一括管理
+// ==================================
+// from → to を duration 秒かけてイージングで補間する値を、まとめて進める。
+//
+//   - イージングの種類ごとに配列（SoA）を分けて持つので、更新ループの中で分岐せず
+//     同じ計算を連続した要素に適用できる（多項式のイージングはそのままベクトル化される）
+//   - 配列は生存しているものだけを前詰めで保持する（削除時は末尾と入れ替え）
+//   - 終了したトゥイーンは Update の最後に GetCompleted へまとめて報告され、
+//     その値（= to）は次の Update の先頭で解放されるまで読める
+class TweenSystem {
+public:
+	static TweenSystem* GetInstance();
+
+	// 開始（duration は 0 より大きいこと）
+	TweenHandle Start(float from, float to, float duration, EaseType ease = EaseType::Linear);
+
+	// 途中で止めて解放する（無効なハンドルなら何もしない）
+	void Stop(TweenHandle handle);
+	bool IsAlive(TweenHandle handle) const;
+
+	// 全トゥイーンを dt 秒進める（1フレーム1回）
+	void Update(float dt);
+
+	// 現在の値
+	float GetValue(TweenHandle handle) const;
+
+	// 生存していて、最後まで進んだか（このフレームで終了したもの）
+	bool IsFinished(TweenHandle handle) const;
+
+	// 直近の Update で終了したトゥイーン
+	std::span<const TweenHandle> GetCompleted() const { return completed_; }
+
+	// 全て破棄する（シーン切り替えなど）
+	void Clear();
+
+	uint32_t GetCount() const;
+
+private:
+	TweenSystem() = default;
+	~TweenSystem() = default;
+	TweenSystem(const TweenSystem&) = delete;
+	TweenSystem& operator=(const TweenSystem&) = delete;
+
+	// 同じイージングのトゥイーンをまとめた配列（添字 = 配列位置）
+	struct Bucket {
+		std::vector<float> elapsed;
+		std::vector<float> inverseDuration;
+		std::vector<float> from;
+		std::vector<float> to;
+		std::vector<float> values;
+		std::vector<uint32_t> slots;
+	};
+
+	// スロット → どのバケットの何番目か
+	struct Location {
+		uint32_t bucket;
+		uint32_t dense;
+	};
+
+	template <typename EaseFunction>
+	void AdvanceBucket(Bucket& bucket, float dt, EaseFunction ease);
+
+	void Remove(uint32_t slot);
+	const Location& GetLocation(TweenHandle handle) const;
+
+	std::array<Bucket, static_cast<size_t>(EaseType::kCount)> buckets_;
+
+	// ハンドル側（スロット番号で引く）
+	std::vector<uint32_t> generations_;
+	std::vector<Location> locations_;
+	std::vector<uint32_t> freeSlots_;
+
+	std::vector<TweenHandle> completed_;
+};
@@ -0,0 +1,149 @@
+#include "UploadHeap.h"
+#include "CommandListManager.h"
+#include "ResourcesUtility.h"
+#include <cassert>
+
+UploadHeap* UploadHeap::GetInstance() {
+	static UploadHeap instance;
+	return &instance;
+}
+
+void UploadHeap::Initialize(ID3D12Device* device, CommandQueue* queue, size_t pageSize, uint32_t maxPageCount) {
+	assert(device != nullptr && queue != nullptr);
+	assert(pageSize > 0 && maxPageCount > 0);
+	device_ = device;
+	queue_ = queue;
+	pageSize_ = pageSize;
+	maxPageCount_ = maxPageCount;
+
+	// 1 枚は先に作っておく（残りは足りなくなったら作る）
+	AddPage();
+}
+
+void UploadHeap::Shutdown() {
+	// 呼び出し側で GPU の完了を待ってから呼ぶこと
+	for (Page& page : pages_) {
+		page.resource->Unmap(0, nullptr);
+	}
+	pages_.clear();
+	dedicatedBuffers_.clear();
+	device_ = nullptr;
+	queue_ = nullptr;
+}
+
+// ===================================
+// 確保
+// ===================================
+UploadAllocation UploadHeap::Allocate(size_t size, size_t alignment) {
+	assert(device_ != nullptr);
+	assert(size > 0);
+
+	if (size > pageSize_) {
+		return AllocateDedicated(size);
+	}
+
+	UploadAllocation allocation;
+
+	// 1.終わったコピーを戻してから、今あるページで探す
+	Retire();
+	for (Page& page : pages_) {
+		if (TryAllocate(page, size, alignment, allocation)) {
+			return allocation;
+		}
+	}
+
+	// 2.ページを足す
+	if (pages_.size() < maxPageCount_) {
+		AddPage();
+		if (TryAllocate(pages_.back(), size, alignment, allocation)) {
+			return allocation;
+		}
+	}
+
+	// 3.締め済みの区間の完了を古い順に待つ
+	for (Page& page : pages_) {
+		while (page.ring.GetOldestFenceValue() != 0) {
+			queue_->WaitForFence(page.ring.GetOldestFenceValue());
+			Retire();
+			if (TryAllocate(page, size, alignment, allocation)) {
+				return allocation;
+			}
+		}
+	}
+
+	// 4.どのページも Submit 前の確保で埋まっている
+	return AllocateDedicated(size);
+}
+
+bool UploadHeap::TryAllocate(Page& page, size_t size, size_t alignment, UploadAllocation& allocation) {
+	const size_t offset = page.ring.Allocate(size, alignment);
+	if (offset == RingAllocator::kInvalidOffset) {
+		return false;
+	}
+	allocation.resource = page.resource.Get();
+	allocation.offset = offset;
+	allocation.size = size;
+	allocation.cpuAddress = page.cpuAddress + offset;
+	allocation.gpuAddress = page.resource->GetGPUVirtualAddress() + offset;
+	return true;
+}
+
+void UploadHeap::AddPage() {
+	Page page;
+	page.resource = CreateBufferResource(device_, pageSize_);
+	page.resource->SetName(L"UploadHeapPage");
+	HRESULT hr = page.resource->Map(0, nullptr, reinterpret_cast<void**>(&page.cpuAddress));
+	assert(SUCCEEDED(hr));
+	page.ring.Reset(pageSize_);
+	pages_.push_back(std::move(page));
+}
+
+UploadAllocation UploadHeap::AllocateDedicated(size_t size) {
+	DedicatedBuffer buffer;
+	buffer.resource = CreateBufferResource(device_, size);
+	buffer.resource->SetName(L"UploadHeapDedicated");
+
+	UploadAllocation allocation;
+	allocation.resource = buffer.resource.Get();
+	allocation.size = size;
+	HRESULT hr = buffer.resource->Map(0, nullptr, &allocation.cpuAddress);
+	assert(SUCCEEDED(hr));
+	allocation.gpuAddress = buffer.resource->GetGPUVirtualAddress();
+
+	dedicatedBuffers_.push_back(std::move(buffer));
+	return allocation;
+}
+
+// ===================================
+// フェンスでの締めと解放
+// ===================================
+void UploadHeap::Submit(uint64_t fenceValue) {
+	for (Page& page : pages_) {
+		page.ring.Close(fenceValue);
+	}
+	for (DedicatedBuffer& buffer : dedicatedBuffers_) {
+		if (buffer.fenceValue == 0) {
+			buffer.fenceValue = fenceValue;
+		}
+	}
+}
+
+void UploadHeap::Retire() {
+	auto isFenceComplete = [this](uint64_t fenceValue) { return queue_->IsFenceComplete(fenceValue); };
+	for (Page& page : pages_) {
+		page.ring.Retire(isFenceComplete);
+	}
+	// 締めていないものは常に末尾にある
+	while (!dedicatedBuffers_.empty() && dedicatedBuffers_.front().fenceValue != 0 &&
+		isFenceComplete(dedicatedBuffers_.front().fenceValue)) {
+		dedicatedBuffers_.pop_front();
+	}
+}
+
+size_t UploadHeap::GetUsedSize() const {
+	size_t used = 0;
+	for (const Page& page : pages_) {
+		used += page.ring.GetUsedSize();
+	}
+	return used;
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <d3d12.h>
+#include <wrl/client.h>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "RingAllocator.h"
+
+class CommandQueue;
+
+// アップロード用に切り出した領域
+struct UploadAllocation {
+	ID3D12Resource* resource = nullptr;         // 切り出し元のアップロードバッファ
+	uint64_t offset = 0;                        // resource 内のオフセット
+	uint64_t size = 0;
+	void* cpuAddress = nullptr;                 // 書き込み先（Map 済み）
+	D3D12_GPU_VIRTUAL_ADDRESS gpuAddress = 0;
+};
+
+// ==================================
+// テクスチャ・バッファ転送用のアップロードヒープ
+// ==================================
+// 大きなアップロードバッファ（ページ）を数枚だけ作って Map したままにし、RingAllocator で切り出す。
+// 転送のたびに中間リソースを作って持ち続けるのをやめ、コピーが終わった領域は次の転送に使い回す。
+//
+//   UploadAllocation upload = UploadHeap::GetInstance()->Allocate(size, alignment);
+//   ... upload.cpuAddress に書き、upload.resource / upload.offset からコピーを積む ...
+//   uint64_t fenceValue = context.Finish();
+//   UploadHeap::GetInstance()->Submit(fenceValue); // Finish の戻り値で締める
+//
+// 締めた領域は CommandQueue::IsFenceComplete が true になった後の Retire（毎フレーム）で戻る。
+// ページに入らない大きさのものだけは専用のバッファを作り、同じようにフェンスで解放する。
+class UploadHeap {
+public:
+	static UploadHeap* GetInstance();
+
+	// queue : コピーを積むコマンドリストを実行するキュー（フェンスの確認・待機に使う）
+	void Initialize(ID3D12Device* device, CommandQueue* queue, size_t pageSize = kDefaultPageSize, uint32_t maxPageCount = kDefaultMaxPageCount);
+	void Shutdown();
+
+	// size バイトを alignment（2 のべき乗）境界で確保する
+	// 全ページが埋まっていれば最も古いコピーの完了を待ち、それでも入らなければ専用のバッファを作る
+	UploadAllocation Allocate(size_t size, size_t alignment = D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+
+	// 前回の Submit 以降の確保を、それを使うコマンドリストのフェンス値で締める
+	void Submit(uint64_t fenceValue);
+
+	// コピーの終わった領域を戻す
+	void Retire();
+
+	size_t GetPageCount() const { return pages_.size(); }
+	size_t GetUsedSize() const;
+
+private:
+	UploadHeap() = default;
+	~UploadHeap() = default;
+	UploadHeap(const UploadHeap&) = delete;
+	UploadHeap& operator=(const UploadHeap&) = delete;
+
+	static constexpr size_t kDefaultPageSize = 32 * 1024 * 1024;
+	static constexpr uint32_t kDefaultMaxPageCount = 4;
+
+	struct Page {
+		Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+		uint8_t* cpuAddress = nullptr;
+		RingAllocator ring;
+	};
+
+	// ページに入らない大きさの転送用
+	struct DedicatedBuffer {
+		Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+		uint64_t fenceValue = 0; // 0 = まだ締めていない
+	};
+
+	bool TryAllocate(Page& page, size_t size, size_t alignment, UploadAllocation& allocation);
+	void AddPage();
+	UploadAllocation AllocateDedicated(size_t size);
+
+	ID3D12Device* device_ = nullptr;
+	CommandQueue* queue_ = nullptr;
+	size_t pageSize_ = 0;
+	uint32_t maxPageCount_ = 0;
+
+	std::vector<Page> pages_;
+	std::deque<DedicatedBuffer> dedicatedBuffers_;
+};
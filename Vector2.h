@@ -1,48 +1,79 @@
 #pragma once
+#include <cmath>
 
 class Vector2 {
 public:
 	float x, y;
 
 	// 加算代入
-	Vector2& operator+=(const Vector2& v) {
+	constexpr Vector2& operator+=(const Vector2& v) {
 		x += v.x;
 		y += v.y;
 		return *this;
 	}
 
 	// 減算代入
-	Vector2& operator-=(const Vector2& v) {
+	constexpr Vector2& operator-=(const Vector2& v) {
 		x -= v.x;
 		y -= v.y;
 		return *this;
 	}
 
 	// スカラー倍代入
-	Vector2& operator*=(float s) {
+	constexpr Vector2& operator*=(float s) {
 		x *= s;
 		y *= s;
 		return *this;
 	}
 
-	Vector2& operator/=(float s) {
+	constexpr Vector2& operator/=(float s) {
 		x /= s;
 		y /= s;
 		return *this;
 	}
 
-	static Vector2 Add(const Vector2& v1, const Vector2& v2);
-	static Vector2 Subtract(const Vector2& v1, const Vector2& v2);
-	static Vector2 Multiply(float scalar, const Vector2& v1);
-	static float Dot(const Vector2& v1, const Vector2& v2);
-	static float Length(const Vector2& v);
-	static Vector2 Normalize(const Vector2& v);
-	static float Cross(const Vector2& v1, const Vector2& v2);
+	// 加算
+	[[nodiscard]] static constexpr Vector2 Add(const Vector2& v1, const Vector2& v2) {
+		return { v1.x + v2.x, v1.y + v2.y };
+	}
+
+	// 減算
+	[[nodiscard]] static constexpr Vector2 Subtract(const Vector2& v1, const Vector2& v2) {
+		return { v1.x - v2.x, v1.y - v2.y };
+	}
+
+	// 乗算
+	[[nodiscard]] static constexpr Vector2 Multiply(float scalar, const Vector2& v1) {
+		return { v1.x * scalar, v1.y * scalar };
+	}
+
+	// 内積
+	[[nodiscard]] static constexpr float Dot(const Vector2& v1, const Vector2& v2) {
+		return v1.x * v2.x + v1.y * v2.y;
+	}
+
+	// 長さを求める
+	[[nodiscard]] static float Length(const Vector2& v) {
+		return std::sqrt(v.x * v.x + v.y * v.y);
+	}
 
+	// ノーマライズ(正規化)
+	[[nodiscard]] static Vector2 Normalize(const Vector2& v) {
+		float length = std::sqrt(v.x * v.x + v.y * v.y);
+		if (length == 0.0f) {
+			return { 0.0f, 0.0f };
+		}
+		return { v.x / length, v.y / length };
+	}
+
+	// 外積
+	[[nodiscard]] static constexpr float Cross(const Vector2& v1, const Vector2& v2) {
+		return v1.x * v2.y - v1.y * v2.x;
+	}
 };
 
-Vector2 operator+(const Vector2& v1, const Vector2& v2);
-Vector2 operator-(const Vector2& v1, const Vector2& v2);
-Vector2 operator*(float s, const Vector2& v);
-Vector2 operator*(const Vector2& v, float s);
-Vector2 operator/(const Vector2& v, float s);
\ No newline at end of file
+[[nodiscard]] constexpr Vector2 operator+(const Vector2& v1, const Vector2& v2) { return Vector2::Add(v1, v2); }
+[[nodiscard]] constexpr Vector2 operator-(const Vector2& v1, const Vector2& v2) { return Vector2::Subtract(v1, v2); }
+[[nodiscard]] constexpr Vector2 operator*(float s, const Vector2& v) { return Vector2::Multiply(s, v); }
+[[nodiscard]] constexpr Vector2 operator*(const Vector2& v, float s) { return s * v; }
+[[nodiscard]] constexpr Vector2 operator/(const Vector2& v, float s) { return Vector2::Multiply(1.0f / s, v); }
@@ -1,4 +1,5 @@
 #pragma once
+#include <cmath>
 
 class Matrix4x4;
 
@@ -7,7 +8,7 @@ public:
 	float x, y, z;
 
 	// 加算代入
-	Vector3& operator+=(const Vector3& v) {
+	constexpr Vector3& operator+=(const Vector3& v) {
 		x += v.x;
 		y += v.y;
 		z += v.z;
@@ -15,7 +16,7 @@ public:
 	}
 
 	// 減算代入
-	Vector3& operator-=(const Vector3& v) {
+	constexpr Vector3& operator-=(const Vector3& v) {
 		x -= v.x;
 		y -= v.y;
 		z -= v.z;
@@ -23,7 +24,7 @@ public:
 	}
 
 	// スカラー倍代入
-	Vector3& operator*=(float s) {
+	constexpr Vector3& operator*=(float s) {
 		x *= s;
 		y *= s;
 		z *= s;
@@ -31,30 +32,60 @@ public:
 	}
 
 
-	Vector3& operator/=(float s) {
+	constexpr Vector3& operator/=(float s) {
 		x /= s;
 		y /= s;
 		z /= s;
 		return *this;
 	}
 
-	static Vector3 Add(const Vector3& v1, const Vector3& v2);
-	static Vector3 Subtract(const Vector3& v1, const Vector3& v2);
-	static Vector3 Multiply(float scalar, const Vector3& v1);
-	static float Dot(const Vector3& v1, const Vector3& v2);
-	static float Length(const Vector3& v);
-	static Vector3 Normalize(Vector3 v);
-	static Vector3 Cross(const Vector3& a, const Vector3& b);
-	static Vector3 Transform(const Vector3& vector, const Matrix4x4& matrix);
-	static Vector3 ViewportTransform(const Vector3& ndc, const Matrix4x4& viewportMatrix);
+	[[nodiscard]] static constexpr Vector3 Add(const Vector3& v1, const Vector3& v2) {
+		return { v1.x + v2.x, v1.y + v2.y, v1.z + v2.z };
+	}
+
+	[[nodiscard]] static constexpr Vector3 Subtract(const Vector3& v1, const Vector3& v2) {
+		return { v1.x - v2.x, v1.y - v2.y, v1.z - v2.z };
+	}
+
+	[[nodiscard]] static constexpr Vector3 Multiply(float scalar, const Vector3& v1) {
+		return { v1.x * scalar, v1.y * scalar, v1.z * scalar };
+	}
+
+	[[nodiscard]] static constexpr float Dot(const Vector3& v1, const Vector3& v2) {
+		return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z;
+	}
+
+	[[nodiscard]] static float Length(const Vector3& v) {
+		return std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+	}
+
+	[[nodiscard]] static Vector3 Normalize(Vector3 v) {
+		float length = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+		return { v.x / length, v.y / length, v.z / length };
+	}
+
+	[[nodiscard]] static constexpr Vector3 Cross(const Vector3& a, const Vector3& b) {
+		return {
+			a.y * b.z - a.z * b.y,
+			a.z * b.x - a.x * b.z,
+			a.x * b.y - a.y * b.x,
+		};
+	}
+
+	// Matrix4x4 の定義が必要なため、実装は Matrix4x4.h にある（このファイルの末尾で include する）
+	[[nodiscard]] static constexpr Vector3 Transform(const Vector3& vector, const Matrix4x4& matrix);
+	[[nodiscard]] static constexpr Vector3 ViewportTransform(const Vector3& ndc, const Matrix4x4& viewportMatrix);
 };
 
-Vector3 operator+(const Vector3& v1, const Vector3& v2);
-Vector3 operator-(const Vector3& v1, const Vector3& v2);
-Vector3 operator*(float s, const Vector3& v);
-Vector3 operator*(const Vector3& v, float s);
-Vector3 operator/(const Vector3& v, float s);
+[[nodiscard]] constexpr Vector3 operator+(const Vector3& v1, const Vector3& v2) { return Vector3::Add(v1, v2); }
+[[nodiscard]] constexpr Vector3 operator-(const Vector3& v1, const Vector3& v2) { return Vector3::Subtract(v1, v2); }
+[[nodiscard]] constexpr Vector3 operator*(float s, const Vector3& v) { return Vector3::Multiply(s, v); }
+[[nodiscard]] constexpr Vector3 operator*(const Vector3& v, float s) { return s * v; }
+[[nodiscard]] constexpr Vector3 operator/(const Vector3& v, float s) { return Vector3::Multiply(1.0f / s, v); }
 
-Vector3 operator-(const Vector3& v);
-Vector3 operator+(const Vector3& v);
+[[nodiscard]] constexpr Vector3 operator-(const Vector3& v) { return { -v.x, -v.y, -v.z }; }
+[[nodiscard]] constexpr Vector3 operator+(const Vector3& v) { return v; }
 
+// constexpr 関数は呼び出す前に定義が見えている必要があるので、Vector3.h だけを include した場合でも
+// Transform / ViewportTransform の定義が入るようにする（Matrix4x4.h は先頭でこのファイルを include する）
+#include "Matrix4x4.h"
@@ -6,8 +6,12 @@ struct Vector4 {
 	float x, y, z, w;
 };
 
-Vector4 TransformWithW(const Vector3& vector, const Matrix4x4& matrix);
-
-Matrix4x4 operator+(const Matrix4x4& m1, const Matrix4x4& m2);
-Matrix4x4 operator-(const Matrix4x4& m1, const Matrix4x4& m2);
-Matrix4x4 operator*(const Matrix4x4& m1, const Matrix4x4& m2);
\ No newline at end of file
+// w 除算をせずに同次座標のまま変換する
+[[nodiscard]] constexpr Vector4 TransformWithW(const Vector3& vector, const Matrix4x4& matrix) {
+	return {
+		vector.x * matrix.m[0][0] + vector.y * matrix.m[1][0] + vector.z * matrix.m[2][0] + matrix.m[3][0],
+		vector.x * matrix.m[0][1] + vector.y * matrix.m[1][1] + vector.z * matrix.m[2][1] + matrix.m[3][1],
+		vector.x * matrix.m[0][2] + vector.y * matrix.m[1][2] + vector.z * matrix.m[2][2] + matrix.m[3][2],
+		vector.x * matrix.m[0][3] + vector.y * matrix.m[1][3] + vector.z * matrix.m[2][3] + matrix.m[3][3],
+	};
+}
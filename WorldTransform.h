@@ -1,36 +1,50 @@
 #pragma once
 #include "Math.h"
-#include "ResourceObject.h"
-#include "TransformationMatrix.h"
-
-class Camera; // 前方宣言
+#include "TransformSystem.h"
 
 class WorldTransform {
 public:
-    // トランスフォームデータ
-    Vector3 scale_ = { 1.0f, 1.0f, 1.0f };
-    Vector3 rotation_ = { 0.0f, 0.0f, 0.0f };
-    Vector3 translation_ = { 0.0f, 0.0f, 0.0f };
+    WorldTransform() = default;
+    ~WorldTransform();
 
+    // ハンドルを所有するのでコピー不可
+    WorldTransform(const WorldTransform&) = delete;
+    WorldTransform& operator=(const WorldTransform&) = delete;
 
-    WorldTransform() = default;
-    ~WorldTransform() = default;
+    // TransformSystem にトランスフォームを登録する
+    // 行列の計算は TransformSystem::Update でまとめて行われる
+    void Initialize();
 
-    // 定数バッファ
-    ResourceObject wvpResource;
-    TransformationMatrix* mappedData = nullptr;
+    // トランスフォームデータ
+    const Vector3& GetScale() const { return System()->GetScale(handle_); }
+    Vector3 GetRotation() const { return System()->GetRotation(handle_); }
+    const Vector3& GetTranslation() const { return System()->GetTranslation(handle_); }
+    void SetScale(const Vector3& scale) { System()->SetScale(handle_, scale); }
+    void SetRotation(const Vector3& rotation) { System()->SetRotation(handle_, rotation); }
+    void SetTranslation(const Vector3& translation) { System()->SetTranslation(handle_, translation); }
 
-    // ローカル → ワールド変換行列
-    Matrix4x4 matWorld_;
-    // 親となるワールド変換へのポインタ
-    const WorldTransform* parent_ = nullptr;
+    // 回転をクォータニオンで扱う場合（補間や合成はこちらの方が安い）
+    const Quaternion& GetRotationQuaternion() const { return System()->GetRotationQuaternion(handle_); }
+    void SetRotationQuaternion(const Quaternion& rotation) { System()->SetRotationQuaternion(handle_, rotation); }
 
-    void Initialize(ID3D12Device* device);
+    // ローカル → ワールド変換行列（直近の TransformSystem::Update の結果）
+    const Affine3x4& GetWorldMatrix() const { return System()->GetWorldMatrix(handle_); }
 
-	// Cameraを受け取って行列更新
-    void UpdateMatrix(const Camera& camera);
+    // 描画するモデルの境界（モデル空間）。Model::GetBounds / GetBoundingSphere を渡す
+    void SetLocalBounds(const AABB& bounds, const BoundingSphere& sphere) { System()->SetLocalBounds(handle_, bounds, sphere); }
+
+    // ワールド空間の境界（ワールド行列と一緒に TransformSystem::Update で更新される）
+    const AABB& GetWorldBounds() const { return System()->GetWorldBounds(handle_); }
+    const BoundingSphere& GetWorldBoundingSphere() const { return System()->GetWorldBoundingSphere(handle_); }
+
+    TransformHandle GetHandle() const { return handle_; }
 
     D3D12_GPU_VIRTUAL_ADDRESS GetGPUVirtualAddress() const {
-        return wvpResource.Get()->GetGPUVirtualAddress();
+        return System()->GetGPUVirtualAddress(handle_);
     }
-};
\ No newline at end of file
+
+private:
+    static TransformSystem* System() { return TransformSystem::GetInstance(); }
+
+    TransformHandle handle_;
+};